@@ -4,6 +4,8 @@
 
 #include "flutter/assets/asset_manager.h"
 
+#include <unordered_set>
+
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/fml/trace_event.h"
 
@@ -87,7 +89,19 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMappings", "pattern",
                asset_pattern.c_str());
+  // Like GetAsMapping, an asset in a resolver shadows the assets with the
+  // same name in the resolvers behind it, as long as they name their assets.
+  std::unordered_set<std::string> names;
   for (const auto& resolver : resolvers_) {
+    auto named_mappings = resolver->GetAsNamedMappings(asset_pattern, subdir);
+    if (named_mappings.has_value()) {
+      for (auto& named_mapping : named_mappings.value()) {
+        if (names.insert(std::move(named_mapping.name)).second) {
+          mappings.push_back(std::move(named_mapping.mapping));
+        }
+      }
+      continue;
+    }
     auto resolver_mappings = resolver->GetAsMappings(asset_pattern, subdir);
     mappings.insert(mappings.end(),
                     std::make_move_iterator(resolver_mappings.begin()),
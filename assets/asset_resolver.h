@@ -5,6 +5,7 @@
 #ifndef FLUTTER_ASSETS_ASSET_RESOLVER_H_
 #define FLUTTER_ASSETS_ASSET_RESOLVER_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,7 +27,8 @@ class AssetResolver {
   enum AssetResolverType {
     kAssetManager,
     kApkAssetProvider,
-    kDirectoryAssetBundle
+    kDirectoryAssetBundle,
+    kPackedAssetBundle,
   };
 
   virtual bool IsValid() const = 0;
@@ -81,6 +83,30 @@ class AssetResolver {
     return {};
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief      An asset returned by GetAsNamedMappings().
+  ///
+  struct NamedMapping {
+    /// The name of the asset, relative to the root of the resolver.
+    std::string name;
+    std::unique_ptr<fml::Mapping> mapping;
+  };
+
+  //--------------------------------------------------------------------------
+  /// @brief      Same as GetAsMappings() but also returns the name of each
+  ///             asset. The asset manager uses the names to skip assets that
+  ///             a resolver ahead of this one already returned.
+  ///
+  /// @return     Returns the matching assets, or std::nullopt if this
+  ///             resolver does not name its assets, in which case the asset
+  ///             manager uses GetAsMappings() instead.
+  ///
+  [[nodiscard]] virtual std::optional<std::vector<NamedMapping>>
+  GetAsNamedMappings(const std::string& asset_pattern,
+                     const std::optional<std::string>& subdir) const {
+    return std::nullopt;
+  }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(AssetResolver);
 };
@@ -63,17 +63,48 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
 std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     const std::string& asset_pattern,
     const std::optional<std::string>& subdir) const {
+  auto named_mappings = GetAsNamedMappings(asset_pattern, subdir);
   std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  for (auto& named_mapping : named_mappings.value()) {
+    mappings.push_back(std::move(named_mapping.mapping));
+  }
+  return mappings;
+}
+
+std::optional<std::vector<AssetResolver::NamedMapping>>
+DirectoryAssetBundle::GetAsNamedMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<NamedMapping> mappings;
   if (!is_valid_) {
     FML_DLOG(WARNING) << "Asset bundle was not valid.";
     return mappings;
   }
 
   std::regex asset_regex(asset_pattern);
+  // The path of the visited directory relative to the bundle, with a trailing
+  // slash unless it is the bundle itself.
+  std::string prefix = subdir.has_value() ? subdir.value() + "/" : "";
   fml::FileVisitor visitor = [&](const fml::UniqueFD& directory,
                                  const std::string& filename) {
     TRACE_EVENT0("flutter", "DirectoryAssetBundle::GetAsMappings FileVisitor");
 
+    // Without a subdirectory, recurse like fml::VisitFilesRecursively while
+    // keeping track of the path for the asset names.
+    if (!subdir && fml::IsDirectory(directory, filename.c_str())) {
+      fml::UniqueFD sub_dir =
+          fml::OpenDirectoryReadOnly(directory, filename.c_str());
+      if (!sub_dir.is_valid()) {
+        FML_LOG(ERROR) << "Can't open sub-directory: " << filename;
+        return true;
+      }
+      const size_t prefix_size = prefix.size();
+      prefix += filename + "/";
+      fml::VisitFiles(sub_dir, visitor);
+      prefix.resize(prefix_size);
+      return true;
+    }
+
     if (std::regex_match(filename, asset_regex)) {
       TRACE_EVENT0("flutter", "Matched File");
 
@@ -87,7 +118,7 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
       auto mapping = std::make_unique<fml::FileMapping>(fd);
 
       if (mapping && mapping->IsValid()) {
-        mappings.push_back(std::move(mapping));
+        mappings.push_back({prefix + filename, std::move(mapping)});
       } else {
         FML_LOG(ERROR) << "Mapping " << filename << " failed";
       }
@@ -95,7 +126,7 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     return true;
   };
   if (!subdir) {
-    fml::VisitFilesRecursively(descriptor_, visitor);
+    fml::VisitFiles(descriptor_, visitor);
   } else {
     fml::UniqueFD subdir_fd =
         fml::OpenFileReadOnly(descriptor_, subdir.value().c_str());
@@ -43,6 +43,11 @@ class DirectoryAssetBundle : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  std::optional<std::vector<NamedMapping>> GetAsNamedMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(DirectoryAssetBundle);
 };
 
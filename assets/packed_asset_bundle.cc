@@ -0,0 +1,592 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+#if !FML_ARCH_CPU_LITTLE_ENDIAN
+#error "Packed asset bundles are read in place and must be little endian."
+#endif
+
+namespace flutter {
+
+namespace packed_asset_bundle {
+
+uint64_t HashName(std::string_view name) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+}  // namespace packed_asset_bundle
+
+namespace {
+
+using packed_asset_bundle::Compression;
+using packed_asset_bundle::Entry;
+using packed_asset_bundle::Header;
+
+// A view of an uncompressed asset that keeps the bundle mapping alive.
+class PackedAssetMapping final : public fml::Mapping {
+ public:
+  PackedAssetMapping(std::shared_ptr<const fml::Mapping> bundle,
+                     const uint8_t* data,
+                     size_t size)
+      : bundle_(std::move(bundle)), data_(data), size_(size) {}
+
+  // |Mapping|
+  size_t GetSize() const override { return size_; }
+
+  // |Mapping|
+  const uint8_t* GetMapping() const override { return data_; }
+
+  // |Mapping|
+  bool IsDontNeedSafe() const override { return bundle_->IsDontNeedSafe(); }
+
+ private:
+  const std::shared_ptr<const fml::Mapping> bundle_;
+  const uint8_t* data_;
+  const size_t size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetMapping);
+};
+
+constexpr size_t kLZ4MinMatch = 4;
+// The LZ4 block format requires the last 5 bytes to be literals and the last
+// match to start at least 12 bytes before the end of the block.
+constexpr size_t kLZ4LastLiterals = 5;
+constexpr size_t kLZ4MatchFindLimit = 12;
+constexpr size_t kLZ4MaxOffset = 65535;
+// Every input byte of an LZ4 block decodes to at most 255 output bytes, which
+// bounds the size an entry can claim to decompress to.
+constexpr uint64_t kLZ4MaxCompressionRatio = 255;
+constexpr int kLZ4HashBits = 14;
+
+bool LZ4ReadLength(const uint8_t*& input,
+                   const uint8_t* input_end,
+                   size_t& length) {
+  uint8_t byte;
+  do {
+    if (input >= input_end) {
+      return false;
+    }
+    byte = *input++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+// Decodes an LZ4 block into exactly |output_size| bytes. All reads and writes
+// are bounds checked since the input comes from a file.
+bool LZ4DecompressBlock(const uint8_t* input,
+                        size_t input_size,
+                        uint8_t* output,
+                        size_t output_size) {
+  const uint8_t* input_end = input + input_size;
+  uint8_t* cursor = output;
+  uint8_t* output_end = output + output_size;
+
+  while (input < input_end) {
+    const uint8_t token = *input++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 &&
+        !LZ4ReadLength(input, input_end, literal_length)) {
+      return false;
+    }
+    if (literal_length > static_cast<size_t>(input_end - input) ||
+        literal_length > static_cast<size_t>(output_end - cursor)) {
+      return false;
+    }
+    std::memcpy(cursor, input, literal_length);
+    cursor += literal_length;
+    input += literal_length;
+
+    // The last sequence has no match.
+    if (input == input_end) {
+      break;
+    }
+
+    if (input_end - input < 2) {
+      return false;
+    }
+    const size_t offset = input[0] | (input[1] << 8);
+    input += 2;
+    if (offset == 0 || offset > static_cast<size_t>(cursor - output)) {
+      return false;
+    }
+    size_t match_length = token & 15;
+    if (match_length == 15 && !LZ4ReadLength(input, input_end, match_length)) {
+      return false;
+    }
+    match_length += kLZ4MinMatch;
+    if (match_length > static_cast<size_t>(output_end - cursor)) {
+      return false;
+    }
+    // Matches may overlap the bytes they produce, so copy bytewise.
+    const uint8_t* match = cursor - offset;
+    for (size_t i = 0; i < match_length; i++) {
+      cursor[i] = match[i];
+    }
+    cursor += match_length;
+  }
+  return cursor == output_end;
+}
+
+void LZ4WriteLength(std::vector<uint8_t>& output, size_t length) {
+  while (length >= 255) {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<uint8_t>(length));
+}
+
+// Writes one sequence. A |match_length| of zero ends the block.
+void LZ4WriteSequence(std::vector<uint8_t>& output,
+                      const uint8_t* literals,
+                      size_t literal_length,
+                      size_t offset,
+                      size_t match_length) {
+  const size_t token_index = output.size();
+  output.push_back(0);
+  uint8_t token = static_cast<uint8_t>(std::min<size_t>(literal_length, 15))
+                  << 4;
+  if (literal_length >= 15) {
+    LZ4WriteLength(output, literal_length - 15);
+  }
+  output.insert(output.end(), literals, literals + literal_length);
+  if (match_length > 0) {
+    output.push_back(static_cast<uint8_t>(offset & 0xff));
+    output.push_back(static_cast<uint8_t>(offset >> 8));
+    const size_t length = match_length - kLZ4MinMatch;
+    token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+    if (length >= 15) {
+      LZ4WriteLength(output, length - 15);
+    }
+  }
+  output[token_index] = token;
+}
+
+// A greedy single pass LZ4 block compressor. It does not compress as well as
+// the reference implementation but produces valid blocks for any decoder.
+std::vector<uint8_t> LZ4CompressBlock(const uint8_t* input, size_t size) {
+  std::vector<uint8_t> output;
+  output.reserve(size + size / 255 + 16);
+
+  size_t anchor = 0;
+  if (size > kLZ4MatchFindLimit) {
+    std::vector<uint32_t> table(1u << kLZ4HashBits, UINT32_MAX);
+    const size_t match_limit = size - kLZ4LastLiterals;
+    size_t position = 0;
+    while (position + kLZ4MatchFindLimit <= size) {
+      uint32_t sequence;
+      std::memcpy(&sequence, input + position, sizeof(sequence));
+      const uint32_t hash = (sequence * 2654435761u) >> (32 - kLZ4HashBits);
+      const size_t candidate = table[hash];
+      table[hash] = static_cast<uint32_t>(position);
+      if (candidate == UINT32_MAX || position - candidate > kLZ4MaxOffset ||
+          std::memcmp(input + candidate, input + position, kLZ4MinMatch) != 0) {
+        position++;
+        continue;
+      }
+      size_t length = kLZ4MinMatch;
+      while (position + length < match_limit &&
+             input[candidate + length] == input[position + length]) {
+        length++;
+      }
+      LZ4WriteSequence(output, input + anchor, position - anchor,
+                       position - candidate, length);
+      position += length;
+      anchor = position;
+    }
+  }
+  LZ4WriteSequence(output, input + anchor, size - anchor, 0, 0);
+  return output;
+}
+
+uint32_t BucketCountForEntries(size_t entry_count) {
+  // Keep the load factor at or below one half.
+  uint32_t bucket_count = 1;
+  while (bucket_count < entry_count * 2) {
+    bucket_count <<= 1;
+  }
+  return bucket_count;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+bool IsInRange(uint64_t offset, uint64_t size, uint64_t limit) {
+  return offset <= limit && size <= limit - offset;
+}
+
+std::string_view GetBaseName(std::string_view name) {
+  const auto separator = name.rfind('/');
+  return separator == std::string_view::npos ? name
+                                             : name.substr(separator + 1);
+}
+
+}  // namespace
+
+PackedAssetBundle::PackedAssetBundle(
+    std::shared_ptr<const fml::Mapping> mapping,
+    bool is_valid_after_asset_manager_change)
+    : mapping_(std::move(mapping)),
+      is_valid_after_asset_manager_change_(
+          is_valid_after_asset_manager_change) {
+  is_valid_ = Validate();
+  if (!is_valid_) {
+    FML_LOG(ERROR) << "Packed asset bundle was malformed.";
+  }
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+std::unique_ptr<PackedAssetBundle> PackedAssetBundle::Open(
+    const fml::UniqueFD& base_directory,
+    const std::string& path,
+    bool is_valid_after_asset_manager_change) {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::Open");
+  if (!fml::FileExists(base_directory, path.c_str())) {
+    return nullptr;
+  }
+  std::shared_ptr<const fml::Mapping> mapping =
+      fml::FileMapping::CreateReadOnly(base_directory, path);
+  if (!mapping) {
+    return nullptr;
+  }
+  auto bundle = std::make_unique<PackedAssetBundle>(
+      std::move(mapping), is_valid_after_asset_manager_change);
+  if (!bundle->IsValid()) {
+    return nullptr;
+  }
+  return bundle;
+}
+
+bool PackedAssetBundle::Validate() {
+  if (!mapping_ || mapping_->GetMapping() == nullptr) {
+    return false;
+  }
+  const uint8_t* base = mapping_->GetMapping();
+  const uint64_t size = mapping_->GetSize();
+  if (size < sizeof(Header) ||
+      reinterpret_cast<uintptr_t>(base) % alignof(Header) != 0) {
+    return false;
+  }
+
+  header_ = reinterpret_cast<const Header*>(base);
+  const auto& header = *header_;
+  if (header.magic != packed_asset_bundle::kMagic ||
+      header.version != packed_asset_bundle::kVersion) {
+    return false;
+  }
+  if (header.bucket_count <= header.entry_count ||
+      (header.bucket_count & (header.bucket_count - 1)) != 0) {
+    return false;
+  }
+  if (header.entries_offset % alignof(Entry) != 0 ||
+      header.buckets_offset % alignof(uint32_t) != 0 ||
+      !IsInRange(header.entries_offset,
+                 uint64_t{header.entry_count} * sizeof(Entry), size) ||
+      !IsInRange(header.buckets_offset,
+                 uint64_t{header.bucket_count} * sizeof(uint32_t), size) ||
+      !IsInRange(header.names_offset, header.names_size, size)) {
+    return false;
+  }
+
+  entries_ = reinterpret_cast<const Entry*>(base + header.entries_offset);
+  buckets_ = reinterpret_cast<const uint32_t*>(base + header.buckets_offset);
+  names_ = reinterpret_cast<const char*>(base + header.names_offset);
+
+  // Everything a lookup touches is checked once here so that lookups can
+  // trust the table of contents.
+  for (uint32_t i = 0; i < header.entry_count; i++) {
+    const auto& entry = entries_[i];
+    if (!IsInRange(entry.name_offset, entry.name_size, header.names_size) ||
+        !IsInRange(entry.data_offset, entry.stored_size, size)) {
+      return false;
+    }
+    switch (entry.compression) {
+      case Compression::kNone:
+        if (entry.stored_size != entry.size) {
+          return false;
+        }
+        break;
+      case Compression::kLZ4:
+        // Reject sizes that can't be right before they are allocated.
+        if (entry.size / kLZ4MaxCompressionRatio > entry.stored_size) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    if (i > 0 && !(GetName(entries_[i - 1]) < GetName(entry))) {
+      return false;
+    }
+  }
+  // Lookups stop at the first empty bucket, so there must be one.
+  bool has_empty_bucket = false;
+  for (uint32_t i = 0; i < header.bucket_count; i++) {
+    if (buckets_[i] == packed_asset_bundle::kEmptyBucket) {
+      has_empty_bucket = true;
+    } else if (buckets_[i] >= header.entry_count) {
+      return false;
+    }
+  }
+  return has_empty_bucket;
+}
+
+size_t PackedAssetBundle::GetEntryCount() const {
+  return is_valid_ ? header_->entry_count : 0;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+std::string_view PackedAssetBundle::GetName(const Entry& entry) const {
+  return {names_ + entry.name_offset, entry.name_size};
+}
+
+const Entry* PackedAssetBundle::FindEntry(std::string_view name) const {
+  const uint64_t hash = packed_asset_bundle::HashName(name);
+  const uint32_t mask = header_->bucket_count - 1;
+  // Validation guarantees an empty bucket, which ends the probe. It is
+  // bounded by the size of the table regardless.
+  uint32_t bucket = hash & mask;
+  for (uint32_t probe = 0; probe < header_->bucket_count; probe++) {
+    const uint32_t index = buckets_[bucket];
+    if (index == packed_asset_bundle::kEmptyBucket) {
+      return nullptr;
+    }
+    const auto& entry = entries_[index];
+    if (entry.name_hash == hash && GetName(entry) == name) {
+      return &entry;
+    }
+    bucket = (bucket + 1) & mask;
+  }
+  return nullptr;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetEntryMapping(
+    const Entry& entry) const {
+  const uint8_t* data = mapping_->GetMapping() + entry.data_offset;
+  if (entry.compression == Compression::kNone) {
+    return std::make_unique<PackedAssetMapping>(mapping_, data, entry.size);
+  }
+
+  TRACE_EVENT0("flutter", "PackedAssetBundle::Decompress");
+  std::vector<uint8_t> decompressed(entry.size);
+  if (!LZ4DecompressBlock(data, entry.stored_size, decompressed.data(),
+                          decompressed.size())) {
+    FML_LOG(ERROR) << "Could not decompress packed asset " << GetName(entry);
+    return nullptr;
+  }
+  return std::make_unique<fml::DataMapping>(std::move(decompressed));
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+  const auto* entry = FindEntry(asset_name);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return GetEntryMapping(*entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  auto named_mappings = GetAsNamedMappings(asset_pattern, subdir);
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  for (auto& named_mapping : named_mappings.value()) {
+    mappings.push_back(std::move(named_mapping.mapping));
+  }
+  return mappings;
+}
+
+// |AssetResolver|
+std::optional<std::vector<AssetResolver::NamedMapping>>
+PackedAssetBundle::GetAsNamedMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<NamedMapping> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  const Entry* begin = entries_;
+  const Entry* end = entries_ + header_->entry_count;
+  std::string prefix;
+  if (subdir.has_value()) {
+    // Entries are sorted by name, so the ones in |subdir| are contiguous.
+    prefix = subdir.value() + "/";
+    begin = std::lower_bound(begin, end, prefix,
+                             [this](const Entry& entry, const std::string& p) {
+                               return GetName(entry) < p;
+                             });
+  }
+
+  // Like |DirectoryAssetBundle|, match the file name only, searching
+  // recursively without a |subdir| and only its direct children with one.
+  std::regex asset_regex(asset_pattern);
+  for (const Entry* entry = begin; entry != end; ++entry) {
+    std::string_view name = GetName(*entry);
+    if (subdir.has_value()) {
+      if (name.compare(0, prefix.size(), prefix) != 0) {
+        break;
+      }
+      name.remove_prefix(prefix.size());
+      if (name.find('/') != std::string_view::npos) {
+        continue;
+      }
+    }
+    const auto base_name = GetBaseName(name);
+    if (!std::regex_match(base_name.begin(), base_name.end(), asset_regex)) {
+      continue;
+    }
+    auto mapping = GetEntryMapping(*entry);
+    if (mapping) {
+      mappings.push_back({std::string(GetName(*entry)), std::move(mapping)});
+    }
+  }
+  return mappings;
+}
+
+PackedAssetBundleBuilder::PackedAssetBundleBuilder() = default;
+
+PackedAssetBundleBuilder::~PackedAssetBundleBuilder() = default;
+
+bool PackedAssetBundleBuilder::AddAsset(const std::string& name,
+                                        const fml::Mapping& data,
+                                        bool compress) {
+  if (name.empty() || name.size() > UINT32_MAX) {
+    return false;
+  }
+  for (const auto& asset : assets_) {
+    if (asset.name == name) {
+      return false;
+    }
+  }
+
+  const uint8_t* bytes = data.GetMapping();
+  const size_t size = data.GetSize();
+  PendingAsset asset{name, {}, size, Compression::kNone};
+  if (compress && size > 0 && size <= UINT32_MAX) {
+    auto compressed = LZ4CompressBlock(bytes, size);
+    if (compressed.size() < size) {
+      asset.data = std::move(compressed);
+      asset.compression = Compression::kLZ4;
+    }
+  }
+  if (asset.compression == Compression::kNone) {
+    asset.data.assign(bytes, bytes + size);
+  }
+  assets_.push_back(std::move(asset));
+  return true;
+}
+
+std::vector<uint8_t> PackedAssetBundleBuilder::Build() const {
+  std::vector<const PendingAsset*> sorted;
+  sorted.reserve(assets_.size());
+  for (const auto& asset : assets_) {
+    sorted.push_back(&asset);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const PendingAsset* a, const PendingAsset* b) {
+              return a->name < b->name;
+            });
+
+  Header header = {};
+  header.magic = packed_asset_bundle::kMagic;
+  header.version = packed_asset_bundle::kVersion;
+  header.entry_count = static_cast<uint32_t>(sorted.size());
+  header.bucket_count = BucketCountForEntries(sorted.size());
+  header.entries_offset = sizeof(Header);
+  header.buckets_offset =
+      header.entries_offset + uint64_t{header.entry_count} * sizeof(Entry);
+  header.names_offset =
+      header.buckets_offset + uint64_t{header.bucket_count} * sizeof(uint32_t);
+
+  std::vector<Entry> entries(sorted.size());
+  std::vector<uint32_t> buckets(header.bucket_count,
+                                packed_asset_bundle::kEmptyBucket);
+  std::string names;
+  for (size_t i = 0; i < sorted.size(); i++) {
+    const auto& asset = *sorted[i];
+    auto& entry = entries[i];
+    entry.name_hash = packed_asset_bundle::HashName(asset.name);
+    entry.name_offset = static_cast<uint32_t>(names.size());
+    entry.name_size = static_cast<uint32_t>(asset.name.size());
+    entry.stored_size = asset.data.size();
+    entry.size = asset.size;
+    entry.compression = asset.compression;
+    names += asset.name;
+
+    const uint32_t mask = header.bucket_count - 1;
+    uint32_t bucket = entry.name_hash & mask;
+    while (buckets[bucket] != packed_asset_bundle::kEmptyBucket) {
+      bucket = (bucket + 1) & mask;
+    }
+    buckets[bucket] = static_cast<uint32_t>(i);
+  }
+  header.names_size = names.size();
+
+  uint64_t data_offset = AlignUp(header.names_offset + header.names_size,
+                                 packed_asset_bundle::kDataAlignment);
+  for (size_t i = 0; i < sorted.size(); i++) {
+    entries[i].data_offset = data_offset;
+    data_offset = AlignUp(data_offset + entries[i].stored_size,
+                          packed_asset_bundle::kDataAlignment);
+  }
+
+  const uint64_t bundle_size =
+      sorted.empty() ? header.names_offset + header.names_size
+                     : entries.back().data_offset + entries.back().stored_size;
+  std::vector<uint8_t> bundle(bundle_size, 0);
+  std::memcpy(bundle.data(), &header, sizeof(header));
+  std::copy(entries.begin(), entries.end(),
+            reinterpret_cast<Entry*>(bundle.data() + header.entries_offset));
+  std::copy(buckets.begin(), buckets.end(),
+            reinterpret_cast<uint32_t*>(bundle.data() + header.buckets_offset));
+  std::copy(names.begin(), names.end(), bundle.data() + header.names_offset);
+  for (size_t i = 0; i < sorted.size(); i++) {
+    std::copy(sorted[i]->data.begin(), sorted[i]->data.end(),
+              bundle.data() + entries[i].data_offset);
+  }
+  return bundle;
+}
+
+}  // namespace flutter
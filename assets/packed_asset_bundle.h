@@ -0,0 +1,200 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The on-disk layout of a packed asset bundle. All fields are
+///             little endian.
+///
+///             A bundle starts with a header, followed by the table of
+///             contents, the hash table, and the entry names. The entry data
+///             follows, with every entry starting on a page boundary so that
+///             uncompressed entries can be handed out as views into a single
+///             mapping of the file.
+///
+///             The table of contents is sorted by name, so entries in the same
+///             directory are contiguous. The hash table is an open addressed
+///             table of indices into the table of contents with linear
+///             probing, indexed by the FNV-1a hash of the entry name.
+///
+namespace packed_asset_bundle {
+
+/// "FPAK" read as a little endian integer.
+constexpr uint32_t kMagic = 0x4b415046;
+constexpr uint32_t kVersion = 1;
+constexpr uint64_t kDataAlignment = 4096;
+constexpr uint32_t kEmptyBucket = UINT32_MAX;
+
+enum class Compression : uint32_t {
+  kNone = 0,
+  /// An LZ4 block, without the LZ4 frame header.
+  kLZ4 = 1,
+};
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+  /// Always a power of two larger than `entry_count`.
+  uint32_t bucket_count;
+  uint64_t entries_offset;
+  uint64_t buckets_offset;
+  uint64_t names_offset;
+  uint64_t names_size;
+};
+
+struct Entry {
+  uint64_t name_hash;
+  /// Relative to `Header::names_offset`.
+  uint32_t name_offset;
+  uint32_t name_size;
+  /// Relative to the start of the bundle.
+  uint64_t data_offset;
+  uint64_t stored_size;
+  uint64_t size;
+  Compression compression;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 48);
+static_assert(sizeof(Entry) == 48);
+
+uint64_t HashName(std::string_view name);
+
+}  // namespace packed_asset_bundle
+
+//------------------------------------------------------------------------------
+/// @brief      An asset resolver backed by a single packed archive of assets,
+///             as written by `PackedAssetBundleBuilder`.
+///
+///             The whole bundle is mapped once. Looking up an asset hashes its
+///             name and probes the table of contents in place, so it neither
+///             touches the file system nor allocates beyond the returned
+///             mapping. Uncompressed assets are views into the bundle mapping.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  explicit PackedAssetBundle(std::shared_ptr<const fml::Mapping> mapping,
+                             bool is_valid_after_asset_manager_change = true);
+
+  ~PackedAssetBundle() override;
+
+  /// The name of the bundle that `RunConfiguration` picks up from the assets
+  /// directory.
+  static constexpr char kDefaultFileName[] = "assets.pak";
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps the bundle at |path|, relative to |base_directory|.
+  ///
+  /// @return     The bundle, or null if the file does not exist or is not a
+  ///             valid bundle.
+  ///
+  static std::unique_ptr<PackedAssetBundle> Open(
+      const fml::UniqueFD& base_directory,
+      const std::string& path,
+      bool is_valid_after_asset_manager_change = true);
+
+  size_t GetEntryCount() const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  // |AssetResolver|
+  std::optional<std::vector<NamedMapping>> GetAsNamedMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+ private:
+  const std::shared_ptr<const fml::Mapping> mapping_;
+  const bool is_valid_after_asset_manager_change_;
+  const packed_asset_bundle::Header* header_ = nullptr;
+  const packed_asset_bundle::Entry* entries_ = nullptr;
+  const uint32_t* buckets_ = nullptr;
+  const char* names_ = nullptr;
+  bool is_valid_ = false;
+
+  bool Validate();
+
+  std::string_view GetName(const packed_asset_bundle::Entry& entry) const;
+
+  const packed_asset_bundle::Entry* FindEntry(std::string_view name) const;
+
+  std::unique_ptr<fml::Mapping> GetEntryMapping(
+      const packed_asset_bundle::Entry& entry) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Writes packed asset bundles. Used by tooling and tests.
+///
+class PackedAssetBundleBuilder {
+ public:
+  PackedAssetBundleBuilder();
+
+  ~PackedAssetBundleBuilder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an asset. Names are paths relative to the root of the
+  ///             bundle using '/' as the separator.
+  ///
+  /// @param[in]  compress  Whether to store the asset LZ4 compressed. Assets
+  ///                       that do not get smaller are stored uncompressed
+  ///                       regardless.
+  ///
+  /// @return     Whether the asset was added. Fails for duplicate names.
+  ///
+  bool AddAsset(const std::string& name,
+                const fml::Mapping& data,
+                bool compress = false);
+
+  std::vector<uint8_t> Build() const;
+
+ private:
+  struct PendingAsset {
+    std::string name;
+    std::vector<uint8_t> data;
+    size_t size;
+    packed_asset_bundle::Compression compression;
+  };
+
+  std::vector<PendingAsset> assets_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundleBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
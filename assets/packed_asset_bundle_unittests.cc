@@ -0,0 +1,280 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+fml::NonOwnedMapping Borrow(const std::string& data) {
+  return fml::NonOwnedMapping(reinterpret_cast<const uint8_t*>(data.data()),
+                              data.size());
+}
+
+std::shared_ptr<fml::Mapping> Wrap(std::vector<uint8_t> data) {
+  return std::make_shared<fml::DataMapping>(std::move(data));
+}
+
+}  // namespace
+
+TEST(PackedAssetBundleTest, EmptyBundleIsValid) {
+  PackedAssetBundleBuilder builder;
+  PackedAssetBundle bundle(Wrap(builder.Build()));
+  ASSERT_TRUE(bundle.IsValid());
+  ASSERT_EQ(bundle.GetEntryCount(), 0u);
+  ASSERT_EQ(bundle.GetType(), AssetResolver::kPackedAssetBundle);
+  ASSERT_EQ(bundle.GetAsMapping("missing"), nullptr);
+  ASSERT_TRUE(bundle.GetAsMappings(".*", std::nullopt).empty());
+}
+
+TEST(PackedAssetBundleTest, RoundTripsAssets) {
+  const std::string repetitive(10000, 'a');
+  std::string mixed;
+  for (int i = 0; i < 2000; i++) {
+    mixed += std::to_string(i % 37) + ",";
+  }
+
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("AssetManifest.json", Borrow("{}")));
+  ASSERT_TRUE(builder.AddAsset("empty", Borrow("")));
+  ASSERT_TRUE(builder.AddAsset("short", Borrow("abc"), true));
+  ASSERT_TRUE(builder.AddAsset("fonts/repetitive", Borrow(repetitive), true));
+  ASSERT_TRUE(builder.AddAsset("fonts/mixed", Borrow(mixed), true));
+  auto data = builder.Build();
+
+  // The repetitive asset is stored compressed. Entries are sorted by name, so
+  // it is the fourth one.
+  packed_asset_bundle::Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  packed_asset_bundle::Entry entry;
+  std::memcpy(&entry,
+              data.data() + header.entries_offset +
+                  3 * sizeof(packed_asset_bundle::Entry),
+              sizeof(entry));
+  ASSERT_EQ(entry.compression, packed_asset_bundle::Compression::kLZ4);
+  ASSERT_EQ(entry.size, repetitive.size());
+  ASSERT_LT(entry.stored_size, repetitive.size() / 10);
+
+  PackedAssetBundle bundle(Wrap(std::move(data)));
+  ASSERT_TRUE(bundle.IsValid());
+  ASSERT_EQ(bundle.GetEntryCount(), 5u);
+
+  auto manifest = bundle.GetAsMapping("AssetManifest.json");
+  ASSERT_NE(manifest, nullptr);
+  ASSERT_EQ(ToString(*manifest), "{}");
+  auto empty = bundle.GetAsMapping("empty");
+  ASSERT_NE(empty, nullptr);
+  ASSERT_EQ(empty->GetSize(), 0u);
+  auto short_asset = bundle.GetAsMapping("short");
+  ASSERT_NE(short_asset, nullptr);
+  ASSERT_EQ(ToString(*short_asset), "abc");
+  auto repetitive_asset = bundle.GetAsMapping("fonts/repetitive");
+  ASSERT_NE(repetitive_asset, nullptr);
+  ASSERT_EQ(ToString(*repetitive_asset), repetitive);
+  auto mixed_asset = bundle.GetAsMapping("fonts/mixed");
+  ASSERT_NE(mixed_asset, nullptr);
+  ASSERT_EQ(ToString(*mixed_asset), mixed);
+
+  ASSERT_EQ(bundle.GetAsMapping("fonts"), nullptr);
+  ASSERT_EQ(bundle.GetAsMapping("fonts/"), nullptr);
+  ASSERT_EQ(bundle.GetAsMapping("shor"), nullptr);
+}
+
+TEST(PackedAssetBundleTest, UncompressedAssetsArePageAligned) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("a", Borrow("first")));
+  ASSERT_TRUE(builder.AddAsset("b", Borrow("second")));
+  auto data = builder.Build();
+  const auto* base = data.data();
+
+  PackedAssetBundle bundle(Wrap(std::move(data)));
+  ASSERT_TRUE(bundle.IsValid());
+  for (const char* name : {"a", "b"}) {
+    auto mapping = bundle.GetAsMapping(name);
+    ASSERT_NE(mapping, nullptr);
+    // Uncompressed assets are views into the bundle, not copies.
+    const auto offset = mapping->GetMapping() - base;
+    ASSERT_EQ(offset % packed_asset_bundle::kDataAlignment, 0);
+  }
+}
+
+TEST(PackedAssetBundleTest, MappingsOutliveTheBundle) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("asset", Borrow("contents")));
+  std::unique_ptr<fml::Mapping> mapping;
+  {
+    PackedAssetBundle bundle(Wrap(builder.Build()));
+    mapping = bundle.GetAsMapping("asset");
+  }
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(ToString(*mapping), "contents");
+}
+
+TEST(PackedAssetBundleTest, RejectsDuplicateNames) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("asset", Borrow("one")));
+  ASSERT_FALSE(builder.AddAsset("asset", Borrow("two")));
+}
+
+TEST(PackedAssetBundleTest, GetAsMappings) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("shaders/a.frag", Borrow("a")));
+  ASSERT_TRUE(builder.AddAsset("shaders/b.frag", Borrow("b")));
+  ASSERT_TRUE(builder.AddAsset("shaders/b.vert", Borrow("c")));
+  ASSERT_TRUE(builder.AddAsset("shaders/nested/c.frag", Borrow("d")));
+  ASSERT_TRUE(builder.AddAsset("shaders_other/d.frag", Borrow("e")));
+  ASSERT_TRUE(builder.AddAsset("e.frag", Borrow("f")));
+  PackedAssetBundle bundle(Wrap(builder.Build()));
+  ASSERT_TRUE(bundle.IsValid());
+
+  // Matching is on the base name, within the subdirectory only.
+  auto in_subdir = bundle.GetAsMappings(".*\\.frag", "shaders");
+  ASSERT_EQ(in_subdir.size(), 2u);
+  ASSERT_EQ(ToString(*in_subdir[0]), "a");
+  ASSERT_EQ(ToString(*in_subdir[1]), "b");
+
+  auto everywhere = bundle.GetAsMappings(".*\\.frag", std::nullopt);
+  ASSERT_EQ(everywhere.size(), 5u);
+
+  ASSERT_TRUE(bundle.GetAsMappings(".*", "missing").empty());
+}
+
+TEST(PackedAssetBundleTest, RejectsMalformedBundles) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("asset", Borrow("contents")));
+  const auto data = builder.Build();
+
+  ASSERT_FALSE(PackedAssetBundle(Wrap({})).IsValid());
+
+  // Truncated in the index and in the data.
+  for (size_t size : {sizeof(packed_asset_bundle::Header) - 1,
+                      sizeof(packed_asset_bundle::Header) + 1,
+                      data.size() - 1}) {
+    std::vector<uint8_t> truncated(data.begin(), data.begin() + size);
+    ASSERT_FALSE(PackedAssetBundle(Wrap(std::move(truncated))).IsValid())
+        << size;
+  }
+
+  auto bad_magic = data;
+  bad_magic[0] ^= 0xff;
+  ASSERT_FALSE(PackedAssetBundle(Wrap(std::move(bad_magic))).IsValid());
+
+  auto bad_version = data;
+  bad_version[offsetof(packed_asset_bundle::Header, version)]++;
+  ASSERT_FALSE(PackedAssetBundle(Wrap(std::move(bad_version))).IsValid());
+
+  auto bad_bucket_count = data;
+  bad_bucket_count[offsetof(packed_asset_bundle::Header, bucket_count)] = 3;
+  ASSERT_FALSE(PackedAssetBundle(Wrap(std::move(bad_bucket_count))).IsValid());
+}
+
+TEST(PackedAssetBundleTest, RejectsImplausibleDecompressedSizes) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("asset", Borrow(std::string(1000, 'a')), true));
+  auto data = builder.Build();
+  ASSERT_TRUE(PackedAssetBundle(Wrap(data)).IsValid());
+
+  packed_asset_bundle::Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  packed_asset_bundle::Entry entry;
+  std::memcpy(&entry, data.data() + header.entries_offset, sizeof(entry));
+  ASSERT_EQ(entry.compression, packed_asset_bundle::Compression::kLZ4);
+
+  // The entry claims to decompress to more than LZ4 can expand its data to,
+  // which would otherwise be allocated by every lookup.
+  entry.size = UINT64_MAX / 2;
+  std::memcpy(data.data() + header.entries_offset, &entry, sizeof(entry));
+  ASSERT_FALSE(PackedAssetBundle(Wrap(std::move(data))).IsValid());
+}
+
+TEST(PackedAssetBundleTest, RejectsFullBucketTables) {
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("asset", Borrow("contents")));
+  auto data = builder.Build();
+
+  packed_asset_bundle::Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  // Every bucket refers to the only entry, so a lookup of any other name
+  // would never reach an empty bucket.
+  const std::vector<uint32_t> buckets(header.bucket_count, 0u);
+  std::memcpy(data.data() + header.buckets_offset, buckets.data(),
+              buckets.size() * sizeof(uint32_t));
+  ASSERT_FALSE(PackedAssetBundle(Wrap(std::move(data))).IsValid());
+}
+
+TEST(PackedAssetBundleTest, ShadowsDirectoryAssetsInAssetManager) {
+  fml::ScopedTemporaryDirectory directory;
+  auto shaders = fml::CreateDirectory(directory.fd(), {"shaders"},
+                                      fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(shaders.is_valid());
+  fml::DataMapping stale(std::vector<uint8_t>{'o', 'l', 'd'});
+  fml::DataMapping unpacked(std::vector<uint8_t>{'d', 'i', 'r'});
+  ASSERT_TRUE(fml::WriteAtomically(shaders, "a.frag", stale));
+  ASSERT_TRUE(fml::WriteAtomically(shaders, "b.frag", unpacked));
+
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("shaders/a.frag", Borrow("new")));
+  ASSERT_TRUE(builder.AddAsset("shaders/c.frag", Borrow("pak")));
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(std::make_unique<PackedAssetBundle>(
+      Wrap(builder.Build()), /*is_valid_after_asset_manager_change=*/true));
+  asset_manager.PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(directory.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+
+  for (const auto& subdir :
+       {std::optional<std::string>("shaders"), std::optional<std::string>()}) {
+    auto mappings = asset_manager.GetAsMappings(".*\\.frag", subdir);
+    std::vector<std::string> contents;
+    for (const auto& mapping : mappings) {
+      contents.push_back(ToString(*mapping));
+    }
+    std::sort(contents.begin(), contents.end());
+    ASSERT_EQ(contents, (std::vector<std::string>{"dir", "new", "pak"}));
+  }
+}
+
+TEST(PackedAssetBundleTest, OpensFromDirectory) {
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_EQ(PackedAssetBundle::Open(directory.fd(),
+                                    PackedAssetBundle::kDefaultFileName),
+            nullptr);
+
+  PackedAssetBundleBuilder builder;
+  ASSERT_TRUE(builder.AddAsset("asset", Borrow("contents")));
+  fml::DataMapping data(builder.Build());
+  ASSERT_TRUE(fml::WriteAtomically(
+      directory.fd(), PackedAssetBundle::kDefaultFileName, data));
+
+  auto bundle = PackedAssetBundle::Open(directory.fd(),
+                                        PackedAssetBundle::kDefaultFileName);
+  ASSERT_NE(bundle, nullptr);
+  auto mapping = bundle->GetAsMapping("asset");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(ToString(*mapping), "contents");
+}
+
+}  // namespace testing
+}  // namespace flutter
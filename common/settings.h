@@ -88,6 +88,9 @@ using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
 
+using TraceRingBufferCallback =
+    std::function<void(const std::string& /* chrome trace json */)>;
+
 class DartIsolate;
 
 struct Settings {
@@ -151,6 +154,9 @@ struct Settings {
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
   bool endless_trace_buffer = false;
+  // Record trace events into the in-process ring buffer described in
+  // fml/trace_ring_buffer.h. Unlike the timeline, this works in release mode.
+  bool trace_ring_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
   bool enable_serial_gc = false;
@@ -206,9 +212,24 @@ struct Settings {
   // manager before creating the engine.
   bool prefetched_default_font_manager = false;
 
+  // Overlap the independent parts of shell creation, such as mapping the
+  // snapshots, setting up the default font manager, and creating the Dart VM,
+  // on the shell's task runners instead of performing them in sequence on the
+  // creating thread.
+  bool concurrent_shell_startup = false;
+
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
+  // Paint layer trees that are prerolled more than once, such as redrawn
+  // trees, with a linearized copy of the tree instead of recursing through
+  // the layers. See |CompiledLayerTree|.
+  bool enable_compiled_layer_tree_paint = false;
+
+  // Dispatch a move event predicted to the target time of the frame for every
+  // dragged pointer when a frame begins. See |PointerDataResampler|.
+  bool enable_pointer_prediction = false;
+
   // Enable the Impeller renderer on supported platforms. Ignored if Impeller is
   // not supported on the platform.
 #if FML_OS_IOS || FML_OS_IOS_SIMULATOR
@@ -304,6 +325,11 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // Callback invoked on the IO task runner with the contents of the trace ring
+  // buffer after a frame takes more than twice the frame budget to rasterize.
+  // Only used if |trace_ring_buffer| is set.
+  TraceRingBufferCallback trace_ring_buffer_jank_callback;
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_latency_aggregator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+int MostSignificantBit(uint64_t value) {
+  FML_DCHECK(value != 0);
+  int bit = 0;
+  while (value >>= 1) {
+    bit++;
+  }
+  return bit;
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() {
+  Reset();
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+size_t LatencyHistogram::BucketIndexForValue(uint64_t micros) {
+  micros = std::min(micros, GetMaxTrackableValue());
+  if (micros < kSubBucketCount) {
+    return micros;
+  }
+  // Scale the value down so that it lands in the upper half of the
+  // sub-buckets. Each extra bit of shift is another half-sized bucket run.
+  const int shift = MostSignificantBit(micros) - (kSubBucketBits - 1);
+  const uint64_t sub_bucket = (micros >> shift) - kSubBucketHalfCount;
+  return kSubBucketCount + (shift - 1) * kSubBucketHalfCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::HighestValueInBucket(size_t index) {
+  FML_DCHECK(index < kBucketCount);
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const size_t offset = index - kSubBucketCount;
+  const int shift = static_cast<int>(offset / kSubBucketHalfCount) + 1;
+  const uint64_t sub_bucket =
+      offset % kSubBucketHalfCount + kSubBucketHalfCount;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(fml::TimeDelta duration) {
+  RecordMicros(
+      static_cast<uint64_t>(std::max<int64_t>(duration.ToMicroseconds(), 0)));
+}
+
+void LatencyHistogram::RecordMicros(uint64_t micros) {
+  counts_[BucketIndexForValue(micros)].fetch_add(1, std::memory_order_relaxed);
+  total_count_.fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t max = max_micros_.load(std::memory_order_relaxed);
+  while (micros > max && !max_micros_.compare_exchange_weak(
+                             max, micros, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::GetCount() const {
+  return total_count_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetMaxMicros() const {
+  return max_micros_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetPercentileMicros(double percentile) const {
+  // Sum the buckets instead of using |total_count_| so that the walk below is
+  // consistent with itself when racing with |Record|.
+  std::array<uint64_t, kBucketCount> counts;
+  uint64_t total = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts[i] = counts_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  const auto target = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(percentile / 100.0 * total)), 1u);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += counts[i];
+    if (seen >= target) {
+      return std::min(HighestValueInBucket(i), GetMaxMicros());
+    }
+  }
+  return GetMaxMicros();
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  total_count_.store(0, std::memory_order_relaxed);
+  max_micros_.store(0, std::memory_order_relaxed);
+}
+
+FrameLatencyAggregator::FrameLatencyAggregator() = default;
+
+FrameLatencyAggregator::~FrameLatencyAggregator() = default;
+
+void FrameLatencyAggregator::AddFrame(const FrameTiming& timing) {
+  const auto vsync_start = timing.Get(FrameTiming::kVsyncStart);
+  const auto build_start = timing.Get(FrameTiming::kBuildStart);
+  const auto raster_finish = timing.Get(FrameTiming::kRasterFinish);
+
+  std::scoped_lock lock(mutex_);
+  histograms_[static_cast<size_t>(Phase::kVsyncOverhead)].Record(
+      build_start - vsync_start);
+  histograms_[static_cast<size_t>(Phase::kBuild)].Record(
+      timing.Get(FrameTiming::kBuildFinish) - build_start);
+  histograms_[static_cast<size_t>(Phase::kRaster)].Record(
+      raster_finish - timing.Get(FrameTiming::kRasterStart));
+  histograms_[static_cast<size_t>(Phase::kTotal)].Record(raster_finish -
+                                                          vsync_start);
+}
+
+FrameLatencyAggregator::Statistics FrameLatencyAggregator::GetStatistics()
+    const {
+  std::scoped_lock lock(mutex_);
+  return ComputeStatisticsLocked();
+}
+
+FrameLatencyAggregator::Statistics
+FrameLatencyAggregator::GetStatisticsAndReset() {
+  std::scoped_lock lock(mutex_);
+  auto statistics = ComputeStatisticsLocked();
+  ResetLocked();
+  return statistics;
+}
+
+FrameLatencyAggregator::Statistics
+FrameLatencyAggregator::ComputeStatisticsLocked() const {
+  Statistics statistics;
+  statistics.frame_count = GetHistogram(Phase::kTotal).GetCount();
+  for (size_t i = 0; i < histograms_.size(); i++) {
+    const auto& histogram = histograms_[i];
+    auto& percentiles = statistics.phases[i];
+    percentiles.p50 = histogram.GetPercentileMicros(50.0);
+    percentiles.p90 = histogram.GetPercentileMicros(90.0);
+    percentiles.p99 = histogram.GetPercentileMicros(99.0);
+    percentiles.p999 = histogram.GetPercentileMicros(99.9);
+    percentiles.max = histogram.GetMaxMicros();
+  }
+  return statistics;
+}
+
+const LatencyHistogram& FrameLatencyAggregator::GetHistogram(
+    Phase phase) const {
+  return histograms_[static_cast<size_t>(phase)];
+}
+
+void FrameLatencyAggregator::Reset() {
+  std::scoped_lock lock(mutex_);
+  ResetLocked();
+}
+
+void FrameLatencyAggregator::ResetLocked() {
+  for (auto& histogram : histograms_) {
+    histogram.Reset();
+  }
+}
+
+const char* FrameLatencyAggregator::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kVsyncOverhead:
+      return "vsyncOverhead";
+    case Phase::kBuild:
+      return "build";
+    case Phase::kRaster:
+      return "raster";
+    case Phase::kTotal:
+      return "total";
+    case Phase::kCount:
+      break;
+  }
+  return "";
+}
+
+}  // namespace flutter
@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_LATENCY_AGGREGATOR_H_
+#define FLUTTER_FLOW_FRAME_LATENCY_AGGREGATOR_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// A log-bucketed histogram of durations in the spirit of HdrHistogram.
+///
+/// Values below |kSubBucketCount| microseconds are recorded exactly. Larger
+/// values fall in buckets whose width doubles with every power of two, each
+/// power of two being split into |kSubBucketCount| / 2 linear sub-buckets,
+/// which bounds the relative error to about 6%. Values larger than
+/// |GetMaxTrackableValue| are clamped.
+///
+/// Recording is wait-free and never allocates. Queries may run concurrently
+/// with recording and observe a slightly stale distribution.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr uint64_t kSubBucketCount = 1u << kSubBucketBits;
+  static constexpr uint64_t kSubBucketHalfCount = kSubBucketCount / 2;
+  /// Tracks values up to 2^36 microseconds, a little over 19 hours.
+  static constexpr int kMaxValueBits = 36;
+  static constexpr size_t kBucketCount =
+      kSubBucketCount +
+      (kMaxValueBits - kSubBucketBits) * kSubBucketHalfCount;
+
+  LatencyHistogram();
+
+  ~LatencyHistogram();
+
+  void Record(fml::TimeDelta duration);
+
+  void RecordMicros(uint64_t micros);
+
+  uint64_t GetCount() const;
+
+  uint64_t GetMaxMicros() const;
+
+  /// The smallest recorded value (rounded up to its bucket) such that
+  /// |percentile| percent of all recorded values are less than or equal to
+  /// it. |percentile| is clamped to [0, 100]. Returns 0 if nothing has been
+  /// recorded.
+  uint64_t GetPercentileMicros(double percentile) const;
+
+  void Reset();
+
+  static constexpr uint64_t GetMaxTrackableValue() {
+    return (uint64_t{1} << kMaxValueBits) - 1;
+  }
+
+  static size_t BucketIndexForValue(uint64_t micros);
+
+  /// The largest value that maps to the bucket at |index|.
+  static uint64_t HighestValueInBucket(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, kBucketCount> counts_;
+  std::atomic<uint64_t> total_count_ = 0;
+  std::atomic<uint64_t> max_micros_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+/// Aggregates |FrameTiming|s into latency histograms for the phases of frame
+/// production so that tail latencies can be queried over long sessions
+/// without keeping per-frame data around.
+///
+/// All methods may be called from any thread. Frames are added under a lock so
+/// that the histograms of the phases always agree on the frames they contain.
+class FrameLatencyAggregator {
+ public:
+  enum class Phase {
+    /// From the vsync signal to the start of the frame build.
+    kVsyncOverhead,
+    /// From the start to the end of the frame build on the UI thread.
+    kBuild,
+    /// From the start to the end of the rasterization on the raster thread.
+    kRaster,
+    /// From the vsync signal to the end of the rasterization.
+    kTotal,
+    kCount,
+  };
+
+  struct Percentiles {
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+  };
+
+  struct Statistics {
+    uint64_t frame_count = 0;
+    std::array<Percentiles, static_cast<size_t>(Phase::kCount)> phases;
+
+    const Percentiles& Get(Phase phase) const {
+      return phases[static_cast<size_t>(phase)];
+    }
+  };
+
+  FrameLatencyAggregator();
+
+  ~FrameLatencyAggregator();
+
+  void AddFrame(const FrameTiming& timing);
+
+  /// Computes the percentiles, in microseconds, of all frames added since
+  /// creation or the last call to |Reset|.
+  Statistics GetStatistics() const;
+
+  /// Like |GetStatistics|, but also resets the histograms without letting
+  /// frames added concurrently fall between the two.
+  Statistics GetStatisticsAndReset();
+
+  const LatencyHistogram& GetHistogram(Phase phase) const;
+
+  void Reset();
+
+  static const char* GetPhaseName(Phase phase);
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<LatencyHistogram, static_cast<size_t>(Phase::kCount)>
+      histograms_;
+
+  Statistics ComputeStatisticsLocked() const;
+
+  void ResetLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameLatencyAggregator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_LATENCY_AGGREGATOR_H_
@@ -0,0 +1,161 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_latency_aggregator.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  for (uint64_t value = 0; value < LatencyHistogram::kSubBucketCount;
+       value++) {
+    const auto index = LatencyHistogram::BucketIndexForValue(value);
+    ASSERT_EQ(index, value);
+    ASSERT_EQ(LatencyHistogram::HighestValueInBucket(index), value);
+  }
+}
+
+TEST(LatencyHistogramTest, BucketsCoverTheTrackableRange) {
+  ASSERT_EQ(LatencyHistogram::BucketIndexForValue(
+                LatencyHistogram::GetMaxTrackableValue()),
+            LatencyHistogram::kBucketCount - 1);
+  ASSERT_EQ(
+      LatencyHistogram::HighestValueInBucket(LatencyHistogram::kBucketCount -
+                                             1),
+      LatencyHistogram::GetMaxTrackableValue());
+  // Out of range values are clamped into the last bucket.
+  ASSERT_EQ(LatencyHistogram::BucketIndexForValue(UINT64_MAX),
+            LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, BucketsAreContiguous) {
+  for (size_t index = 1; index < LatencyHistogram::kBucketCount; index++) {
+    const auto lowest = LatencyHistogram::HighestValueInBucket(index - 1) + 1;
+    ASSERT_EQ(LatencyHistogram::BucketIndexForValue(lowest), index);
+    ASSERT_EQ(LatencyHistogram::BucketIndexForValue(
+                  LatencyHistogram::HighestValueInBucket(index)),
+              index);
+  }
+}
+
+TEST(LatencyHistogramTest, RelativeErrorIsBounded) {
+  for (uint64_t value = 1; value < 10000000; value = value * 3 + 1) {
+    const auto bucket_value = LatencyHistogram::HighestValueInBucket(
+        LatencyHistogram::BucketIndexForValue(value));
+    ASSERT_GE(bucket_value, value);
+    ASSERT_LE(static_cast<double>(bucket_value - value) / value, 0.0625);
+  }
+}
+
+TEST(LatencyHistogramTest, EmptyHistogramHasNoPercentiles) {
+  LatencyHistogram histogram;
+  ASSERT_EQ(histogram.GetCount(), 0u);
+  ASSERT_EQ(histogram.GetPercentileMicros(50), 0u);
+  ASSERT_EQ(histogram.GetPercentileMicros(100), 0u);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  // 1000 frames at 8ms and a 10 frame tail at 100ms.
+  for (int i = 0; i < 1000; i++) {
+    histogram.Record(fml::TimeDelta::FromMilliseconds(8));
+  }
+  for (int i = 0; i < 10; i++) {
+    histogram.Record(fml::TimeDelta::FromMilliseconds(100));
+  }
+  ASSERT_EQ(histogram.GetCount(), 1010u);
+  ASSERT_EQ(histogram.GetMaxMicros(), 100000u);
+
+  const auto p50 = histogram.GetPercentileMicros(50);
+  ASSERT_GE(p50, 8000u);
+  ASSERT_LE(p50, 8500u);
+  const auto p99 = histogram.GetPercentileMicros(99);
+  ASSERT_GE(p99, 8000u);
+  ASSERT_LE(p99, 8500u);
+  ASSERT_EQ(histogram.GetPercentileMicros(99.9), 100000u);
+  ASSERT_EQ(histogram.GetPercentileMicros(100), 100000u);
+}
+
+TEST(LatencyHistogramTest, NegativeDurationsAreRecordedAsZero) {
+  LatencyHistogram histogram;
+  histogram.Record(fml::TimeDelta::FromMilliseconds(-5));
+  ASSERT_EQ(histogram.GetCount(), 1u);
+  ASSERT_EQ(histogram.GetPercentileMicros(100), 0u);
+}
+
+TEST(LatencyHistogramTest, Reset) {
+  LatencyHistogram histogram;
+  histogram.RecordMicros(1234);
+  histogram.Reset();
+  ASSERT_EQ(histogram.GetCount(), 0u);
+  ASSERT_EQ(histogram.GetMaxMicros(), 0u);
+  ASSERT_EQ(histogram.GetPercentileMicros(50), 0u);
+}
+
+TEST(FrameLatencyAggregatorTest, AggregatesPhases) {
+  FrameLatencyAggregator aggregator;
+  const auto vsync_start = fml::TimePoint::Now();
+
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kBuildStart,
+             vsync_start + fml::TimeDelta::FromMicroseconds(10));
+  timing.Set(FrameTiming::kBuildFinish,
+             vsync_start + fml::TimeDelta::FromMicroseconds(20));
+  timing.Set(FrameTiming::kRasterStart,
+             vsync_start + fml::TimeDelta::FromMicroseconds(25));
+  timing.Set(FrameTiming::kRasterFinish,
+             vsync_start + fml::TimeDelta::FromMicroseconds(30));
+  aggregator.AddFrame(timing);
+
+  const auto statistics = aggregator.GetStatistics();
+  ASSERT_EQ(statistics.frame_count, 1u);
+  using Phase = FrameLatencyAggregator::Phase;
+  ASSERT_EQ(statistics.Get(Phase::kVsyncOverhead).p50, 10u);
+  ASSERT_EQ(statistics.Get(Phase::kBuild).p50, 10u);
+  ASSERT_EQ(statistics.Get(Phase::kRaster).p50, 5u);
+  ASSERT_EQ(statistics.Get(Phase::kTotal).p50, 30u);
+  ASSERT_EQ(statistics.Get(Phase::kTotal).p999, 30u);
+  ASSERT_EQ(statistics.Get(Phase::kTotal).max, 30u);
+
+  aggregator.Reset();
+  ASSERT_EQ(aggregator.GetStatistics().frame_count, 0u);
+}
+
+TEST(FrameLatencyAggregatorTest, GetStatisticsAndResetLosesNoFrames) {
+  FrameLatencyAggregator aggregator;
+  const auto vsync_start = fml::TimePoint::Now();
+  FrameTiming timing;
+  for (auto phase : {FrameTiming::kVsyncStart, FrameTiming::kBuildStart,
+                     FrameTiming::kBuildFinish, FrameTiming::kRasterStart,
+                     FrameTiming::kRasterFinish}) {
+    timing.Set(phase, vsync_start);
+  }
+
+  constexpr uint64_t kFrameCount = 100000;
+  std::atomic<bool> done = false;
+  std::thread raster_thread([&aggregator, &timing, &done]() {
+    for (uint64_t i = 0; i < kFrameCount; i++) {
+      aggregator.AddFrame(timing);
+    }
+    done = true;
+  });
+  uint64_t frame_count = 0;
+  while (!done) {
+    frame_count += aggregator.GetStatisticsAndReset().frame_count;
+  }
+  raster_thread.join();
+  frame_count += aggregator.GetStatisticsAndReset().frame_count;
+
+  ASSERT_EQ(frame_count, kFrameCount);
+  ASSERT_EQ(aggregator.GetStatistics().frame_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
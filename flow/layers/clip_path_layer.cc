@@ -17,4 +17,8 @@ void ClipPathLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipPath(clip_shape(), clip_behavior() != Clip::hardEdge);
 }
 
+void ClipPathLayer::CompileClip(CompiledLayerTree& tree) const {
+  tree.ClipPath(clip_shape(), clip_behavior() != Clip::hardEdge);
+}
+
 }  // namespace flutter
@@ -18,6 +18,7 @@ class ClipPathLayer : public ClipShapeLayer<SkPath> {
   const SkRect& clip_shape_bounds() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
+  void CompileClip(CompiledLayerTree& tree) const override;
 
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(ClipPathLayer);
@@ -17,4 +17,8 @@ void ClipRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRect(clip_shape(), clip_behavior() != Clip::hardEdge);
 }
 
+void ClipRectLayer::CompileClip(CompiledLayerTree& tree) const {
+  tree.ClipRect(clip_shape(), clip_behavior() != Clip::hardEdge);
+}
+
 }  // namespace flutter
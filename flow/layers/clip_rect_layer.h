@@ -17,6 +17,7 @@ class ClipRectLayer : public ClipShapeLayer<SkRect> {
   const SkRect& clip_shape_bounds() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
+  void CompileClip(CompiledLayerTree& tree) const override;
 
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(ClipRectLayer);
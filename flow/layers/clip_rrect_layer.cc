@@ -17,4 +17,8 @@ void ClipRRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRRect(clip_shape(), clip_behavior() != Clip::hardEdge);
 }
 
+void ClipRRectLayer::CompileClip(CompiledLayerTree& tree) const {
+  tree.ClipRRect(clip_shape(), clip_behavior() != Clip::hardEdge);
+}
+
 }  // namespace flutter
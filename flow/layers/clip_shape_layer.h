@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_CLIP_SHAPE_LAYER_H_
 
 #include "flutter/flow/layers/cacheable_layer.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/paint_utils.h"
 
@@ -99,6 +100,26 @@ class ClipShapeLayer : public CacheableContainerLayer {
     PaintChildren(context);
   }
 
+  bool CompilePaint(CompiledLayerTree& tree) const override {
+    const size_t layer = tree.BeginLayer(this);
+    CompileClip(tree);
+
+    if (UsesSaveLayer()) {
+      tree.IntegralTransform();
+      tree.ApplyRasterCacheState(paint_bounds());
+      tree.DrawRasterCacheItem(layer_raster_cache_item_.get());
+      tree.Restore();
+
+      tree.SaveLayer(paint_bounds());
+    }
+
+    if (!CompilePaintChildren(tree)) {
+      return false;
+    }
+    tree.EndLayer(layer);
+    return true;
+  }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
@@ -106,6 +127,7 @@ class ClipShapeLayer : public CacheableContainerLayer {
  protected:
   virtual const SkRect& clip_shape_bounds() const = 0;
   virtual void ApplyClip(LayerStateStack::MutatorContext& mutator) const = 0;
+  virtual void CompileClip(CompiledLayerTree& tree) const = 0;
   virtual ~ClipShapeLayer() = default;
 
   const ClipShape& clip_shape() const { return clip_shape_; }
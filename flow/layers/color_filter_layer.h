@@ -21,6 +21,9 @@ class ColorFilterLayer : public CacheableContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // Not supported, the layer is always painted by |Paint|.
+  bool CompilePaint(CompiledLayerTree& tree) const override { return false; }
+
  private:
   std::shared_ptr<const DlColorFilter> filter_;
 
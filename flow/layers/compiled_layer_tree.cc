@@ -0,0 +1,260 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/compiled_layer_tree.h"
+
+#include <algorithm>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/raster_cache_item.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+std::unique_ptr<CompiledLayerTree> CompiledLayerTree::Compile(
+    const Layer* root) {
+  TRACE_EVENT0("flutter", "CompiledLayerTree::Compile");
+  std::unique_ptr<CompiledLayerTree> tree(new CompiledLayerTree());
+  if (!root->CompilePaint(*tree)) {
+    return nullptr;
+  }
+  FML_DCHECK(tree->open_layers_.empty());
+  FML_DCHECK(tree->save_depth_ == 0);
+  return tree;
+}
+
+CompiledLayerTree::CompiledLayerTree() = default;
+
+CompiledLayerTree::~CompiledLayerTree() = default;
+
+CompiledLayerTree::Command& CompiledLayerTree::Append(Op op) {
+  auto& command = commands_.emplace_back();
+  command.op = op;
+  return command;
+}
+
+void CompiledLayerTree::PushSave() {
+  save_depth_++;
+  max_save_depth_ = std::max(max_save_depth_, save_depth_);
+}
+
+size_t CompiledLayerTree::BeginLayer(const Layer* layer) {
+  const size_t begin = commands_.size();
+  Append(Op::kBeginLayer).data = layer;
+  open_layers_.push_back(begin);
+  PushSave();
+  return begin;
+}
+
+void CompiledLayerTree::EndLayer(size_t begin) {
+  FML_DCHECK(!open_layers_.empty() && open_layers_.back() == begin);
+  open_layers_.pop_back();
+  save_depth_--;
+  commands_[begin].index = commands_.size();
+  Append(Op::kEndLayer).index = save_depth_;
+}
+
+void CompiledLayerTree::Translate(const SkPoint& offset) {
+  if (!offset.isZero()) {
+    Append(Op::kTranslate).value = offset;
+  }
+}
+
+void CompiledLayerTree::Transform(const SkMatrix& matrix) {
+  if (matrix.isTranslate()) {
+    Translate(SkPoint::Make(matrix.getTranslateX(), matrix.getTranslateY()));
+  } else if (!matrix.isIdentity()) {
+    Append(Op::kTransform).data = &matrix;
+  }
+}
+
+void CompiledLayerTree::IntegralTransform() {
+  Append(Op::kIntegralTransform);
+}
+
+void CompiledLayerTree::ClipRect(const SkRect& rect, bool is_aa) {
+  auto& command = Append(Op::kClipRect);
+  command.data = &rect;
+  command.is_aa = is_aa;
+}
+
+void CompiledLayerTree::ClipRRect(const SkRRect& rrect, bool is_aa) {
+  auto& command = Append(Op::kClipRRect);
+  command.data = &rrect;
+  command.is_aa = is_aa;
+}
+
+void CompiledLayerTree::ClipPath(const SkPath& path, bool is_aa) {
+  auto& command = Append(Op::kClipPath);
+  command.data = &path;
+  command.is_aa = is_aa;
+}
+
+void CompiledLayerTree::ApplyOpacity(const SkRect& bounds, SkScalar opacity) {
+  if (opacity < SK_Scalar1) {
+    auto& command = Append(Op::kApplyOpacity);
+    command.data = &bounds;
+    command.value.fX = opacity;
+  }
+}
+
+void CompiledLayerTree::SaveLayer(const SkRect& bounds) {
+  Append(Op::kSaveLayer).data = &bounds;
+}
+
+void CompiledLayerTree::ApplyChildrenState(const ContainerLayer* container) {
+  Append(Op::kApplyChildrenState).data = container;
+  PushSave();
+}
+
+void CompiledLayerTree::ApplyRasterCacheState(const SkRect& bounds) {
+  Append(Op::kApplyRasterCacheState).data = &bounds;
+  PushSave();
+}
+
+void CompiledLayerTree::Restore() {
+  FML_DCHECK(save_depth_ > open_layers_.size());
+  save_depth_--;
+  Append(Op::kRestore);
+}
+
+void CompiledLayerTree::DrawRasterCacheItem(const RasterCacheItem* item,
+                                            const OpacityLayer* opacity_layer) {
+  FML_DCHECK(!open_layers_.empty());
+  auto& command = Append(Op::kDrawRasterCacheItem);
+  command.data = item;
+  command.condition = opacity_layer;
+  command.index = open_layers_.back();
+}
+
+void CompiledLayerTree::DrawDisplayList(
+    const sk_sp<DisplayList>& display_list) {
+  Append(Op::kDrawDisplayList).data = &display_list;
+}
+
+void CompiledLayerTree::Paint(PaintContext& context) const {
+  LayerStateStack& state_stack = context.state_stack;
+
+  // The state stack counts to restore to. These are the equivalent of the
+  // |LayerStateStack::MutatorContext| and |LayerStateStack::AutoRestore|
+  // objects that |Layer::Paint| keeps on the C++ stack.
+  std::vector<size_t> saves;
+  saves.reserve(max_save_depth_);
+  // Whether the current layer has not yet saved the canvas state for a
+  // transform or clip, see |LayerStateStack::MutatorContext|.
+  bool save_needed = true;
+
+  const size_t count = commands_.size();
+  for (size_t i = 0; i < count; i++) {
+    const Command& command = commands_[i];
+    switch (command.op) {
+      case Op::kBeginLayer: {
+        auto* layer = static_cast<const Layer*>(command.data);
+        if (!layer->needs_painting(context)) {
+          // Skip to the matching kEndLayer, which restores nothing.
+          i = command.index;
+          break;
+        }
+        saves.push_back(state_stack.stack_count());
+        save_needed = true;
+        break;
+      }
+      case Op::kEndLayer:
+        FML_DCHECK(saves.size() > command.index);
+        state_stack.restore_to_count(saves[command.index]);
+        saves.resize(command.index);
+        break;
+      case Op::kTranslate:
+        state_stack.maybe_save_layer_for_transform(save_needed);
+        save_needed = false;
+        state_stack.push_translate(command.value.fX, command.value.fY);
+        break;
+      case Op::kTransform:
+        state_stack.maybe_save_layer_for_transform(save_needed);
+        save_needed = false;
+        state_stack.push_transform(*static_cast<const SkMatrix*>(command.data));
+        break;
+      case Op::kIntegralTransform:
+        if (context.raster_cache) {
+          state_stack.maybe_save_layer_for_transform(save_needed);
+          save_needed = false;
+          state_stack.push_integral_transform();
+        }
+        break;
+      case Op::kClipRect:
+        state_stack.maybe_save_layer_for_clip(save_needed);
+        save_needed = false;
+        state_stack.push_clip_rect(*static_cast<const SkRect*>(command.data),
+                                   command.is_aa);
+        break;
+      case Op::kClipRRect:
+        state_stack.maybe_save_layer_for_clip(save_needed);
+        save_needed = false;
+        state_stack.push_clip_rrect(*static_cast<const SkRRect*>(command.data),
+                                    command.is_aa);
+        break;
+      case Op::kClipPath:
+        state_stack.maybe_save_layer_for_clip(save_needed);
+        save_needed = false;
+        state_stack.push_clip_path(*static_cast<const SkPath*>(command.data),
+                                   command.is_aa);
+        break;
+      case Op::kApplyOpacity:
+        state_stack.push_opacity(*static_cast<const SkRect*>(command.data),
+                                 command.value.fX);
+        break;
+      case Op::kSaveLayer:
+        state_stack.save_layer(*static_cast<const SkRect*>(command.data));
+        break;
+      case Op::kApplyChildrenState: {
+        auto* container = static_cast<const ContainerLayer*>(command.data);
+        saves.push_back(state_stack.stack_count());
+        if (state_stack.needs_save_layer(
+                container->children_renderable_state_flags())) {
+          state_stack.save_layer(container->child_paint_bounds());
+        }
+        break;
+      }
+      case Op::kApplyRasterCacheState:
+        saves.push_back(state_stack.stack_count());
+        if (context.raster_cache &&
+            state_stack.needs_save_layer(
+                LayerStateStack::kCallerCanApplyOpacity)) {
+          state_stack.save_layer(*static_cast<const SkRect*>(command.data));
+        }
+        break;
+      case Op::kRestore:
+        state_stack.restore_to_count(saves.back());
+        saves.pop_back();
+        break;
+      case Op::kDrawRasterCacheItem: {
+        if (!context.raster_cache) {
+          break;
+        }
+        auto* opacity_layer =
+            static_cast<const OpacityLayer*>(command.condition);
+        if (opacity_layer && opacity_layer->children_can_accept_opacity()) {
+          break;
+        }
+        auto* item = static_cast<const RasterCacheItem*>(command.data);
+        DlPaint paint;
+        if (item->Draw(context, state_stack.fill(paint))) {
+          // Skip the rest of the layer. Its kEndLayer restores everything
+          // that the layer has saved.
+          i = commands_[command.index].index - 1;
+        }
+        break;
+      }
+      case Op::kDrawDisplayList:
+        context.canvas->DrawDisplayList(
+            *static_cast<const sk_sp<DisplayList>*>(command.data),
+            state_stack.outstanding_opacity());
+        break;
+    }
+  }
+  FML_DCHECK(saves.empty());
+}
+
+}  // namespace flutter
@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_COMPILED_LAYER_TREE_H_
+#define FLUTTER_FLOW_LAYERS_COMPILED_LAYER_TREE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+class ContainerLayer;
+class OpacityLayer;
+class RasterCacheItem;
+
+//------------------------------------------------------------------------------
+/// @brief      The |Paint| pass of a layer tree, linearized into an array of
+///             commands that are executed by a single loop instead of a
+///             recursion through the virtual |Layer::Paint| methods.
+///
+///             Each supported layer appends the commands that mirror its
+///             |Paint| method in |Layer::CompilePaint|. The commands only
+///             capture the structure of the tree and the properties that
+///             the layers were created with. Everything that |Preroll|
+///             computes, such as paint bounds, renderable state flags and the
+///             raster cache state, is read from the layers when the commands
+///             are executed. Since layer trees do not change once they are
+///             built, a compiled tree can therefore paint its layer tree in
+///             every frame that the layer tree is prerolled and painted in.
+///
+///             The compiled tree refers to the layers, which must outlive it.
+///
+class CompiledLayerTree {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Compiles the tree below |root|.
+  ///
+  /// @return     The compiled tree, or null if any of the layers in the tree
+  ///             must be painted through |Layer::Paint|.
+  ///
+  static std::unique_ptr<CompiledLayerTree> Compile(const Layer* root);
+
+  ~CompiledLayerTree();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Paints the layer tree. Equivalent to calling |Layer::Paint|
+  ///             on the root layer if it |Layer::needs_painting|.
+  ///
+  void Paint(PaintContext& context) const;
+
+  size_t GetCommandCount() const { return commands_.size(); }
+
+  // The methods below are used by the layers to append their commands. Each
+  // corresponds to an operation on a |LayerStateStack::MutatorContext| or a
+  // |LayerStateStack|.
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts the commands for |layer|. The layer is culled if it
+  ///             does not |Layer::needs_painting|. Otherwise the state stack
+  ///             is saved, as if a |LayerStateStack::MutatorContext| was
+  ///             created, until the matching |EndLayer|.
+  ///
+  /// @return     A token to pass to |EndLayer|.
+  ///
+  size_t BeginLayer(const Layer* layer);
+  void EndLayer(size_t begin);
+
+  void Translate(const SkPoint& offset);
+  void Transform(const SkMatrix& matrix);
+  // Only applied when painting with a raster cache.
+  void IntegralTransform();
+  void ClipRect(const SkRect& rect, bool is_aa);
+  void ClipRRect(const SkRRect& rrect, bool is_aa);
+  void ClipPath(const SkPath& path, bool is_aa);
+  void ApplyOpacity(const SkRect& bounds, SkScalar opacity);
+  void SaveLayer(const SkRect& bounds);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Applies the outstanding state that the children of
+  ///             |container| cannot handle, as |ContainerLayer::PaintChildren|
+  ///             does, until the matching |Restore|.
+  ///
+  void ApplyChildrenState(const ContainerLayer* container);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Applies the outstanding state that content drawn from the
+  ///             raster cache with the given |bounds| cannot handle, until the
+  ///             matching |Restore|. Only applied when painting with a raster
+  ///             cache.
+  ///
+  void ApplyRasterCacheState(const SkRect& bounds);
+
+  void Restore();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Draws |item| from the raster cache, if it is cached, and
+  ///             skips the rest of the current layer if it was.
+  ///
+  /// @param[in]  opacity_layer  If not null, the item is only drawn if the
+  ///                            children of this layer cannot accept its
+  ///                            opacity.
+  ///
+  void DrawRasterCacheItem(const RasterCacheItem* item,
+                           const OpacityLayer* opacity_layer = nullptr);
+
+  void DrawDisplayList(const sk_sp<DisplayList>& display_list);
+
+ private:
+  enum class Op : uint8_t {
+    kBeginLayer,
+    kEndLayer,
+    kTranslate,
+    kTransform,
+    kIntegralTransform,
+    kClipRect,
+    kClipRRect,
+    kClipPath,
+    kApplyOpacity,
+    kSaveLayer,
+    kApplyChildrenState,
+    kApplyRasterCacheState,
+    kRestore,
+    kDrawRasterCacheItem,
+    kDrawDisplayList,
+  };
+
+  struct Command {
+    Op op;
+    bool is_aa = false;
+    // kBeginLayer: The index of the matching kEndLayer.
+    // kEndLayer: The number of saved states to restore to.
+    // kDrawRasterCacheItem: The index of the kBeginLayer of the layer.
+    uint32_t index = 0;
+    // kTranslate: The offset. kApplyOpacity: The opacity in |fX|.
+    SkPoint value = SkPoint::Make(0, 0);
+    // The layer, or the layer property, that the command applies.
+    const void* data = nullptr;
+    // kDrawRasterCacheItem: The optional |OpacityLayer|.
+    const void* condition = nullptr;
+  };
+
+  std::vector<Command> commands_;
+  std::vector<size_t> open_layers_;
+  // The number of states that are saved at the end of the commands.
+  uint32_t save_depth_ = 0;
+  uint32_t max_save_depth_ = 0;
+
+  CompiledLayerTree();
+
+  Command& Append(Op op);
+
+  void PushSave();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompiledLayerTree);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_COMPILED_LAYER_TREE_H_
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/compiled_layer_tree.h"
+
+#include "flutter/flow/layers/clip_path_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/clip_rrect_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/shader_mask_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "flutter/testing/display_list_testing.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+class CompiledLayerTreeTest : public LayerTest {
+ public:
+  // Paints the prerolled |root| through |Layer::Paint| and through
+  // |compiled|, and expects both to record the same display list.
+  void ExpectCompiledPaintMatches(const Layer* root,
+                                  const CompiledLayerTree& compiled) {
+    reset_display_list();
+    if (root->needs_painting(display_list_paint_context())) {
+      root->Paint(display_list_paint_context());
+    }
+    auto expected = display_list();
+
+    reset_display_list();
+    compiled.Paint(display_list_paint_context());
+    EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected));
+  }
+
+  void ExpectCompiledPaintMatches(const Layer* root) {
+    auto compiled = CompiledLayerTree::Compile(root);
+    ASSERT_NE(compiled, nullptr);
+    ExpectCompiledPaintMatches(root, *compiled);
+  }
+
+  static sk_sp<DisplayList> MakeDisplayList(const SkRect& rect) {
+    DisplayListBuilder builder;
+    builder.DrawRect(rect, DlPaint());
+    return builder.Build();
+  }
+
+  // A display list that cannot apply group opacity.
+  static sk_sp<DisplayList> MakeOverlappingDisplayList(const SkRect& rect) {
+    DisplayListBuilder builder;
+    builder.DrawRect(rect, DlPaint());
+    builder.DrawRect(rect.makeOffset(rect.width() / 2, rect.height() / 2),
+                     DlPaint());
+    return builder.Build();
+  }
+
+  static std::shared_ptr<ContainerLayer> MakeTree(bool overlapping,
+                                                  bool is_complex) {
+    auto make_display_list =
+        overlapping ? MakeOverlappingDisplayList : MakeDisplayList;
+    auto root = std::make_shared<ContainerLayer>();
+    auto transform = std::make_shared<TransformLayer>(
+        SkMatrix::Translate(10, 20).preScale(2, 2));
+    auto clip_rect = std::make_shared<ClipRectLayer>(
+        SkRect::MakeWH(200, 200), Clip::hardEdge);
+    auto clip_rrect = std::make_shared<ClipRRectLayer>(
+        SkRRect::MakeRectXY(SkRect::MakeWH(150, 150), 10, 10),
+        Clip::antiAlias);
+    auto clip_path = std::make_shared<ClipPathLayer>(
+        SkPath().addOval(SkRect::MakeWH(120, 120)),
+        Clip::antiAliasWithSaveLayer);
+    auto opacity = std::make_shared<OpacityLayer>(128, SkPoint::Make(5, 5));
+
+    opacity->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(0, 0), make_display_list(SkRect::MakeWH(20, 20)),
+        is_complex, false));
+    opacity->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(40, 0), make_display_list(SkRect::MakeWH(20, 20)),
+        is_complex, false));
+    clip_path->Add(opacity);
+    clip_rrect->Add(clip_path);
+    clip_rect->Add(clip_rrect);
+    transform->Add(clip_rect);
+    root->Add(transform);
+    root->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(300, 300), make_display_list(SkRect::MakeWH(10, 10)),
+        is_complex, false));
+    return root;
+  }
+};
+
+TEST_F(CompiledLayerTreeTest, PaintsLikeLayerTree) {
+  auto root = MakeTree(false, false);
+  root->Preroll(preroll_context());
+  ExpectCompiledPaintMatches(root.get());
+}
+
+TEST_F(CompiledLayerTreeTest, PaintsLikeLayerTreeWithoutOpacityPeephole) {
+  auto root = MakeTree(true, false);
+  root->Preroll(preroll_context());
+  ExpectCompiledPaintMatches(root.get());
+}
+
+TEST_F(CompiledLayerTreeTest, CulledLayersAreSkipped) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeWH(10, 10),
+                                              Clip::hardEdge);
+  auto culled = std::make_shared<TransformLayer>(SkMatrix::Translate(5, 5));
+  culled->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(100, 100), MakeDisplayList(SkRect::MakeWH(10, 10)), false,
+      false));
+  clip->Add(culled);
+  clip->Add(std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), MakeDisplayList(SkRect::MakeWH(5, 5)), false,
+      false));
+  root->Add(clip);
+
+  root->Preroll(preroll_context());
+  ExpectCompiledPaintMatches(root.get());
+}
+
+TEST_F(CompiledLayerTreeTest, CompiledTreeCanBeReused) {
+  auto root = MakeTree(false, false);
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  ASSERT_NE(compiled, nullptr);
+  const size_t command_count = compiled->GetCommandCount();
+
+  for (int i = 0; i < 3; i++) {
+    root->Preroll(preroll_context());
+    ExpectCompiledPaintMatches(root.get(), *compiled);
+  }
+  EXPECT_EQ(compiled->GetCommandCount(), command_count);
+}
+
+TEST_F(CompiledLayerTreeTest, PaintsLikeLayerTreeWithRasterCache) {
+  use_mock_raster_cache();
+  auto root = MakeTree(true, true);
+  auto compiled = CompiledLayerTree::Compile(root.get());
+  ASSERT_NE(compiled, nullptr);
+
+  for (size_t i = 0; i <= raster_cache()->access_threshold(); i++) {
+    raster_cache()->BeginFrame();
+    root->Preroll(preroll_context());
+    LayerTree::TryToRasterCache(cacheable_items(), &paint_context());
+    ExpectCompiledPaintMatches(root.get(), *compiled);
+    cacheable_items().clear();
+    raster_cache()->EndFrame();
+  }
+  EXPECT_GT(raster_cache()->GetLayerCachedEntriesCount() +
+                raster_cache()->GetPictureCachedEntriesCount(),
+            0u);
+}
+
+TEST_F(CompiledLayerTreeTest, UnsupportedLayersAreNotCompiled) {
+  auto root = std::make_shared<ContainerLayer>();
+  auto transform = std::make_shared<TransformLayer>(SkMatrix::Scale(2, 2));
+  root->Add(transform);
+  EXPECT_NE(CompiledLayerTree::Compile(root.get()), nullptr);
+
+  transform->Add(std::make_shared<ShaderMaskLayer>(
+      nullptr, SkRect::MakeWH(10, 10), DlBlendMode::kSrc));
+  EXPECT_EQ(CompiledLayerTree::Compile(root.get()), nullptr);
+
+  auto other_root = std::make_shared<ContainerLayer>();
+  other_root->Add(
+      std::make_shared<MockLayer>(SkPath().addRect(SkRect::MakeWH(5, 5))));
+  EXPECT_EQ(CompiledLayerTree::Compile(other_root.get()), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
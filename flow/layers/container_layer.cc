@@ -6,6 +6,9 @@
 
 #include <optional>
 
+#include "flutter/flow/layers/compiled_layer_tree.h"
+#include "flutter/flow/raster_cache_item.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
@@ -105,6 +108,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  children_preroll_state_.reset();
 }
 
 void ContainerLayer::Preroll(PrerollContext* context) {
@@ -119,6 +123,15 @@ void ContainerLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool ContainerLayer::CompilePaint(CompiledLayerTree& tree) const {
+  const size_t layer = tree.BeginLayer(this);
+  if (!CompilePaintChildren(tree)) {
+    return false;
+  }
+  tree.EndLayer(layer);
+  return true;
+}
+
 static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   if (rect1->isEmpty() || rect2.isEmpty()) {
     return false;
@@ -126,6 +139,42 @@ static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   return rect1->intersects(rect2);
 }
 
+bool ContainerLayer::CanReuseChildrenPreroll(
+    const PrerollContext* context) const {
+  if (!context->reuse_retained_preroll ||
+      !children_preroll_state_.has_value() ||
+      children_preroll_state_->gr_context != context->gr_context ||
+      children_preroll_state_->raster_cache != context->raster_cache ||
+      children_preroll_state_->device_cull_rect !=
+          context->state_stack.device_cull_rect() ||
+      children_preroll_state_->transform !=
+          context->state_stack.transform_4x4()) {
+    return false;
+  }
+  // The raster cache may have dropped an image since the last frame.
+  for (RasterCacheItem* item : children_preroll_state_->raster_cache_items) {
+    if (!item->IsPrerollSettled(*context->raster_cache)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ContainerLayer::AreRasterCacheItemsSettled(
+    const PrerollContext* context,
+    size_t first_item) const {
+  if (!context->raster_cached_entries) {
+    return true;
+  }
+  const auto& items = *context->raster_cached_entries;
+  for (size_t i = first_item; i < items.size(); i++) {
+    if (!items[i]->IsPrerollSettled(*context->raster_cache)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      SkRect* child_paint_bounds) {
   // Platform views have no children, so context->has_platform_view should
@@ -133,6 +182,28 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   FML_DCHECK(!context->has_texture_layer);
 
+  // A layer that is prerolled again was retained from a previous frame along
+  // with all of its children. If the children are prerolled under the same
+  // conditions as last time, they come to the same results, which they still
+  // hold.
+  if (CanReuseChildrenPreroll(context)) {
+    child_paint_bounds->join(child_paint_bounds_);
+    context->renderable_state_flags = children_renderable_state_flags_;
+    if (children_preroll_state_->children_need_readback) {
+      context->surface_needs_readback = true;
+    }
+    for (RasterCacheItem* item : children_preroll_state_->raster_cache_items) {
+      item->PrerollReplay(context);
+    }
+    return;
+  }
+  children_preroll_state_.reset();
+
+  const bool surface_needed_readback = context->surface_needs_readback;
+  const size_t raster_cached_entry_count =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
@@ -171,6 +242,28 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   set_subtree_has_platform_view(child_has_platform_view);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
+
+  // Platform views and textures must be prerolled every frame. Raster cache
+  // entries can be replayed only once their items stop changing their minds,
+  // which for most of them takes a few frames of being seen.
+  if (context->reuse_retained_preroll && !child_has_platform_view &&
+      !child_has_texture_layer && !surface_needed_readback &&
+      AreRasterCacheItemsSettled(context, raster_cached_entry_count)) {
+    std::vector<RasterCacheItem*> raster_cache_items;
+    if (context->raster_cached_entries) {
+      raster_cache_items.assign(
+          context->raster_cached_entries->begin() + raster_cached_entry_count,
+          context->raster_cached_entries->end());
+    }
+    children_preroll_state_ = ChildrenPrerollState{
+        .transform = context->state_stack.transform_4x4(),
+        .device_cull_rect = context->state_stack.device_cull_rect(),
+        .gr_context = context->gr_context,
+        .raster_cache = context->raster_cache,
+        .raster_cache_items = std::move(raster_cache_items),
+        .children_need_readback = context->surface_needs_readback,
+    };
+  }
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -194,4 +287,15 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   }
 }
 
+bool ContainerLayer::CompilePaintChildren(CompiledLayerTree& tree) const {
+  tree.ApplyChildrenState(this);
+  for (auto& layer : layers_) {
+    if (!layer->CompilePaint(tree)) {
+      return false;
+    }
+  }
+  tree.Restore();
+  return true;
+}
+
 }  // namespace flutter
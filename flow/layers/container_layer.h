@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
@@ -30,6 +31,8 @@ class ContainerLayer : public Layer {
 
   void PaintChildren(PaintContext& context) const override;
 
+  bool CompilePaint(CompiledLayerTree& tree) const override;
+
   const ContainerLayer* as_container_layer() const override { return this; }
 
   const SkRect& child_paint_bounds() const { return child_paint_bounds_; }
@@ -47,10 +50,31 @@ class ContainerLayer : public Layer {
  protected:
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
+  // Appends the commands that do what |PaintChildren| does to |tree|.
+  bool CompilePaintChildren(CompiledLayerTree& tree) const;
+
  private:
+  // The conditions the children were last prerolled under, recorded only if
+  // the results of that preroll depend on nothing else.
+  struct ChildrenPrerollState {
+    SkM44 transform;
+    SkRect device_cull_rect;
+    GrDirectContext* gr_context;
+    RasterCache* raster_cache;
+    // The items the children added to the raster cache entries, which are
+    // added again when the children are not prerolled.
+    std::vector<RasterCacheItem*> raster_cache_items;
+    bool children_need_readback;
+  };
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
+  std::optional<ChildrenPrerollState> children_preroll_state_;
+
+  bool CanReuseChildrenPreroll(const PrerollContext* context) const;
+  bool AreRasterCacheItemsSettled(const PrerollContext* context,
+                                  size_t first_item) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/testing/diff_context_test.h"
@@ -763,6 +765,226 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+namespace {
+
+class CountingMockLayer : public MockLayer {
+ public:
+  using MockLayer::MockLayer;
+
+  void Preroll(PrerollContext* context) override {
+    preroll_count_++;
+    MockLayer::Preroll(context);
+  }
+
+  int preroll_count() const { return preroll_count_; }
+
+ private:
+  int preroll_count_ = 0;
+};
+
+class CountingMockCacheableLayer : public MockCacheableLayer {
+ public:
+  using MockCacheableLayer::MockCacheableLayer;
+
+  void Preroll(PrerollContext* context) override {
+    preroll_count_++;
+    MockCacheableLayer::Preroll(context);
+  }
+
+  int preroll_count() const { return preroll_count_; }
+
+ private:
+  int preroll_count_ = 0;
+};
+
+}  // namespace
+
+TEST_F(ContainerLayerTest, RetainedChildrenAreNotPrerolledAgain) {
+  SkPath child_path1 = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath child_path2 = SkPath().addRect(25.0f, 6.0f, 40.5f, 21.5f);
+  auto mock_layer1 = std::make_shared<CountingMockLayer>(child_path1);
+  auto mock_layer2 = std::make_shared<CountingMockLayer>(child_path2);
+  mock_layer1->set_fake_opacity_compatible(true);
+  mock_layer2->set_fake_opacity_compatible(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  SkRect expected_bounds = child_path1.getBounds();
+  expected_bounds.join(child_path2.getBounds());
+  preroll_context()->reuse_retained_preroll = true;
+  for (int frame = 0; frame < 3; frame++) {
+    preroll_context()->renderable_state_flags = 0;
+    layer->Preroll(preroll_context());
+    EXPECT_EQ(layer->paint_bounds(), expected_bounds);
+    EXPECT_EQ(layer->child_paint_bounds(), expected_bounds);
+    EXPECT_EQ(preroll_context()->renderable_state_flags,
+              LayerStateStack::kCallerCanApplyOpacity);
+  }
+  EXPECT_EQ(mock_layer1->preroll_count(), 1);
+  EXPECT_EQ(mock_layer2->preroll_count(), 1);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildrenArePrerolledWithoutReuseFlag) {
+  SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<CountingMockLayer>(child_path);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context());
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildrenArePrerolledWhenTransformChanges) {
+  SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<CountingMockLayer>(child_path);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix());
+
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.translate(10.0f, 20.0f);
+    layer->Preroll(preroll_context());
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 2);
+  EXPECT_EQ(mock_layer->parent_matrix(), SkMatrix::Translate(10.0f, 20.0f));
+
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.clipRect(SkRect::MakeLTRB(0.0f, 0.0f, 10.0f, 10.0f), false);
+    layer->Preroll(preroll_context());
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 3);
+  EXPECT_EQ(mock_layer->parent_cull_rect(),
+            SkRect::MakeLTRB(0.0f, 0.0f, 10.0f, 10.0f));
+
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 4);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->preroll_count(), 4);
+}
+
+TEST_F(ContainerLayerTest, PlatformViewsAndTexturesAreAlwaysPrerolled) {
+  SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto platform_view = std::make_shared<CountingMockLayer>(child_path);
+  platform_view->set_fake_has_platform_view(true);
+  auto texture = std::make_shared<CountingMockLayer>(child_path);
+  texture->set_fake_has_texture_layer(true);
+  auto platform_view_parent = std::make_shared<ContainerLayer>();
+  platform_view_parent->Add(platform_view);
+  auto texture_parent = std::make_shared<ContainerLayer>();
+  texture_parent->Add(texture);
+
+  preroll_context()->reuse_retained_preroll = true;
+  for (int frame = 0; frame < 2; frame++) {
+    preroll_context()->has_platform_view = false;
+    platform_view_parent->Preroll(preroll_context());
+    EXPECT_TRUE(preroll_context()->has_platform_view);
+    preroll_context()->has_texture_layer = false;
+    texture_parent->Preroll(preroll_context());
+    EXPECT_TRUE(preroll_context()->has_texture_layer);
+  }
+  EXPECT_EQ(platform_view->preroll_count(), 2);
+  EXPECT_EQ(texture->preroll_count(), 2);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildrenStillRequestReadback) {
+  SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<CountingMockLayer>(child_path);
+  mock_layer->set_fake_reads_surface(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  for (int frame = 0; frame < 2; frame++) {
+    preroll_context()->surface_needs_readback = false;
+    layer->Preroll(preroll_context());
+    EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildrenWithRasterCacheItemsAreSkipped) {
+  use_mock_raster_cache();
+  SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  // The child is cached after it has been prerolled 3 times.
+  auto cacheable_layer = std::make_shared<CountingMockCacheableLayer>(
+      child_path, DlPaint(), 3);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(cacheable_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  for (int frame = 0; frame < 6; frame++) {
+    preroll_context()->raster_cached_entries->clear();
+    raster_cache()->BeginFrame();
+    layer->Preroll(preroll_context());
+    raster_cache()->EvictUnusedCacheEntries();
+    LayerTree::TryToRasterCache(*preroll_context()->raster_cached_entries,
+                                &paint_context());
+    raster_cache()->EndFrame();
+
+    // The skipped child is still handed to the raster cache every frame.
+    ASSERT_EQ(preroll_context()->raster_cached_entries->size(), 1u);
+    EXPECT_EQ(preroll_context()->raster_cached_entries->front(),
+              cacheable_layer->raster_cache_item());
+    EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+  }
+  EXPECT_EQ(cacheable_layer->preroll_count(), 3);
+  EXPECT_EQ(cacheable_layer->raster_cache_item()->cache_state(),
+            RasterCacheItem::CacheState::kCurrent);
+  EXPECT_TRUE(raster_cache()->HasEntry(
+      cacheable_layer->raster_cache_item()->GetId().value(), SkMatrix::I()));
+  EXPECT_EQ(raster_cache()->GetLayerCachedEntriesCount(), 1u);
+}
+
+TEST_F(ContainerLayerTest, RetainedChildrenWithUncachedDisplayListsAreSkipped) {
+  use_mock_raster_cache();
+  preroll_context()->state_stack.set_preroll_delegate(
+      SkRect::MakeWH(100.0f, 100.0f), SkMatrix::I());
+
+  // Too simple to be worth caching.
+  DisplayListBuilder simple_builder;
+  simple_builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto simple_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), simple_builder.Build(), false, false);
+  // Worth caching, but outside of the cull rect.
+  DisplayListBuilder culled_builder;
+  culled_builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto culled_layer = std::make_shared<DisplayListLayer>(
+      SkPoint::Make(200, 200), culled_builder.Build(), true, false);
+  SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<CountingMockLayer>(child_path);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(simple_layer);
+  layer->Add(culled_layer);
+  layer->Add(mock_layer);
+
+  preroll_context()->reuse_retained_preroll = true;
+  for (int frame = 0; frame < 4; frame++) {
+    preroll_context()->raster_cached_entries->clear();
+    raster_cache()->BeginFrame();
+    layer->Preroll(preroll_context());
+    raster_cache()->EvictUnusedCacheEntries();
+    LayerTree::TryToRasterCache(*preroll_context()->raster_cached_entries,
+                                &paint_context());
+    raster_cache()->EndFrame();
+
+    // Only the culled display list is handed to the raster cache, and it is
+    // never cached.
+    ASSERT_EQ(preroll_context()->raster_cached_entries->size(), 1u);
+    EXPECT_EQ(culled_layer->raster_cache_item()->cache_state(),
+              RasterCacheItem::CacheState::kNone);
+  }
+  EXPECT_EQ(mock_layer->preroll_count(), 1);
+  EXPECT_EQ(raster_cache()->GetPictureCachedEntriesCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -9,6 +9,7 @@
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/layers/cacheable_layer.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_util.h"
@@ -160,4 +161,18 @@ void DisplayListLayer::Paint(PaintContext& context) const {
   context.canvas->DrawDisplayList(display_list_, opacity);
 }
 
+bool DisplayListLayer::CompilePaint(CompiledLayerTree& tree) const {
+  FML_DCHECK(display_list_);
+
+  const size_t layer = tree.BeginLayer(this);
+  tree.Translate(offset_);
+  tree.IntegralTransform();
+  if (display_list_raster_cache_item_) {
+    tree.DrawRasterCacheItem(display_list_raster_cache_item_.get());
+  }
+  tree.DrawDisplayList(display_list_);
+  tree.EndLayer(layer);
+  return true;
+}
+
 }  // namespace flutter
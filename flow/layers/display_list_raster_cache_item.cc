@@ -71,6 +71,7 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
+  is_cache_candidate_ = false;
   DisplayListComplexityCalculator* complexity_calculator =
       context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
                                 context->gr_context->backend())
@@ -93,6 +94,7 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
   if (context->raster_cached_entries && context->raster_cache) {
     context->raster_cached_entries->push_back(this);
     cache_state_ = CacheState::kCurrent;
+    is_cache_candidate_ = true;
   }
   return;
 }
@@ -105,10 +107,11 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   }
   auto* raster_cache = context->raster_cache;
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
-  bool visible = !context->state_stack.content_culled(bounds);
+  visible_ = !context->state_stack.content_culled(bounds);
+  matrix_ = matrix;
   RasterCache::CacheInfo cache_info =
-      raster_cache->MarkSeen(key_id_, matrix, visible);
-  if (!visible ||
+      raster_cache->MarkSeen(key_id_, matrix, visible_);
+  if (!visible_ ||
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
   } else {
@@ -121,6 +124,27 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   return;
 }
 
+bool DisplayListRasterCacheItem::IsPrerollSettled(
+    const RasterCache& raster_cache) const {
+  // A display list that isn't worth caching, or that is culled under the
+  // same cull rect and matrix, stays uncached. Whether a visible one is
+  // cached no longer depends on the access count once it is, but whether it
+  // can apply opacity depends on the image.
+  if (!is_cache_candidate_ || !visible_) {
+    return true;
+  }
+  return cache_state_ == CacheState::kCurrent &&
+         raster_cache.HasImage(key_id_, matrix_);
+}
+
+void DisplayListRasterCacheItem::PrerollReplay(PrerollContext* context) {
+  if (!is_cache_candidate_) {
+    return;
+  }
+  context->raster_cached_entries->push_back(this);
+  context->raster_cache->MarkSeen(key_id_, matrix_, visible_);
+}
+
 bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
                                       const DlPaint* paint) const {
   return Draw(context, context.canvas, paint);
@@ -38,6 +38,10 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   void PrerollFinalize(PrerollContext* context,
                        const SkMatrix& matrix) override;
 
+  bool IsPrerollSettled(const RasterCache& raster_cache) const override;
+
+  void PrerollReplay(PrerollContext* context) override;
+
   bool Draw(const PaintContext& context, const DlPaint* paint) const override;
 
   bool Draw(const PaintContext& context,
@@ -59,6 +63,10 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // Whether the last preroll handed this item to the raster cache, and
+  // whether the display list was visible when it did.
+  bool is_cache_candidate_ = false;
+  bool visible_ = false;
 };
 
 }  // namespace flutter
@@ -21,6 +21,9 @@ class ImageFilterLayer : public CacheableContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // Not supported, the layer is always painted by |Paint|.
+  bool CompilePaint(CompiledLayerTree& tree) const override { return false; }
+
  private:
   SkPoint offset_;
   std::shared_ptr<const DlImageFilter> filter_;
@@ -40,6 +40,7 @@ namespace testing {
 class MockLayer;
 }  // namespace testing
 
+class CompiledLayerTree;
 class ContainerLayer;
 class DisplayListLayer;
 class PerformanceOverlayLayer;
@@ -88,6 +89,12 @@ struct PrerollContext {
   // the embedders that must decide between creating SkPicture or
   // DisplayList objects for the inter-view slices of the layer tree.
   bool display_list_enabled = false;
+
+  // This flag is set iff the layers being prerolled are part of a layer tree
+  // and can no longer change. Container layers that were retained from a
+  // previous frame may then skip prerolling their children if nothing the
+  // children depend on changed. See |ContainerLayer::PrerollChildren|.
+  bool reuse_retained_preroll = false;
 };
 
 struct PaintContext {
@@ -202,6 +209,11 @@ class Layer {
 
   virtual void PaintChildren(PaintContext& context) const { FML_DCHECK(false); }
 
+  // Appends the commands that do what |Paint| does to |tree|, see
+  // |CompiledLayerTree|. Layers that can only be painted by their |Paint|
+  // method return false, which makes the whole tree use |Paint|.
+  virtual bool CompilePaint(CompiledLayerTree& tree) const { return false; }
+
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
   void set_subtree_has_platform_view(bool value) {
     subtree_has_platform_view_ = value;
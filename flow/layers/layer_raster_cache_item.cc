@@ -23,6 +23,7 @@ LayerRasterCacheItem::LayerRasterCacheItem(Layer* layer,
 void LayerRasterCacheItem::PrerollSetup(PrerollContext* context,
                                         const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
+  is_cache_candidate_ = false;
   if (context->raster_cache && context->raster_cached_entries) {
     context->raster_cached_entries->push_back(this);
     child_items_ = context->raster_cached_entries->size();
@@ -50,6 +51,7 @@ void LayerRasterCacheItem::PrerollFinalize(PrerollContext* context,
       context->state_stack.content_culled(layer_->paint_bounds())) {
     return;
   }
+  is_cache_candidate_ = true;
   child_items_ = context->raster_cached_entries->size() - child_items_;
   if (num_cache_attempts_ >= layer_cached_threshold_) {
     // the layer can be cached
@@ -74,6 +76,21 @@ void LayerRasterCacheItem::PrerollFinalize(PrerollContext* context,
   }
 }
 
+bool LayerRasterCacheItem::IsPrerollSettled(
+    const RasterCache& raster_cache) const {
+  // A layer that can't be cached under the same matrix and children stays
+  // uncached. Once the layer itself is cached, the number of attempts no
+  // longer matters.
+  return !is_cache_candidate_ || cache_state_ == CacheState::kCurrent;
+}
+
+void LayerRasterCacheItem::PrerollReplay(PrerollContext* context) {
+  context->raster_cached_entries->push_back(this);
+  if (cache_state_ == CacheState::kCurrent) {
+    context->raster_cache->MarkSeen(key_id_, matrix_, true);
+  }
+}
+
 std::optional<RasterCacheKeyID> LayerRasterCacheItem::GetId() const {
   switch (cache_state_) {
     case kCurrent:
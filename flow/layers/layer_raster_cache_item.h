@@ -36,6 +36,10 @@ class LayerRasterCacheItem : public RasterCacheItem {
   void PrerollFinalize(PrerollContext* context,
                        const SkMatrix& matrix) override;
 
+  bool IsPrerollSettled(const RasterCache& raster_cache) const override;
+
+  void PrerollReplay(PrerollContext* context) override;
+
   bool Draw(const PaintContext& context, const DlPaint* paint) const override;
 
   bool Draw(const PaintContext& context,
@@ -64,6 +68,10 @@ class LayerRasterCacheItem : public RasterCacheItem {
   // if the layer's children can be directly cache, set the param is true;
   bool can_cache_children_ = false;
 
+  // Whether the last preroll could have cached the layer at all, that is it
+  // had no platform view or texture and wasn't culled.
+  bool is_cache_candidate_ = false;
+
   mutable int num_cache_attempts_ = 1;
 };
 
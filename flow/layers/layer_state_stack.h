@@ -473,6 +473,7 @@ class LayerStateStack {
 
   std::vector<std::unique_ptr<StateEntry>> state_stack_;
   friend class MutatorContext;
+  friend class CompiledLayerTree;
 
   std::shared_ptr<Delegate> delegate_;
   RenderingAttributes outstanding_;
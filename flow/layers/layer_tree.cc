@@ -65,11 +65,23 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .texture_registry              = frame.context().texture_registry(),
       .raster_cached_entries         = &raster_cache_items_,
       .display_list_enabled          = frame.display_list_builder() != nullptr,
+      .reuse_retained_preroll        = true,
       // clang-format on
   };
 
   root_layer_->Preroll(&context);
 
+  // The framework builds a new tree for most frames, so compiling a tree
+  // only pays off once it is painted again, e.g. when the last tree is
+  // redrawn. The compiled tree reads the results of the preroll from the
+  // layers, so it stays valid for all later frames that this tree is painted
+  // in.
+  if (enable_compiled_paint_ && was_prerolled_ && !compile_attempted_) {
+    compiled_tree_ = CompiledLayerTree::Compile(root_layer_.get());
+    compile_attempted_ = true;
+  }
+  was_prerolled_ = true;
+
   return context.surface_needs_readback;
 }
 
@@ -152,7 +164,9 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
   }
 
-  if (root_layer_->needs_painting(context)) {
+  if (is_paint_compiled() && !enable_leaf_layer_tracing_) {
+    compiled_tree_->Paint(context);
+  } else if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
   }
 }
@@ -10,6 +10,7 @@
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
@@ -81,6 +82,19 @@ class LayerTree {
     return enable_leaf_layer_tracing_;
   }
 
+  /// When enabled, the second `Preroll` of the layer tree compiles it and
+  /// `Paint` executes the compiled tree from then on, unless the tree contains
+  /// layers that do not support being compiled. Trees that are only painted
+  /// once are not compiled.
+  ///
+  /// See: `CompiledLayerTree`
+  void enable_compiled_paint(bool enable) { enable_compiled_paint_ = enable; }
+
+  /// Whether `Paint` executes a compiled copy of the layer tree.
+  bool is_paint_compiled() const {
+    return enable_compiled_paint_ && compiled_tree_ != nullptr;
+  }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
@@ -88,6 +102,10 @@ class LayerTree {
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
   bool enable_leaf_layer_tracing_ = false;
+  bool enable_compiled_paint_ = false;
+  bool was_prerolled_ = false;
+  bool compile_attempted_ = false;
+  std::unique_ptr<CompiledLayerTree> compiled_tree_;
 
   PaintRegionMap paint_region_map_;
 
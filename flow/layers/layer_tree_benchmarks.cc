@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+
+namespace flutter {
+
+namespace {
+
+sk_sp<DisplayList> MakeDisplayList() {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(100, 40), DlPaint(DlColor::kBlue()));
+  return builder.Build();
+}
+
+// Builds a tree shaped like the scene of a scrolling list: every item is
+// offset, clipped and faded, and draws a few pictures.
+std::shared_ptr<Layer> BuildTree(const sk_sp<DisplayList>& display_list,
+                                 int item_count) {
+  constexpr int kPicturesPerItem = 4;
+
+  auto root = std::make_shared<ContainerLayer>();
+  auto scroll = std::make_shared<TransformLayer>(SkMatrix::Translate(0, -250));
+  root->Add(scroll);
+  for (int i = 0; i < item_count; i++) {
+    auto offset =
+        std::make_shared<TransformLayer>(SkMatrix::Translate(0, i * 50));
+    auto clip = std::make_shared<ClipRectLayer>(SkRect::MakeWH(400, 50),
+                                                Clip::hardEdge);
+    auto opacity = std::make_shared<OpacityLayer>(200, SkPoint::Make(8, 0));
+    for (int j = 0; j < kPicturesPerItem; j++) {
+      opacity->Add(std::make_shared<DisplayListLayer>(
+          SkPoint::Make(j * 100, 5), display_list, false, false));
+    }
+    clip->Add(opacity);
+    offset->Add(clip);
+    scroll->Add(offset);
+  }
+  return root;
+}
+
+void BM_LayerTreeBuildAndTeardown(benchmark::State& state) {
+  const auto display_list = MakeDisplayList();
+  const auto item_count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    auto root = BuildTree(display_list, item_count);
+    benchmark::DoNotOptimize(root.get());
+    root.reset();
+  }
+  state.counters["Layers"] = 2 + item_count * 7;
+}
+
+}  // namespace
+
+BENCHMARK(BM_LayerTreeBuildAndTeardown)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -7,6 +7,7 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -100,6 +101,48 @@ TEST_F(LayerTreeTest, Simple) {
                 0, MockCanvas::DrawPathData{child_path, child_paint}}}));
 }
 
+TEST_F(LayerTreeTest, CompiledPaint) {
+  auto transform_layer =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(2.0f, 3.0f));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(transform_layer);
+
+  auto layer_tree = BuildLayerTree(LayerTree::Config{
+      .root_layer = layer,
+  });
+  layer_tree->enable_compiled_paint(true);
+  // A tree that is only painted once is not worth compiling.
+  layer_tree->Preroll(frame());
+  EXPECT_FALSE(layer_tree->is_paint_compiled());
+
+  layer_tree->Preroll(frame());
+  EXPECT_TRUE(layer_tree->is_paint_compiled());
+
+  layer_tree->Paint(frame());
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
+}
+
+TEST_F(LayerTreeTest, CompiledPaintFallsBackForUnsupportedLayers) {
+  const SkPath child_path = SkPath().addRect(SkRect::MakeWH(5.0f, 5.0f));
+  const DlPaint child_paint = DlPaint(DlColor::kCyan());
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  auto layer_tree = BuildLayerTree(LayerTree::Config{
+      .root_layer = layer,
+  });
+  layer_tree->enable_compiled_paint(true);
+  layer_tree->Preroll(frame());
+  layer_tree->Preroll(frame());
+  EXPECT_FALSE(layer_tree->is_paint_compiled());
+
+  layer_tree->Paint(frame());
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}}));
+}
+
 TEST_F(LayerTreeTest, Multiple) {
   const SkPath child_path1 = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
   const SkPath child_path2 = SkPath().addRect(8.0f, 2.0f, 16.5f, 14.5f);
@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/opacity_layer.h"
 
 #include "flutter/flow/layers/cacheable_layer.h"
+#include "flutter/flow/layers/compiled_layer_tree.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "third_party/skia/include/core/SkPaint.h"
 
@@ -89,4 +90,17 @@ void OpacityLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool OpacityLayer::CompilePaint(CompiledLayerTree& tree) const {
+  const size_t layer = tree.BeginLayer(this);
+  tree.Translate(offset_);
+  tree.IntegralTransform();
+  tree.ApplyOpacity(child_paint_bounds(), opacity());
+  tree.DrawRasterCacheItem(layer_raster_cache_item_.get(), this);
+  if (!CompilePaintChildren(tree)) {
+    return false;
+  }
+  tree.EndLayer(layer);
+  return true;
+}
+
 }  // namespace flutter
@@ -22,6 +22,9 @@ class ShaderMaskLayer : public CacheableContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // Not supported, the layer is always painted by |Paint|.
+  bool CompilePaint(CompiledLayerTree& tree) const override { return false; }
+
  private:
   std::shared_ptr<DlColorSource> color_source_;
   SkRect mask_rect_;
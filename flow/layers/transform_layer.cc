@@ -6,6 +6,8 @@
 
 #include <optional>
 
+#include "flutter/flow/layers/compiled_layer_tree.h"
+
 namespace flutter {
 
 TransformLayer::TransformLayer(const SkMatrix& transform)
@@ -60,4 +62,14 @@ void TransformLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+bool TransformLayer::CompilePaint(CompiledLayerTree& tree) const {
+  const size_t layer = tree.BeginLayer(this);
+  tree.Transform(transform_);
+  if (!CompilePaintChildren(tree)) {
+    return false;
+  }
+  tree.EndLayer(layer);
+  return true;
+}
+
 }  // namespace flutter
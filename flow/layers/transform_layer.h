@@ -21,6 +21,8 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  bool CompilePaint(CompiledLayerTree& tree) const override;
+
  private:
   SkMatrix transform_;
 
@@ -174,6 +174,12 @@ bool RasterCache::HasEntry(const RasterCacheKeyID& id,
   return false;
 }
 
+bool RasterCache::HasImage(const RasterCacheKeyID& id,
+                           const SkMatrix& matrix) const {
+  auto it = cache_.find(RasterCacheKey(id, matrix));
+  return it != cache_.cend() && it->second.image != nullptr;
+}
+
 bool RasterCache::Draw(const RasterCacheKeyID& id,
                        DlCanvas& canvas,
                        const DlPaint* paint,
@@ -160,6 +160,11 @@ class RasterCache {
 
   bool HasEntry(const RasterCacheKeyID& id, const SkMatrix&) const;
 
+  /**
+   * Return true iff the entry for the given id and matrix holds an image.
+   */
+  bool HasImage(const RasterCacheKeyID& id, const SkMatrix&) const;
+
   void BeginFrame();
 
   void EvictUnusedCacheEntries();
@@ -53,6 +53,18 @@ class RasterCacheItem {
   virtual bool TryToPrepareRasterCache(const PaintContext& context,
                                        bool parent_cached = false) const = 0;
 
+  // Whether a preroll under the same matrix would come to the same decision
+  // as the last one did, so that |PrerollReplay| can stand in for it.
+  virtual bool IsPrerollSettled(const RasterCache& raster_cache) const {
+    return false;
+  }
+
+  // Repeats what the last |PrerollSetup| and |PrerollFinalize| did to the
+  // raster cache entries of |context| for a settled item.
+  //
+  // See also |ContainerLayer::PrerollChildren|.
+  virtual void PrerollReplay(PrerollContext* context) {}
+
   unsigned child_items() const { return child_items_; }
 
   void set_matrix(const SkMatrix& matrix) { matrix_ = matrix; }
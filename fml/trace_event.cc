@@ -15,6 +15,21 @@
 namespace fml {
 namespace tracing {
 
+namespace {
+
+// Scoped events are gated at compile time by the macros in trace_event.h.
+// Everything else is filtered here.
+void TraceRingRecordIfEnabled(TraceArg category_group,
+                              TraceArg name,
+                              TraceRingEventType type,
+                              TraceIDArg id) {
+  if (TraceRingIsEnabled() && TraceRingCategoryEnabled(category_group)) {
+    TraceRingRecord(category_group, name, type, id);
+  }
+}
+
+}  // namespace
+
 #if FLUTTER_TIMELINE_ENABLED
 
 namespace {
@@ -195,6 +210,8 @@ void TraceEventEnd(TraceArg name) {
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncBegin, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,  // timestamp1_or_async_id
@@ -208,6 +225,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncEnd, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
@@ -223,6 +242,8 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceIDArg id,
                            TraceArg arg1_name,
                            TraceArg arg1_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncBegin, id);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -240,6 +261,8 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceIDArg id,
                          TraceArg arg1_name,
                          TraceArg arg1_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncEnd, id);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -253,6 +276,8 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 }
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kInstant, 0);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                            // timestamp1_or_async_id
@@ -267,6 +292,8 @@ void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kInstant, 0);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -285,6 +312,8 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
                         TraceArg arg2_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kInstant, 0);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   FlutterTimelineEvent(name,                            // label
@@ -300,6 +329,8 @@ void TraceEventInstant2(TraceArg category_group,
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kFlowBegin, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,  // timestamp1_or_async_id
@@ -313,6 +344,8 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kFlowStep, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
@@ -324,6 +357,8 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kFlowEnd, id);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                            // timestamp1_or_async_id
@@ -405,47 +440,76 @@ void TraceEventAsyncComplete(TraceArg category_group,
 
 void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceArg name,
-                           TraceIDArg id) {}
+                           TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncBegin, id);
+}
 
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncEnd, id);
+}
 
 void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg name,
                            TraceIDArg id,
                            TraceArg arg1_name,
-                           TraceArg arg1_val) {}
+                           TraceArg arg1_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncBegin, id);
+}
 
 void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id,
                          TraceArg arg1_name,
-                         TraceArg arg1_val) {}
+                         TraceArg arg1_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kAsyncEnd, id);
+}
 
-void TraceEventInstant0(TraceArg category_group, TraceArg name) {}
+void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kInstant, 0);
+}
 
 void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
-                        TraceArg arg1_val) {}
+                        TraceArg arg1_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kInstant, 0);
+}
 
 void TraceEventInstant2(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
-                        TraceArg arg2_val) {}
+                        TraceArg arg2_val) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kInstant, 0);
+}
 
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
-                          TraceIDArg id) {}
+                          TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kFlowBegin, id);
+}
 
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
-                         TraceIDArg id) {}
+                         TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kFlowStep, id);
+}
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  TraceRingRecordIfEnabled(category_group, name,
+                           TraceRingEventType::kFlowEnd, id);
 }
 
 #endif  // FLUTTER_TIMELINE_ENABLED
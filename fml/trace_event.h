@@ -35,6 +35,23 @@
 #define TRACE_EVENT_INSTANT2(a, b, k1, v1, k2, v2) \
   TRACE_INSTANT(a, b, TRACE_SCOPE_THREAD, k1, v1, k2, v2)
 
+#define TRACE_EVENT2_INT(category_group, name, arg1_name, arg1_val, arg2_name, \
+                         arg2_val)                                             \
+  const auto __arg1_val_str = std::to_string(arg1_val);                        \
+  const auto __arg2_val_str = std::to_string(arg2_val);                        \
+  TRACE_EVENT2(category_group, name, arg1_name, __arg1_val_str.c_str(),        \
+               arg2_name, __arg2_val_str.c_str());
+
+#define TRACE_EVENT4_INT(category_group, name, arg1_name, arg1_val, arg2_name, \
+                         arg2_val, arg3_name, arg3_val, arg4_name, arg4_val)   \
+  const auto __arg1_val_str = std::to_string(arg1_val);                        \
+  const auto __arg2_val_str = std::to_string(arg2_val);                        \
+  const auto __arg3_val_str = std::to_string(arg3_val);                        \
+  const auto __arg4_val_str = std::to_string(arg4_val);                        \
+  TRACE_EVENT4(category_group, name, arg1_name, __arg1_val_str.c_str(),        \
+               arg2_name, __arg2_val_str.c_str(), arg3_name,                   \
+               __arg3_val_str.c_str(), arg4_name, __arg4_val_str.c_str());
+
 #endif  //  defined(OS_FUCHSIA)
 
 #include <cstddef>
@@ -45,6 +62,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA) && !defined(FML_OS_ANDROID))
@@ -62,6 +80,34 @@
   ::fml::tracing::ScopedInstantEnd __FML__TOKEN_CAT__2(__trace_end_, \
                                                        __LINE__)(name);
 
+// Scoped events are also recorded into the per-thread ring buffer when their
+// category is one of |FML_TRACE_RING_CATEGORIES|. Events in other categories
+// instantiate an empty scope object that compiles away.
+#define __FML__TRACE_RING_SCOPE(category_group, name)                      \
+  ::fml::tracing::TraceRingScope<                                          \
+      ::fml::tracing::TraceRingCategoryEnabled(category_group)>            \
+      __FML__TOKEN_CAT__2(__trace_ring_, __LINE__)(category_group, name);
+
+#define __FML__TRACE_RING_SCOPE_INT(category_group, name, arg1_name,       \
+                                    arg1_val, arg2_name, arg2_val)         \
+  ::fml::tracing::TraceRingScope<                                          \
+      ::fml::tracing::TraceRingCategoryEnabled(category_group)>            \
+      __FML__TOKEN_CAT__2(__trace_ring_, __LINE__)(                        \
+          category_group, name, arg1_name, static_cast<int64_t>(arg1_val), \
+          arg2_name, static_cast<int64_t>(arg2_val));
+
+#define __FML__TRACE_RING_SCOPE_INT4(category_group, name, arg1_name,      \
+                                     arg1_val, arg2_name, arg2_val,        \
+                                     arg3_name, arg3_val, arg4_name,       \
+                                     arg4_val)                             \
+  ::fml::tracing::TraceRingScope<                                          \
+      ::fml::tracing::TraceRingCategoryEnabled(category_group)>            \
+      __FML__TOKEN_CAT__2(__trace_ring_, __LINE__)(                        \
+          category_group, name, arg1_name, static_cast<int64_t>(arg1_val), \
+          arg2_name, static_cast<int64_t>(arg2_val), arg3_name,            \
+          static_cast<int64_t>(arg3_val), arg4_name,                       \
+          static_cast<int64_t>(arg4_val));
+
 // This macro has the FML_ prefix so that it does not collide with the macros
 // from lib/trace/event.h on Fuchsia.
 //
@@ -85,21 +131,25 @@
 // Instead, either use different `name` or `arg1` parameter names.
 #define FML_TRACE_EVENT(category_group, name, ...)                   \
   ::fml::tracing::TraceEvent((category_group), (name), __VA_ARGS__); \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(name)                                        \
+  __FML__TRACE_RING_SCOPE(category_group, name)
 
 #define TRACE_EVENT0(category_group, name)           \
   ::fml::tracing::TraceEvent0(category_group, name); \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(name)                        \
+  __FML__TRACE_RING_SCOPE(category_group, name)
 
 #define TRACE_EVENT1(category_group, name, arg1_name, arg1_val)           \
   ::fml::tracing::TraceEvent1(category_group, name, arg1_name, arg1_val); \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(name)                                             \
+  __FML__TRACE_RING_SCOPE(category_group, name)
 
 #define TRACE_EVENT2(category_group, name, arg1_name, arg1_val, arg2_name, \
                      arg2_val)                                             \
   ::fml::tracing::TraceEvent2(category_group, name, arg1_name, arg1_val,   \
                               arg2_name, arg2_val);                        \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(name)                                              \
+  __FML__TRACE_RING_SCOPE(category_group, name)
 
 #define TRACE_EVENT4(category_group, name, arg1_name, arg1_val, arg2_name, \
                      arg2_val, arg3_name, arg3_val, arg4_name, arg4_val)   \
@@ -107,7 +157,46 @@
                               /*flow_ids=*/nullptr, arg1_name, arg1_val,   \
                               arg2_name, arg2_val, arg3_name, arg3_val,    \
                               arg4_name, arg4_val);                        \
-  __FML__AUTO_TRACE_END(name)
+  __FML__AUTO_TRACE_END(name)                                              \
+  __FML__TRACE_RING_SCOPE(category_group, name)
+
+// The integer variants only format their arguments when a timeline event
+// handler is installed. The ring buffer records the integers directly.
+#define TRACE_EVENT2_INT(category_group, name, arg1_name, arg1_val, arg2_name, \
+                         arg2_val)                                             \
+  const bool __trace_int_args =                                                \
+      ::fml::tracing::TraceHasTimelineEventHandler();                          \
+  const auto __arg1_val_str =                                                  \
+      __trace_int_args ? std::to_string(arg1_val) : std::string();             \
+  const auto __arg2_val_str =                                                  \
+      __trace_int_args ? std::to_string(arg2_val) : std::string();             \
+  ::fml::tracing::TraceEvent2(category_group, name, arg1_name,                 \
+                              __arg1_val_str.c_str(), arg2_name,               \
+                              __arg2_val_str.c_str());                         \
+  __FML__AUTO_TRACE_END(name)                                                  \
+  __FML__TRACE_RING_SCOPE_INT(category_group, name, arg1_name, arg1_val,       \
+                              arg2_name, arg2_val)
+
+#define TRACE_EVENT4_INT(category_group, name, arg1_name, arg1_val, arg2_name, \
+                         arg2_val, arg3_name, arg3_val, arg4_name, arg4_val)   \
+  const bool __trace_int_args =                                                \
+      ::fml::tracing::TraceHasTimelineEventHandler();                          \
+  const auto __arg1_val_str =                                                  \
+      __trace_int_args ? std::to_string(arg1_val) : std::string();             \
+  const auto __arg2_val_str =                                                  \
+      __trace_int_args ? std::to_string(arg2_val) : std::string();             \
+  const auto __arg3_val_str =                                                  \
+      __trace_int_args ? std::to_string(arg3_val) : std::string();             \
+  const auto __arg4_val_str =                                                  \
+      __trace_int_args ? std::to_string(arg4_val) : std::string();             \
+  ::fml::tracing::TraceEvent4(                                                 \
+      category_group, name, /*flow_id_count=*/0, /*flow_ids=*/nullptr,         \
+      arg1_name, __arg1_val_str.c_str(), arg2_name, __arg2_val_str.c_str(),    \
+      arg3_name, __arg3_val_str.c_str(), arg4_name, __arg4_val_str.c_str());   \
+  __FML__AUTO_TRACE_END(name)                                                  \
+  __FML__TRACE_RING_SCOPE_INT4(category_group, name, arg1_name, arg1_val,      \
+                               arg2_name, arg2_val, arg3_name, arg3_val,       \
+                               arg4_name, arg4_val)
 
 #define TRACE_EVENT_ASYNC_BEGIN0_WITH_FLOW_IDS(category_group, name, id, \
                                                flow_id_count, flow_ids)  \
@@ -152,23 +241,6 @@
 #endif  // TRACE_EVENT_HIDE_MACROS
 #endif  // !defined(OS_FUCHSIA)
 
-#define TRACE_EVENT2_INT(category_group, name, arg1_name, arg1_val, arg2_name, \
-                         arg2_val)                                             \
-  const auto __arg1_val_str = std::to_string(arg1_val);                        \
-  const auto __arg2_val_str = std::to_string(arg2_val);                        \
-  TRACE_EVENT2(category_group, name, arg1_name, __arg1_val_str.c_str(),        \
-               arg2_name, __arg2_val_str.c_str());
-
-#define TRACE_EVENT4_INT(category_group, name, arg1_name, arg1_val, arg2_name, \
-                         arg2_val, arg3_name, arg3_val, arg4_name, arg4_val)   \
-  const auto __arg1_val_str = std::to_string(arg1_val);                        \
-  const auto __arg2_val_str = std::to_string(arg2_val);                        \
-  const auto __arg3_val_str = std::to_string(arg3_val);                        \
-  const auto __arg4_val_str = std::to_string(arg4_val);                        \
-  TRACE_EVENT4(category_group, name, arg1_name, __arg1_val_str.c_str(),        \
-               arg2_name, __arg2_val_str.c_str(), arg3_name,                   \
-               __arg3_val_str.c_str(), arg4_name, __arg4_val_str.c_str());
-
 namespace fml {
 namespace tracing {
 
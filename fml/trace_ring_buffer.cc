@@ -0,0 +1,402 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+// Upper bound on the number of distinct strings. Names built at runtime
+// could otherwise grow the table without bound.
+constexpr size_t kMaxInternedStrings = 8192;
+
+// Upper bound on the number of buffers kept alive after their thread exits.
+constexpr size_t kMaxRetiredBuffers = 32;
+
+std::atomic<bool> gTraceRingEnabled = false;
+
+struct InternTable {
+  std::mutex mutex;
+  std::unordered_map<std::string_view, uint32_t> ids;
+  // Deque so that references to existing strings stay valid on insertion.
+  std::deque<std::string> strings = {""};
+};
+
+InternTable& GetInternTable() {
+  static InternTable* table = new InternTable();
+  return *table;
+}
+
+struct BufferRegistry {
+  std::mutex mutex;
+  int64_t next_thread_id = 1;
+  std::vector<std::shared_ptr<TraceRingBuffer>> buffers;
+};
+
+BufferRegistry& GetBufferRegistry() {
+  static BufferRegistry* registry = new BufferRegistry();
+  return *registry;
+}
+
+std::shared_ptr<TraceRingBuffer> CreateThreadBuffer() {
+  auto& registry = GetBufferRegistry();
+  std::scoped_lock lock(registry.mutex);
+
+  // Buffers only referenced by the registry belong to exited threads. Keep
+  // the most recent ones around so their events still show up in dumps.
+  size_t retired = 0;
+  for (auto it = registry.buffers.rbegin(); it != registry.buffers.rend();
+       ++it) {
+    if (it->use_count() == 1 && ++retired > kMaxRetiredBuffers) {
+      it->reset();
+    }
+  }
+  registry.buffers.erase(
+      std::remove(registry.buffers.begin(), registry.buffers.end(), nullptr),
+      registry.buffers.end());
+
+  auto buffer = std::make_shared<TraceRingBuffer>(registry.next_thread_id++);
+  registry.buffers.push_back(buffer);
+  return buffer;
+}
+
+TraceRingBuffer& GetThreadBuffer() {
+  thread_local std::shared_ptr<TraceRingBuffer> buffer = CreateThreadBuffer();
+  return *buffer;
+}
+
+// A small direct mapped cache in front of the intern table so that the common
+// case of a string literal name does not need to take the table lock. Entries
+// are validated by content since callers may pass transient strings.
+struct InternCacheEntry {
+  const char* key = nullptr;
+  const char* interned = nullptr;
+  uint32_t id = 0;
+};
+
+constexpr size_t kInternCacheSize = 64;
+
+InternCacheEntry& GetInternCacheEntry(const char* string) {
+  thread_local InternCacheEntry cache[kInternCacheSize];
+  const auto hash = reinterpret_cast<uintptr_t>(string) >> 3;
+  return cache[hash & (kInternCacheSize - 1)];
+}
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+int64_t NowMicros() {
+  return TimePoint::Now().ToEpochDelta().ToMicroseconds();
+}
+
+const char* PhaseForType(TraceRingEventType type) {
+  switch (type) {
+    case TraceRingEventType::kBegin:
+      return "B";
+    case TraceRingEventType::kEnd:
+      return "E";
+    case TraceRingEventType::kInstant:
+      return "i";
+    case TraceRingEventType::kAsyncBegin:
+      return "b";
+    case TraceRingEventType::kAsyncEnd:
+      return "e";
+    case TraceRingEventType::kFlowBegin:
+      return "s";
+    case TraceRingEventType::kFlowStep:
+      return "t";
+    case TraceRingEventType::kFlowEnd:
+      return "f";
+  }
+  return "i";
+}
+
+void WriteJSONString(std::ostream& stream, std::string_view string) {
+  stream << '"';
+  for (char c : string) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          static constexpr char kHex[] = "0123456789abcdef";
+          stream << "\\u00" << kHex[(c >> 4) & 0xf] << kHex[c & 0xf];
+        } else {
+          stream << c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+void WriteEvents(std::ostream& stream,
+                 int64_t thread_id,
+                 const std::vector<TraceRingEvent>& events,
+                 const std::vector<std::string>& strings,
+                 bool& first) {
+  auto lookup = [&strings](uint32_t id) -> std::string_view {
+    return id < strings.size() ? strings[id] : std::string_view{};
+  };
+  for (const auto& event : events) {
+    stream << (first ? "" : ",") << "{\"name\":";
+    first = false;
+    WriteJSONString(stream, lookup(event.name));
+    stream << ",\"cat\":";
+    WriteJSONString(stream, lookup(event.category));
+    stream << ",\"ph\":\"" << PhaseForType(event.type) << "\"";
+    stream << ",\"ts\":" << event.timestamp_micros;
+    stream << ",\"pid\":0,\"tid\":" << thread_id;
+    switch (event.type) {
+      case TraceRingEventType::kBegin:
+      case TraceRingEventType::kEnd:
+        break;
+      case TraceRingEventType::kInstant:
+        stream << ",\"s\":\"t\"";
+        break;
+      default:
+        stream << ",\"id\":" << event.id;
+        break;
+    }
+    if (event.arg_count > 0) {
+      stream << ",\"args\":{";
+      for (size_t i = 0; i < event.arg_count; i++) {
+        stream << (i == 0 ? "" : ",");
+        WriteJSONString(stream, lookup(event.arg_names[i]));
+        stream << ":" << event.arg_values[i];
+      }
+      stream << "}";
+    }
+    stream << "}";
+  }
+}
+
+std::vector<std::string> CopyInternedStrings() {
+  auto& table = GetInternTable();
+  std::scoped_lock lock(table.mutex);
+  return {table.strings.begin(), table.strings.end()};
+}
+
+}  // namespace
+
+TraceRingBuffer::TraceRingBuffer(int64_t thread_id, size_t capacity)
+    : thread_id_(thread_id),
+      mask_(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 1u)) - 1),
+      slots_(new Slot[mask_ + 1]) {}
+
+TraceRingBuffer::~TraceRingBuffer() = default;
+
+void TraceRingBuffer::Record(const TraceRingEvent& event) {
+  uint64_t words[kEventWords] = {};
+  std::memcpy(words, &event, sizeof(event));
+
+  const uint64_t index = next_.load(std::memory_order_relaxed);
+  Slot& slot = slots_[index & mask_];
+
+  // Odd sequence numbers mark a slot that is being written.
+  const uint64_t sequence = (index + 1) * 2;
+  slot.sequence.store(sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kEventWords; i++) {
+    slot.words[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot.sequence.store(sequence, std::memory_order_release);
+  next_.store(index + 1, std::memory_order_release);
+}
+
+void TraceRingBuffer::Snapshot(std::vector<TraceRingEvent>& events) const {
+  const uint64_t end = next_.load(std::memory_order_acquire);
+  const uint64_t capacity = mask_ + 1;
+  const uint64_t begin = end > capacity ? end - capacity : 0;
+
+  events.reserve(events.size() + (end - begin));
+  for (uint64_t index = begin; index < end; index++) {
+    const Slot& slot = slots_[index & mask_];
+    const uint64_t expected = (index + 1) * 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+      // Overwritten by the owning thread since |end| was read.
+      continue;
+    }
+    uint64_t words[kEventWords];
+    for (size_t i = 0; i < kEventWords; i++) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+      continue;
+    }
+    TraceRingEvent event;
+    std::memcpy(&event, words, sizeof(event));
+    events.push_back(event);
+  }
+}
+
+void TraceRingSetEnabled(bool enabled) {
+  gTraceRingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool TraceRingIsEnabled() {
+  return gTraceRingEnabled.load(std::memory_order_relaxed);
+}
+
+uint32_t TraceRingInternString(const char* string) {
+  if (string == nullptr || string[0] == '\0') {
+    return 0;
+  }
+
+  auto& entry = GetInternCacheEntry(string);
+  if (entry.key == string && std::strcmp(entry.interned, string) == 0) {
+    return entry.id;
+  }
+
+  auto& table = GetInternTable();
+  std::scoped_lock lock(table.mutex);
+  auto found = table.ids.find(string);
+  if (found == table.ids.end()) {
+    if (table.strings.size() >= kMaxInternedStrings) {
+      return 0;
+    }
+    const auto id = static_cast<uint32_t>(table.strings.size());
+    const auto& interned = table.strings.emplace_back(string);
+    found = table.ids.emplace(interned, id).first;
+  }
+  entry.key = string;
+  entry.interned = table.strings[found->second].c_str();
+  entry.id = found->second;
+  return entry.id;
+}
+
+void TraceRingRecord(const char* category,
+                     const char* name,
+                     TraceRingEventType type,
+                     int64_t id) {
+  if (!TraceRingIsEnabled()) {
+    return;
+  }
+  TraceRingEvent event;
+  event.timestamp_micros = NowMicros();
+  event.id = id;
+  event.category = TraceRingInternString(category);
+  event.name = TraceRingInternString(name);
+  event.type = type;
+  GetThreadBuffer().Record(event);
+}
+
+static void RecordArgs(const char* category,
+                       const char* name,
+                       TraceRingEventType type,
+                       const char* const* arg_names,
+                       const int64_t* arg_values,
+                       size_t arg_count) {
+  if (!TraceRingIsEnabled()) {
+    return;
+  }
+  FML_DCHECK(arg_count <= TraceRingEvent::kMaxArgs);
+  TraceRingEvent event;
+  event.timestamp_micros = NowMicros();
+  event.category = TraceRingInternString(category);
+  event.name = TraceRingInternString(name);
+  for (size_t i = 0; i < arg_count; i++) {
+    event.arg_names[i] = TraceRingInternString(arg_names[i]);
+    event.arg_values[i] = arg_values[i];
+  }
+  event.arg_count = static_cast<uint8_t>(arg_count);
+  event.type = type;
+  GetThreadBuffer().Record(event);
+}
+
+void TraceRingRecordArgs(const char* category,
+                         const char* name,
+                         TraceRingEventType type,
+                         const char* arg1_name,
+                         int64_t arg1_val,
+                         const char* arg2_name,
+                         int64_t arg2_val) {
+  const char* const arg_names[] = {arg1_name, arg2_name};
+  const int64_t arg_values[] = {arg1_val, arg2_val};
+  RecordArgs(category, name, type, arg_names, arg_values, 2u);
+}
+
+void TraceRingRecordArgs(const char* category,
+                         const char* name,
+                         TraceRingEventType type,
+                         const char* arg1_name,
+                         int64_t arg1_val,
+                         const char* arg2_name,
+                         int64_t arg2_val,
+                         const char* arg3_name,
+                         int64_t arg3_val,
+                         const char* arg4_name,
+                         int64_t arg4_val) {
+  const char* const arg_names[] = {arg1_name, arg2_name, arg3_name, arg4_name};
+  const int64_t arg_values[] = {arg1_val, arg2_val, arg3_val, arg4_val};
+  RecordArgs(category, name, type, arg_names, arg_values, 4u);
+}
+
+std::string TraceRingDumpJSON() {
+  std::vector<std::shared_ptr<TraceRingBuffer>> buffers;
+  {
+    auto& registry = GetBufferRegistry();
+    std::scoped_lock lock(registry.mutex);
+    buffers = registry.buffers;
+  }
+
+  // Snapshot the events before the strings so that every interned id
+  // referenced by an event is resolvable.
+  std::vector<std::vector<TraceRingEvent>> events(buffers.size());
+  for (size_t i = 0; i < buffers.size(); i++) {
+    buffers[i]->Snapshot(events[i]);
+  }
+  const auto strings = CopyInternedStrings();
+
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (size_t i = 0; i < buffers.size(); i++) {
+    WriteEvents(stream, buffers[i]->GetThreadId(), events[i], strings, first);
+  }
+  stream << "],\"displayTimeUnit\":\"ms\"}";
+  return stream.str();
+}
+
+std::string TraceRingEventsToJSON(int64_t thread_id,
+                                  const std::vector<TraceRingEvent>& events) {
+  const auto strings = CopyInternedStrings();
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  WriteEvents(stream, thread_id, events, strings, first);
+  stream << "],\"displayTimeUnit\":\"ms\"}";
+  return stream.str();
+}
+
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,222 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+// Comma separated list of the trace categories that are compiled into the
+// ring buffer backend. Scoped trace events in any other category do not touch
+// the ring buffer at all. A "*" entry enables every category.
+#ifndef FML_TRACE_RING_CATEGORIES
+#define FML_TRACE_RING_CATEGORIES "flutter,impeller"
+#endif
+
+namespace fml {
+namespace tracing {
+
+constexpr bool TraceRingCategoryListContains(std::string_view list,
+                                             std::string_view category) {
+  while (!list.empty()) {
+    const size_t comma = list.find(',');
+    const std::string_view item = list.substr(0, comma);
+    if (item == category || item == "*") {
+      return true;
+    }
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    list.remove_prefix(comma + 1);
+  }
+  return false;
+}
+
+/// Whether events in |category| are recorded into the ring buffer. This is
+/// usable in constant expressions so that disabled categories compile away.
+constexpr bool TraceRingCategoryEnabled(std::string_view category) {
+  return TraceRingCategoryListContains(FML_TRACE_RING_CATEGORIES, category);
+}
+
+enum class TraceRingEventType : uint8_t {
+  kBegin,
+  kEnd,
+  kInstant,
+  kAsyncBegin,
+  kAsyncEnd,
+  kFlowBegin,
+  kFlowStep,
+  kFlowEnd,
+};
+
+/// A single fixed-size event in the ring buffer. Strings are stored as ids
+/// interned via |TraceRingInternString| and only resolved when dumping.
+struct TraceRingEvent {
+  static constexpr size_t kMaxArgs = 4;
+
+  int64_t timestamp_micros = 0;
+  int64_t id = 0;
+  int64_t arg_values[kMaxArgs] = {};
+  uint32_t category = 0;
+  uint32_t name = 0;
+  uint32_t arg_names[kMaxArgs] = {};
+  TraceRingEventType type = TraceRingEventType::kInstant;
+  uint8_t arg_count = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A fixed capacity, overwriting ring of trace events.
+///
+///             Only the owning thread may call |Record|. Any thread may call
+///             |Snapshot| concurrently; each slot is guarded by a sequence
+///             counter so that torn events are detected and dropped instead
+///             of requiring a lock on the recording path.
+///
+class TraceRingBuffer {
+ public:
+  static constexpr size_t kDefaultCapacity = 4096;
+
+  /// |capacity| is rounded up to the next power of two.
+  TraceRingBuffer(int64_t thread_id, size_t capacity = kDefaultCapacity);
+
+  ~TraceRingBuffer();
+
+  int64_t GetThreadId() const { return thread_id_; }
+
+  size_t GetCapacity() const { return mask_ + 1; }
+
+  void Record(const TraceRingEvent& event);
+
+  /// Appends the events currently in the ring, oldest first, to |events|.
+  void Snapshot(std::vector<TraceRingEvent>& events) const;
+
+ private:
+  static constexpr size_t kEventWords =
+      (sizeof(TraceRingEvent) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  struct Slot {
+    std::atomic<uint64_t> sequence = 0;
+    std::atomic<uint64_t> words[kEventWords] = {};
+  };
+
+  const int64_t thread_id_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> next_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceRingBuffer);
+};
+
+/// Enables or disables recording into the per-thread ring buffers. Recording
+/// is disabled by default.
+void TraceRingSetEnabled(bool enabled);
+
+bool TraceRingIsEnabled();
+
+/// Returns a stable id for the contents of |string|. Id 0 is reserved for the
+/// empty string and for strings that did not fit in the intern table.
+uint32_t TraceRingInternString(const char* string);
+
+void TraceRingRecord(const char* category,
+                     const char* name,
+                     TraceRingEventType type,
+                     int64_t id = 0);
+
+void TraceRingRecordArgs(const char* category,
+                         const char* name,
+                         TraceRingEventType type,
+                         const char* arg1_name,
+                         int64_t arg1_val,
+                         const char* arg2_name,
+                         int64_t arg2_val);
+
+void TraceRingRecordArgs(const char* category,
+                         const char* name,
+                         TraceRingEventType type,
+                         const char* arg1_name,
+                         int64_t arg1_val,
+                         const char* arg2_name,
+                         int64_t arg2_val,
+                         const char* arg3_name,
+                         int64_t arg3_val,
+                         const char* arg4_name,
+                         int64_t arg4_val);
+
+/// Serializes the contents of every thread's ring buffer in the Chrome JSON
+/// trace event format, which is also accepted by the Perfetto UI.
+std::string TraceRingDumpJSON();
+
+/// Serializes the given events, which must all have been recorded on the
+/// thread identified by |thread_id|.
+std::string TraceRingEventsToJSON(int64_t thread_id,
+                                  const std::vector<TraceRingEvent>& events);
+
+template <bool kEnabled>
+class TraceRingScope;
+
+template <>
+class TraceRingScope<false> {
+ public:
+  template <typename... Args>
+  explicit TraceRingScope(Args&&... args) {}
+};
+
+template <>
+class TraceRingScope<true> {
+ public:
+  TraceRingScope(const char* category, const char* name)
+      : category_(category), name_(name) {
+    TraceRingRecord(category_, name_, TraceRingEventType::kBegin);
+  }
+
+  TraceRingScope(const char* category,
+                 const char* name,
+                 const char* arg1_name,
+                 int64_t arg1_val,
+                 const char* arg2_name,
+                 int64_t arg2_val)
+      : category_(category), name_(name) {
+    TraceRingRecordArgs(category_, name_, TraceRingEventType::kBegin,
+                        arg1_name, arg1_val, arg2_name, arg2_val);
+  }
+
+  TraceRingScope(const char* category,
+                 const char* name,
+                 const char* arg1_name,
+                 int64_t arg1_val,
+                 const char* arg2_name,
+                 int64_t arg2_val,
+                 const char* arg3_name,
+                 int64_t arg3_val,
+                 const char* arg4_name,
+                 int64_t arg4_val)
+      : category_(category), name_(name) {
+    TraceRingRecordArgs(category_, name_, TraceRingEventType::kBegin,
+                        arg1_name, arg1_val, arg2_name, arg2_val, arg3_name,
+                        arg3_val, arg4_name, arg4_val);
+  }
+
+  ~TraceRingScope() {
+    TraceRingRecord(category_, name_, TraceRingEventType::kEnd);
+  }
+
+ private:
+  const char* category_;
+  const char* name_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceRingScope);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <thread>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+static_assert(TraceRingCategoryListContains("flutter,impeller", "impeller"));
+static_assert(!TraceRingCategoryListContains("flutter,impeller", "skia"));
+static_assert(!TraceRingCategoryListContains("flutter", "flut"));
+static_assert(TraceRingCategoryListContains("*", "anything"));
+
+TEST(TraceRingBufferTest, CapacityIsRoundedUpToPowerOfTwo) {
+  TraceRingBuffer buffer(1, 100);
+  ASSERT_EQ(buffer.GetCapacity(), 128u);
+}
+
+TEST(TraceRingBufferTest, SnapshotIsOrderedOldestFirst) {
+  TraceRingBuffer buffer(1, 8);
+  for (int64_t i = 0; i < 5; i++) {
+    TraceRingEvent event;
+    event.timestamp_micros = i;
+    buffer.Record(event);
+  }
+  std::vector<TraceRingEvent> events;
+  buffer.Snapshot(events);
+  ASSERT_EQ(events.size(), 5u);
+  for (int64_t i = 0; i < 5; i++) {
+    ASSERT_EQ(events[i].timestamp_micros, i);
+  }
+}
+
+TEST(TraceRingBufferTest, OverwritesOldestEvents) {
+  TraceRingBuffer buffer(1, 8);
+  for (int64_t i = 0; i < 20; i++) {
+    TraceRingEvent event;
+    event.timestamp_micros = i;
+    buffer.Record(event);
+  }
+  std::vector<TraceRingEvent> events;
+  buffer.Snapshot(events);
+  ASSERT_EQ(events.size(), 8u);
+  ASSERT_EQ(events.front().timestamp_micros, 12);
+  ASSERT_EQ(events.back().timestamp_micros, 19);
+}
+
+TEST(TraceRingBufferTest, SnapshotWhileRecordingNeverTears) {
+  TraceRingBuffer buffer(1, 16);
+  std::atomic<bool> done = false;
+  std::thread writer([&]() {
+    for (int64_t i = 0; i < 100000; i++) {
+      TraceRingEvent event;
+      event.timestamp_micros = i;
+      event.id = i;
+      event.arg_values[0] = i;
+      event.arg_values[1] = i;
+      buffer.Record(event);
+    }
+    done = true;
+  });
+  while (!done) {
+    std::vector<TraceRingEvent> events;
+    buffer.Snapshot(events);
+    for (const auto& event : events) {
+      ASSERT_EQ(event.timestamp_micros, event.id);
+      ASSERT_EQ(event.timestamp_micros, event.arg_values[0]);
+      ASSERT_EQ(event.timestamp_micros, event.arg_values[1]);
+    }
+  }
+  writer.join();
+}
+
+TEST(TraceRingBufferTest, InternedStringsAreStable) {
+  std::string dynamic_name = "TraceRingBufferTest.Dynamic";
+  const auto id = TraceRingInternString("TraceRingBufferTest.Dynamic");
+  ASSERT_NE(id, 0u);
+  ASSERT_EQ(TraceRingInternString(dynamic_name.c_str()), id);
+  dynamic_name[0] = 'X';
+  ASSERT_NE(TraceRingInternString(dynamic_name.c_str()), id);
+  ASSERT_EQ(TraceRingInternString(""), 0u);
+  ASSERT_EQ(TraceRingInternString(nullptr), 0u);
+}
+
+TEST(TraceRingBufferTest, EventsToJSON) {
+  TraceRingEvent event;
+  event.timestamp_micros = 42;
+  event.category = TraceRingInternString("flutter");
+  event.name = TraceRingInternString("Frame \"1\"");
+  event.type = TraceRingEventType::kBegin;
+  event.arg_count = 1;
+  event.arg_names[0] = TraceRingInternString("frame_number");
+  event.arg_values[0] = 7;
+  ASSERT_EQ(TraceRingEventsToJSON(3, {event}),
+            "{\"traceEvents\":[{\"name\":\"Frame \\\"1\\\"\",\"cat\":"
+            "\"flutter\",\"ph\":\"B\",\"ts\":42,\"pid\":0,\"tid\":3,\"args\":{"
+            "\"frame_number\":7}}],\"displayTimeUnit\":\"ms\"}");
+}
+
+TEST(TraceRingBufferTest, RecordsOnlyWhenEnabled) {
+  TraceRingRecord("flutter", "TraceRingBufferTest.Disabled",
+                  TraceRingEventType::kInstant);
+  ASSERT_EQ(TraceRingDumpJSON().find("TraceRingBufferTest.Disabled"),
+            std::string::npos);
+
+  TraceRingSetEnabled(true);
+  {
+    TraceRingScope<TraceRingCategoryEnabled("flutter")> scope(
+        "flutter", "TraceRingBufferTest.Enabled");
+    TraceRingScope<TraceRingCategoryEnabled("not_a_category")> ignored(
+        "not_a_category", "TraceRingBufferTest.Ignored");
+  }
+  TraceRingSetEnabled(false);
+
+  const auto json = TraceRingDumpJSON();
+  ASSERT_NE(json.find("\"name\":\"TraceRingBufferTest.Enabled\",\"cat\":"
+                      "\"flutter\",\"ph\":\"B\""),
+            std::string::npos);
+  ASSERT_NE(json.find("\"name\":\"TraceRingBufferTest.Enabled\",\"cat\":"
+                      "\"flutter\",\"ph\":\"E\""),
+            std::string::npos);
+  ASSERT_EQ(json.find("TraceRingBufferTest.Ignored"), std::string::npos);
+}
+
+TEST(TraceRingBufferTest, RecordsAllIntArgs) {
+  TraceRingSetEnabled(true);
+  {
+    TRACE_EVENT4_INT("flutter", "TraceRingBufferTest.FourArgs", "first", 1,
+                     "second", 2, "third", 3, "fourth", 4);
+  }
+  TraceRingSetEnabled(false);
+
+  ASSERT_NE(TraceRingDumpJSON().find("\"args\":{\"first\":1,\"second\":2,"
+                                     "\"third\":3,\"fourth\":4}"),
+            std::string::npos);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -41,11 +41,17 @@ bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
     return false;
   }
 
-  if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+  if (!picture.pass) {
+    return true;
   }
 
-  return true;
+  // Offscreen textures that went unused for several frames are released once
+  // the frame has been rendered.
+  auto render_target_cache = content_context_->GetRenderTargetCache();
+  render_target_cache->Start();
+  const bool result = picture.pass->Render(*content_context_, render_target);
+  render_target_cache->End();
+  return result;
 }
 
 }  // namespace impeller
@@ -2601,6 +2601,36 @@ TEST_P(AiksTest, CanRenderBackdropBlurHugeSigma) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, CanRenderBackdropBlurAcrossDownsampleLevels) {
+  // Large blurs sample a downsampled copy of their input. Each column uses a
+  // sigma just below and just above a change of the downsample factor, so
+  // that a visible discontinuity between the levels shows up in the goldens.
+  const Scalar sigmas[] = {9, 11, 19, 21, 38, 42};
+  Canvas canvas;
+  for (size_t i = 0; i < std::size(sigmas); i++) {
+    auto x = 20 + i * 160;
+    canvas.DrawRect(Rect::MakeXYWH(x + 40, 140, 80, 320),
+                    {.color = Color::CornflowerBlue()});
+    canvas.DrawRect(Rect::MakeXYWH(x, 260, 160, 80),
+                    {.color = Color::OrangeRed()});
+    canvas.Save();
+    canvas.ClipRect(Rect::MakeXYWH(x, 100, 160, 400));
+    canvas.SaveLayer({.blend_mode = BlendMode::kSource}, std::nullopt,
+                     [sigma = sigmas[i]](const FilterInput::Ref& input,
+                                         const Matrix& effect_transform,
+                                         bool is_subpass) {
+                       return FilterContents::MakeGaussianBlur(
+                           input, Sigma(sigma), Sigma(sigma),
+                           FilterContents::BlurStyle::kNormal,
+                           Entity::TileMode::kClamp, effect_transform);
+                     });
+    canvas.Restore();
+    canvas.Restore();
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, CanRenderClippedBlur) {
   Canvas canvas;
   canvas.ClipRect(Rect::MakeXYWH(100, 150, 400, 400));
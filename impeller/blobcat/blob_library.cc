@@ -4,8 +4,9 @@
 
 #include "impeller/blobcat/blob_library.h"
 
-#include <array>
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "impeller/base/validation.h"
@@ -25,6 +26,36 @@ constexpr BlobShaderType ToShaderType(fb::Stage stage) {
   FML_UNREACHABLE();
 }
 
+constexpr fb::Stage ToStage(BlobShaderType type) {
+  switch (type) {
+    case BlobShaderType::kVertex:
+      return fb::Stage::kVertex;
+    case BlobShaderType::kFragment:
+      return fb::Stage::kFragment;
+    case BlobShaderType::kCompute:
+      return fb::Stage::kCompute;
+  }
+  FML_UNREACHABLE();
+}
+
+/// @brief  Orders blobs by stage, and then by name. This is the order in which
+///         the blob writer sorts the items of a library.
+static int CompareBlobKeys(fb::Stage lhs_stage,
+                           std::string_view lhs_name,
+                           fb::Stage rhs_stage,
+                           std::string_view rhs_name) {
+  if (lhs_stage != rhs_stage) {
+    return lhs_stage < rhs_stage ? -1 : 1;
+  }
+  return lhs_name.compare(rhs_name);
+}
+
+static std::string_view GetBlobName(const fb::Blob& blob) {
+  return blob.name() ? std::string_view(blob.name()->c_str(),
+                                        blob.name()->size())
+                     : std::string_view();
+}
+
 BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
     : payload_(std::move(payload)) {
   if (!payload_ || payload_->GetMapping() == nullptr) {
@@ -37,25 +68,11 @@ BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
     return;
   }
 
-  auto blob_library = fb::GetBlobLibrary(payload_->GetMapping());
-  if (!blob_library) {
+  library_ = fb::GetBlobLibrary(payload_->GetMapping());
+  if (!library_) {
     return;
   }
 
-  if (auto items = blob_library->items()) {
-    for (auto i = items->begin(), end = items->end(); i != end; i++) {
-      BlobKey key;
-      key.name = i->name()->str();
-      key.type = ToShaderType(i->stage());
-      blobs_[key] = std::make_shared<fml::NonOwnedMapping>(
-          i->mapping()->Data(), i->mapping()->size(),
-          [payload = payload_](auto, auto) {
-            // The pointers are into the base payload. Instead of copying the
-            // data, just hold onto the payload.
-          });
-    }
-  }
-
   is_valid_ = true;
 }
 
@@ -67,17 +84,95 @@ bool BlobLibrary::IsValid() const {
   return is_valid_;
 }
 
+bool BlobLibrary::IsShadowed(size_t index) const {
+  const auto* items = library_->items();
+  const auto* blob = items->Get(index);
+  // Sorted libraries keep blobs with the same key next to each other, so only
+  // the next blob needs to be checked.
+  const size_t size = items->size();
+  const size_t end = library_->sorted() ? std::min(index + 2u, size) : size;
+  for (size_t i = index + 1u; i < end; i++) {
+    const auto* later = items->Get(i);
+    if (CompareBlobKeys(later->stage(), GetBlobName(*later), blob->stage(),
+                        GetBlobName(*blob)) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 size_t BlobLibrary::GetShaderCount() const {
-  return blobs_.size();
+  if (!IsValid() || !library_->items()) {
+    return 0u;
+  }
+  size_t count = 0u;
+  for (size_t i = 0; i < library_->items()->size(); i++) {
+    if (!IsShadowed(i)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+const fb::Blob* BlobLibrary::FindBlob(BlobShaderType type,
+                                      const std::string& name) const {
+  if (!IsValid() || !library_->items()) {
+    return nullptr;
+  }
+  const auto stage = ToStage(type);
+  const auto* items = library_->items();
+
+  if (!library_->sorted()) {
+    // Libraries written before items were sorted are scanned. As before, the
+    // last of any blobs with the same key wins.
+    const fb::Blob* found = nullptr;
+    for (const auto* blob : *items) {
+      if (CompareBlobKeys(blob->stage(), GetBlobName(*blob), stage, name) ==
+          0) {
+        found = blob;
+      }
+    }
+    return found;
+  }
+
+  // Find the last blob that isn't ordered after the key.
+  size_t begin = 0u;
+  size_t end = items->size();
+  while (begin < end) {
+    const size_t middle = begin + (end - begin) / 2u;
+    const auto* blob = items->Get(middle);
+    if (CompareBlobKeys(blob->stage(), GetBlobName(*blob), stage, name) <= 0) {
+      begin = middle + 1u;
+    } else {
+      end = middle;
+    }
+  }
+  if (begin == 0u) {
+    return nullptr;
+  }
+  const auto* blob = items->Get(begin - 1u);
+  return CompareBlobKeys(blob->stage(), GetBlobName(*blob), stage, name) == 0
+             ? blob
+             : nullptr;
+}
+
+std::shared_ptr<fml::Mapping> BlobLibrary::CreateBlobMapping(
+    const fb::Blob& blob) const {
+  if (!blob.mapping()) {
+    return nullptr;
+  }
+  return std::make_shared<fml::NonOwnedMapping>(
+      blob.mapping()->Data(), blob.mapping()->size(),
+      [payload = payload_](auto, auto) {
+        // The pointers are into the base payload. Instead of copying the
+        // data, just hold onto the payload.
+      });
 }
 
 std::shared_ptr<fml::Mapping> BlobLibrary::GetMapping(BlobShaderType type,
                                                       std::string name) const {
-  BlobKey key;
-  key.type = type;
-  key.name = std::move(name);
-  auto found = blobs_.find(key);
-  return found == blobs_.end() ? nullptr : found->second;
+  const auto* blob = FindBlob(type, name);
+  return blob ? CreateBlobMapping(*blob) : nullptr;
 }
 
 size_t BlobLibrary::IterateAllBlobs(
@@ -85,13 +180,18 @@ size_t BlobLibrary::IterateAllBlobs(
                              const std::string& name,
                              const std::shared_ptr<fml::Mapping>& mapping)>&
         callback) const {
-  if (!IsValid() || !callback) {
+  if (!IsValid() || !callback || !library_->items()) {
     return 0u;
   }
   size_t count = 0u;
-  for (const auto& blob : blobs_) {
+  for (size_t i = 0; i < library_->items()->size(); i++) {
+    if (IsShadowed(i)) {
+      continue;
+    }
+    const auto* blob = library_->items()->Get(i);
     count++;
-    if (!callback(blob.first.type, blob.first.name, blob.second)) {
+    if (!callback(ToShaderType(blob->stage()), std::string(GetBlobName(*blob)),
+                  CreateBlobMapping(*blob))) {
       break;
     }
   }
@@ -4,17 +4,28 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
-#include <type_traits>
-#include <unordered_map>
+#include <string>
 
-#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/blobcat/blob_types.h"
 
 namespace impeller {
 
+namespace fb {
+struct Blob;
+struct BlobLibrary;
+}  // namespace fb
+
+//------------------------------------------------------------------------------
+/// @brief      A read-only view of the shaders in a blob payload.
+///
+///             Nothing is copied out of the payload. Shaders are looked up in
+///             place, and the mapping of a shader is only created when it is
+///             asked for. Mappings keep the payload alive.
+///
 class BlobLibrary {
  public:
   explicit BlobLibrary(std::shared_ptr<fml::Mapping> payload);
@@ -37,34 +48,19 @@ class BlobLibrary {
       const;
 
  private:
-  struct BlobKey {
-    BlobShaderType type = BlobShaderType::kFragment;
-    std::string name;
-
-    struct Hash {
-      size_t operator()(const BlobKey& key) const {
-        return fml::HashCombine(
-            static_cast<std::underlying_type_t<decltype(key.type)>>(key.type),
-            key.name);
-      }
-    };
-
-    struct Equal {
-      bool operator()(const BlobKey& lhs, const BlobKey& rhs) const {
-        return lhs.type == rhs.type && lhs.name == rhs.name;
-      }
-    };
-  };
-
-  using Blobs = std::unordered_map<BlobKey,
-                                   std::shared_ptr<fml::Mapping>,
-                                   BlobKey::Hash,
-                                   BlobKey::Equal>;
-
   std::shared_ptr<fml::Mapping> payload_;
-  Blobs blobs_;
+  const fb::BlobLibrary* library_ = nullptr;
   bool is_valid_ = false;
 
+  const fb::Blob* FindBlob(BlobShaderType type, const std::string& name) const;
+
+  /// Whether a later blob of the library has the same key as the blob at the
+  /// index, and so replaces it. Libraries written by the current blob writer
+  /// never contain such blobs, but older payloads may.
+  bool IsShadowed(size_t index) const;
+
+  std::shared_ptr<fml::Mapping> CreateBlobMapping(const fb::Blob& blob) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(BlobLibrary);
 };
 
@@ -4,6 +4,7 @@
 
 #include "impeller/blobcat/blob_writer.h"
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <optional>
@@ -96,15 +97,43 @@ constexpr fb::Stage ToStage(BlobShaderType type) {
 }
 
 std::shared_ptr<fml::Mapping> BlobWriter::CreateMapping() const {
-  fb::BlobLibraryT blobs;
+  // Sort the blobs by stage and then by name, so that libraries can binary
+  // search them in place. The sort is stable so that the last of any blobs
+  // with the same key still wins, and the others are dropped below.
+  std::vector<const BlobDescription*> sorted_descriptions;
+  sorted_descriptions.reserve(blob_descriptions_.size());
   for (const auto& blob_description : blob_descriptions_) {
-    auto mapping = blob_description.mapping;
+    sorted_descriptions.push_back(&blob_description);
+  }
+  std::stable_sort(sorted_descriptions.begin(), sorted_descriptions.end(),
+                   [](const BlobDescription* lhs, const BlobDescription* rhs) {
+                     const auto lhs_stage = ToStage(lhs->type);
+                     const auto rhs_stage = ToStage(rhs->type);
+                     if (lhs_stage != rhs_stage) {
+                       return lhs_stage < rhs_stage;
+                     }
+                     return lhs->name < rhs->name;
+                   });
+  // Deduplicate back to front, which keeps the last blob of every key at the
+  // end of the vector.
+  sorted_descriptions.erase(
+      sorted_descriptions.begin(),
+      std::unique(sorted_descriptions.rbegin(), sorted_descriptions.rend(),
+                  [](const BlobDescription* lhs, const BlobDescription* rhs) {
+                    return lhs->type == rhs->type && lhs->name == rhs->name;
+                  })
+          .base());
+
+  fb::BlobLibraryT blobs;
+  blobs.sorted = true;
+  for (const auto* blob_description : sorted_descriptions) {
+    auto mapping = blob_description->mapping;
     if (!mapping) {
       return nullptr;
     }
     auto desc = std::make_unique<fb::BlobT>();
-    desc->name = blob_description.name;
-    desc->stage = ToStage(blob_description.type);
+    desc->name = blob_description->name;
+    desc->stage = ToStage(blob_description->type);
     desc->mapping = {mapping->GetMapping(),
                      mapping->GetMapping() + mapping->GetSize()};
     blobs.items.emplace_back(std::move(desc));
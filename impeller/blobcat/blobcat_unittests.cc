@@ -3,9 +3,11 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "flutter/testing/testing.h"
+#include "impeller/blobcat/blob_flatbuffers.h"
 #include "impeller/blobcat/blob_library.h"
 #include "impeller/blobcat/blob_writer.h"
 
@@ -53,5 +55,119 @@ TEST(BlobTest, CanReadAndWriteBlobs) {
   ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "World");
 }
 
+TEST(BlobTest, CanFindBlobsInLargeLibraries) {
+  BlobWriter writer;
+  // Added out of order, and with the same names for different stages.
+  for (int i = 99; i >= 0; i--) {
+    const auto name = "Shader" + std::to_string(i);
+    ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, name,
+                               CreateMappingFromString("frag" + name)));
+    ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, name,
+                               CreateMappingFromString("vert" + name)));
+  }
+
+  BlobLibrary library(writer.CreateMapping());
+  ASSERT_TRUE(library.IsValid());
+  ASSERT_EQ(library.GetShaderCount(), 200u);
+
+  for (int i = 0; i < 100; i++) {
+    const auto name = "Shader" + std::to_string(i);
+    auto vertex = library.GetMapping(BlobShaderType::kVertex, name);
+    ASSERT_NE(vertex, nullptr);
+    ASSERT_EQ(CreateStringFromMapping(*vertex), "vert" + name);
+    auto fragment = library.GetMapping(BlobShaderType::kFragment, name);
+    ASSERT_NE(fragment, nullptr);
+    ASSERT_EQ(CreateStringFromMapping(*fragment), "frag" + name);
+  }
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kCompute, "Shader0"), nullptr);
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kVertex, "Shader"), nullptr);
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kVertex, "Shader999"), nullptr);
+
+  size_t vertex_count = 0u;
+  ASSERT_EQ(library.IterateAllBlobs(
+                [&vertex_count](BlobShaderType type, const std::string& name,
+                                const std::shared_ptr<fml::Mapping>& mapping) {
+                  if (type == BlobShaderType::kVertex) {
+                    vertex_count++;
+                    EXPECT_EQ(CreateStringFromMapping(*mapping), "vert" + name);
+                  }
+                  return true;
+                }),
+            200u);
+  ASSERT_EQ(vertex_count, 100u);
+}
+
+TEST(BlobTest, MappingsOutliveTheLibrary) {
+  BlobWriter writer;
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, "Hello",
+                             CreateMappingFromString("World")));
+  std::shared_ptr<fml::Mapping> mapping;
+  {
+    BlobLibrary library(writer.CreateMapping());
+    mapping = library.GetMapping(BlobShaderType::kVertex, "Hello");
+  }
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(CreateStringFromMapping(*mapping), "World");
+}
+
+static std::vector<std::string> CollectBlobContents(
+    const BlobLibrary& library) {
+  std::vector<std::string> contents;
+  library.IterateAllBlobs(
+      [&contents](BlobShaderType type, const std::string& name,
+                  const std::shared_ptr<fml::Mapping>& mapping) {
+        contents.push_back(CreateStringFromMapping(*mapping));
+        return true;
+      });
+  return contents;
+}
+
+TEST(BlobTest, LastBlobWithTheSameKeyWins) {
+  BlobWriter writer;
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, "Hello",
+                             CreateMappingFromString("First")));
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, "Hello",
+                             CreateMappingFromString("Fragment")));
+  ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, "Hello",
+                             CreateMappingFromString("Second")));
+
+  BlobLibrary library(writer.CreateMapping());
+  ASSERT_TRUE(library.IsValid());
+  ASSERT_EQ(library.GetShaderCount(), 2u);
+  auto hello_vtx = library.GetMapping(BlobShaderType::kVertex, "Hello");
+  ASSERT_NE(hello_vtx, nullptr);
+  ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "Second");
+  ASSERT_EQ(CollectBlobContents(library),
+            (std::vector<std::string>{"Second", "Fragment"}));
+}
+
+TEST(BlobTest, UnsortedLibrariesSkipShadowedBlobs) {
+  // Libraries written before blobs were sorted may contain duplicate keys.
+  fb::BlobLibraryT blobs;
+  for (const auto& [name, contents] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"Hello", "First"}, {"Foo", "Bar"}, {"Hello", "Second"}}) {
+    auto blob = std::make_unique<fb::BlobT>();
+    blob->name = name;
+    blob->stage = fb::Stage::kVertex;
+    blob->mapping = {contents.begin(), contents.end()};
+    blobs.items.emplace_back(std::move(blob));
+  }
+  auto builder = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  builder->Finish(fb::BlobLibrary::Pack(*builder, &blobs),
+                  fb::BlobLibraryIdentifier());
+
+  BlobLibrary library(std::make_shared<fml::NonOwnedMapping>(
+      builder->GetBufferPointer(), builder->GetSize(),
+      [builder](auto, auto) {}));
+  ASSERT_TRUE(library.IsValid());
+  ASSERT_EQ(library.GetShaderCount(), 2u);
+  auto hello_vtx = library.GetMapping(BlobShaderType::kVertex, "Hello");
+  ASSERT_NE(hello_vtx, nullptr);
+  ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "Second");
+  ASSERT_EQ(CollectBlobContents(library),
+            (std::vector<std::string>{"Bar", "Second"}));
+}
+
 }  // namespace testing
 }  // namespace impeller
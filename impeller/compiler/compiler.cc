@@ -433,17 +433,19 @@ static std::string JoinStrings(std::vector<std::string> items,
   return stream.str();
 }
 
-std::string Compiler::GetDependencyNames(const std::string& separator) const {
+std::unique_ptr<fml::Mapping> Compiler::CreateDepfileContents(
+    std::initializer_list<std::string> targets_names) const {
   std::vector<std::string> dependencies = included_file_names_;
   dependencies.push_back(options_.file_name);
-  return JoinStrings(dependencies, separator);
+  return CreateDepfileContents(targets_names, dependencies);
 }
 
 std::unique_ptr<fml::Mapping> Compiler::CreateDepfileContents(
-    std::initializer_list<std::string> targets_names) const {
+    const std::vector<std::string>& target_names,
+    const std::vector<std::string>& dependency_names) {
   // https://github.com/ninja-build/ninja/blob/master/src/depfile_parser.cc#L28
-  const auto targets = JoinStrings(targets_names, " ");
-  const auto dependencies = GetDependencyNames(" ");
+  const auto targets = JoinStrings(target_names, " ");
+  const auto dependencies = JoinStrings(dependency_names, " ");
 
   std::stringstream stream;
   stream << targets << ": " << dependencies << "\n";
@@ -42,6 +42,14 @@ class Compiler {
   std::unique_ptr<fml::Mapping> CreateDepfileContents(
       std::initializer_list<std::string> targets) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the contents of a depfile in which the targets depend
+  ///             on the dependencies.
+  ///
+  static std::unique_ptr<fml::Mapping> CreateDepfileContents(
+      const std::vector<std::string>& targets,
+      const std::vector<std::string>& dependencies);
+
   const Reflector* GetReflector() const;
 
  private:
@@ -55,8 +63,6 @@ class Compiler {
 
   std::string GetSourcePrefix() const;
 
-  std::string GetDependencyNames(const std::string& separator) const;
-
   FML_DISALLOW_COPY_AND_ASSIGN(Compiler);
 };
 
@@ -2,16 +2,28 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <filesystem>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "impeller/base/strings.h"
 #include "impeller/compiler/compiler.h"
+#include "impeller/compiler/shader_cache.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/switches.h"
 #include "impeller/compiler/types.h"
@@ -36,27 +48,34 @@ static bool SetPermissiveAccess(const std::filesystem::path& p) {
   return true;
 }
 
-bool Main(const fml::CommandLine& command_line) {
-  fml::InstallCrashHandler();
-  if (command_line.HasOption("help")) {
-    Switches::PrintHelp(std::cout);
-    return true;
-  }
-
-  Switches switches(command_line);
-  if (!switches.AreValid(std::cerr)) {
-    std::cerr << "Invalid flags specified." << std::endl;
-    Switches::PrintHelp(std::cerr);
-    return false;
-  }
+/// The kinds of outputs of a compilation, as they are stored in the cache.
+static constexpr const char* kSPIRVOutput = "spirv";
+static constexpr const char* kSLOutput = "sl";
+static constexpr const char* kReflectionJSONOutput = "reflection-json";
+static constexpr const char* kReflectionHeaderOutput = "reflection-header";
+static constexpr const char* kReflectionCCOutput = "reflection-cc";
 
-  std::shared_ptr<fml::FileMapping> source_file_mapping =
-      fml::FileMapping::CreateReadOnly(switches.source_file_name);
-  if (!source_file_mapping) {
-    std::cerr << "Could not open input file." << std::endl;
-    return false;
-  }
+/// @brief  Identifies the build of impellerc by the contents of its
+///         executable, so that cached outputs aren't reused across changes to
+///         the compiler. The executable is only hashed once per process.
+static const std::optional<std::string>& GetCompilerIdentity() {
+  static const std::optional<std::string> identity =
+      []() -> std::optional<std::string> {
+    auto [found, executable_path] = fml::paths::GetExecutablePath();
+    if (!found) {
+      return std::nullopt;
+    }
+    return ShaderCache::ComputeCompilerIdentity(executable_path);
+  }();
+  return identity;
+}
 
+/// @brief  Compiles the source, and returns the outputs of the compilation
+///         along with the files it included.
+static std::optional<ShaderCache::Entry> Compile(
+    const Switches& switches,
+    const std::shared_ptr<fml::FileMapping>& source_file_mapping,
+    std::ostream& log) {
   SourceOptions options;
   options.target_platform = switches.target_platform;
   options.source_language = switches.source_language;
@@ -85,8 +104,10 @@ bool Main(const fml::CommandLine& command_line) {
   reflector_options.header_file_name = Utf8FromPath(
       std::filesystem::path{switches.reflection_header_name}.filename());
 
-  // Generate SkSL if needed.
-  std::shared_ptr<fml::Mapping> sksl_mapping;
+  // Generate SkSL if needed. It doesn't depend on the compilation for the
+  // target platform, so the two run in parallel.
+  std::future<std::shared_ptr<fml::Mapping>> sksl_future;
+  std::string sksl_errors;
   if (switches.iplr && TargetPlatformBundlesSkSL(switches.target_platform)) {
     SourceOptions sksl_options = options;
     sksl_options.target_platform = TargetPlatform::kSkSL;
@@ -94,45 +115,52 @@ bool Main(const fml::CommandLine& command_line) {
     Reflector::Options sksl_reflector_options = reflector_options;
     sksl_reflector_options.target_platform = TargetPlatform::kSkSL;
 
-    Compiler sksl_compiler =
-        Compiler(source_file_mapping, sksl_options, sksl_reflector_options);
-    if (!sksl_compiler.IsValid()) {
-      std::cerr << "Compilation to SkSL failed." << std::endl;
-      std::cerr << sksl_compiler.GetErrorMessages() << std::endl;
-      return false;
-    }
-    sksl_mapping = sksl_compiler.GetSLShaderSource();
+    sksl_future = std::async(
+        std::launch::async,
+        [&source_file_mapping, &sksl_errors, sksl_options,
+         sksl_reflector_options]() -> std::shared_ptr<fml::Mapping> {
+          Compiler sksl_compiler = Compiler(source_file_mapping, sksl_options,
+                                            sksl_reflector_options);
+          if (!sksl_compiler.IsValid()) {
+            sksl_errors = sksl_compiler.GetErrorMessages();
+            return nullptr;
+          }
+          return sksl_compiler.GetSLShaderSource();
+        });
   }
 
   Compiler compiler(source_file_mapping, options, reflector_options);
-  if (!compiler.IsValid()) {
-    std::cerr << "Compilation failed." << std::endl;
-    std::cerr << compiler.GetErrorMessages() << std::endl;
-    return false;
+
+  std::shared_ptr<fml::Mapping> sksl_mapping;
+  if (sksl_future.valid()) {
+    sksl_mapping = sksl_future.get();
+    if (!sksl_mapping) {
+      log << "Compilation to SkSL failed." << std::endl;
+      log << sksl_errors << std::endl;
+      return std::nullopt;
+    }
   }
 
-  auto spriv_file_name = std::filesystem::absolute(
-      std::filesystem::current_path() / switches.spirv_file_name);
-  if (!fml::WriteAtomically(*switches.working_directory,
-                            Utf8FromPath(spriv_file_name).c_str(),
-                            *compiler.GetSPIRVAssembly())) {
-    std::cerr << "Could not write file to " << switches.spirv_file_name
-              << std::endl;
-    return false;
+  if (!compiler.IsValid()) {
+    log << "Compilation failed." << std::endl;
+    log << compiler.GetErrorMessages() << std::endl;
+    return std::nullopt;
   }
 
-  auto sl_file_name = std::filesystem::absolute(
-      std::filesystem::current_path() / switches.sl_file_name);
+  ShaderCache::Entry result;
+  result.dependencies = compiler.GetIncludedFileNames();
+  result.outputs[kSPIRVOutput] = compiler.GetSPIRVAssembly();
+
   if (switches.iplr) {
     auto reflector = compiler.GetReflector();
     if (reflector == nullptr) {
-      std::cerr << "Could not create reflector." << std::endl;
-      return false;
+      log << "Could not create reflector." << std::endl;
+      return std::nullopt;
     }
     auto stage_data = reflector->GetRuntimeStageData();
     if (!stage_data) {
-      std::cerr << "Runtime stage information was nil." << std::endl;
-      return false;
+      log << "Runtime stage information was nil." << std::endl;
+      return std::nullopt;
     }
     if (sksl_mapping) {
       stage_data->SetSkSLData(sksl_mapping);
@@ -141,71 +169,115 @@ bool Main(const fml::CommandLine& command_line) {
                                   ? stage_data->CreateJsonMapping()
                                   : stage_data->CreateMapping();
     if (!stage_data_mapping) {
-      std::cerr << "Runtime stage data could not be created." << std::endl;
-      return false;
-    }
-    if (!fml::WriteAtomically(*switches.working_directory,         //
-                              Utf8FromPath(sl_file_name).c_str(),  //
-                              *stage_data_mapping                  //
-                              )) {
-      std::cerr << "Could not write file to " << switches.sl_file_name
-                << std::endl;
-      return false;
-    }
-    // Tools that consume the runtime stage data expect the access mode to
-    // be 0644.
-    if (!SetPermissiveAccess(sl_file_name)) {
-      return false;
+      log << "Runtime stage data could not be created." << std::endl;
+      return std::nullopt;
     }
+    result.outputs[kSLOutput] = std::move(stage_data_mapping);
   } else {
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(sl_file_name).c_str(),
-                              *compiler.GetSLShaderSource())) {
-      std::cerr << "Could not write file to " << switches.sl_file_name
-                << std::endl;
-      return false;
-    }
+    result.outputs[kSLOutput] = compiler.GetSLShaderSource();
   }
 
   if (TargetPlatformNeedsReflection(options.target_platform)) {
     if (!switches.reflection_json_name.empty()) {
-      auto reflection_json_name = std::filesystem::absolute(
-          std::filesystem::current_path() / switches.reflection_json_name);
-      if (!fml::WriteAtomically(
-              *switches.working_directory,
-              Utf8FromPath(reflection_json_name).c_str(),
-              *compiler.GetReflector()->GetReflectionJSON())) {
-        std::cerr << "Could not write reflection json to "
-                  << switches.reflection_json_name << std::endl;
-        return false;
-      }
+      result.outputs[kReflectionJSONOutput] =
+          compiler.GetReflector()->GetReflectionJSON();
     }
-
     if (!switches.reflection_header_name.empty()) {
-      auto reflection_header_name =
-          std::filesystem::absolute(std::filesystem::current_path() /
-                                    switches.reflection_header_name.c_str());
-      if (!fml::WriteAtomically(
-              *switches.working_directory,
-              Utf8FromPath(reflection_header_name).c_str(),
-              *compiler.GetReflector()->GetReflectionHeader())) {
-        std::cerr << "Could not write reflection header to "
-                  << switches.reflection_header_name << std::endl;
-        return false;
-      }
+      result.outputs[kReflectionHeaderOutput] =
+          compiler.GetReflector()->GetReflectionHeader();
     }
-
     if (!switches.reflection_cc_name.empty()) {
-      auto reflection_cc_name =
-          std::filesystem::absolute(std::filesystem::current_path() /
-                                    switches.reflection_cc_name.c_str());
-      if (!fml::WriteAtomically(*switches.working_directory,
-                                Utf8FromPath(reflection_cc_name).c_str(),
-                                *compiler.GetReflector()->GetReflectionCC())) {
-        std::cerr << "Could not write reflection CC to "
-                  << switches.reflection_cc_name << std::endl;
-        return false;
-      }
+      result.outputs[kReflectionCCOutput] =
+          compiler.GetReflector()->GetReflectionCC();
+    }
+  }
+
+  return result;
+}
+
+/// @brief  Writes an output of the compilation to the file name, which is
+///         relative to the working directory.
+static bool WriteOutput(const Switches& switches,
+                        const ShaderCache::Entry& entry,
+                        const char* kind,
+                        const std::string& file_name,
+                        std::ostream& log) {
+  auto found = entry.outputs.find(kind);
+  if (found == entry.outputs.end() || !found->second) {
+    log << "Missing " << kind << " output for " << file_name << std::endl;
+    return false;
+  }
+  auto path = std::filesystem::absolute(std::filesystem::current_path() /
+                                        file_name.c_str());
+  if (!fml::WriteAtomically(*switches.working_directory,
+                            Utf8FromPath(path).c_str(), *found->second)) {
+    log << "Could not write file to " << file_name << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static bool CompileAndWriteOutputs(const Switches& switches,
+                                   const ShaderCache* cache,
+                                   const std::string& compiler_identity,
+                                   std::ostream& log) {
+  std::shared_ptr<fml::FileMapping> source_file_mapping =
+      fml::FileMapping::CreateReadOnly(switches.source_file_name);
+  if (!source_file_mapping) {
+    log << "Could not open input file." << std::endl;
+    return false;
+  }
+
+  std::optional<ShaderCache::Entry> entry;
+  std::string cache_key;
+  if (cache) {
+    cache_key = ShaderCache::ComputeKey(switches, *source_file_mapping,
+                                        compiler_identity);
+    entry = cache->Load(cache_key);
+  }
+  if (!entry.has_value()) {
+    entry = Compile(switches, source_file_mapping, log);
+    if (!entry.has_value()) {
+      return false;
+    }
+    if (cache && !cache->Store(cache_key, entry.value())) {
+      // The outputs are still valid, they just won't be reused.
+      log << "Could not store the outputs of " << switches.source_file_name
+          << " in the cache." << std::endl;
+    }
+  }
+
+  if (!WriteOutput(switches, *entry, kSPIRVOutput, switches.spirv_file_name,
+                   log)) {
+    return false;
+  }
+
+  if (!WriteOutput(switches, *entry, kSLOutput, switches.sl_file_name, log)) {
+    return false;
+  }
+  // Tools that consume the runtime stage data expect the access mode to be
+  // 0644.
+  if (switches.iplr &&
+      !SetPermissiveAccess(std::filesystem::absolute(
+          std::filesystem::current_path() / switches.sl_file_name))) {
+    return false;
+  }
+
+  if (TargetPlatformNeedsReflection(switches.target_platform)) {
+    if (!switches.reflection_json_name.empty() &&
+        !WriteOutput(switches, *entry, kReflectionJSONOutput,
+                     switches.reflection_json_name, log)) {
+      return false;
+    }
+    if (!switches.reflection_header_name.empty() &&
+        !WriteOutput(switches, *entry, kReflectionHeaderOutput,
+                     switches.reflection_header_name, log)) {
+      return false;
+    }
+    if (!switches.reflection_cc_name.empty() &&
+        !WriteOutput(switches, *entry, kReflectionCCOutput,
+                     switches.reflection_cc_name, log)) {
+      return false;
     }
   }
 
@@ -227,13 +299,15 @@ bool Main(const fml::CommandLine& command_line) {
         result_file = switches.spirv_file_name;
         break;
     }
+    std::vector<std::string> dependencies = entry->dependencies;
+    dependencies.push_back(switches.source_file_name);
     auto depfile_path = std::filesystem::absolute(
         std::filesystem::current_path() / switches.depfile_path.c_str());
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(depfile_path).c_str(),
-                              *compiler.CreateDepfileContents({result_file}))) {
-      std::cerr << "Could not write depfile to " << switches.depfile_path
-                << std::endl;
+    if (!fml::WriteAtomically(
+            *switches.working_directory, Utf8FromPath(depfile_path).c_str(),
+            *Compiler::CreateDepfileContents({result_file}, dependencies))) {
+      log << "Could not write depfile to " << switches.depfile_path
+          << std::endl;
       return false;
     }
   }
@@ -241,6 +315,127 @@ bool Main(const fml::CommandLine& command_line) {
   return true;
 }
 
+/// @brief  Creates the cache named by the switches, if any, or returns null.
+static std::unique_ptr<ShaderCache> OpenCache(const Switches& switches,
+                                              std::ostream& log) {
+  if (switches.cache_directory.empty()) {
+    return nullptr;
+  }
+  // Without a way to tell builds of the compiler apart, cached outputs could
+  // be stale, so caching is disabled.
+  if (!GetCompilerIdentity().has_value()) {
+    log << "Could not identify the impellerc executable. Compiling without "
+           "a cache."
+        << std::endl;
+    return nullptr;
+  }
+  auto cache = std::make_unique<ShaderCache>(switches.working_directory,
+                                             switches.cache_directory);
+  if (!cache->IsValid()) {
+    log << "Could not open the cache directory " << switches.cache_directory
+        << ". Compiling without a cache." << std::endl;
+    return nullptr;
+  }
+  return cache;
+}
+
+/// @brief  Runs the jobs of a batch file on a pool of threads. The output of
+///         each job is printed once it completes, so that the messages of
+///         concurrent jobs don't interleave.
+static bool RunBatch(const fml::CommandLine& command_line) {
+  auto jobs = ReadBatchJobs(command_line, std::cerr);
+  if (!jobs.has_value()) {
+    return false;
+  }
+
+  std::vector<Switches> job_switches;
+  job_switches.reserve(jobs->size());
+  for (const auto& job : jobs.value()) {
+    Switches switches(job);
+    if (!switches.AreValid(std::cerr)) {
+      std::cerr << "Invalid flags specified for batch job: "
+                << switches.source_file_name << std::endl;
+      return false;
+    }
+    job_switches.push_back(std::move(switches));
+  }
+
+  // Each cache directory is opened once, and shared by the jobs that use it.
+  std::map<std::string, std::unique_ptr<ShaderCache>> caches;
+  std::vector<const ShaderCache*> job_caches;
+  job_caches.reserve(job_switches.size());
+  for (const auto& switches : job_switches) {
+    auto found = caches.find(switches.cache_directory);
+    if (found == caches.end()) {
+      found = caches
+                  .emplace(switches.cache_directory,
+                           OpenCache(switches, std::cerr))
+                  .first;
+    }
+    job_caches.push_back(found->second.get());
+  }
+
+  size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+  std::string jobs_option;
+  if (command_line.GetOptionValue("jobs", &jobs_option)) {
+    thread_count = std::max(1, std::atoi(jobs_option.c_str()));
+  }
+  thread_count = std::min(thread_count, job_switches.size());
+
+  std::atomic<size_t> next_job = 0u;
+  std::atomic<bool> success = true;
+  std::mutex log_mutex;
+  auto run_jobs = [&]() {
+    for (size_t i = next_job++; i < job_switches.size(); i = next_job++) {
+      std::stringstream log;
+      if (!CompileAndWriteOutputs(job_switches[i], job_caches[i],
+                                  GetCompilerIdentity().value_or(""), log)) {
+        log << "Batch job failed: " << job_switches[i].source_file_name
+            << std::endl;
+        success = false;
+      }
+      const auto messages = log.str();
+      if (!messages.empty()) {
+        std::scoped_lock lock(log_mutex);
+        std::cerr << messages;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; i++) {
+    threads.emplace_back(run_jobs);
+  }
+  run_jobs();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return success;
+}
+
+bool Main(const fml::CommandLine& command_line) {
+  fml::InstallCrashHandler();
+  if (command_line.HasOption("help")) {
+    Switches::PrintHelp(std::cout);
+    return true;
+  }
+
+  if (command_line.HasOption("batch")) {
+    return RunBatch(command_line);
+  }
+
+  Switches switches(command_line);
+  if (!switches.AreValid(std::cerr)) {
+    std::cerr << "Invalid flags specified." << std::endl;
+    Switches::PrintHelp(std::cerr);
+    return false;
+  }
+
+  auto cache = OpenCache(switches, std::cerr);
+  return CompileAndWriteOutputs(switches, cache.get(),
+                                GetCompilerIdentity().value_or(""), std::cerr);
+}
+
 }  // namespace compiler
 }  // namespace impeller
 
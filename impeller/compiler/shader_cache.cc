@@ -0,0 +1,257 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/shader_cache.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+
+#include "flutter/fml/file.h"
+#include "impeller/compiler/utilities.h"
+
+namespace impeller {
+namespace compiler {
+
+/// Bumped whenever the format of the entries changes.
+static constexpr std::string_view kEntryHeader = "impellerc-cache-1\n";
+static constexpr std::string_view kDependencyTag = "dependency ";
+static constexpr std::string_view kOutputTag = "output ";
+
+namespace {
+
+/// A 64 bit FNV-1a hash. Unlike `std::hash`, its results are the same for
+/// every build of the compiler, which is what allows the cache to be shared.
+class ContentHasher {
+ public:
+  void Add(const void* data, size_t length) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 0x100000001b3u;
+    }
+  }
+
+  /// Adds a field along with its length, so that the boundaries between
+  /// fields are part of the hash.
+  void AddField(std::string_view field) {
+    const uint64_t length = field.size();
+    Add(&length, sizeof(length));
+    Add(field.data(), field.size());
+  }
+
+  std::string GetHexDigest() const {
+    std::stringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash_;
+    return stream.str();
+  }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325u;
+};
+
+}  // namespace
+
+static std::string HashMapping(const fml::Mapping& mapping) {
+  ContentHasher hasher;
+  hasher.Add(mapping.GetMapping(), mapping.GetSize());
+  return hasher.GetHexDigest();
+}
+
+ShaderCache::ShaderCache(std::shared_ptr<fml::UniqueFD> working_directory,
+                         const std::string& cache_directory)
+    : working_directory_(std::move(working_directory)) {
+  if (!working_directory_ || !working_directory_->is_valid() ||
+      cache_directory.empty()) {
+    return;
+  }
+  std::filesystem::path path(cache_directory);
+  if (!path.is_absolute()) {
+    path = std::filesystem::absolute(std::filesystem::current_path() / path);
+  }
+  std::error_code error;
+  std::filesystem::create_directories(path, error);
+  if (error) {
+    return;
+  }
+  cache_directory_ = fml::OpenDirectory(Utf8FromPath(path).c_str(), false,
+                                        fml::FilePermission::kReadWrite);
+}
+
+ShaderCache::~ShaderCache() = default;
+
+bool ShaderCache::IsValid() const {
+  return cache_directory_.is_valid();
+}
+
+std::string ShaderCache::ComputeKey(const Switches& switches,
+                                    const fml::Mapping& source,
+                                    const std::string& compiler_identity) {
+  ContentHasher hasher;
+  hasher.AddField(kEntryHeader);
+  hasher.AddField(compiler_identity);
+  hasher.AddField(std::string_view(
+      reinterpret_cast<const char*>(source.GetMapping()), source.GetSize()));
+
+  // Every option that can affect the contents of the outputs. The names of
+  // the outputs are included because the reflection sources refer to them.
+  hasher.AddField(std::to_string(static_cast<int>(switches.target_platform)));
+  hasher.AddField(std::to_string(static_cast<int>(switches.input_type)));
+  hasher.AddField(
+      std::to_string(static_cast<int>(switches.source_language)));
+  hasher.AddField(switches.source_file_name);
+  hasher.AddField(switches.sl_file_name);
+  hasher.AddField(switches.spirv_file_name);
+  hasher.AddField(switches.reflection_json_name);
+  hasher.AddField(switches.reflection_header_name);
+  hasher.AddField(switches.reflection_cc_name);
+  hasher.AddField(switches.iplr ? "iplr" : "");
+  hasher.AddField(switches.json_format ? "json" : "");
+  hasher.AddField(std::to_string(switches.gles_language_version));
+  hasher.AddField(switches.metal_version);
+  hasher.AddField(switches.entry_point);
+  hasher.AddField(switches.use_half_textures ? "half-textures" : "");
+  hasher.AddField(std::to_string(switches.include_directories.size()));
+  for (const auto& include_directory : switches.include_directories) {
+    hasher.AddField(include_directory.name);
+  }
+  hasher.AddField(std::to_string(switches.defines.size()));
+  for (const auto& define : switches.defines) {
+    hasher.AddField(define);
+  }
+  return hasher.GetHexDigest();
+}
+
+std::optional<std::string> ShaderCache::ComputeCompilerIdentity(
+    const std::string& executable_path) {
+  auto mapping = fml::FileMapping::CreateReadOnly(executable_path);
+  if (!mapping) {
+    return std::nullopt;
+  }
+  return HashMapping(*mapping);
+}
+
+std::optional<std::string> ShaderCache::HashDependency(
+    const std::string& path) const {
+  auto mapping = fml::FileMapping::CreateReadOnly(*working_directory_, path);
+  if (!mapping) {
+    return std::nullopt;
+  }
+  return HashMapping(*mapping);
+}
+
+/// @brief  Reads up to the next newline of `contents`, starting at `offset`,
+///         and moves `offset` past it.
+static std::optional<std::string_view> ReadLine(std::string_view contents,
+                                                size_t& offset) {
+  const size_t end = contents.find('\n', offset);
+  if (end == std::string_view::npos) {
+    return std::nullopt;
+  }
+  auto line = contents.substr(offset, end - offset);
+  offset = end + 1;
+  return line;
+}
+
+std::optional<ShaderCache::Entry> ShaderCache::Load(
+    const std::string& key) const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(cache_directory_, key);
+  if (!mapping) {
+    return std::nullopt;
+  }
+  const std::string_view contents(
+      reinterpret_cast<const char*>(mapping->GetMapping()),
+      mapping->GetSize());
+  if (contents.substr(0, kEntryHeader.size()) != kEntryHeader) {
+    return std::nullopt;
+  }
+
+  Entry entry;
+  size_t offset = kEntryHeader.size();
+  while (offset < contents.size()) {
+    auto line = ReadLine(contents, offset);
+    if (!line.has_value()) {
+      return std::nullopt;
+    }
+
+    if (line->substr(0, kDependencyTag.size()) == kDependencyTag) {
+      // "dependency <hash> <path>"
+      auto fields = line->substr(kDependencyTag.size());
+      const size_t separator = fields.find(' ');
+      if (separator == std::string_view::npos) {
+        return std::nullopt;
+      }
+      std::string path(fields.substr(separator + 1));
+      if (HashDependency(path) != fields.substr(0, separator)) {
+        // The dependency changed or went away since the entry was stored.
+        return std::nullopt;
+      }
+      entry.dependencies.push_back(std::move(path));
+      continue;
+    }
+
+    if (line->substr(0, kOutputTag.size()) == kOutputTag) {
+      // "output <kind> <length>", followed by the contents.
+      auto fields = line->substr(kOutputTag.size());
+      const size_t separator = fields.find(' ');
+      if (separator == std::string_view::npos) {
+        return std::nullopt;
+      }
+      const size_t length =
+          std::strtoull(std::string(fields.substr(separator + 1)).c_str(),
+                        nullptr, 10);
+      if (length > contents.size() - offset) {
+        return std::nullopt;
+      }
+      const auto* data =
+          reinterpret_cast<const uint8_t*>(contents.data() + offset);
+      entry.outputs[std::string(fields.substr(0, separator))] =
+          std::make_shared<fml::DataMapping>(
+              std::vector<uint8_t>(data, data + length));
+      offset += length;
+      continue;
+    }
+
+    return std::nullopt;
+  }
+  return entry;
+}
+
+bool ShaderCache::Store(const std::string& key, const Entry& entry) const {
+  if (!IsValid()) {
+    return false;
+  }
+
+  std::string contents(kEntryHeader);
+  for (const auto& dependency : entry.dependencies) {
+    auto hash = HashDependency(dependency);
+    if (!hash.has_value()) {
+      return false;
+    }
+    contents.append(kDependencyTag);
+    contents.append(hash.value() + " " + dependency + "\n");
+  }
+  for (const auto& [kind, output] : entry.outputs) {
+    if (!output) {
+      continue;
+    }
+    contents.append(kOutputTag);
+    contents.append(kind + " " + std::to_string(output->GetSize()) + "\n");
+    if (output->GetSize() > 0) {
+      contents.append(reinterpret_cast<const char*>(output->GetMapping()),
+                      output->GetSize());
+    }
+  }
+
+  return fml::WriteAtomically(cache_directory_, key.c_str(),
+                              fml::DataMapping(contents));
+}
+
+}  // namespace compiler
+}  // namespace impeller
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/compiler/switches.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      A content addressed cache of the outputs of impellerc.
+///
+///             Entries are keyed by a hash of the shader source, the options
+///             that affect compilation, and the identity of the compiler. An
+///             entry also records the contents of every file the source
+///             included. It is only used while all of them are unchanged, so
+///             the cache is invalidated exactly when the depfile of the
+///             compilation would be.
+///
+///             Each entry is a single file that is written atomically, so the
+///             cache may be shared by concurrent invocations.
+///
+class ShaderCache {
+ public:
+  /// The outputs of a compilation.
+  struct Entry {
+    /// The files included by the source, as they appear in the depfile.
+    std::vector<std::string> dependencies;
+    /// The generated files, keyed by the kind of output.
+    std::map<std::string, std::shared_ptr<fml::Mapping>> outputs;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the cache at the directory, creating it if necessary.
+  ///
+  /// @param[in]  working_directory  The directory that relative paths,
+  ///                                including those of dependencies, are
+  ///                                resolved against.
+  /// @param[in]  cache_directory    The path of the cache.
+  ///
+  ShaderCache(std::shared_ptr<fml::UniqueFD> working_directory,
+              const std::string& cache_directory);
+
+  ~ShaderCache();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the key of the compilation of the source with the
+  ///             switches.
+  ///
+  /// @param[in]  switches           The switches of the compilation.
+  /// @param[in]  source             The contents of the source file.
+  /// @param[in]  compiler_identity  A string that changes whenever the
+  ///                                compiler itself does.
+  ///
+  static std::string ComputeKey(const Switches& switches,
+                                const fml::Mapping& source,
+                                const std::string& compiler_identity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Identifies a build of the compiler by the contents of its
+  ///             executable.
+  ///
+  /// @param[in]  executable_path  The absolute path of the executable.
+  ///
+  /// @return     A hash of the executable, or nullopt if it can't be read.
+  ///
+  static std::optional<std::string> ComputeCompilerIdentity(
+      const std::string& executable_path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the entry for the key, or nullopt if there is none or
+  ///             one of its dependencies has changed since it was stored.
+  ///
+  std::optional<Entry> Load(const std::string& key) const;
+
+  bool Store(const std::string& key, const Entry& entry) const;
+
+ private:
+  std::shared_ptr<fml::UniqueFD> working_directory_;
+  fml::UniqueFD cache_directory_;
+
+  std::optional<std::string> HashDependency(const std::string& path) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShaderCache);
+};
+
+}  // namespace compiler
+}  // namespace impeller
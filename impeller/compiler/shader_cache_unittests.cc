@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/compiler/shader_cache.h"
+#include "impeller/compiler/switches.h"
+
+namespace impeller {
+namespace compiler {
+namespace testing {
+
+static Switches MakeSwitches(std::vector<std::string> additional_options = {}) {
+  std::vector<std::string> options = {"--opengl-desktop", "--input=input.vert",
+                                      "--sl=output.vert",
+                                      "--spirv=output.spirv"};
+  options.insert(options.end(), additional_options.begin(),
+                 additional_options.end());
+  auto cl = fml::CommandLineFromIteratorsWithArgv0("impellerc", options.begin(),
+                                                   options.end());
+  return Switches(cl);
+}
+
+static std::string ToString(const std::shared_ptr<fml::Mapping>& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+TEST(ShaderCacheTest, KeyDependsOnSourceSwitchesAndCompiler) {
+  const fml::DataMapping source(std::string("void main() {}"));
+  const fml::DataMapping other_source(std::string("void main() { }"));
+  const auto key = ShaderCache::ComputeKey(MakeSwitches(), source, "1");
+
+  ASSERT_EQ(key, ShaderCache::ComputeKey(MakeSwitches(), source, "1"));
+  ASSERT_NE(key, ShaderCache::ComputeKey(MakeSwitches(), other_source, "1"));
+  ASSERT_NE(key, ShaderCache::ComputeKey(MakeSwitches(), source, "2"));
+  ASSERT_NE(key, ShaderCache::ComputeKey(MakeSwitches({"--define=FOO"}),
+                                         source, "1"));
+  ASSERT_NE(key, ShaderCache::ComputeKey(MakeSwitches({"--iplr"}), source,
+                                         "1"));
+}
+
+TEST(ShaderCacheTest, CanStoreAndLoadEntries) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "include.glsl",
+                                   fml::DataMapping(std::string("// A"))));
+  auto working_directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(temp_dir.path().c_str(), false,
+                         fml::FilePermission::kRead));
+  ShaderCache cache(working_directory, temp_dir.path() + "/cache");
+  ASSERT_TRUE(cache.IsValid());
+
+  ASSERT_FALSE(cache.Load("key").has_value());
+
+  ShaderCache::Entry entry;
+  entry.dependencies = {"include.glsl"};
+  entry.outputs["sl"] =
+      std::make_shared<fml::DataMapping>(std::string("shader\nsource"));
+  entry.outputs["spirv"] = std::make_shared<fml::DataMapping>(std::string());
+  ASSERT_TRUE(cache.Store("key", entry));
+
+  auto loaded = cache.Load("key");
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_EQ(loaded->dependencies, entry.dependencies);
+  ASSERT_EQ(loaded->outputs.size(), 2u);
+  ASSERT_EQ(ToString(loaded->outputs["sl"]), "shader\nsource");
+  ASSERT_EQ(ToString(loaded->outputs["spirv"]), "");
+}
+
+TEST(ShaderCacheTest, EntriesAreInvalidatedByChangedDependencies) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "include.glsl",
+                                   fml::DataMapping(std::string("// A"))));
+  auto working_directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(temp_dir.path().c_str(), false,
+                         fml::FilePermission::kRead));
+  ShaderCache cache(working_directory, temp_dir.path() + "/cache");
+  ASSERT_TRUE(cache.IsValid());
+
+  ShaderCache::Entry entry;
+  entry.dependencies = {"include.glsl"};
+  entry.outputs["sl"] = std::make_shared<fml::DataMapping>(std::string("sl"));
+  ASSERT_TRUE(cache.Store("key", entry));
+  ASSERT_TRUE(cache.Load("key").has_value());
+
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "include.glsl",
+                                   fml::DataMapping(std::string("// B"))));
+  ASSERT_FALSE(cache.Load("key").has_value());
+
+  ASSERT_TRUE(fml::UnlinkFile(temp_dir.fd(), "include.glsl"));
+  ASSERT_FALSE(cache.Load("key").has_value());
+}
+
+TEST(ShaderCacheTest, CompilerIdentityDependsOnExecutableContents) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  const auto executable_path = temp_dir.path() + "/impellerc";
+  ASSERT_FALSE(
+      ShaderCache::ComputeCompilerIdentity(executable_path).has_value());
+
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "impellerc",
+                                   fml::DataMapping(std::string("A"))));
+  const auto identity = ShaderCache::ComputeCompilerIdentity(executable_path);
+  ASSERT_TRUE(identity.has_value());
+  EXPECT_EQ(ShaderCache::ComputeCompilerIdentity(executable_path), identity);
+
+  // A rebuild of the same size still changes the identity.
+  ASSERT_TRUE(fml::WriteAtomically(temp_dir.fd(), "impellerc",
+                                   fml::DataMapping(std::string("B"))));
+  EXPECT_NE(ShaderCache::ComputeCompilerIdentity(executable_path), identity);
+}
+
+}  // namespace testing
+}  // namespace compiler
+}  // namespace impeller
@@ -8,8 +8,10 @@
 #include <cctype>
 #include <filesystem>
 #include <map>
+#include <sstream>
 
 #include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/compiler/types.h"
 #include "impeller/compiler/utilities.h"
 
@@ -75,6 +77,15 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --use-half-textures (force openGL semantics when "
             "targeting metal)"
          << std::endl;
+  stream << "[optional] --cache-dir=<directory> (reuse the outputs of earlier "
+            "compilations with the same inputs)"
+         << std::endl;
+  stream << "[optional] --batch=<jobs_file> (compile every line of the file "
+            "as a separate set of arguments, in parallel)"
+         << std::endl;
+  stream << "[optional] --jobs=<count> (the number of parallel batch jobs; "
+            "default: the number of cores)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -136,7 +147,9 @@ Switches::Switches(const fml::CommandLine& command_line)
           command_line.GetOptionValueWithDefault("metal-version", "1.2")),
       entry_point(
           command_line.GetOptionValueWithDefault("entry-point", "main")),
-      use_half_textures(command_line.HasOption("use-half-textures")) {
+      use_half_textures(command_line.HasOption("use-half-textures")),
+      cache_directory(
+          command_line.GetOptionValueWithDefault("cache-dir", "")) {
   auto language =
       command_line.GetOptionValueWithDefault("source-language", "glsl");
   std::transform(language.begin(), language.end(), language.begin(),
@@ -226,5 +239,52 @@ bool Switches::AreValid(std::ostream& explain) const {
   return valid;
 }
 
+std::optional<std::vector<fml::CommandLine>> ReadBatchJobs(
+    const fml::CommandLine& command_line,
+    std::ostream& explain) {
+  std::string batch_file_name;
+  if (!command_line.GetOptionValue("batch", &batch_file_name) ||
+      batch_file_name.empty()) {
+    explain << "Batch file name was empty." << std::endl;
+    return std::nullopt;
+  }
+  auto batch_file = fml::FileMapping::CreateReadOnly(batch_file_name);
+  if (!batch_file) {
+    explain << "Could not open batch file: " << batch_file_name << std::endl;
+    return std::nullopt;
+  }
+
+  std::vector<std::string> shared_args;
+  for (const auto& option : command_line.options()) {
+    if (option.name == "batch" || option.name == "jobs") {
+      continue;
+    }
+    shared_args.push_back(option.value.empty()
+                              ? "--" + option.name
+                              : "--" + option.name + "=" + option.value);
+  }
+
+  std::vector<fml::CommandLine> jobs;
+  std::istringstream lines(
+      std::string(reinterpret_cast<const char*>(batch_file->GetMapping()),
+                  batch_file->GetSize()));
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::vector<std::string> args = shared_args;
+    std::istringstream line_args(line);
+    std::string arg;
+    const size_t shared_arg_count = args.size();
+    while (line_args >> arg) {
+      args.push_back(std::move(arg));
+    }
+    if (args.size() == shared_arg_count) {
+      continue;
+    }
+    jobs.push_back(fml::CommandLineFromIteratorsWithArgv0(
+        command_line.argv0(), args.begin(), args.end()));
+  }
+  return jobs;
+}
+
 }  // namespace compiler
 }  // namespace impeller
@@ -6,6 +6,8 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/macros.h"
@@ -37,6 +39,7 @@ struct Switches {
   std::string metal_version = "";
   std::string entry_point = "";
   bool use_half_textures = false;
+  std::string cache_directory = "";
 
   Switches();
 
@@ -49,5 +52,20 @@ struct Switches {
   static void PrintHelp(std::ostream& stream);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Reads the jobs of the file passed with `--batch`.
+///
+///             Each non-empty line of the file holds the arguments of one
+///             job, separated by whitespace. The other options of the
+///             command line are shared by every job, and are overridden by
+///             the options of a job.
+///
+/// @return     The command lines of the jobs, or nullopt if the file could not
+///             be read.
+///
+std::optional<std::vector<fml::CommandLine>> ReadBatchJobs(
+    const fml::CommandLine& command_line,
+    std::ostream& explain);
+
 }  // namespace compiler
 }  // namespace impeller
@@ -3,10 +3,12 @@
 // found in the LICENSE file.
 
 #include <initializer_list>
+#include <string>
 #include <vector>
 
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/testing/testing.h"
 #include "impeller/compiler/switches.h"
 #include "impeller/compiler/utilities.h"
@@ -69,6 +71,47 @@ TEST(SwitchesTest, EntryPointCanBeSetForHLSL) {
   ASSERT_EQ(switches.entry_point, "CustomEntryPoint");
 }
 
+TEST(SwitchesTest, BatchJobsShareOptionsAndCanOverrideThem) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto batch_file_name = temp_dir.path() + "/jobs.txt";
+  ASSERT_TRUE(fml::WriteAtomically(
+      temp_dir.fd(), "jobs.txt",
+      fml::DataMapping("--input=a.vert --sl=a.glsl --spirv=a.spirv\n"
+                       "\n"
+                       "--input=b.frag --sl=b.glsl --spirv=b.spirv "
+                       "--entry-point=other\n")));
+
+  std::vector<std::string> options = {"--opengl-desktop",
+                                      "--batch=" + batch_file_name,
+                                      "--jobs=2", "--entry-point=shared"};
+  auto command_line = fml::CommandLineFromIteratorsWithArgv0(
+      "impellerc", options.begin(), options.end());
+
+  auto jobs = ReadBatchJobs(command_line, std::cout);
+  ASSERT_TRUE(jobs.has_value());
+  ASSERT_EQ(jobs->size(), 2u);
+
+  Switches first((*jobs)[0]);
+  ASSERT_TRUE(first.AreValid(std::cout));
+  ASSERT_EQ(first.source_file_name, "a.vert");
+  ASSERT_EQ(first.target_platform, TargetPlatform::kOpenGLDesktop);
+  ASSERT_EQ(first.entry_point, "shared");
+  ASSERT_FALSE((*jobs)[0].HasOption("batch"));
+
+  Switches second((*jobs)[1]);
+  ASSERT_TRUE(second.AreValid(std::cout));
+  ASSERT_EQ(second.source_file_name, "b.frag");
+  ASSERT_EQ(second.entry_point, "other");
+}
+
+TEST(SwitchesTest, BatchJobsFailWithoutBatchFile) {
+  std::vector<std::string> options = {"--opengl-desktop",
+                                      "--batch=does_not_exist.txt"};
+  auto command_line = fml::CommandLineFromIteratorsWithArgv0(
+      "impellerc", options.begin(), options.end());
+  ASSERT_FALSE(ReadBatchJobs(command_line, std::cout).has_value());
+}
+
 TEST(SwitchesTEst, ConvertToEntrypointName) {
   ASSERT_EQ(ConvertToEntrypointName("mandelbrot_unrolled"),
             "mandelbrot_unrolled");
@@ -39,7 +39,7 @@ std::shared_ptr<Texture> DeviceBuffer::AsTexture(
   return texture;
 }
 
-void DeviceBuffer::Flush() {}
+void DeviceBuffer::Flush(std::optional<Range> range) {}
 
 const DeviceBufferDescriptor& DeviceBuffer::GetDeviceBufferDescriptor() const {
   return desc_;
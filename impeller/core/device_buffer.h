@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -32,7 +33,13 @@ class DeviceBuffer : public Buffer,
 
   BufferView AsBufferView() const;
 
-  virtual void Flush();
+  //----------------------------------------------------------------------------
+  /// @brief      Makes writes to the contents of the buffer visible to the
+  ///             device, which may be necessary if the memory is non-coherent.
+  ///
+  /// @param[in]  range  The range to flush, or the entire buffer if none.
+  ///
+  virtual void Flush(std::optional<Range> range = std::nullopt);
 
   virtual std::shared_ptr<Texture> AsTexture(
       Allocator& allocator,
@@ -108,6 +108,11 @@ enum class PixelFormat {
   // Depth and stencil formats.
   kS8UInt,
   kD32FloatS8UInt,
+  // Block compressed formats. These may only be sampled, and are only
+  // available when the capabilities of the context say so.
+  kETC2R8G8B8UNormInt,
+  kETC2R8G8B8A8UNormInt,
+  kASTC4x4UNormInt,
 };
 
 constexpr const char* PixelFormatToString(PixelFormat format) {
@@ -142,6 +147,12 @@ constexpr const char* PixelFormatToString(PixelFormat format) {
       return "S8UInt";
     case PixelFormat::kD32FloatS8UInt:
       return "D32FloatS8UInt";
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      return "ETC2R8G8B8UNormInt";
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return "ETC2R8G8B8A8UNormInt";
+    case PixelFormat::kASTC4x4UNormInt:
+      return "ASTC4x4UNormInt";
   }
   FML_UNREACHABLE();
 }
@@ -407,10 +418,59 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
       return 8u;
     case PixelFormat::kR32G32B32A32Float:
       return 16u;
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+      // Pixels of block compressed formats don't take up a whole number of
+      // bytes. See |BytesPerBlockForPixelFormat|.
+      return 0u;
   }
   return 0u;
 }
 
+constexpr bool PixelFormatIsBlockCompressed(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The size in pixels of the blocks that the format is stored in.
+///             Formats that aren't block compressed have 1x1 blocks.
+///
+constexpr ISize BlockSizeForPixelFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+      return ISize{4, 4};
+    default:
+      return ISize{1, 1};
+  }
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The number of bytes of each block of the format. This is the
+///             number of bytes per pixel for formats that aren't block
+///             compressed.
+///
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      return 8u;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
+      return 16u;
+    default:
+      return BytesPerPixelForPixelFormat(format);
+  }
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Describe the color attachment that will be used with this
 ///             pipeline.
@@ -16,10 +16,16 @@
 namespace impeller {
 
 std::shared_ptr<HostBuffer> HostBuffer::Create() {
-  return std::shared_ptr<HostBuffer>(new HostBuffer());
+  return std::shared_ptr<HostBuffer>(new HostBuffer(nullptr));
 }
 
-HostBuffer::HostBuffer() = default;
+std::shared_ptr<HostBuffer> HostBuffer::Create(
+    std::shared_ptr<TransientBufferRing> ring) {
+  return std::shared_ptr<HostBuffer>(new HostBuffer(std::move(ring)));
+}
+
+HostBuffer::HostBuffer(std::shared_ptr<TransientBufferRing> ring)
+    : ring_(std::move(ring)) {}
 
 HostBuffer::~HostBuffer() = default;
 
@@ -29,7 +35,16 @@ void HostBuffer::SetLabel(std::string label) {
 
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
-                               size_t align) {
+                               size_t align,
+                               TransientBufferRing::Usage usage) {
+  if (ring_) {
+    return ring_->Allocate(usage, length, align, [&](uint8_t* contents) {
+      if (buffer) {
+        ::memmove(contents, buffer, length);
+      }
+    });
+  }
+
   if (align == 0 || (GetLength() % align) == 0) {
     return Emplace(buffer, length);
   }
@@ -62,6 +77,10 @@ BufferView HostBuffer::Emplace(size_t length,
   if (!cb) {
     return {};
   }
+  if (ring_) {
+    return ring_->Allocate(TransientBufferRing::Usage::kVertex, length, align,
+                           cb);
+  }
   auto old_length = GetLength();
   if (!Truncate(old_length + length)) {
     return {};
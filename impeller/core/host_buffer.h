@@ -14,6 +14,7 @@
 #include "impeller/core/buffer.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/platform.h"
+#include "impeller/core/transient_buffer_ring.h"
 
 namespace impeller {
 
@@ -23,6 +24,17 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
  public:
   static std::shared_ptr<HostBuffer> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a host buffer that writes the emplaced data directly
+  ///             into device memory sub-allocated from the ring, instead of
+  ///             accumulating it in host memory. The returned buffer views
+  ///             reference device buffers of the ring.
+  ///
+  /// @param[in]  ring  The ring to allocate from.
+  ///
+  static std::shared_ptr<HostBuffer> Create(
+      std::shared_ptr<TransientBufferRing> ring);
+
   // |Buffer|
   virtual ~HostBuffer();
 
@@ -45,7 +57,8 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
         std::max(alignof(UniformType), DefaultUniformAlignment());
     return Emplace(reinterpret_cast<const void*>(&uniform),  // buffer
                    sizeof(UniformType),                      // size
-                   alignment                                 // alignment
+                   alignment,                                // alignment
+                   TransientBufferRing::Usage::kUniform      // usage
     );
   }
 
@@ -66,9 +79,10 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
       const StorageBufferType& buffer) {
     const auto alignment =
         std::max(alignof(StorageBufferType), DefaultUniformAlignment());
-    return Emplace(&buffer,                    // buffer
-                   sizeof(StorageBufferType),  // size
-                   alignment                   // alignment
+    return Emplace(&buffer,                              // buffer
+                   sizeof(StorageBufferType),            // size
+                   alignment,                            // alignment
+                   TransientBufferRing::Usage::kUniform  // usage
     );
   }
 
@@ -91,9 +105,11 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
     );
   }
 
-  [[nodiscard]] BufferView Emplace(const void* buffer,
-                                   size_t length,
-                                   size_t align);
+  [[nodiscard]] BufferView Emplace(
+      const void* buffer,
+      size_t length,
+      size_t align,
+      TransientBufferRing::Usage usage = TransientBufferRing::Usage::kVertex);
 
   using EmplaceProc = std::function<void(uint8_t* buffer)>;
 
@@ -112,6 +128,7 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
   BufferView Emplace(size_t length, size_t align, const EmplaceProc& cb);
 
  private:
+  const std::shared_ptr<TransientBufferRing> ring_;
   mutable std::shared_ptr<DeviceBuffer> device_buffer_;
   mutable size_t device_buffer_generation_ = 0u;
   size_t generation_ = 1u;
@@ -123,7 +140,7 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
-  HostBuffer();
+  explicit HostBuffer(std::shared_ptr<TransientBufferRing> ring);
 
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
 };
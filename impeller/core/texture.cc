@@ -46,6 +46,32 @@ bool Texture::SetContents(std::shared_ptr<const fml::Mapping> mapping,
   return true;
 }
 
+bool Texture::SetMipLevelContents(std::shared_ptr<const fml::Mapping> mapping,
+                                  size_t mip_level) {
+  if (desc_.type != TextureType::kTexture2D || mip_level == 0u ||
+      mip_level >= desc_.mip_count) {
+    VALIDATION_LOG << "Invalid mip level for texture.";
+    return false;
+  }
+  if (!mapping) {
+    return false;
+  }
+  if (!OnSetMipLevelContents(std::move(mapping), mip_level)) {
+    return false;
+  }
+  if (mip_level == desc_.mip_count - 1u) {
+    mipmap_generated_ = true;
+  }
+  return true;
+}
+
+bool Texture::OnSetMipLevelContents(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t mip_level) {
+  VALIDATION_LOG << "Setting the contents of mip levels is not supported.";
+  return false;
+}
+
 bool Texture::IsOpaque() const {
   return is_opaque_;
 }
@@ -29,6 +29,21 @@ class Texture {
                                  size_t slice = 0,
                                  bool is_opaque = false);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the contents of a mip level of a 2D texture other than
+  ///             the base level, which is set with |SetContents|.
+  ///
+  ///             Once the last level is set, the mipmap counts as generated.
+  ///             The other levels must have been set by then.
+  ///
+  /// @param[in]  mapping    The contents, in the layout of
+  ///                        |TextureDescriptor::GetByteSizeOfMipLevel|.
+  /// @param[in]  mip_level  The level, from 1 to the mip count - 1.
+  ///
+  [[nodiscard]] bool SetMipLevelContents(
+      std::shared_ptr<const fml::Mapping> mapping,
+      size_t mip_level);
+
   virtual bool IsValid() const = 0;
 
   virtual ISize GetSize() const = 0;
@@ -58,6 +73,12 @@ class Texture {
       std::shared_ptr<const fml::Mapping> mapping,
       size_t slice) = 0;
 
+  // Backends that can upload mip levels override this. The level has been
+  // checked to be valid.
+  [[nodiscard]] virtual bool OnSetMipLevelContents(
+      std::shared_ptr<const fml::Mapping> mapping,
+      size_t mip_level);
+
   bool mipmap_generated_ = false;
 
  private:
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <optional>
 
 #include "impeller/core/formats.h"
@@ -48,17 +49,39 @@ struct TextureDescriptor {
   CompressionType compression_type = CompressionType::kLossless;
 
   constexpr size_t GetByteSizeOfBaseMipLevel() const {
+    return GetByteSizeOfMipLevel(0u);
+  }
+
+  /// The number of bytes in a mip level, where 0 is the base level.
+  constexpr size_t GetByteSizeOfMipLevel(size_t mip_level) const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.Area() * BytesPerPixelForPixelFormat(format);
+    const auto block_size = BlockSizeForPixelFormat(format);
+    const size_t block_rows =
+        (GetMipLevelSize(mip_level).height + block_size.height - 1) /
+        block_size.height;
+    return block_rows * GetBytesPerRow(mip_level);
   }
 
-  constexpr size_t GetBytesPerRow() const {
+  /// The number of bytes in a row of pixels, or in a row of blocks for block
+  /// compressed formats, of a mip level.
+  constexpr size_t GetBytesPerRow(size_t mip_level = 0u) const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.width * BytesPerPixelForPixelFormat(format);
+    const auto block_size = BlockSizeForPixelFormat(format);
+    const size_t blocks_per_row =
+        (GetMipLevelSize(mip_level).width + block_size.width - 1) /
+        block_size.width;
+    return blocks_per_row * BytesPerBlockForPixelFormat(format);
+  }
+
+  /// The size of a mip level, where 0 is the base level. Each level is half
+  /// the size of the previous one, rounded down, but at least one pixel.
+  constexpr ISize GetMipLevelSize(size_t mip_level) const {
+    return ISize(std::max<int64_t>(size.width >> mip_level, 1),
+                 std::max<int64_t>(size.height >> mip_level, 1));
   }
 
   constexpr bool SamplingOptionsAreValid() const {
@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/transient_buffer_ring.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+
+namespace impeller {
+
+static constexpr size_t AlignOffset(size_t offset, size_t align) {
+  if (align == 0u) {
+    return offset;
+  }
+  return (offset + align - 1u) / align * align;
+}
+
+TransientBufferRing::TransientBufferRing(std::shared_ptr<Allocator> allocator)
+    : allocator_(std::move(allocator)) {
+  FML_DCHECK(allocator_);
+}
+
+TransientBufferRing::~TransientBufferRing() = default;
+
+BufferView TransientBufferRing::Allocate(Usage usage,
+                                         size_t length,
+                                         size_t align,
+                                         const WriteProc& cb) {
+  std::shared_ptr<DeviceBuffer> buffer;
+  uint8_t* contents = nullptr;
+  size_t offset = 0u;
+  if (length > kBlockSize) {
+    auto block = CreateBlock(length);
+    buffer = std::move(block.buffer);
+    contents = block.contents;
+  } else {
+    Lock lock(mutex_);
+    auto block = FindBlock(GetArena(usage), length, align);
+    if (block) {
+      offset = AlignOffset(block->offset, align);
+      block->offset = offset + length;
+      // The reference taken here keeps the block from being recycled while
+      // it is written.
+      buffer = block->buffer;
+      contents = block->contents;
+    }
+  }
+  if (!buffer) {
+    return {};
+  }
+
+  if (cb) {
+    cb(contents + offset);
+  }
+  buffer->Flush(Range{offset, length});
+  return BufferView{std::move(buffer), contents, Range{offset, length}};
+}
+
+size_t TransientBufferRing::GetBlockCount(Usage usage) const {
+  Lock lock(mutex_);
+  return usage == Usage::kUniform ? uniform_arena_.blocks.size()
+                                  : vertex_arena_.blocks.size();
+}
+
+TransientBufferRing::Arena& TransientBufferRing::GetArena(Usage usage) {
+  switch (usage) {
+    case Usage::kUniform:
+      return uniform_arena_;
+    case Usage::kVertex:
+      return vertex_arena_;
+  }
+  FML_UNREACHABLE();
+}
+
+TransientBufferRing::Block* TransientBufferRing::FindBlock(Arena& arena,
+                                                           size_t length,
+                                                           size_t align) {
+  auto& blocks = arena.blocks;
+  // The ring is walked starting with the current block, so that blocks are
+  // recycled in the order in which they were filled.
+  for (size_t i = 0; i < blocks.size(); i++) {
+    const size_t index = (arena.current + i) % blocks.size();
+    auto& block = blocks[index];
+    if (i == 0 && AlignOffset(block.offset, align) + length <= kBlockSize) {
+      return &block;
+    }
+    // Only the ring references the block, so the GPU is done reading it.
+    if (block.buffer.use_count() == 1) {
+      block.offset = 0u;
+      arena.current = index;
+      return &block;
+    }
+  }
+
+  auto block = CreateBlock(kBlockSize);
+  if (!block.buffer) {
+    return nullptr;
+  }
+  // The new block is inserted right after the current one, so that it is the
+  // last one to be recycled.
+  const size_t index = blocks.empty() ? 0u : arena.current + 1u;
+  blocks.insert(blocks.begin() + index, std::move(block));
+  arena.current = index;
+  return &blocks[index];
+}
+
+TransientBufferRing::Block TransientBufferRing::CreateBlock(size_t size) const {
+  TRACE_EVENT0("impeller", "TransientBufferRing::CreateBlock");
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = size;
+  auto buffer = allocator_->CreateBuffer(desc);
+  if (!buffer) {
+    VALIDATION_LOG << "Could not allocate a transients buffer block.";
+    return {};
+  }
+  auto contents = buffer->OnGetContents();
+  if (!contents) {
+    VALIDATION_LOG << "Could not map a transients buffer block.";
+    return {};
+  }
+  buffer->SetLabel("Transients Block");
+  return Block{std::move(buffer), contents, 0u};
+}
+
+}  // namespace impeller
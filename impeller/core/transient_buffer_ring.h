@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/core/buffer_view.h"
+
+namespace impeller {
+
+class Allocator;
+class DeviceBuffer;
+
+//------------------------------------------------------------------------------
+/// @brief      Sub-allocates the transient data of render and compute passes
+///             directly out of persistently mapped, host visible device
+///             buffers.
+///
+///             Data is written once, straight into the memory the GPU reads,
+///             instead of being accumulated in a host allocation that is then
+///             copied into a new device buffer for every pass.
+///
+///             Uniform data and vertex data are allocated from separate
+///             arenas, so that the padding required by uniform alignment
+///             does not spread vertex data out. Each arena is a ring of fixed
+///             size blocks. Allocations bump through the current block, and
+///             once it is full the arena moves on to the next block in the
+///             ring that is no longer in use.
+///
+///             A block is in use for as long as a buffer view or a command
+///             buffer references it. Backends that hand this ring out must
+///             track the buffers referenced by a command buffer until its
+///             fence has signaled, which is what makes recycling a block safe
+///             without explicit frame boundaries.
+///
+class TransientBufferRing {
+ public:
+  /// The size of the blocks of the arenas. Larger allocations get a device
+  /// buffer of their own.
+  static constexpr size_t kBlockSize = 1024u * 1024u;
+
+  enum class Usage {
+    kUniform,
+    kVertex,
+  };
+
+  using WriteProc = std::function<void(uint8_t* buffer)>;
+
+  explicit TransientBufferRing(std::shared_ptr<Allocator> allocator);
+
+  ~TransientBufferRing();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates space in the arena for the usage, and gives the
+  ///             caller a chance to write into it. The written range is
+  ///             flushed to the device once the callback returns.
+  ///
+  /// @param[in]  usage   The arena to allocate from.
+  /// @param[in]  length  The number of bytes to allocate.
+  /// @param[in]  align   The alignment of the allocation, or zero.
+  /// @param[in]  cb      The callback that writes the allocated bytes. May be
+  ///                     null, in which case the contents are undefined.
+  ///
+  /// @return     A view into a device buffer, or an invalid view if the
+  ///             device buffer could not be allocated.
+  ///
+  [[nodiscard]] BufferView Allocate(Usage usage,
+                                    size_t length,
+                                    size_t align,
+                                    const WriteProc& cb);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of blocks that have been allocated for the usage.
+  ///             Exposed for testing.
+  ///
+  size_t GetBlockCount(Usage usage) const;
+
+ private:
+  struct Block {
+    std::shared_ptr<DeviceBuffer> buffer;
+    uint8_t* contents = nullptr;
+    size_t offset = 0u;
+  };
+
+  struct Arena {
+    std::vector<Block> blocks;
+    size_t current = 0u;
+  };
+
+  const std::shared_ptr<Allocator> allocator_;
+  mutable Mutex mutex_;
+  Arena uniform_arena_ IPLR_GUARDED_BY(mutex_);
+  Arena vertex_arena_ IPLR_GUARDED_BY(mutex_);
+
+  Arena& GetArena(Usage usage) IPLR_REQUIRES(mutex_);
+
+  Block* FindBlock(Arena& arena, size_t length, size_t align)
+      IPLR_REQUIRES(mutex_);
+
+  Block CreateBlock(size_t size) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TransientBufferRing);
+};
+
+}  // namespace impeller
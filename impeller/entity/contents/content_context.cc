@@ -163,7 +163,10 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
       tessellator_(std::make_shared<Tessellator>()),
       alpha_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
       color_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
-      scene_context_(std::make_shared<scene::SceneContext>(context_)) {
+      scene_context_(std::make_shared<scene::SceneContext>(context_)),
+      render_target_cache_(context_ ? std::make_shared<RenderTargetCache>(
+                                          context_->GetResourceAllocator())
+                                    : nullptr) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -354,7 +357,8 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   RenderTarget subpass_target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA() && msaa_enabled) {
     subpass_target = RenderTarget::CreateOffscreenMSAA(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *render_target_cache_, texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfigMSAA  //
 #ifndef FML_OS_ANDROID  // Reduce PSO variants for Vulkan.
         ,
@@ -363,7 +367,8 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
     );
   } else {
     subpass_target = RenderTarget::CreateOffscreen(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *render_target_cache_, texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfig  //
 #ifndef FML_OS_ANDROID  // Reduce PSO variants for Vulkan.
         ,
@@ -407,6 +412,11 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+std::shared_ptr<RenderTargetCache> ContentContext::GetRenderTargetCache()
+    const {
+  return render_target_cache_;
+}
+
 std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext(
     GlyphAtlas::Type type) const {
   return type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_atlas_context_
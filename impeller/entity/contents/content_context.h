@@ -14,6 +14,7 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/scene/scene_context.h"
@@ -679,6 +680,12 @@ class ContentContext {
 
   std::shared_ptr<Context> GetContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The allocator for the textures of offscreen render targets,
+  ///             which recycles them across frames.
+  ///
+  std::shared_ptr<RenderTargetCache> GetRenderTargetCache() const;
+
   std::shared_ptr<GlyphAtlasContext> GetGlyphAtlasContext(
       GlyphAtlas::Type type) const;
 
@@ -853,6 +860,7 @@ class ContentContext {
   std::shared_ptr<GlyphAtlasContext> alpha_glyph_atlas_context_;
   std::shared_ptr<GlyphAtlasContext> color_glyph_atlas_context_;
   std::shared_ptr<scene::SceneContext> scene_context_;
+  std::shared_ptr<RenderTargetCache> render_target_cache_;
   bool wireframe_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
@@ -29,6 +29,89 @@ DirectionalGaussianBlurFilterContents::DirectionalGaussianBlurFilterContents() =
 DirectionalGaussianBlurFilterContents::
     ~DirectionalGaussianBlurFilterContents() = default;
 
+Scalar DirectionalGaussianBlurFilterContents::CalculateDownsampleFactor(
+    Scalar blur_radius) {
+  Scalar factor = 1;
+  while (blur_radius / (factor * 2) >= kMinDownsampledBlurRadius) {
+    factor *= 2;
+  }
+  return factor;
+}
+
+/// Halves the resolution of a snapshot along one of its texture axes. Every
+/// fragment samples the shared edge of two adjacent texels with a linear
+/// filter, which box filters them. Repeated calls produce the levels of a mip
+/// pyramid along that axis.
+static std::optional<Snapshot> DownsampleSnapshot(
+    const ContentContext& renderer,
+    const Snapshot& snapshot,
+    bool horizontal) {
+  using VS = TexturePipeline::VertexShader;
+  using FS = TexturePipeline::FragmentShader;
+
+  const auto size = snapshot.texture->GetSize();
+  const auto half_size = horizontal
+                             ? ISize((size.width + 1) / 2, size.height)
+                             : ISize(size.width, (size.height + 1) / 2);
+  // Each downsampled texel covers exactly two input texels. For odd sizes the
+  // last texel reaches half a texel past the input.
+  const auto scale = horizontal ? Vector2(2, 1) : Vector2(1, 2);
+  const auto uv_extent =
+      Point(half_size) * scale / Point(size.width, size.height);
+
+  auto sampler_descriptor = snapshot.sampler_descriptor;
+  sampler_descriptor.min_filter = MinMagFilter::kLinear;
+  sampler_descriptor.mag_filter = MinMagFilter::kLinear;
+
+  ContentContext::SubpassCallback callback = [&](const ContentContext& renderer,
+                                                 RenderPass& pass) {
+    auto& host_buffer = pass.GetTransientsBuffer();
+
+    VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+    vtx_builder.AddVertices({
+        {Point(0, 0), Point(0, 0)},
+        {Point(half_size.width, 0), Point(uv_extent.x, 0)},
+        {Point(0, half_size.height), Point(0, uv_extent.y)},
+        {Point(half_size), uv_extent},
+    });
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+    frame_info.texture_sampler_y_coord_scale =
+        snapshot.texture->GetYCoordScale();
+
+    FS::FragInfo frag_info;
+    frag_info.alpha = 1.0;
+
+    auto options = OptionsFromPass(pass);
+    options.blend_mode = BlendMode::kSource;
+    options.primitive_type = PrimitiveType::kTriangleStrip;
+
+    Command cmd;
+    cmd.label = "Gaussian Blur Downsample";
+    cmd.pipeline = renderer.GetTexturePipeline(options);
+    cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    FS::BindTextureSampler(
+        cmd, snapshot.texture,
+        renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+            sampler_descriptor));
+    return pass.AddCommand(std::move(cmd));
+  };
+
+  auto texture = renderer.MakeSubpass("Gaussian Blur Downsample", half_size,
+                                      callback, /*msaa_enabled=*/false);
+  if (!texture) {
+    return std::nullopt;
+  }
+  return Snapshot{
+      .texture = texture,
+      .transform = snapshot.transform * Matrix::MakeScale(scale),
+      .sampler_descriptor = snapshot.sampler_descriptor,
+      .opacity = snapshot.opacity};
+}
+
 void DirectionalGaussianBlurFilterContents::SetSigma(Sigma sigma) {
   blur_sigma_ = sigma;
 }
@@ -101,8 +184,7 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  // Limit the kernel size to 1000x1000 pixels, like Skia does.
-  auto radius = std::min(Radius{blur_sigma_}.radius, 500.0f);
+  auto radius = Radius{blur_sigma_}.radius;
 
   // Input 0 snapshot.
 
@@ -130,6 +212,21 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   auto transformed_blur_radius =
       transform.TransformDirection(blur_direction_ * radius);
 
+  // Blurs that are aligned with a texture axis of the input are downsampled
+  // (see below), which bounds the number of taps per fragment for any radius.
+  // Other blurs sample the input at full resolution, so their kernel is
+  // limited to 1000 texels, like Skia does.
+  {
+    auto texel_blur_radius = input_snapshot->transform.Invert()
+                                 .TransformDirection(transformed_blur_radius)
+                                 .Abs();
+    auto texel_radius = std::max(texel_blur_radius.x, texel_blur_radius.y);
+    auto cross_radius = std::min(texel_blur_radius.x, texel_blur_radius.y);
+    if (cross_radius >= 0.5 && texel_radius > kMaxFullResolutionBlurRadius) {
+      transformed_blur_radius *= kMaxFullResolutionBlurRadius / texel_radius;
+    }
+  }
+
   auto transformed_blur_radius_length = transformed_blur_radius.GetLength();
 
   // If the radius length is < .5, the shader will take at most 1 sample,
@@ -168,6 +265,36 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     pass_texture_rect = *maybe_pass_texture_rect;
   }
 
+  // Blurs with a large radius sample a copy of the input that has been
+  // downsampled along the blur direction, so that the number of taps per
+  // fragment stays bounded regardless of the blur radius. This is only done
+  // when the blur is aligned with a texture axis, as downsampling both axes
+  // would also blur the input perpendicular to the blur direction.
+
+  auto blur_input = input_snapshot.value();
+  // The distance in screen space between two taps of the kernel.
+  Scalar kernel_step = 1;
+  {
+    auto texel_blur_radius = input_snapshot->transform.Invert()
+                                 .TransformDirection(transformed_blur_radius)
+                                 .Abs();
+    bool horizontal = texel_blur_radius.x > texel_blur_radius.y;
+    auto texel_radius = std::max(texel_blur_radius.x, texel_blur_radius.y);
+    auto cross_radius = std::min(texel_blur_radius.x, texel_blur_radius.y);
+    auto factor = cross_radius < 0.5 ? CalculateDownsampleFactor(texel_radius)
+                                     : Scalar{1};
+    for (Scalar level = 1; level < factor; level *= 2) {
+      auto downsampled = DownsampleSnapshot(renderer, blur_input, horizontal);
+      if (!downsampled.has_value()) {
+        return std::nullopt;
+      }
+      blur_input = downsampled.value();
+    }
+    if (factor > 1) {
+      kernel_step = factor * transformed_blur_radius_length / texel_radius;
+    }
+  }
+
   // Source override snapshot.
 
   auto source = source_override_ ? source_override_ : inputs[0];
@@ -186,7 +313,7 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     return pass_texture_rect.GetTransformedPoints(uv_matrix);
   };
 
-  auto input_uvs = pass_uv_project(input_snapshot.value());
+  auto input_uvs = pass_uv_project(blur_input);
 
   auto source_uvs = pass_uv_project(source_snapshot.value());
 
@@ -213,19 +340,21 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     VS::FrameInfo frame_info;
     frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
     frame_info.texture_sampler_y_coord_scale =
-        input_snapshot->texture->GetYCoordScale();
+        blur_input.texture->GetYCoordScale();
     frame_info.alpha_mask_sampler_y_coord_scale =
         source_snapshot->texture->GetYCoordScale();
 
+    // The kernel is evaluated in units of kernel steps.
     FS::BlurInfo frag_info;
-    auto r = Radius{transformed_blur_radius_length};
-    frag_info.blur_sigma = Sigma{r}.sigma;
-    frag_info.blur_radius = std::round(r.radius);
+    Sigma sigma = Radius{transformed_blur_radius_length};
+    auto step_sigma = Sigma{sigma.sigma / kernel_step};
+    frag_info.blur_sigma = step_sigma.sigma;
+    frag_info.blur_radius = std::round(Radius{step_sigma}.radius);
 
     // The blur direction is in input UV space.
     frag_info.blur_uv_offset =
         pass_transform.Invert().TransformDirection(Vector2(1, 0)).Normalize() /
-        Point(input_snapshot->GetCoverage().value().size);
+        Point(input_snapshot->GetCoverage().value().size) * kernel_step;
 
     Command cmd;
     cmd.label = SPrintF("Gaussian Blur Filter (Radius=%.2f)",
@@ -234,7 +363,7 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
 
     auto options = OptionsFromPass(pass);
     options.blend_mode = BlendMode::kSource;
-    auto input_descriptor = input_snapshot->sampler_descriptor;
+    auto input_descriptor = blur_input.sampler_descriptor;
     auto source_descriptor = source_snapshot->sampler_descriptor;
     switch (tile_mode_) {
       case Entity::TileMode::kDecal:
@@ -284,7 +413,7 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     }
 
     FS::BindTextureSampler(
-        cmd, input_snapshot->texture,
+        cmd, blur_input.texture,
         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
             input_descriptor));
     VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
@@ -13,6 +13,26 @@ namespace impeller {
 
 class DirectionalGaussianBlurFilterContents final : public FilterContents {
  public:
+  /// Blurs are never downsampled below this radius, in texels of the
+  /// downsampled input. Downsampling further would visibly degrade quality.
+  static constexpr Scalar kMinDownsampledBlurRadius = 16;
+
+  /// Blurs that can't be downsampled are limited to this radius, in texels of
+  /// the input.
+  static constexpr Scalar kMaxFullResolutionBlurRadius = 500;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes how much the input of a blur is downsampled along
+  ///             the blur direction before the kernel is applied.
+  ///
+  /// @param[in]  blur_radius  The blur radius, in texels of the input.
+  ///
+  /// @return     A power of two, such that the radius in texels of the
+  ///             downsampled input is at least `kMinDownsampledBlurRadius`
+  ///             and less than twice that, or 1 for small radii.
+  ///
+  static Scalar CalculateDownsampleFactor(Scalar blur_radius);
+
   DirectionalGaussianBlurFilterContents();
 
   ~DirectionalGaussianBlurFilterContents() override;
@@ -0,0 +1,170 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
+#include "impeller/geometry/sigma.h"
+
+namespace impeller {
+namespace testing {
+
+using BlurContents = DirectionalGaussianBlurFilterContents;
+
+namespace {
+
+// Samples a row of texels with a linear filter and decal tiling. `position`
+// is in texels, with texel centers at `i + 0.5`.
+float SampleLinear(const std::vector<float>& texels, float position) {
+  auto texel = [&texels](int i) {
+    return i < 0 || i >= static_cast<int>(texels.size()) ? 0.0f : texels[i];
+  };
+  float x = position - 0.5f;
+  int left = static_cast<int>(std::floor(x));
+  float t = x - left;
+  return texel(left) * (1 - t) + texel(left + 1) * t;
+}
+
+// Mirrors the downsample pass: every output texel samples the shared edge of
+// two adjacent input texels.
+std::vector<float> Downsample(const std::vector<float>& texels) {
+  std::vector<float> result((texels.size() + 1) / 2);
+  for (size_t i = 0; i < result.size(); i++) {
+    result[i] = SampleLinear(texels, i * 2 + 1);
+  }
+  return result;
+}
+
+// Mirrors RenderFilter and the blur shader for a horizontal blur of a row of
+// `texels` that is drawn untransformed. Returns one value per output pixel,
+// including the blur radius on either side of the input.
+std::vector<float> RenderBlur(const std::vector<float>& texels,
+                              Scalar blur_radius,
+                              bool allow_downsampling) {
+  Scalar factor = allow_downsampling
+                      ? BlurContents::CalculateDownsampleFactor(blur_radius)
+                      : 1;
+  auto input = texels;
+  for (Scalar level = 1; level < factor; level *= 2) {
+    input = Downsample(input);
+  }
+  Scalar kernel_step = factor;
+
+  Sigma sigma = Radius{blur_radius};
+  auto step_sigma = Sigma{sigma.sigma / kernel_step};
+  auto kernel_radius = std::round(Radius{step_sigma}.radius);
+
+  auto padding = static_cast<int>(std::ceil(blur_radius));
+  std::vector<float> result(texels.size() + padding * 2);
+  for (size_t i = 0; i < result.size(); i++) {
+    Scalar center = static_cast<Scalar>(i) - padding + 0.5f;
+    float total = 0;
+    float integral = 0;
+    for (Scalar tap = -kernel_radius; tap <= kernel_radius; tap += 2) {
+      float gaussian =
+          std::exp(-0.5f * tap * tap / (step_sigma.sigma * step_sigma.sigma));
+      integral += gaussian;
+      total += gaussian *
+               SampleLinear(input, (center + tap * kernel_step) / factor);
+    }
+    result[i] = total / integral;
+  }
+  return result;
+}
+
+// Applies the same truncated kernel as the blur shader, but to every texel of
+// the input.
+std::vector<float> RenderReferenceBlur(const std::vector<float>& texels,
+                                       Scalar blur_radius) {
+  Sigma sigma = Radius{blur_radius};
+  auto kernel_radius = static_cast<int>(std::round(Radius{sigma}.radius));
+
+  auto padding = static_cast<int>(std::ceil(blur_radius));
+  std::vector<float> result(texels.size() + padding * 2);
+  for (size_t i = 0; i < result.size(); i++) {
+    float total = 0;
+    float integral = 0;
+    for (int tap = -kernel_radius; tap <= kernel_radius; tap++) {
+      float gaussian =
+          std::exp(-0.5f * tap * tap / (sigma.sigma * sigma.sigma));
+      integral += gaussian;
+      int texel = static_cast<int>(i) - padding + tap;
+      if (texel >= 0 && texel < static_cast<int>(texels.size())) {
+        total += gaussian * texels[texel];
+      }
+    }
+    result[i] = total / integral;
+  }
+  return result;
+}
+
+float MaxError(const std::vector<float>& actual,
+               const std::vector<float>& expected) {
+  float max_error = 0;
+  for (size_t i = 0; i < actual.size(); i++) {
+    max_error = std::max(max_error, std::abs(actual[i] - expected[i]));
+  }
+  return max_error;
+}
+
+}  // namespace
+
+TEST(GaussianBlurFilterContentsTest, SmallBlursAreNotDownsampled) {
+  EXPECT_EQ(BlurContents::CalculateDownsampleFactor(0), 1);
+  EXPECT_EQ(BlurContents::CalculateDownsampleFactor(1), 1);
+  EXPECT_EQ(BlurContents::CalculateDownsampleFactor(
+                BlurContents::kMinDownsampledBlurRadius * 2 - 1),
+            1);
+}
+
+TEST(GaussianBlurFilterContentsTest, DownsampleFactorIsPowerOfTwo) {
+  EXPECT_EQ(BlurContents::CalculateDownsampleFactor(
+                BlurContents::kMinDownsampledBlurRadius * 2),
+            2);
+  EXPECT_EQ(BlurContents::CalculateDownsampleFactor(100), 4);
+  EXPECT_EQ(BlurContents::CalculateDownsampleFactor(500), 16);
+}
+
+TEST(GaussianBlurFilterContentsTest, DownsampledRadiusStaysWithinBounds) {
+  for (Scalar radius = 1; radius < 5000; radius *= 1.1) {
+    auto factor = BlurContents::CalculateDownsampleFactor(radius);
+    auto downsampled_radius = radius / factor;
+    EXPECT_LT(downsampled_radius, BlurContents::kMinDownsampledBlurRadius * 2);
+    if (factor > 1) {
+      EXPECT_GE(downsampled_radius, BlurContents::kMinDownsampledBlurRadius);
+    }
+  }
+}
+
+TEST(GaussianBlurFilterContentsTest, DownsampledBlurMatchesFullResolution) {
+  // A hard edged bar is the worst case for the box filter of the downsample
+  // passes.
+  std::vector<float> texels(301);
+  for (size_t i = 100; i < 200; i++) {
+    texels[i] = 1;
+  }
+  for (Scalar radius : {32.0f, 50.0f, 100.0f, 333.0f, 1000.0f}) {
+    ASSERT_GT(BlurContents::CalculateDownsampleFactor(radius), 1);
+    auto expected = RenderReferenceBlur(texels, radius);
+    auto full_resolution =
+        RenderBlur(texels, radius, /*allow_downsampling=*/false);
+    auto downsampled = RenderBlur(texels, radius, /*allow_downsampling=*/true);
+    ASSERT_EQ(full_resolution.size(), expected.size());
+    ASSERT_EQ(downsampled.size(), expected.size());
+    // The full resolution path only takes every other texel, so neither path
+    // matches the reference exactly. Both stay within five steps of an 8 bit
+    // color channel.
+    EXPECT_LT(MaxError(full_resolution, expected), 5.0f / 255)
+        << "Blur radius " << radius;
+    EXPECT_LT(MaxError(downsampled, expected), 5.0f / 255)
+        << "Blur radius " << radius;
+  }
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/texture.h"
+
+namespace impeller {
+
+static bool IsCompatible(const TextureDescriptor& a,
+                         const TextureDescriptor& b) {
+  return a.storage_mode == b.storage_mode &&  //
+         a.type == b.type &&                  //
+         a.format == b.format &&              //
+         a.size == b.size &&                  //
+         a.mip_count == b.mip_count &&        //
+         a.usage == b.usage &&                //
+         a.sample_count == b.sample_count &&  //
+         a.compression_type == b.compression_type;
+}
+
+static size_t GetTextureByteSize(const TextureDescriptor& desc) {
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_idle_frames)
+    : RenderTargetAllocator(std::move(allocator)),
+      max_idle_frames_(max_idle_frames) {}
+
+RenderTargetCache::~RenderTargetCache() = default;
+
+std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
+    const TextureDescriptor& desc) {
+  for (auto& cached : textures_) {
+    // Only the cache references the texture, so any render pass that used it
+    // has either been encoded already or has been discarded.
+    if (cached.texture.use_count() == 1 && IsCompatible(cached.desc, desc)) {
+      cached.used_this_frame = true;
+      metrics_.reused_count++;
+      return cached.texture;
+    }
+  }
+
+  auto texture = RenderTargetAllocator::CreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+  textures_.push_back(CachedTexture{desc, texture, 0u, true});
+  metrics_.created_count++;
+  metrics_.pooled_bytes += GetTextureByteSize(desc);
+  metrics_.pooled_bytes_high_water_mark =
+      std::max(metrics_.pooled_bytes_high_water_mark, metrics_.pooled_bytes);
+  return texture;
+}
+
+void RenderTargetCache::Start() {
+  for (auto& cached : textures_) {
+    cached.used_this_frame = false;
+  }
+}
+
+void RenderTargetCache::End() {
+  for (auto it = textures_.begin(); it != textures_.end();) {
+    it->idle_frames = it->used_this_frame ? 0u : it->idle_frames + 1u;
+    // Textures that are still referenced may be read by a pass that has not
+    // been encoded yet, and are kept until the next frame.
+    if (it->idle_frames > max_idle_frames_ && it->texture.use_count() == 1) {
+      metrics_.pooled_bytes -= GetTextureByteSize(it->desc);
+      metrics_.evicted_count++;
+      it = textures_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  TraceMetricsToTimeline();
+}
+
+size_t RenderTargetCache::GetCachedTextureCount() const {
+  return textures_.size();
+}
+
+const RenderTargetCache::Metrics& RenderTargetCache::GetMetrics() const {
+  return metrics_;
+}
+
+void RenderTargetCache::TraceMetricsToTimeline() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("impeller",                                           //
+                    "RenderTargetCache",                                  //
+                    reinterpret_cast<int64_t>(this),                      //
+                    "CachedCount", textures_.size(),                      //
+                    "PooledBytes", metrics_.pooled_bytes,                 //
+                    "HighWaterMark",                                      //
+                    metrics_.pooled_bytes_high_water_mark,                //
+                    "ReusedCount", metrics_.reused_count,                 //
+                    "CreatedCount", metrics_.created_count,               //
+                    "EvictedCount", metrics_.evicted_count);
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace impeller
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render target allocator that recycles the textures of
+///             offscreen render targets across frames.
+///
+///             Entity passes and filters create offscreen render targets for
+///             every save layer and every filter input, and the same
+///             attachments tend to be requested again in the next frame. Once
+///             a texture is no longer referenced outside of the cache, a
+///             request for a texture with an identical descriptor is served
+///             from the cache instead of the device allocator.
+///
+///             Textures are keyed by their full descriptor (size, format,
+///             sample count, usage, storage mode). Sizes are not rounded up
+///             to buckets, because render target sizes are used as viewports
+///             and to compute texture coordinates throughout the entity
+///             framework.
+///
+///             Textures that were not used for more than the configured
+///             number of frames are released in |End|.
+///
+class RenderTargetCache : public RenderTargetAllocator {
+ public:
+  static constexpr size_t kDefaultMaxIdleFrames = 2u;
+
+  struct Metrics {
+    /// The number of textures served from the cache.
+    size_t reused_count = 0u;
+    /// The number of textures that had to be created by the allocator.
+    size_t created_count = 0u;
+    /// The number of textures released after being idle.
+    size_t evicted_count = 0u;
+    /// The number of bytes of all textures held by the cache.
+    size_t pooled_bytes = 0u;
+    /// The largest value |pooled_bytes| has had.
+    size_t pooled_bytes_high_water_mark = 0u;
+  };
+
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t max_idle_frames = kDefaultMaxIdleFrames);
+
+  ~RenderTargetCache() override;
+
+  // |RenderTargetAllocator|
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc) override;
+
+  // |RenderTargetAllocator|
+  void Start() override;
+
+  // |RenderTargetAllocator|
+  void End() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of textures held by the cache, whether they are
+  ///             in use or not.
+  ///
+  size_t GetCachedTextureCount() const;
+
+  const Metrics& GetMetrics() const;
+
+ private:
+  struct CachedTexture {
+    TextureDescriptor desc;
+    std::shared_ptr<Texture> texture;
+    size_t idle_frames = 0u;
+    bool used_this_frame = false;
+  };
+
+  const size_t max_idle_frames_;
+  std::vector<CachedTexture> textures_;
+  Metrics metrics_;
+
+  void TraceMetricsToTimeline() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
+};
+
+}  // namespace impeller
@@ -0,0 +1,198 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/render_target_cache.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestTexture : public Texture {
+ public:
+  explicit TestTexture(const TextureDescriptor& desc) : Texture(desc) {}
+
+  void SetLabel(std::string_view label) override {}
+
+  bool IsValid() const override { return true; }
+
+  ISize GetSize() const override { return GetTextureDescriptor().size; }
+
+ private:
+  bool OnSetContents(const uint8_t* contents,
+                     size_t length,
+                     size_t slice) override {
+    return false;
+  }
+
+  bool OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
+                     size_t slice) override {
+    return false;
+  }
+};
+
+class TestAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override { return {1024, 1024}; }
+
+  size_t GetCreatedTextureCount() const { return created_texture_count_; }
+
+ private:
+  size_t created_texture_count_ = 0u;
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    created_texture_count_++;
+    return std::make_shared<TestTexture>(desc);
+  }
+};
+
+TextureDescriptor CreateColorDescriptor(ISize size) {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = size;
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget) |
+               static_cast<TextureUsageMask>(TextureUsage::kShaderRead);
+  return desc;
+}
+
+}  // namespace
+
+TEST(RenderTargetCacheTest, ReusesTexturesThatAreNoLongerReferenced) {
+  auto allocator = std::make_shared<TestAllocator>();
+  RenderTargetCache cache(allocator);
+  const auto desc = CreateColorDescriptor({100, 100});
+
+  for (int frame = 0; frame < 3; frame++) {
+    cache.Start();
+    auto first = cache.CreateTexture(desc);
+    // The first texture is still referenced, so a second one is created.
+    auto second = cache.CreateTexture(desc);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+    cache.End();
+  }
+
+  EXPECT_EQ(allocator->GetCreatedTextureCount(), 2u);
+  EXPECT_EQ(cache.GetCachedTextureCount(), 2u);
+  EXPECT_EQ(cache.GetMetrics().reused_count, 4u);
+  EXPECT_EQ(cache.GetMetrics().created_count, 2u);
+}
+
+TEST(RenderTargetCacheTest, ReusesTexturesWithinAFrame) {
+  auto allocator = std::make_shared<TestAllocator>();
+  RenderTargetCache cache(allocator);
+  const auto desc = CreateColorDescriptor({100, 100});
+
+  cache.Start();
+  const Texture* first = cache.CreateTexture(desc).get();
+  const Texture* second = cache.CreateTexture(desc).get();
+  cache.End();
+
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(allocator->GetCreatedTextureCount(), 1u);
+}
+
+TEST(RenderTargetCacheTest, DoesNotReuseIncompatibleTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  RenderTargetCache cache(allocator);
+  const auto desc = CreateColorDescriptor({100, 100});
+
+  auto other_size = desc;
+  other_size.size = {100, 101};
+  auto other_format = desc;
+  other_format.format = PixelFormat::kB8G8R8A8UNormInt;
+  auto other_usage = desc;
+  other_usage.usage =
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  auto other_sample_count = desc;
+  other_sample_count.type = TextureType::kTexture2DMultisample;
+  other_sample_count.sample_count = SampleCount::kCount4;
+
+  cache.Start();
+  cache.CreateTexture(desc);
+  cache.CreateTexture(other_size);
+  cache.CreateTexture(other_format);
+  cache.CreateTexture(other_usage);
+  cache.CreateTexture(other_sample_count);
+  cache.End();
+
+  EXPECT_EQ(allocator->GetCreatedTextureCount(), 5u);
+  EXPECT_EQ(cache.GetMetrics().reused_count, 0u);
+}
+
+TEST(RenderTargetCacheTest, EvictsTexturesAfterIdleFrames) {
+  auto allocator = std::make_shared<TestAllocator>();
+  RenderTargetCache cache(allocator, /*max_idle_frames=*/1u);
+  const auto desc = CreateColorDescriptor({100, 100});
+
+  cache.Start();
+  cache.CreateTexture(desc);
+  cache.End();
+  EXPECT_EQ(cache.GetCachedTextureCount(), 1u);
+
+  cache.Start();
+  cache.End();
+  EXPECT_EQ(cache.GetCachedTextureCount(), 1u);
+
+  cache.Start();
+  cache.End();
+  EXPECT_EQ(cache.GetCachedTextureCount(), 0u);
+  EXPECT_EQ(cache.GetMetrics().evicted_count, 1u);
+  EXPECT_EQ(cache.GetMetrics().pooled_bytes, 0u);
+}
+
+TEST(RenderTargetCacheTest, DoesNotEvictReferencedTextures) {
+  auto allocator = std::make_shared<TestAllocator>();
+  RenderTargetCache cache(allocator, /*max_idle_frames=*/0u);
+  const auto desc = CreateColorDescriptor({100, 100});
+
+  cache.Start();
+  auto texture = cache.CreateTexture(desc);
+  cache.End();
+  cache.Start();
+  cache.End();
+  EXPECT_EQ(cache.GetCachedTextureCount(), 1u);
+
+  texture.reset();
+  cache.Start();
+  cache.End();
+  EXPECT_EQ(cache.GetCachedTextureCount(), 0u);
+}
+
+TEST(RenderTargetCacheTest, TracksPooledBytesHighWaterMark) {
+  auto allocator = std::make_shared<TestAllocator>();
+  RenderTargetCache cache(allocator, /*max_idle_frames=*/0u);
+  auto msaa_desc = CreateColorDescriptor({10, 10});
+  msaa_desc.type = TextureType::kTexture2DMultisample;
+  msaa_desc.sample_count = SampleCount::kCount4;
+
+  cache.Start();
+  auto color = cache.CreateTexture(CreateColorDescriptor({10, 10}));
+  auto msaa = cache.CreateTexture(msaa_desc);
+  EXPECT_EQ(cache.GetMetrics().pooled_bytes, 400u + 1600u);
+  color.reset();
+  msaa.reset();
+  cache.End();
+
+  cache.Start();
+  cache.End();
+  EXPECT_EQ(cache.GetMetrics().pooled_bytes, 0u);
+  EXPECT_EQ(cache.GetMetrics().pooled_bytes_high_water_mark, 2000u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,306 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/image/backends/ktx2/compressed_image_ktx2.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <optional>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/image/backends/ktx2/etc2_decoder.h"
+
+namespace impeller {
+
+static constexpr uint8_t kKTX2Identifier[] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+};
+
+// The offsets of the fields of the header that follows the identifier, and of
+// the level index that follows the header.
+static constexpr size_t kVkFormatOffset = 12u;
+static constexpr size_t kPixelWidthOffset = 20u;
+static constexpr size_t kPixelHeightOffset = 24u;
+static constexpr size_t kPixelDepthOffset = 28u;
+static constexpr size_t kLayerCountOffset = 32u;
+static constexpr size_t kFaceCountOffset = 36u;
+static constexpr size_t kLevelCountOffset = 40u;
+static constexpr size_t kSupercompressionSchemeOffset = 44u;
+static constexpr size_t kLevelIndexOffset = 80u;
+static constexpr size_t kLevelIndexEntrySize = 24u;
+
+/// The number of rows of blocks transcoded by each task of a parallel decode.
+static constexpr size_t kBlockRowsPerTask = 16u;
+
+/// @brief  Reads a little endian integer, which is how KTX2 stores them.
+template <class T>
+static T ReadField(const uint8_t* data, size_t offset) {
+  T value;
+  std::memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+static std::optional<CompressedImageKTX2::Format> ToFormat(uint32_t vk_format) {
+  // The values are those of VkFormat.
+  switch (vk_format) {
+    case 37u:  // VK_FORMAT_R8G8B8A8_UNORM
+    case 43u:  // VK_FORMAT_R8G8B8A8_SRGB
+      return CompressedImageKTX2::Format::kR8G8B8A8;
+    case 147u:  // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+    case 148u:  // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+      return CompressedImageKTX2::Format::kETC2R8G8B8;
+    case 151u:  // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+    case 152u:  // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+      return CompressedImageKTX2::Format::kETC2R8G8B8A8;
+    case 157u:  // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+    case 158u:  // VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+      return CompressedImageKTX2::Format::kASTC4x4;
+  }
+  return std::nullopt;
+}
+
+/// @brief  Returns the width and height of the blocks of the format.
+static size_t BlockDimension(CompressedImageKTX2::Format format) {
+  switch (format) {
+    case CompressedImageKTX2::Format::kR8G8B8A8:
+      return 1u;
+    case CompressedImageKTX2::Format::kETC2R8G8B8:
+    case CompressedImageKTX2::Format::kETC2R8G8B8A8:
+    case CompressedImageKTX2::Format::kASTC4x4:
+      return 4u;
+  }
+  FML_UNREACHABLE();
+}
+
+static size_t BytesPerBlock(CompressedImageKTX2::Format format) {
+  switch (format) {
+    case CompressedImageKTX2::Format::kR8G8B8A8:
+      return 4u;
+    case CompressedImageKTX2::Format::kETC2R8G8B8:
+      return 8u;
+    case CompressedImageKTX2::Format::kETC2R8G8B8A8:
+    case CompressedImageKTX2::Format::kASTC4x4:
+      return 16u;
+  }
+  FML_UNREACHABLE();
+}
+
+/// @brief  Returns the number of bytes of a level of the size in the format.
+static size_t LevelByteSize(ISize size, CompressedImageKTX2::Format format) {
+  const size_t block = BlockDimension(format);
+  const size_t blocks_wide = (size.width + block - 1u) / block;
+  const size_t blocks_high = (size.height + block - 1u) / block;
+  return blocks_wide * blocks_high * BytesPerBlock(format);
+}
+
+bool CompressedImageKTX2::IsKTX2(const fml::Mapping& allocation) {
+  return allocation.GetMapping() != nullptr &&
+         allocation.GetSize() >= sizeof(kKTX2Identifier) &&
+         std::memcmp(allocation.GetMapping(), kKTX2Identifier,
+                     sizeof(kKTX2Identifier)) == 0;
+}
+
+std::shared_ptr<CompressedImageKTX2> CompressedImageKTX2::Create(
+    std::shared_ptr<const fml::Mapping> allocation) {
+  if (!allocation || !IsKTX2(*allocation) ||
+      allocation->GetSize() < kLevelIndexOffset) {
+    return nullptr;
+  }
+  const uint8_t* data = allocation->GetMapping();
+  const size_t data_size = allocation->GetSize();
+
+  const auto format = ToFormat(ReadField<uint32_t>(data, kVkFormatOffset));
+  if (!format.has_value()) {
+    VALIDATION_LOG << "Unsupported KTX2 image format.";
+    return nullptr;
+  }
+  if (ReadField<uint32_t>(data, kSupercompressionSchemeOffset) != 0u) {
+    VALIDATION_LOG << "Supercompressed KTX2 images are not supported.";
+    return nullptr;
+  }
+  const uint32_t width = ReadField<uint32_t>(data, kPixelWidthOffset);
+  const uint32_t height = ReadField<uint32_t>(data, kPixelHeightOffset);
+  if (width == 0u || height == 0u ||
+      ReadField<uint32_t>(data, kPixelDepthOffset) != 0u ||
+      ReadField<uint32_t>(data, kLayerCountOffset) > 1u ||
+      ReadField<uint32_t>(data, kFaceCountOffset) != 1u) {
+    VALIDATION_LOG << "Only 2D KTX2 images are supported.";
+    return nullptr;
+  }
+  const ISize size(width, height);
+
+  // A level count of zero asks for the mips to be generated at runtime.
+  const size_t level_count =
+      std::max(ReadField<uint32_t>(data, kLevelCountOffset), 1u);
+  size_t max_level_count = 1u;
+  for (auto extent = std::max(width, height); extent > 1u; extent >>= 1) {
+    max_level_count++;
+  }
+  if (level_count > max_level_count ||
+      (data_size - kLevelIndexOffset) / kLevelIndexEntrySize < level_count) {
+    VALIDATION_LOG << "Invalid KTX2 level index.";
+    return nullptr;
+  }
+
+  std::vector<Level> levels;
+  levels.reserve(level_count);
+  for (size_t i = 0; i < level_count; i++) {
+    const size_t entry = kLevelIndexOffset + i * kLevelIndexEntrySize;
+    const uint64_t offset = ReadField<uint64_t>(data, entry);
+    const uint64_t length = ReadField<uint64_t>(data, entry + 8u);
+    const ISize level_size(std::max<int64_t>(size.width >> i, 1),
+                           std::max<int64_t>(size.height >> i, 1));
+    // Without supercompression, the length of a level is exactly that of its
+    // blocks.
+    if (offset > data_size || length > data_size - offset ||
+        length != LevelByteSize(level_size, format.value())) {
+      VALIDATION_LOG << "KTX2 level " << i << " is out of bounds.";
+      return nullptr;
+    }
+    levels.push_back(
+        {static_cast<size_t>(offset), static_cast<size_t>(length)});
+  }
+
+  return std::shared_ptr<CompressedImageKTX2>(new CompressedImageKTX2(
+      std::move(allocation), size, format.value(), std::move(levels)));
+}
+
+CompressedImageKTX2::CompressedImageKTX2(
+    std::shared_ptr<const fml::Mapping> allocation,
+    ISize size,
+    Format format,
+    std::vector<Level> levels)
+    : CompressedImage(std::move(allocation)),
+      size_(size),
+      format_(format),
+      levels_(std::move(levels)) {}
+
+CompressedImageKTX2::~CompressedImageKTX2() = default;
+
+const ISize& CompressedImageKTX2::GetSize() const {
+  return size_;
+}
+
+CompressedImageKTX2::Format CompressedImageKTX2::GetFormat() const {
+  return format_;
+}
+
+size_t CompressedImageKTX2::GetMipCount() const {
+  return levels_.size();
+}
+
+std::shared_ptr<fml::Mapping> CompressedImageKTX2::GetMipLevel(
+    size_t level) const {
+  if (level >= levels_.size()) {
+    return nullptr;
+  }
+  // The mapping keeps the allocation of the image alive.
+  return std::make_shared<fml::NonOwnedMapping>(
+      source_->GetMapping() + levels_[level].offset,           // data
+      levels_[level].length,                                   // size
+      [source = source_](const uint8_t* data, size_t size) {}  // proc
+  );
+}
+
+// |CompressedImage|
+DecompressedImage CompressedImageKTX2::Decode() const {
+  return Decode(nullptr);
+}
+
+DecompressedImage CompressedImageKTX2::Decode(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner)
+    const {
+  if (!IsValid() || levels_.empty()) {
+    return {};
+  }
+
+  void (*decode_block)(const uint8_t*, uint8_t*, size_t) = nullptr;
+  switch (format_) {
+    case Format::kR8G8B8A8:
+      return {size_, DecompressedImage::Format::kRGBA, GetMipLevel(0u)};
+    case Format::kETC2R8G8B8:
+      decode_block = DecodeETC2RGB8Block;
+      break;
+    case Format::kETC2R8G8B8A8:
+      decode_block = DecodeETC2RGBA8Block;
+      break;
+    case Format::kASTC4x4:
+      VALIDATION_LOG << "ASTC images can't be decoded on the CPU.";
+      return {};
+  }
+
+  TRACE_EVENT0("impeller", "CompressedImageKTX2::Decode");
+  const size_t width = size_.width;
+  const size_t height = size_.height;
+  const size_t row_stride = width * 4u;
+  const size_t bytes_per_block = BytesPerBlock(format_);
+  const size_t blocks_wide =
+      (width + kETC2BlockDimension - 1u) / kETC2BlockDimension;
+  const size_t blocks_high =
+      (height + kETC2BlockDimension - 1u) / kETC2BlockDimension;
+  const uint8_t* blocks = source_->GetMapping() + levels_[0].offset;
+  std::vector<uint8_t> pixels(row_stride * height);
+
+  auto decode_block_rows = [&](size_t first_row, size_t end_row) {
+    uint8_t block_pixels[kETC2BlockDimension * kETC2BlockDimension * 4u];
+    const size_t block_stride = kETC2BlockDimension * 4u;
+    for (size_t block_y = first_row; block_y < end_row; block_y++) {
+      for (size_t block_x = 0; block_x < blocks_wide; block_x++) {
+        decode_block(
+            blocks + (block_y * blocks_wide + block_x) * bytes_per_block,
+            block_pixels, block_stride);
+        // Blocks on the right and bottom edges may hang off of the image.
+        const size_t x = block_x * kETC2BlockDimension;
+        const size_t y = block_y * kETC2BlockDimension;
+        const size_t columns = std::min(kETC2BlockDimension, width - x);
+        const size_t rows = std::min(kETC2BlockDimension, height - y);
+        for (size_t row = 0; row < rows; row++) {
+          std::memcpy(pixels.data() + (y + row) * row_stride + x * 4u,
+                      block_pixels + row * block_stride, columns * 4u);
+        }
+      }
+    }
+  };
+
+  const size_t task_count =
+      (blocks_high + kBlockRowsPerTask - 1u) / kBlockRowsPerTask;
+  if (!worker_task_runner || task_count < 2u) {
+    decode_block_rows(0u, blocks_high);
+  } else {
+    // Tasks are claimed by the workers and by the calling thread alike, and
+    // the calling thread only waits for tasks that a worker has claimed. So
+    // the decode finishes even if all workers are busy, or if it is called
+    // from one of them. Workers that only start once every task is claimed
+    // return without touching the image.
+    struct Tasks {
+      explicit Tasks(size_t count) : remaining(count) {}
+      std::atomic<size_t> next = 0u;
+      fml::CountDownLatch remaining;
+    };
+    auto tasks = std::make_shared<Tasks>(task_count);
+    auto run_tasks = [decode_block_rows = &decode_block_rows, task_count,
+                      blocks_high](Tasks& tasks) {
+      for (size_t i = tasks.next++; i < task_count; i = tasks.next++) {
+        const size_t first_row = i * kBlockRowsPerTask;
+        (*decode_block_rows)(
+            first_row, std::min(first_row + kBlockRowsPerTask, blocks_high));
+        tasks.remaining.CountDown();
+      }
+    };
+    for (size_t i = 1; i < task_count; i++) {
+      worker_task_runner->PostTask(
+          [tasks, run_tasks]() { run_tasks(*tasks); });
+    }
+    run_tasks(*tasks);
+    tasks->remaining.Wait();
+  }
+
+  return {size_, DecompressedImage::Format::kRGBA,
+          std::make_shared<fml::DataMapping>(std::move(pixels))};
+}
+
+}  // namespace impeller
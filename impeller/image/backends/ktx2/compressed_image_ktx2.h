@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/geometry/size.h"
+#include "impeller/image/compressed_image.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      An image in a KTX2 container, whose levels are already in a
+///             format that GPUs can sample from directly.
+///
+///             The levels are exposed as is, so that they can be uploaded
+///             without being decoded when the device supports their format.
+///             When it doesn't, |Decode| transcodes the base level to RGBA on
+///             the CPU.
+///
+///             Only 2D images without supercompression are supported. The
+///             sRGB variants of the formats are treated like their linear
+///             counterparts, like the other formats of images are.
+///
+class CompressedImageKTX2 final : public CompressedImage {
+ public:
+  enum class Format {
+    kR8G8B8A8,
+    kETC2R8G8B8,
+    kETC2R8G8B8A8,
+    kASTC4x4,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the contents of the allocation start with the KTX2
+  ///             file identifier.
+  ///
+  static bool IsKTX2(const fml::Mapping& allocation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses the container in the allocation.
+  ///
+  /// @return     The image, or `nullptr` if the allocation isn't a KTX2
+  ///             container or uses a feature that isn't supported.
+  ///
+  static std::shared_ptr<CompressedImageKTX2> Create(
+      std::shared_ptr<const fml::Mapping> allocation);
+
+  ~CompressedImageKTX2() override;
+
+  const ISize& GetSize() const;
+
+  Format GetFormat() const;
+
+  size_t GetMipCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the contents of a mip level, which references the
+  ///             allocation of the image instead of copying it.
+  ///
+  /// @param[in]  level  The level, where 0 is the base level.
+  ///
+  std::shared_ptr<fml::Mapping> GetMipLevel(size_t level) const;
+
+  // |CompressedImage|
+  DecompressedImage Decode() const override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Transcodes the base level to RGBA, with the rows of blocks
+  ///             split between the workers of the task runner.
+  ///
+  ///             Blocks until the whole image has been transcoded. The
+  ///             calling thread transcodes rows as well, so this may be
+  ///             called from one of the workers.
+  ///
+  /// @param[in]  worker_task_runner  The workers to transcode on. The image is
+  ///                                 transcoded on the calling thread if this
+  ///                                 is `nullptr`.
+  ///
+  DecompressedImage Decode(
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner)
+      const;
+
+ private:
+  struct Level {
+    size_t offset = 0u;
+    size_t length = 0u;
+  };
+
+  ISize size_;
+  Format format_ = Format::kR8G8B8A8;
+  std::vector<Level> levels_;
+
+  CompressedImageKTX2(std::shared_ptr<const fml::Mapping> allocation,
+                      ISize size,
+                      Format format,
+                      std::vector<Level> levels);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompressedImageKTX2);
+};
+
+}  // namespace impeller
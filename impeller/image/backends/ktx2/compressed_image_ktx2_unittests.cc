@@ -0,0 +1,277 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/base/validation.h"
+#include "impeller/image/backends/ktx2/compressed_image_ktx2.h"
+#include "impeller/image/backends/ktx2/etc2_decoder.h"
+
+namespace impeller {
+namespace testing {
+
+using Pixels = std::array<uint8_t, 4u * 4u * 4u>;
+
+static constexpr uint32_t kVkFormatR8G8B8A8UNorm = 37u;
+static constexpr uint32_t kVkFormatETC2R8G8B8UNorm = 147u;
+static constexpr uint32_t kVkFormatETC2R8G8B8A8UNorm = 151u;
+
+static Pixels DecodeRGB8(std::array<uint8_t, 8> block) {
+  Pixels pixels = {};
+  DecodeETC2RGB8Block(block.data(), pixels.data(), 16u);
+  return pixels;
+}
+
+static std::array<uint8_t, 4> PixelAt(const Pixels& pixels,
+                                      size_t x,
+                                      size_t y) {
+  const size_t offset = y * 16u + x * 4u;
+  return {pixels[offset], pixels[offset + 1], pixels[offset + 2],
+          pixels[offset + 3]};
+}
+
+/// @brief  Creates a KTX2 container with the levels, which are laid out after
+///         the level index in order.
+static std::shared_ptr<fml::Mapping> CreateKTX2(
+    uint32_t vk_format,
+    uint32_t width,
+    uint32_t height,
+    const std::vector<std::vector<uint8_t>>& levels,
+    uint32_t supercompression_scheme = 0u) {
+  const uint8_t identifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  std::vector<uint8_t> data(80u + levels.size() * 24u);
+  std::memcpy(data.data(), identifier, sizeof(identifier));
+  auto write_u32 = [&data](size_t offset, uint32_t value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+  };
+  auto write_u64 = [&data](size_t offset, uint64_t value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+  };
+  write_u32(12u, vk_format);
+  write_u32(16u, 1u);  // typeSize
+  write_u32(20u, width);
+  write_u32(24u, height);
+  write_u32(36u, 1u);  // faceCount
+  write_u32(40u, levels.size());
+  write_u32(44u, supercompression_scheme);
+  for (size_t i = 0; i < levels.size(); i++) {
+    write_u64(80u + i * 24u, data.size());
+    write_u64(80u + i * 24u + 8u, levels[i].size());
+    write_u64(80u + i * 24u + 16u, levels[i].size());
+    data.insert(data.end(), levels[i].begin(), levels[i].end());
+  }
+  return std::make_shared<fml::DataMapping>(std::move(data));
+}
+
+TEST(ETC2DecoderTest, DecodesIndividualMode) {
+  auto pixels =
+      DecodeRGB8({0xF0, 0x00, 0x0F, 0x1C, 0x80, 0x00, 0x80, 0x00});
+  using Pixel = std::array<uint8_t, 4>;
+  // The left half uses the first base color and modifier table.
+  ASSERT_EQ(PixelAt(pixels, 0, 0), (Pixel{255, 2, 2, 255}));
+  ASSERT_EQ(PixelAt(pixels, 1, 3), (Pixel{255, 2, 2, 255}));
+  ASSERT_EQ(PixelAt(pixels, 2, 0), (Pixel{47, 47, 255, 255}));
+  ASSERT_EQ(PixelAt(pixels, 3, 3), (Pixel{0, 0, 72, 255}));
+}
+
+TEST(ETC2DecoderTest, DecodesDifferentialMode) {
+  auto pixels =
+      DecodeRGB8({0x87, 0x00, 0xF8, 0x03, 0x00, 0x00, 0x00, 0x00});
+  using Pixel = std::array<uint8_t, 4>;
+  // The block is flipped, so the halves are the top and bottom.
+  ASSERT_EQ(PixelAt(pixels, 3, 1), (Pixel{134, 2, 255, 255}));
+  ASSERT_EQ(PixelAt(pixels, 0, 2), (Pixel{125, 2, 255, 255}));
+}
+
+TEST(ETC2DecoderTest, DecodesTMode) {
+  auto pixels =
+      DecodeRGB8({0xFB, 0x00, 0x08, 0x02, 0x00, 0x00, 0x00, 0x10});
+  using Pixel = std::array<uint8_t, 4>;
+  ASSERT_EQ(PixelAt(pixels, 0, 0), (Pixel{255, 0, 0, 255}));
+  ASSERT_EQ(PixelAt(pixels, 1, 0), (Pixel{3, 139, 3, 255}));
+}
+
+TEST(ETC2DecoderTest, DecodesHMode) {
+  auto pixels =
+      DecodeRGB8({0x78, 0x04, 0x00, 0x7A, 0x00, 0x02, 0x00, 0x00});
+  using Pixel = std::array<uint8_t, 4>;
+  ASSERT_EQ(PixelAt(pixels, 0, 0), (Pixel{255, 6, 6, 255}));
+  ASSERT_EQ(PixelAt(pixels, 0, 1), (Pixel{6, 6, 255, 255}));
+}
+
+TEST(ETC2DecoderTest, DecodesPlanarMode) {
+  auto pixels =
+      DecodeRGB8({0x41, 0x00, 0x14, 0x42, 0x80, 0x84, 0x10, 0x10});
+  using Pixel = std::array<uint8_t, 4>;
+  // All three corners are the same color.
+  for (size_t y = 0; y < 4u; y++) {
+    for (size_t x = 0; x < 4u; x++) {
+      ASSERT_EQ(PixelAt(pixels, x, y), (Pixel{130, 129, 65, 255}));
+    }
+  }
+}
+
+TEST(ETC2DecoderTest, DecodesEACAlpha) {
+  std::array<uint8_t, 16> block = {0x80, 0x20, 0xE0, 0x00, 0x00, 0x00,
+                                   0x00, 0x00, 0x87, 0x00, 0xF8, 0x03,
+                                   0x00, 0x00, 0x00, 0x00};
+  Pixels pixels = {};
+  DecodeETC2RGBA8Block(block.data(), pixels.data(), 16u);
+  using Pixel = std::array<uint8_t, 4>;
+  ASSERT_EQ(PixelAt(pixels, 0, 0), (Pixel{134, 2, 255, 156}));
+  ASSERT_EQ(PixelAt(pixels, 3, 3), (Pixel{125, 2, 255, 122}));
+}
+
+TEST(CompressedImageKTX2Test, RejectsOtherContainers) {
+  auto png = std::make_shared<fml::DataMapping>(
+      std::vector<uint8_t>{0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A});
+  ASSERT_FALSE(CompressedImageKTX2::IsKTX2(*png));
+  ASSERT_EQ(CompressedImageKTX2::Create(png), nullptr);
+  ASSERT_EQ(CompressedImageKTX2::Create(nullptr), nullptr);
+}
+
+TEST(CompressedImageKTX2Test, RejectsInvalidContainers) {
+  ScopedValidationDisable disable_validation;
+  const std::vector<uint8_t> level(32u);
+  // Supercompression isn't supported.
+  ASSERT_EQ(CompressedImageKTX2::Create(CreateKTX2(kVkFormatETC2R8G8B8UNorm,
+                                                   8u, 8u, {level}, 2u)),
+            nullptr);
+  // Neither are formats that aren't listed.
+  ASSERT_EQ(CompressedImageKTX2::Create(CreateKTX2(0u, 8u, 8u, {level})),
+            nullptr);
+  // Levels must be exactly as large as their size requires.
+  ASSERT_EQ(CompressedImageKTX2::Create(
+                CreateKTX2(kVkFormatETC2R8G8B8UNorm, 16u, 8u, {level})),
+            nullptr);
+  // And there can't be more of them than the size allows.
+  ASSERT_EQ(CompressedImageKTX2::Create(CreateKTX2(
+                kVkFormatR8G8B8A8UNorm, 1u, 1u,
+                {std::vector<uint8_t>(4u), std::vector<uint8_t>(4u)})),
+            nullptr);
+  // The level index must be in bounds.
+  auto truncated = CreateKTX2(kVkFormatETC2R8G8B8UNorm, 8u, 8u, {level});
+  ASSERT_EQ(CompressedImageKTX2::Create(std::make_shared<fml::NonOwnedMapping>(
+                truncated->GetMapping(), truncated->GetSize() - 1u)),
+            nullptr);
+}
+
+TEST(CompressedImageKTX2Test, CanReadMipLevels) {
+  std::vector<uint8_t> base_level(4u * 8u, 0xAA);
+  std::vector<uint8_t> second_level(8u, 0xBB);
+  // The smallest level is 2x1, but still takes a whole block.
+  std::vector<uint8_t> third_level(8u, 0xCC);
+  auto image = CompressedImageKTX2::Create(
+      CreateKTX2(kVkFormatETC2R8G8B8UNorm, 8u, 5u,
+                 {base_level, second_level, third_level}));
+  ASSERT_NE(image, nullptr);
+  ASSERT_EQ(image->GetSize(), ISize(8, 5));
+  ASSERT_EQ(image->GetFormat(), CompressedImageKTX2::Format::kETC2R8G8B8);
+  ASSERT_EQ(image->GetMipCount(), 3u);
+
+  auto level = image->GetMipLevel(1u);
+  ASSERT_NE(level, nullptr);
+  ASSERT_EQ(level->GetSize(), second_level.size());
+  ASSERT_EQ(std::memcmp(level->GetMapping(), second_level.data(),
+                        second_level.size()),
+            0);
+  ASSERT_EQ(image->GetMipLevel(3u), nullptr);
+
+  // The levels keep the contents of the image alive.
+  auto base = image->GetMipLevel(0u);
+  image.reset();
+  ASSERT_EQ(base->GetSize(), base_level.size());
+  ASSERT_EQ(base->GetMapping()[0], 0xAA);
+}
+
+TEST(CompressedImageKTX2Test, DecodesUncompressedLevelsAsIs) {
+  std::vector<uint8_t> level = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto image = CompressedImageKTX2::Create(
+      CreateKTX2(kVkFormatR8G8B8A8UNorm, 2u, 1u, {level}));
+  ASSERT_NE(image, nullptr);
+  auto decoded = image->Decode();
+  ASSERT_TRUE(decoded.IsValid());
+  ASSERT_EQ(decoded.GetFormat(), DecompressedImage::Format::kRGBA);
+  ASSERT_EQ(decoded.GetAllocation()->GetSize(), level.size());
+  ASSERT_EQ(decoded.GetAllocation()->GetMapping()[4], 5u);
+}
+
+TEST(CompressedImageKTX2Test, ParallelDecodeMatchesSerialDecode) {
+  // An odd size, so that the blocks on the edges are clipped, that spans
+  // enough rows of blocks to be split between several tasks.
+  constexpr uint32_t kWidth = 37u;
+  constexpr uint32_t kHeight = 150u;
+  const std::array<std::array<uint8_t, 16>, 3> blocks = {{
+      {0x80, 0x20, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00,  //
+       0xF0, 0x00, 0x0F, 0x1C, 0x80, 0x00, 0x80, 0x00},
+      {0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //
+       0x41, 0x00, 0x14, 0x42, 0x80, 0x84, 0x10, 0x10},
+      {0x10, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  //
+       0x78, 0x04, 0x00, 0x7A, 0x00, 0x02, 0x00, 0x00},
+  }};
+  const size_t block_count = ((kWidth + 3u) / 4u) * ((kHeight + 3u) / 4u);
+  std::vector<uint8_t> level;
+  for (size_t i = 0; i < block_count; i++) {
+    level.insert(level.end(), blocks[i % blocks.size()].begin(),
+                 blocks[i % blocks.size()].end());
+  }
+  auto image = CompressedImageKTX2::Create(
+      CreateKTX2(kVkFormatETC2R8G8B8A8UNorm, kWidth, kHeight, {level}));
+  ASSERT_NE(image, nullptr);
+
+  auto serial = image->Decode();
+  ASSERT_TRUE(serial.IsValid());
+  ASSERT_EQ(serial.GetSize(), ISize(kWidth, kHeight));
+  ASSERT_EQ(serial.GetAllocation()->GetSize(), kWidth * kHeight * 4u);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto parallel = image->Decode(loop->GetTaskRunner());
+  ASSERT_TRUE(parallel.IsValid());
+  ASSERT_EQ(parallel.GetAllocation()->GetSize(),
+            serial.GetAllocation()->GetSize());
+  ASSERT_EQ(std::memcmp(parallel.GetAllocation()->GetMapping(),
+                        serial.GetAllocation()->GetMapping(),
+                        serial.GetAllocation()->GetSize()),
+            0);
+
+  // The first block is in the top left corner.
+  const uint8_t* first_pixel = serial.GetAllocation()->GetMapping();
+  ASSERT_EQ(first_pixel[0], 255u);
+  ASSERT_EQ(first_pixel[1], 2u);
+  ASSERT_EQ(first_pixel[3], 156u);
+}
+
+TEST(CompressedImageKTX2Test, CanDecodeOnTheWorkersItSplitsWorkBetween) {
+  constexpr uint32_t kWidth = 16u;
+  constexpr uint32_t kHeight = 256u;
+  const std::vector<uint8_t> level((kWidth / 4u) * (kHeight / 4u) * 16u, 0u);
+  auto image = CompressedImageKTX2::Create(
+      CreateKTX2(kVkFormatETC2R8G8B8A8UNorm, kWidth, kHeight, {level}));
+  ASSERT_NE(image, nullptr);
+
+  // The only worker decodes the image. Waiting on tasks queued behind it
+  // would never return.
+  auto loop = fml::ConcurrentMessageLoop::Create(1u);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  DecompressedImage decoded;
+  task_runner->PostTask([&]() {
+    decoded = image->Decode(task_runner);
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_TRUE(decoded.IsValid());
+  ASSERT_EQ(decoded.GetAllocation()->GetSize(), kWidth * kHeight * 4u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,268 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/image/backends/ktx2/etc2_decoder.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+static constexpr int kModifierTable[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},  {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+static constexpr int kDistanceTable[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+static constexpr int kAlphaModifierTable[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},   {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},   {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},   {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},   {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},     {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+namespace {
+
+struct RGB {
+  int r = 0;
+  int g = 0;
+  int b = 0;
+};
+
+}  // namespace
+
+/// @brief  Reads the 8 bytes of a block, which are stored big endian.
+static uint64_t ReadBlock(const uint8_t* block) {
+  uint64_t bits = 0u;
+  for (size_t i = 0; i < 8u; i++) {
+    bits = (bits << 8) | block[i];
+  }
+  return bits;
+}
+
+/// @brief  Returns the bits from `high` down to `low`, inclusive.
+static int Bits(uint64_t value, int high, int low) {
+  return static_cast<int>((value >> low) & ((1u << (high - low + 1)) - 1));
+}
+
+static int Extend4(int value) {
+  return (value << 4) | value;
+}
+
+static int Extend5(int value) {
+  return (value << 3) | (value >> 2);
+}
+
+static int Extend6(int value) {
+  return (value << 2) | (value >> 4);
+}
+
+static int Extend7(int value) {
+  return (value << 1) | (value >> 6);
+}
+
+static int SignExtend3(int value) {
+  return value >= 4 ? value - 8 : value;
+}
+
+static uint8_t Clamp(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+static RGB Offset(const RGB& color, int offset) {
+  return {color.r + offset, color.g + offset, color.b + offset};
+}
+
+/// @brief  Returns the 2 bit index of the pixel, which are stored in column
+///         major order with their most significant bits in a separate half.
+static int PixelIndex(uint64_t bits, size_t x, size_t y) {
+  const size_t i = x * 4u + y;
+  return (((bits >> (16u + i)) & 1u) << 1) | ((bits >> i) & 1u);
+}
+
+static void WritePixel(uint8_t* pixels,
+                       size_t row_stride,
+                       size_t x,
+                       size_t y,
+                       const RGB& color) {
+  uint8_t* pixel = pixels + y * row_stride + x * 4u;
+  pixel[0] = Clamp(color.r);
+  pixel[1] = Clamp(color.g);
+  pixel[2] = Clamp(color.b);
+  pixel[3] = 255u;
+}
+
+/// @brief  Decodes the blocks that pick one of four paint colors per pixel.
+static void DecodePaintColors(uint64_t bits,
+                              const RGB (&paint_colors)[4],
+                              uint8_t* pixels,
+                              size_t row_stride) {
+  for (size_t y = 0; y < kETC2BlockDimension; y++) {
+    for (size_t x = 0; x < kETC2BlockDimension; x++) {
+      WritePixel(pixels, row_stride, x, y,
+                 paint_colors[PixelIndex(bits, x, y)]);
+    }
+  }
+}
+
+static void DecodeTMode(uint64_t bits, uint8_t* pixels, size_t row_stride) {
+  const RGB color_1 = {
+      Extend4((Bits(bits, 60, 59) << 2) | Bits(bits, 57, 56)),
+      Extend4(Bits(bits, 55, 52)),
+      Extend4(Bits(bits, 51, 48)),
+  };
+  const RGB color_2 = {
+      Extend4(Bits(bits, 47, 44)),
+      Extend4(Bits(bits, 43, 40)),
+      Extend4(Bits(bits, 39, 36)),
+  };
+  const int distance =
+      kDistanceTable[(Bits(bits, 35, 34) << 1) | Bits(bits, 32, 32)];
+  const RGB paint_colors[4] = {
+      color_1,
+      Offset(color_2, distance),
+      color_2,
+      Offset(color_2, -distance),
+  };
+  DecodePaintColors(bits, paint_colors, pixels, row_stride);
+}
+
+static void DecodeHMode(uint64_t bits, uint8_t* pixels, size_t row_stride) {
+  const int r1 = Bits(bits, 62, 59);
+  const int g1 = (Bits(bits, 58, 56) << 1) | Bits(bits, 52, 52);
+  const int b1 = (Bits(bits, 51, 51) << 3) | Bits(bits, 49, 47);
+  const int r2 = Bits(bits, 46, 43);
+  const int g2 = Bits(bits, 42, 39);
+  const int b2 = Bits(bits, 38, 35);
+  // The least significant bit of the distance is implied by the order of the
+  // two base colors.
+  const int order =
+      ((r1 << 8) | (g1 << 4) | b1) >= ((r2 << 8) | (g2 << 4) | b2) ? 1 : 0;
+  const int distance = kDistanceTable[(Bits(bits, 34, 34) << 2) |
+                                      (Bits(bits, 32, 32) << 1) | order];
+  const RGB color_1 = {Extend4(r1), Extend4(g1), Extend4(b1)};
+  const RGB color_2 = {Extend4(r2), Extend4(g2), Extend4(b2)};
+  const RGB paint_colors[4] = {
+      Offset(color_1, distance),
+      Offset(color_1, -distance),
+      Offset(color_2, distance),
+      Offset(color_2, -distance),
+  };
+  DecodePaintColors(bits, paint_colors, pixels, row_stride);
+}
+
+static void DecodePlanarMode(uint64_t bits,
+                             uint8_t* pixels,
+                             size_t row_stride) {
+  const RGB origin = {
+      Extend6(Bits(bits, 62, 57)),
+      Extend7((Bits(bits, 56, 56) << 6) | Bits(bits, 54, 49)),
+      Extend6((Bits(bits, 48, 48) << 5) | (Bits(bits, 44, 43) << 3) |
+              Bits(bits, 41, 39)),
+  };
+  const RGB horizontal = {
+      Extend6((Bits(bits, 38, 34) << 1) | Bits(bits, 32, 32)),
+      Extend7(Bits(bits, 31, 25)),
+      Extend6(Bits(bits, 24, 19)),
+  };
+  const RGB vertical = {
+      Extend6(Bits(bits, 18, 13)),
+      Extend7(Bits(bits, 12, 6)),
+      Extend6(Bits(bits, 5, 0)),
+  };
+  auto interpolate = [](int o, int h, int v, int x, int y) {
+    return (x * (h - o) + y * (v - o) + 4 * o + 2) >> 2;
+  };
+  for (size_t y = 0; y < kETC2BlockDimension; y++) {
+    for (size_t x = 0; x < kETC2BlockDimension; x++) {
+      const int ix = static_cast<int>(x);
+      const int iy = static_cast<int>(y);
+      WritePixel(
+          pixels, row_stride, x, y,
+          {
+              interpolate(origin.r, horizontal.r, vertical.r, ix, iy),
+              interpolate(origin.g, horizontal.g, vertical.g, ix, iy),
+              interpolate(origin.b, horizontal.b, vertical.b, ix, iy),
+          });
+    }
+  }
+}
+
+void DecodeETC2RGB8Block(const uint8_t* block,
+                         uint8_t* pixels,
+                         size_t row_stride) {
+  const uint64_t bits = ReadBlock(block);
+
+  RGB base_colors[2];
+  if (Bits(bits, 33, 33) == 0) {
+    // Individual mode.
+    base_colors[0] = {Extend4(Bits(bits, 63, 60)), Extend4(Bits(bits, 55, 52)),
+                      Extend4(Bits(bits, 47, 44))};
+    base_colors[1] = {Extend4(Bits(bits, 59, 56)), Extend4(Bits(bits, 51, 48)),
+                      Extend4(Bits(bits, 43, 40))};
+  } else {
+    // Differential mode. Differences that overflow a component select the
+    // modes that ETC2 added to ETC1.
+    const int r = Bits(bits, 63, 59);
+    const int g = Bits(bits, 55, 51);
+    const int b = Bits(bits, 47, 43);
+    const int r2 = r + SignExtend3(Bits(bits, 58, 56));
+    const int g2 = g + SignExtend3(Bits(bits, 50, 48));
+    const int b2 = b + SignExtend3(Bits(bits, 42, 40));
+    if (r2 < 0 || r2 > 31) {
+      DecodeTMode(bits, pixels, row_stride);
+      return;
+    }
+    if (g2 < 0 || g2 > 31) {
+      DecodeHMode(bits, pixels, row_stride);
+      return;
+    }
+    if (b2 < 0 || b2 > 31) {
+      DecodePlanarMode(bits, pixels, row_stride);
+      return;
+    }
+    base_colors[0] = {Extend5(r), Extend5(g), Extend5(b)};
+    base_colors[1] = {Extend5(r2), Extend5(g2), Extend5(b2)};
+  }
+
+  const int tables[2] = {Bits(bits, 39, 37), Bits(bits, 36, 34)};
+  const bool flip = Bits(bits, 32, 32) != 0;
+  for (size_t y = 0; y < kETC2BlockDimension; y++) {
+    for (size_t x = 0; x < kETC2BlockDimension; x++) {
+      // The block is split into two 2x4 halves, or two 4x2 halves when
+      // flipped.
+      const size_t sub_block = flip ? y / 2u : x / 2u;
+      const int index = PixelIndex(bits, x, y);
+      const int modifier = kModifierTable[tables[sub_block]][index & 1];
+      WritePixel(pixels, row_stride, x, y,
+                 Offset(base_colors[sub_block],
+                        (index & 2) ? -modifier : modifier));
+    }
+  }
+}
+
+void DecodeETC2RGBA8Block(const uint8_t* block,
+                          uint8_t* pixels,
+                          size_t row_stride) {
+  DecodeETC2RGB8Block(block + 8u, pixels, row_stride);
+
+  const uint64_t bits = ReadBlock(block);
+  const int base = Bits(bits, 63, 56);
+  const int multiplier = Bits(bits, 55, 52);
+  const int* modifiers = kAlphaModifierTable[Bits(bits, 51, 48)];
+  for (size_t y = 0; y < kETC2BlockDimension; y++) {
+    for (size_t x = 0; x < kETC2BlockDimension; x++) {
+      const int i = static_cast<int>(x * 4u + y);
+      const int index = Bits(bits, 47 - 3 * i, 45 - 3 * i);
+      pixels[y * row_stride + x * 4u + 3u] =
+          Clamp(base + modifiers[index] * multiplier);
+    }
+  }
+}
+
+}  // namespace impeller
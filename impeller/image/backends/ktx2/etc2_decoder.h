@@ -0,0 +1,41 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace impeller {
+
+/// The width and height of the blocks of the ETC2 formats, in pixels.
+static constexpr size_t kETC2BlockDimension = 4u;
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes an 8 byte ETC2 RGB8 block into 16 RGBA8 pixels.
+///
+///             All the modes of ETC2 (individual, differential, T, H and
+///             planar) are supported. The decoded alpha is always opaque.
+///
+/// @param[in]  block   The 8 bytes of the compressed block.
+/// @param[out] pixels  The 4x4 decoded pixels, in row major order, with a
+///                     stride of `row_stride` bytes between rows.
+///
+void DecodeETC2RGB8Block(const uint8_t* block,
+                         uint8_t* pixels,
+                         size_t row_stride);
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes a 16 byte ETC2 RGBA8 block, which is an EAC alpha block
+///             followed by an ETC2 RGB8 block, into 16 RGBA8 pixels.
+///
+/// @param[in]  block   The 16 bytes of the compressed block.
+/// @param[out] pixels  The 4x4 decoded pixels, in row major order, with a
+///                     stride of `row_stride` bytes between rows.
+///
+void DecodeETC2RGBA8Block(const uint8_t* block,
+                          uint8_t* pixels,
+                          size_t row_stride);
+
+}  // namespace impeller
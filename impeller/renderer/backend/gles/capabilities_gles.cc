@@ -4,6 +4,9 @@
 
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -81,6 +84,17 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
     num_compressed_texture_formats = value;
   }
 
+  if (num_compressed_texture_formats > 0u) {
+    std::vector<GLint> formats(num_compressed_texture_formats);
+    gl.GetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    auto has_format = [&formats](GLint format) {
+      return std::find(formats.begin(), formats.end(), format) != formats.end();
+    };
+    supports_etc2_textures = has_format(GL_COMPRESSED_RGB8_ETC2) &&
+                             has_format(GL_COMPRESSED_RGBA8_ETC2_EAC);
+    supports_astc_textures = has_format(GL_COMPRESSED_RGBA_ASTC_4x4_KHR);
+  }
+
   if (gl.GetDescription()->IsES()) {
     GLint value = 0;
     gl.GetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &value);
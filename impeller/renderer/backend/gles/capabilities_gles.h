@@ -56,6 +56,12 @@ struct CapabilitiesGLES {
   // May be 0.
   size_t num_shader_binary_formats = 0;
 
+  // Whether the ETC2 formats are among the compressed texture formats.
+  bool supports_etc2_textures = false;
+
+  // Whether the ASTC 4x4 format is among the compressed texture formats.
+  bool supports_astc_textures = false;
+
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 };
 
@@ -60,6 +60,7 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the device capabilities.
   {
+    const auto* gl_capabilities = reactor_->GetProcTable().GetCapabilities();
     device_capabilities_ =
         CapabilitiesBuilder()
             .SetHasThreadingRestrictions(true)
@@ -77,6 +78,10 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
             .SetSupportsReadFromOnscreenTexture(false)
             .SetSupportsDecalTileMode(false)
             .SetSupportsMemorylessTextures(false)
+            .SetSupportsTextureCompressionETC2(
+                gl_capabilities->supports_etc2_textures)
+            .SetSupportsTextureCompressionASTC(
+                gl_capabilities->supports_astc_textures)
             .Build();
   }
 
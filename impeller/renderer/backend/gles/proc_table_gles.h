@@ -101,6 +101,7 @@ struct GLProc {
   PROC(ClearStencil);                        \
   PROC(ColorMask);                           \
   PROC(CompileShader);                       \
+  PROC(CompressedTexImage2D);                \
   PROC(CreateProgram);                       \
   PROC(CreateShader);                        \
   PROC(CullFace);                            \
@@ -90,6 +90,10 @@ struct TexImage2DData {
   GLint internal_format = 0;
   GLenum external_format = GL_NONE;
   GLenum type = GL_NONE;
+  /// Whether the data is block compressed, in which case only the internal
+  /// format is meaningful and the data must be uploaded with
+  /// `glCompressedTexImage2D`.
+  bool is_compressed = false;
   std::shared_ptr<const fml::Mapping> data;
 
   explicit TexImage2DData(PixelFormat pixel_format) {
@@ -117,6 +121,18 @@ struct TexImage2DData {
         external_format = GL_RGBA;
         type = GL_HALF_FLOAT;
         break;
+      case PixelFormat::kETC2R8G8B8UNormInt:
+        internal_format = GL_COMPRESSED_RGB8_ETC2;
+        is_compressed = true;
+        break;
+      case PixelFormat::kETC2R8G8B8A8UNormInt:
+        internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        is_compressed = true;
+        break;
+      case PixelFormat::kASTC4x4UNormInt:
+        internal_format = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        is_compressed = true;
+        break;
       case PixelFormat::kUnknown:
       case PixelFormat::kS8UInt:
       case PixelFormat::kD32FloatS8UInt:
@@ -163,6 +179,24 @@ struct TexImage2DData {
         data = std::move(mapping);
         break;
       }
+      case PixelFormat::kETC2R8G8B8UNormInt: {
+        internal_format = GL_COMPRESSED_RGB8_ETC2;
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
+      case PixelFormat::kETC2R8G8B8A8UNormInt: {
+        internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC;
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
+      case PixelFormat::kASTC4x4UNormInt: {
+        internal_format = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
       case PixelFormat::kR8G8B8A8UNormIntSRGB:
       case PixelFormat::kB8G8R8A8UNormInt:
       case PixelFormat::kB8G8R8A8UNormIntSRGB:
@@ -194,6 +228,19 @@ bool TextureGLES::OnSetContents(const uint8_t* contents,
 // |Texture|
 bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
                                 size_t slice) {
+  return SetLevelContents(std::move(mapping), slice, 0u);
+}
+
+// |Texture|
+bool TextureGLES::OnSetMipLevelContents(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t mip_level) {
+  return SetLevelContents(std::move(mapping), 0u, mip_level);
+}
+
+bool TextureGLES::SetLevelContents(std::shared_ptr<const fml::Mapping> mapping,
+                                   size_t slice,
+                                   size_t mip_level) {
   if (!mapping) {
     return false;
   }
@@ -227,7 +274,7 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     return false;
   }
 
-  if (mapping->GetSize() < tex_descriptor.GetByteSizeOfBaseMipLevel()) {
+  if (mapping->GetSize() < tex_descriptor.GetByteSizeOfMipLevel(mip_level)) {
     return false;
   }
 
@@ -255,11 +302,13 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     return false;
   }
 
-  ReactorGLES::Operation texture_upload = [handle = handle_,            //
-                                           data,                        //
-                                           size = tex_descriptor.size,  //
-                                           texture_type,                //
-                                           texture_target               //
+  ReactorGLES::Operation texture_upload =
+      [handle = handle_,                                  //
+       data,                                              //
+       size = tex_descriptor.GetMipLevelSize(mip_level),  //
+       level = static_cast<GLint>(mip_level),             //
+       texture_type,                                      //
+       texture_target                                     //
   ](const auto& reactor) {
     auto gl_handle = reactor.GetGLHandle(handle);
     if (!gl_handle.has_value()) {
@@ -274,11 +323,23 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
       tex_data = data->data->GetMapping();
     }
 
-    {
+    if (data->is_compressed) {
+      TRACE_EVENT1("impeller", "CompressedTexImage2DUpload", "Bytes",
+                   std::to_string(data->data->GetSize()).c_str());
+      gl.CompressedTexImage2D(texture_target,         // target
+                              level,                  // LOD level
+                              data->internal_format,  // internal format
+                              size.width,             // width
+                              size.height,            // height
+                              0u,                     // border
+                              data->data->GetSize(),  // image size
+                              tex_data                // data
+      );
+    } else {
       TRACE_EVENT1("impeller", "TexImage2DUpload", "Bytes",
                    std::to_string(data->data->GetSize()).c_str());
       gl.TexImage2D(texture_target,         // target
-                    0u,                     // LOD level
+                    level,                  // LOD level
                     data->internal_format,  // internal format
                     size.width,             // width
                     size.height,            // height
@@ -321,6 +382,9 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -359,6 +423,11 @@ void TextureGLES::InitializeContentsIfNecessary() const {
         VALIDATION_LOG << "Invalid format for texture image.";
         return;
       }
+      if (tex_data.is_compressed) {
+        // Compressed images can't be allocated without their contents, which
+        // are only ever specified by |OnSetContents|.
+        return;
+      }
       gl.BindTexture(GL_TEXTURE_2D, handle.value());
       {
         TRACE_EVENT0("impeller", "TexImage2DInitialization");
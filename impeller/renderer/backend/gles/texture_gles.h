@@ -78,6 +78,14 @@ class TextureGLES final : public Texture,
   bool OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
                      size_t slice) override;
 
+  // |Texture|
+  bool OnSetMipLevelContents(std::shared_ptr<const fml::Mapping> mapping,
+                             size_t mip_level) override;
+
+  bool SetLevelContents(std::shared_ptr<const fml::Mapping> mapping,
+                        size_t slice,
+                        size_t mip_level);
+
   // |Texture|
   bool IsValid() const override;
 
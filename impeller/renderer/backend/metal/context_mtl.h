@@ -86,7 +86,9 @@ class ContextMTL final : public Context,
 
   id<MTLCommandBuffer> CreateMTLCommandBuffer(const std::string& label) const;
 
-  const std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner() const;
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner()
+      const override;
 
   std::shared_ptr<const fml::SyncSwitch> GetIsGpuDisabledSyncSwitch() const;
 
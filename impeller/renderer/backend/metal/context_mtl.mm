@@ -47,6 +47,17 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+static bool DeviceSupportsCompressedTextures(id<MTLDevice> device) {
+  bool supports_compressed_textures = false;
+  // ETC2 and ASTC are available on the Apple GPU families, including Macs
+  // with Apple silicon, but not on the Mac family.
+  // https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
+  if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+    supports_compressed_textures = [device supportsFamily:MTLGPUFamilyApple2];
+  }
+  return supports_compressed_textures;
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
     PixelFormat color_format) {
@@ -65,6 +76,10 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsReadFromResolve(true)
       .SetSupportsReadFromOnscreenTexture(true)
       .SetSupportsMemorylessTextures(true)
+      .SetSupportsTextureCompressionETC2(
+          DeviceSupportsCompressedTextures(device))
+      .SetSupportsTextureCompressionASTC(
+          DeviceSupportsCompressedTextures(device))
       .Build();
 }
 
@@ -320,8 +335,12 @@ void ContextMTL::Shutdown() {
   raster_message_loop_.reset();
 }
 
-const std::shared_ptr<fml::ConcurrentTaskRunner>
-ContextMTL::GetWorkerTaskRunner() const {
+// |Context|
+std::shared_ptr<fml::ConcurrentTaskRunner> ContextMTL::GetWorkerTaskRunner()
+    const {
+  if (!raster_message_loop_) {
+    return nullptr;
+  }
   return raster_message_loop_->GetTaskRunner();
 }
 
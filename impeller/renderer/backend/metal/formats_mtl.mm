@@ -133,4 +133,28 @@ MTLPixelFormat SafeMTLPixelFormatBGRA10_XR() {
   }
 }
 
+MTLPixelFormat SafeMTLPixelFormatETC2_RGB8() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatETC2_RGB8;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
+MTLPixelFormat SafeMTLPixelFormatEAC_RGBA8() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatEAC_RGBA8;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
+MTLPixelFormat SafeMTLPixelFormatASTC_4x4_LDR() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatASTC_4x4_LDR;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
 }  // namespace impeller
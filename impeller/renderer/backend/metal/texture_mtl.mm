@@ -68,6 +68,21 @@ bool TextureMTL::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
 bool TextureMTL::OnSetContents(const uint8_t* contents,
                                size_t length,
                                size_t slice) {
+  return SetLevelContents(contents, length, slice, 0u);
+}
+
+// |Texture|
+bool TextureMTL::OnSetMipLevelContents(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t mip_level) {
+  return SetLevelContents(mapping->GetMapping(), mapping->GetSize(), 0u,
+                          mip_level);
+}
+
+bool TextureMTL::SetLevelContents(const uint8_t* contents,
+                                  size_t length,
+                                  size_t slice,
+                                  size_t mip_level) {
   if (!IsValid() || !contents || is_wrapped_) {
     return false;
   }
@@ -75,18 +90,19 @@ bool TextureMTL::OnSetContents(const uint8_t* contents,
   const auto& desc = GetTextureDescriptor();
 
   // Out of bounds access.
-  if (length != desc.GetByteSizeOfBaseMipLevel()) {
+  if (length != desc.GetByteSizeOfMipLevel(mip_level)) {
     return false;
   }
 
+  const auto level_size = desc.GetMipLevelSize(mip_level);
   const auto region =
-      MTLRegionMake2D(0u, 0u, desc.size.width, desc.size.height);
-  [texture_ replaceRegion:region                            //
-              mipmapLevel:0u                                //
-                    slice:slice                             //
-                withBytes:contents                          //
-              bytesPerRow:desc.GetBytesPerRow()             //
-            bytesPerImage:desc.GetByteSizeOfBaseMipLevel()  //
+      MTLRegionMake2D(0u, 0u, level_size.width, level_size.height);
+  [texture_ replaceRegion:region                                 //
+              mipmapLevel:mip_level                              //
+                    slice:slice                                  //
+                withBytes:contents                               //
+              bytesPerRow:desc.GetBytesPerRow(mip_level)         //
+            bytesPerImage:desc.GetByteSizeOfMipLevel(mip_level)  //
   ];
 
   return true;
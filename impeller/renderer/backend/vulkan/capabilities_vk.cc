@@ -298,6 +298,12 @@ CapabilitiesVK::GetEnabledDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Compressed textures are used when they are available, and decompressed
+  // on the CPU otherwise.
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+  required.textureCompressionASTC_LDR =
+      device_features.textureCompressionASTC_LDR;
+
   return required;
 }
 
@@ -363,6 +369,15 @@ bool CapabilitiesVK::SetPhysicalDevice(const vk::PhysicalDevice& device) {
     }
   }
 
+  {
+    // These must match the features enabled by |GetEnabledDeviceFeatures|.
+    const auto device_features = device.getFeatures();
+    supports_texture_compression_etc2_ =
+        !!device_features.textureCompressionETC2;
+    supports_texture_compression_astc_ =
+        !!device_features.textureCompressionASTC_LDR;
+  }
+
   // Determine the optional device extensions this physical device supports.
   {
     optional_device_extensions_.clear();
@@ -442,6 +457,18 @@ bool CapabilitiesVK::SupportsMemorylessTextures() const {
   return supports_memoryless_textures_;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsTextureCompressionETC2() const {
+  // Set by |SetPhysicalDevice|.
+  return supports_texture_compression_etc2_;
+}
+
+// |Capabilities|
+bool CapabilitiesVK::SupportsTextureCompressionASTC() const {
+  // Set by |SetPhysicalDevice|.
+  return supports_texture_compression_astc_;
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return color_format_;
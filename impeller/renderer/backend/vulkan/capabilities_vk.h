@@ -93,6 +93,12 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsMemorylessTextures() const override;
 
+  // |Capabilities|
+  bool SupportsTextureCompressionETC2() const override;
+
+  // |Capabilities|
+  bool SupportsTextureCompressionASTC() const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -108,6 +114,8 @@ class CapabilitiesVK final : public Capabilities,
   vk::PhysicalDeviceProperties device_properties_;
   bool supports_compute_subgroups_ = false;
   bool supports_memoryless_textures_ = false;
+  bool supports_texture_compression_etc2_ = false;
+  bool supports_texture_compression_astc_ = false;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
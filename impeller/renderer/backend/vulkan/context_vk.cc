@@ -21,6 +21,7 @@
 #include "flutter/fml/string_conversion.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/core/transient_buffer_ring.h"
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
@@ -402,6 +403,9 @@ void ContextVK::Setup(Settings settings) {
   device_holder_ = std::move(device_holder);
   debug_report_ = std::move(debug_report);
   allocator_ = std::move(allocator);
+  // Command encoders track the buffers they reference until their fence has
+  // signaled, so passes can write their transients into device memory.
+  transient_buffer_ring_ = std::make_shared<TransientBufferRing>(allocator_);
   shader_library_ = std::move(shader_library);
   sampler_library_ = std::move(sampler_library);
   pipeline_library_ = std::move(pipeline_library);
@@ -435,6 +439,10 @@ std::shared_ptr<Allocator> ContextVK::GetResourceAllocator() const {
   return allocator_;
 }
 
+std::shared_ptr<TransientBufferRing> ContextVK::GetTransientBufferRing() const {
+  return transient_buffer_ring_;
+}
+
 std::shared_ptr<ShaderLibrary> ContextVK::GetShaderLibrary() const {
   return shader_library_;
 }
@@ -471,6 +479,12 @@ ContextVK::GetConcurrentWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
+// |Context|
+std::shared_ptr<fml::ConcurrentTaskRunner> ContextVK::GetWorkerTaskRunner()
+    const {
+  return GetConcurrentWorkerTaskRunner();
+}
+
 void ContextVK::Shutdown() {
   raster_message_loop_->Terminate();
 }
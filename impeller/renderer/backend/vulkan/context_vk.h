@@ -74,6 +74,13 @@ class ContextVK final : public Context,
   // |Context|
   std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override;
 
+  // |Context|
+  std::shared_ptr<TransientBufferRing> GetTransientBufferRing() const override;
+
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner()
+      const override;
+
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
@@ -153,6 +160,7 @@ class ContextVK final : public Context,
   std::shared_ptr<DeviceHolderImpl> device_holder_;
   std::unique_ptr<DebugReportVK> debug_report_;
   std::shared_ptr<Allocator> allocator_;
+  std::shared_ptr<TransientBufferRing> transient_buffer_ring_;
   std::shared_ptr<ShaderLibraryVK> shader_library_;
   std::shared_ptr<SamplerLibraryVK> sampler_library_;
   std::shared_ptr<PipelineLibraryVK> pipeline_library_;
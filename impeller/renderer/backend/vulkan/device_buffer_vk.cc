@@ -57,7 +57,12 @@ bool DeviceBufferVK::OnCopyHostBuffer(const uint8_t* source,
   return true;
 }
 
-void DeviceBufferVK::Flush() {
+void DeviceBufferVK::Flush(std::optional<Range> range) {
+  if (range.has_value()) {
+    ::vmaFlushAllocation(allocator_, allocation_, range->offset,
+                         range->length);
+    return;
+  }
   TRACE_EVENT0("impeller", "FlushDeviceBuffer");
   ::vmaFlushAllocation(allocator_, allocation_, 0, VK_WHOLE_SIZE);
 }
@@ -31,7 +31,7 @@ class DeviceBufferVK final : public DeviceBuffer,
   // If the contents of this buffer have been written to with
   // `OnGetContents`, then calling flush may be necessary if the memory is
   // non-coherent.
-  void Flush() override;
+  void Flush(std::optional<Range> range = std::nullopt) override;
 
  private:
   friend class AllocatorVK;
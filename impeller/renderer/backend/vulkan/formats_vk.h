@@ -163,6 +163,12 @@ constexpr vk::Format ToVKImageFormat(PixelFormat format) {
       return vk::Format::eR8Unorm;
     case PixelFormat::kR8G8UNormInt:
       return vk::Format::eR8G8Unorm;
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      return vk::Format::eEtc2R8G8B8UnormBlock;
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+      return vk::Format::eEtc2R8G8B8A8UnormBlock;
+    case PixelFormat::kASTC4x4UNormInt:
+      return vk::Format::eAstc4x4UnormBlock;
   }
 
   FML_UNREACHABLE();
@@ -192,6 +198,12 @@ constexpr PixelFormat ToPixelFormat(vk::Format format) {
       return PixelFormat::kR8UNormInt;
     case vk::Format::eR8G8Unorm:
       return PixelFormat::kR8G8UNormInt;
+    case vk::Format::eEtc2R8G8B8UnormBlock:
+      return PixelFormat::kETC2R8G8B8UNormInt;
+    case vk::Format::eEtc2R8G8B8A8UnormBlock:
+      return PixelFormat::kETC2R8G8B8A8UNormInt;
+    case vk::Format::eAstc4x4UnormBlock:
+      return PixelFormat::kASTC4x4UNormInt;
     default:
       return PixelFormat::kUnknown;
   }
@@ -383,6 +395,9 @@ constexpr bool PixelFormatIsDepthStencil(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
       return false;
     case PixelFormat::kS8UInt:
     case PixelFormat::kD32FloatS8UInt:
@@ -413,6 +428,9 @@ constexpr AttachmentKind AttachmentKindFromFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
       return AttachmentKind::kColor;
     case PixelFormat::kS8UInt:
       return AttachmentKind::kStencil;
@@ -571,6 +589,9 @@ constexpr vk::ImageAspectFlags ToVKImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
@@ -635,6 +656,9 @@ constexpr vk::ImageAspectFlags ToImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
+    case PixelFormat::kETC2R8G8B8A8UNormInt:
+    case PixelFormat::kASTC4x4UNormInt:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
@@ -31,6 +31,20 @@ void TextureVK::SetLabel(std::string_view label) {
 bool TextureVK::OnSetContents(const uint8_t* contents,
                               size_t length,
                               size_t slice) {
+  return SetLevelContents(contents, length, slice, 0u);
+}
+
+bool TextureVK::OnSetMipLevelContents(
+    std::shared_ptr<const fml::Mapping> mapping,
+    size_t mip_level) {
+  return SetLevelContents(mapping->GetMapping(), mapping->GetSize(), 0u,
+                          mip_level);
+}
+
+bool TextureVK::SetLevelContents(const uint8_t* contents,
+                                 size_t length,
+                                 size_t slice,
+                                 size_t mip_level) {
   if (!IsValid() || !contents) {
     return false;
   }
@@ -38,7 +52,7 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
   const auto& desc = GetTextureDescriptor();
 
   // Out of bounds access.
-  if (length != desc.GetByteSizeOfBaseMipLevel()) {
+  if (length != desc.GetByteSizeOfMipLevel(mip_level)) {
     VALIDATION_LOG << "Illegal to set contents for invalid size.";
     return false;
   }
@@ -90,11 +104,12 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
   copy.imageOffset.x = 0u;
   copy.imageOffset.y = 0u;
   copy.imageOffset.z = 0u;
-  copy.imageExtent.width = desc.size.width;
-  copy.imageExtent.height = desc.size.height;
+  const auto level_size = desc.GetMipLevelSize(mip_level);
+  copy.imageExtent.width = level_size.width;
+  copy.imageExtent.height = level_size.height;
   copy.imageExtent.depth = 1u;
   copy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-  copy.imageSubresource.mipLevel = 0u;
+  copy.imageSubresource.mipLevel = mip_level;
   copy.imageSubresource.baseArrayLayer = slice;
   copy.imageSubresource.layerCount = 1u;
 
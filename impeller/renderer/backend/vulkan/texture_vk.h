@@ -56,6 +56,15 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
   bool OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
                      size_t slice) override;
 
+  // |Texture|
+  bool OnSetMipLevelContents(std::shared_ptr<const fml::Mapping> mapping,
+                             size_t mip_level) override;
+
+  bool SetLevelContents(const uint8_t* contents,
+                        size_t length,
+                        size_t slice,
+                        size_t mip_level);
+
   // |Texture|
   bool IsValid() const override;
 
@@ -94,6 +94,12 @@ bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
     source_region = IRect::MakeSize(source->GetSize());
   }
 
+  if (PixelFormatIsBlockCompressed(source->GetTextureDescriptor().format)) {
+    VALIDATION_LOG << "Attempted to add a texture blit from a block "
+                      "compressed texture.";
+    return false;
+  }
+
   auto bytes_per_pixel =
       BytesPerPixelForPixelFormat(source->GetTextureDescriptor().format);
   auto bytes_per_image = source_region->size.Area() * bytes_per_pixel;
@@ -125,6 +131,13 @@ bool BlitPass::AddCopy(BufferView source,
     return false;
   }
 
+  if (PixelFormatIsBlockCompressed(
+          destination->GetTextureDescriptor().format)) {
+    VALIDATION_LOG << "Attempted to add a texture blit to a block compressed "
+                      "texture.";
+    return false;
+  }
+
   auto bytes_per_pixel =
       BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
   auto bytes_per_image =
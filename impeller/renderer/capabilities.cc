@@ -80,6 +80,16 @@ class StandardCapabilities final : public Capabilities {
     return supports_memoryless_textures_;
   }
 
+  // |Capabilities|
+  bool SupportsTextureCompressionETC2() const override {
+    return supports_texture_compression_etc2_;
+  }
+
+  // |Capabilities|
+  bool SupportsTextureCompressionASTC() const override {
+    return supports_texture_compression_astc_;
+  }
+
  private:
   StandardCapabilities(bool has_threading_restrictions,
                        bool supports_offscreen_msaa,
@@ -93,6 +103,8 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_read_from_resolve,
                        bool supports_decal_tile_mode,
                        bool supports_memoryless_textures,
+                       bool supports_texture_compression_etc2,
+                       bool supports_texture_compression_astc,
                        PixelFormat default_color_format,
                        PixelFormat default_stencil_format)
       : has_threading_restrictions_(has_threading_restrictions),
@@ -108,6 +120,8 @@ class StandardCapabilities final : public Capabilities {
         supports_read_from_resolve_(supports_read_from_resolve),
         supports_decal_tile_mode_(supports_decal_tile_mode),
         supports_memoryless_textures_(supports_memoryless_textures),
+        supports_texture_compression_etc2_(supports_texture_compression_etc2),
+        supports_texture_compression_astc_(supports_texture_compression_astc),
         default_color_format_(default_color_format),
         default_stencil_format_(default_stencil_format) {}
 
@@ -125,6 +139,8 @@ class StandardCapabilities final : public Capabilities {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_tile_mode_ = false;
   bool supports_memoryless_textures_ = false;
+  bool supports_texture_compression_etc2_ = false;
+  bool supports_texture_compression_astc_ = false;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
 
@@ -215,6 +231,18 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsMemorylessTextures(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureCompressionETC2(
+    bool value) {
+  supports_texture_compression_etc2_ = value;
+  return *this;
+}
+
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureCompressionASTC(
+    bool value) {
+  supports_texture_compression_astc_ = value;
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       has_threading_restrictions_,                                        //
@@ -229,6 +257,8 @@ std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
       supports_read_from_resolve_,                                        //
       supports_decal_tile_mode_,                                          //
       supports_memoryless_textures_,                                      //
+      supports_texture_compression_etc2_,                                 //
+      supports_texture_compression_astc_,                                 //
       default_color_format_.value_or(PixelFormat::kUnknown),              //
       default_stencil_format_.value_or(PixelFormat::kUnknown)             //
       ));
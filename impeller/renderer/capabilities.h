@@ -39,6 +39,12 @@ class Capabilities {
 
   virtual bool SupportsMemorylessTextures() const = 0;
 
+  /// Whether textures may use the ETC2 block compressed pixel formats.
+  virtual bool SupportsTextureCompressionETC2() const = 0;
+
+  /// Whether textures may use the ASTC block compressed pixel formats.
+  virtual bool SupportsTextureCompressionASTC() const = 0;
+
   virtual PixelFormat GetDefaultColorFormat() const = 0;
 
   virtual PixelFormat GetDefaultStencilFormat() const = 0;
@@ -83,6 +89,10 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsMemorylessTextures(bool value);
 
+  CapabilitiesBuilder& SetSupportsTextureCompressionETC2(bool value);
+
+  CapabilitiesBuilder& SetSupportsTextureCompressionASTC(bool value);
+
   std::unique_ptr<Capabilities> Build();
 
  private:
@@ -98,6 +108,8 @@ class CapabilitiesBuilder {
   bool supports_read_from_resolve_ = false;
   bool supports_decal_tile_mode_ = false;
   bool supports_memoryless_textures_ = false;
+  bool supports_texture_compression_etc2_ = false;
+  bool supports_texture_compression_astc_ = false;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
 
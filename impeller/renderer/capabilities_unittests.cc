@@ -30,6 +30,8 @@ CAPABILITY_TEST(SupportsReadFromOnscreenTexture, false);
 CAPABILITY_TEST(SupportsReadFromResolve, false);
 CAPABILITY_TEST(SupportsDecalTileMode, false);
 CAPABILITY_TEST(SupportsMemorylessTextures, false);
+CAPABILITY_TEST(SupportsTextureCompressionETC2, false);
+CAPABILITY_TEST(SupportsTextureCompressionASTC, false);
 
 }  // namespace testing
 }  // namespace impeller
@@ -8,11 +8,22 @@
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/renderer/context.h"
 
 namespace impeller {
 
+static std::shared_ptr<HostBuffer> CreateTransientsBuffer(
+    const std::weak_ptr<const Context>& weak_context) {
+  auto context = weak_context.lock();
+  if (auto ring = context ? context->GetTransientBufferRing() : nullptr) {
+    return HostBuffer::Create(std::move(ring));
+  }
+  return HostBuffer::Create();
+}
+
 ComputePass::ComputePass(std::weak_ptr<const Context> context)
-    : context_(std::move(context)), transients_buffer_(HostBuffer::Create()) {}
+    : context_(std::move(context)),
+      transients_buffer_(CreateTransientsBuffer(context_)) {}
 
 ComputePass::~ComputePass() = default;
 
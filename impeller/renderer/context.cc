@@ -4,6 +4,9 @@
 
 #include "impeller/renderer/context.h"
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/core/transient_buffer_ring.h"
+
 namespace impeller {
 
 Context::~Context() = default;
@@ -14,4 +17,13 @@ bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
 
+std::shared_ptr<TransientBufferRing> Context::GetTransientBufferRing() const {
+  return nullptr;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner> Context::GetWorkerTaskRunner()
+    const {
+  return nullptr;
+}
+
 }  // namespace impeller
@@ -11,6 +11,10 @@
 #include "impeller/core/formats.h"
 #include "impeller/renderer/capabilities.h"
 
+namespace fml {
+class ConcurrentTaskRunner;
+}  // namespace fml
+
 namespace impeller {
 
 class ShaderLibrary;
@@ -18,6 +22,7 @@ class SamplerLibrary;
 class CommandBuffer;
 class PipelineLibrary;
 class Allocator;
+class TransientBufferRing;
 
 //------------------------------------------------------------------------------
 /// @brief      To do anything rendering related with Impeller, you need a
@@ -131,6 +136,30 @@ class Context {
   ///
   virtual std::shared_ptr<CommandBuffer> CreateCommandBuffer() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the ring the transients buffers of render and compute
+  ///             passes allocate device memory from directly.
+  ///
+  ///             Backends only return a ring if their command buffers keep the
+  ///             device buffers they reference alive until the device is done
+  ///             with them.
+  ///
+  /// @return     The transient buffer ring, or `nullptr` if the transients
+  ///             buffers of passes are copied to the device when encoded.
+  ///
+  virtual std::shared_ptr<TransientBufferRing> GetTransientBufferRing() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the task runner of the pool of worker threads owned by
+  ///             the context, which may be used to spread CPU work that
+  ///             prepares a frame across cores.
+  ///
+  /// @return     The worker task runner, or `nullptr` if the context doesn't
+  ///             own a worker pool.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner()
+      const;
+
   //----------------------------------------------------------------------------
   /// @brief      Force all pending asynchronous work to finish. This is
   ///             achieved by deleting all owned concurrent message loops.
@@ -4,13 +4,24 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "impeller/renderer/context.h"
+
 namespace impeller {
 
+static std::shared_ptr<HostBuffer> CreateTransientsBuffer(
+    const std::weak_ptr<const Context>& weak_context) {
+  auto context = weak_context.lock();
+  if (auto ring = context ? context->GetTransientBufferRing() : nullptr) {
+    return HostBuffer::Create(std::move(ring));
+  }
+  return HostBuffer::Create();
+}
+
 RenderPass::RenderPass(std::weak_ptr<const Context> context,
                        const RenderTarget& target)
     : context_(std::move(context)),
       render_target_(target),
-      transients_buffer_(HostBuffer::Create()) {}
+      transients_buffer_(CreateTransientsBuffer(context_)) {}
 
 RenderPass::~RenderPass() = default;
 
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +18,42 @@ namespace impeller {
 
 class Context;
 
+//------------------------------------------------------------------------------
+/// @brief      Creates the textures backing offscreen render targets.
+///
+///             The default implementation forwards every request to the
+///             resource allocator of the context. Subclasses may recycle
+///             textures across frames, in which case |Start| and |End| mark
+///             the boundaries of a frame.
+///
+class RenderTargetAllocator {
+ public:
+  explicit RenderTargetAllocator(std::shared_ptr<Allocator> allocator);
+
+  virtual ~RenderTargetAllocator() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a texture for use as a render target attachment.
+  ///
+  virtual std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the beginning of a frame workload.
+  ///
+  virtual void Start();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame workload.
+  ///
+  virtual void End();
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetAllocator);
+};
+
 class RenderTarget final {
  public:
   struct AttachmentConfig {
@@ -70,6 +107,25 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  static RenderTarget CreateOffscreen(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen",
+      AttachmentConfig color_attachment_config = kDefaultColorAttachmentConfig,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
+  static RenderTarget CreateOffscreenMSAA(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen MSAA",
+      AttachmentConfigMSAA color_attachment_config =
+          kDefaultColorAttachmentConfigMSAA,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
   RenderTarget();
 
   ~RenderTarget();
@@ -83,6 +139,14 @@ class RenderTarget final {
                               AttachmentConfig stencil_attachment_config =
                                   kDefaultStencilAttachmentConfig);
 
+  void SetupStencilAttachment(const Context& context,
+                              RenderTargetAllocator& allocator,
+                              ISize size,
+                              bool msaa,
+                              const std::string& label = "Offscreen",
+                              AttachmentConfig stencil_attachment_config =
+                                  kDefaultStencilAttachmentConfig);
+
   SampleCount GetSampleCount() const;
 
   bool HasColorAttachment(size_t index) const;
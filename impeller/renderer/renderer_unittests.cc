@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+
 #include "flutter/testing/testing.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/device_buffer_descriptor.h"
@@ -25,6 +27,7 @@
 #include "impeller/fixtures/test_texture.frag.h"
 #include "impeller/fixtures/test_texture.vert.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/image/backends/ktx2/compressed_image_ktx2.h"
 #include "impeller/image/compressed_image.h"
 #include "impeller/image/decompressed_image.h"
 #include "impeller/playground/playground_test.h"
@@ -35,6 +38,7 @@
 #include "impeller/renderer/renderer.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/surface.h"
+#include "impeller/renderer/texture_ktx2.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 #include "impeller/tessellator/tessellator.h"
 #include "third_party/imgui/imgui.h"
@@ -1006,6 +1010,109 @@ TEST_P(RendererTest, CanCreateCPUBackedTexture) {
   } while (dimension <= 8192);
 }
 
+/// @brief  Creates an 8x8 ETC2 RGB8 image in a KTX2 container, whose blocks
+///         each decode to a red and a blue half.
+///
+/// @param[in]  level_count  The number of levels, of 8x8, 4x4, 2x2 and 1x1
+///                          pixels.
+static std::shared_ptr<CompressedImageKTX2> CreateETC2Image(
+    uint32_t level_count = 1u) {
+  const uint8_t identifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  // Individual mode blocks with a modifier of +2 for every pixel.
+  const uint8_t block[] = {0xF0, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00};
+  std::vector<uint8_t> data(80u + level_count * 24u);
+  std::memcpy(data.data(), identifier, sizeof(identifier));
+  auto write_u32 = [&data](size_t offset, uint32_t value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+  };
+  write_u32(12u, 147u);         // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+  write_u32(20u, 8u);           // pixelWidth
+  write_u32(24u, 8u);           // pixelHeight
+  write_u32(36u, 1u);           // faceCount
+  write_u32(40u, level_count);  // levelCount
+  for (uint32_t level = 0u; level < level_count; level++) {
+    // Every level below the base level fits into a single block.
+    const size_t block_count = level == 0u ? 4u : 1u;
+    write_u32(80u + level * 24u, data.size());
+    write_u32(88u + level * 24u, block_count * sizeof(block));
+    for (size_t i = 0; i < block_count; i++) {
+      data.insert(data.end(), block, block + sizeof(block));
+    }
+  }
+  return CompressedImageKTX2::Create(
+      std::make_shared<fml::DataMapping>(std::move(data)));
+}
+
+TEST(TextureKTX2Test, FallsBackToRGBAWithoutCapabilities) {
+  auto capabilities = CapabilitiesBuilder().Build();
+  ASSERT_EQ(PixelFormatForKTX2Format(*capabilities,
+                                     CompressedImageKTX2::Format::kR8G8B8A8),
+            PixelFormat::kR8G8B8A8UNormInt);
+  ASSERT_FALSE(PixelFormatForKTX2Format(
+                   *capabilities, CompressedImageKTX2::Format::kETC2R8G8B8)
+                   .has_value());
+  ASSERT_FALSE(PixelFormatForKTX2Format(*capabilities,
+                                        CompressedImageKTX2::Format::kASTC4x4)
+                   .has_value());
+
+  capabilities = CapabilitiesBuilder()
+                     .SetSupportsTextureCompressionETC2(true)
+                     .SetSupportsTextureCompressionASTC(true)
+                     .Build();
+  ASSERT_EQ(PixelFormatForKTX2Format(
+                *capabilities, CompressedImageKTX2::Format::kETC2R8G8B8A8),
+            PixelFormat::kETC2R8G8B8A8UNormInt);
+  ASSERT_EQ(PixelFormatForKTX2Format(*capabilities,
+                                     CompressedImageKTX2::Format::kASTC4x4),
+            PixelFormat::kASTC4x4UNormInt);
+}
+
+TEST_P(RendererTest, CanCreateTexturesForKTX2Images) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto image = CreateETC2Image();
+  ASSERT_NE(image, nullptr);
+
+  auto texture = CreateTextureForKTX2Image(*context, *image);
+  ASSERT_TRUE(texture);
+  ASSERT_TRUE(texture->IsValid());
+  ASSERT_EQ(texture->GetSize(), ISize(8, 8));
+  // The blocks are only decoded on the CPU when the device can't sample them.
+  ASSERT_EQ(texture->GetTextureDescriptor().format,
+            context->GetCapabilities()->SupportsTextureCompressionETC2()
+                ? PixelFormat::kETC2R8G8B8UNormInt
+                : PixelFormat::kR8G8B8A8UNormInt);
+}
+
+TEST_P(RendererTest, CanCreateMipmappedTexturesForKTX2Images) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto image = CreateETC2Image(4u);
+  ASSERT_NE(image, nullptr);
+  ASSERT_EQ(image->GetMipCount(), 4u);
+
+  auto texture = CreateTextureForKTX2Image(*context, *image);
+  ASSERT_TRUE(texture);
+  ASSERT_TRUE(texture->IsValid());
+  // Every level is uploaded as is, but only the base level is decoded.
+  ASSERT_EQ(texture->GetMipCount(),
+            context->GetCapabilities()->SupportsTextureCompressionETC2() ? 4u
+                                                                         : 1u);
+  ASSERT_FALSE(texture->NeedsMipmapGeneration());
+}
+
+TEST_P(RendererTest, UploadsOnlyTheBaseLevelOfPartialKTX2Mipmaps) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto image = CreateETC2Image(2u);
+  ASSERT_NE(image, nullptr);
+
+  auto texture = CreateTextureForKTX2Image(*context, *image);
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(texture->GetMipCount(), 1u);
+}
+
 TEST_P(RendererTest, DefaultIndexSize) {
   using VS = BoxFadeVertexShader;
 
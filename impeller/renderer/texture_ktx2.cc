@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/texture_ktx2.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/core/allocator.h"
+
+namespace impeller {
+
+std::optional<PixelFormat> PixelFormatForKTX2Format(
+    const Capabilities& capabilities,
+    CompressedImageKTX2::Format format) {
+  switch (format) {
+    case CompressedImageKTX2::Format::kR8G8B8A8:
+      return PixelFormat::kR8G8B8A8UNormInt;
+    case CompressedImageKTX2::Format::kETC2R8G8B8:
+      if (capabilities.SupportsTextureCompressionETC2()) {
+        return PixelFormat::kETC2R8G8B8UNormInt;
+      }
+      return std::nullopt;
+    case CompressedImageKTX2::Format::kETC2R8G8B8A8:
+      if (capabilities.SupportsTextureCompressionETC2()) {
+        return PixelFormat::kETC2R8G8B8A8UNormInt;
+      }
+      return std::nullopt;
+    case CompressedImageKTX2::Format::kASTC4x4:
+      if (capabilities.SupportsTextureCompressionASTC()) {
+        return PixelFormat::kASTC4x4UNormInt;
+      }
+      return std::nullopt;
+  }
+  FML_UNREACHABLE();
+}
+
+// Whether the image has every level down to 1x1. Backends without a way to
+// limit the levels that are sampled can't sample from a partial mipmap.
+static bool HasCompleteMipChain(const CompressedImageKTX2& image) {
+  size_t level_count = 1u;
+  const auto& size = image.GetSize();
+  for (auto extent = std::max(size.width, size.height); extent > 1;
+       extent >>= 1) {
+    level_count++;
+  }
+  return image.GetMipCount() == level_count;
+}
+
+// Creates a texture with the given levels, where the first is the base level.
+static std::shared_ptr<Texture> CreateTextureWithContents(
+    const Context& context,
+    PixelFormat format,
+    ISize size,
+    std::vector<std::shared_ptr<const fml::Mapping>> levels) {
+  TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = StorageMode::kHostVisible;
+  texture_descriptor.format = format;
+  texture_descriptor.size = size;
+  texture_descriptor.mip_count = levels.size();
+
+  auto texture =
+      context.GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!texture) {
+    VALIDATION_LOG << "Could not allocate texture for KTX2 image.";
+    return nullptr;
+  }
+  texture->SetLabel("KTX2 Image");
+  if (!texture->SetContents(std::move(levels[0]))) {
+    VALIDATION_LOG << "Could not upload KTX2 image to device memory.";
+    return nullptr;
+  }
+  for (size_t level = 1u; level < levels.size(); level++) {
+    if (!texture->SetMipLevelContents(std::move(levels[level]), level)) {
+      VALIDATION_LOG << "Could not upload level " << level
+                     << " of KTX2 image to device memory.";
+      return nullptr;
+    }
+  }
+  return texture;
+}
+
+std::shared_ptr<Texture> CreateTextureForKTX2Image(
+    const Context& context,
+    const CompressedImageKTX2& image) {
+  TRACE_EVENT0("impeller", "CreateTextureForKTX2Image");
+  const auto format =
+      PixelFormatForKTX2Format(*context.GetCapabilities(), image.GetFormat());
+  if (format.has_value()) {
+    std::vector<std::shared_ptr<const fml::Mapping>> levels;
+    const size_t level_count =
+        HasCompleteMipChain(image) ? image.GetMipCount() : 1u;
+    for (size_t level = 0u; level < level_count; level++) {
+      levels.push_back(image.GetMipLevel(level));
+    }
+    return CreateTextureWithContents(context, format.value(), image.GetSize(),
+                                     std::move(levels));
+  }
+
+  auto decompressed = image.Decode(context.GetWorkerTaskRunner());
+  if (!decompressed.IsValid()) {
+    VALIDATION_LOG << "Could not decode KTX2 image.";
+    return nullptr;
+  }
+  return CreateTextureWithContents(context, PixelFormat::kR8G8B8A8UNormInt,
+                                   decompressed.GetSize(),
+                                   {decompressed.GetAllocation()});
+}
+
+}  // namespace impeller
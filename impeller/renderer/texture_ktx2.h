@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "impeller/core/formats.h"
+#include "impeller/core/texture.h"
+#include "impeller/image/backends/ktx2/compressed_image_ktx2.h"
+#include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Returns the pixel format that textures with the contents of an
+///             image in the format can be created with as is.
+///
+/// @return     The pixel format, or nullopt if the device can't sample from
+///             the format and the image needs to be decoded first.
+///
+std::optional<PixelFormat> PixelFormatForKTX2Format(
+    const Capabilities& capabilities,
+    CompressedImageKTX2::Format format);
+
+//------------------------------------------------------------------------------
+/// @brief      Creates a texture with the contents of the image.
+///
+///             The compressed blocks of every level are uploaded directly if
+///             the device supports their format, unless the levels stop short
+///             of 1x1, in which case only the base level is. Otherwise, the
+///             base level is decoded to RGBA on the worker task runner of the
+///             context first, which takes four to eight times the memory on
+///             the device.
+///
+/// @return     The texture, or `nullptr` if it could not be created.
+///
+std::shared_ptr<Texture> CreateTextureForKTX2Image(
+    const Context& context,
+    const CompressedImageKTX2& image);
+
+}  // namespace impeller
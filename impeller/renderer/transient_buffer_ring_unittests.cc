@@ -0,0 +1,185 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/transient_buffer_ring.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestDeviceBuffer : public DeviceBuffer {
+ public:
+  explicit TestDeviceBuffer(const DeviceBufferDescriptor& desc)
+      : DeviceBuffer(desc), storage_(desc.size) {}
+
+  bool SetLabel(const std::string& label) override { return true; }
+
+  bool SetLabel(const std::string& label, Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override {
+    return const_cast<uint8_t*>(storage_.data());
+  }
+
+  void Flush(std::optional<Range> range) override {
+    flushed_length_ += range.has_value() ? range->length : desc_.size;
+  }
+
+  size_t GetFlushedLength() const { return flushed_length_; }
+
+ private:
+  std::vector<uint8_t> storage_;
+  size_t flushed_length_ = 0u;
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    return false;
+  }
+};
+
+class TestAllocator : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override { return {}; }
+
+  size_t GetCreatedBufferCount() const { return created_buffer_count_; }
+
+ private:
+  size_t created_buffer_count_ = 0u;
+
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    EXPECT_EQ(desc.storage_mode, StorageMode::kHostVisible);
+    created_buffer_count_++;
+    return std::make_shared<TestDeviceBuffer>(desc);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+
+using Usage = TransientBufferRing::Usage;
+
+}  // namespace
+
+TEST(TransientBufferRingTest, WritesDirectlyIntoDeviceBuffers) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TransientBufferRing ring(allocator);
+
+  auto view = ring.Allocate(Usage::kVertex, 4u, 0u, [](uint8_t* contents) {
+    for (uint8_t i = 0; i < 4u; i++) {
+      contents[i] = i + 1;
+    }
+  });
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view.range, Range(0u, 4u));
+  EXPECT_EQ(view.contents[2], 3u);
+  auto device_buffer = view.buffer->GetDeviceBuffer(*allocator);
+  ASSERT_TRUE(device_buffer);
+  EXPECT_EQ(device_buffer->OnGetContents(), view.contents);
+  EXPECT_EQ(
+      static_cast<const TestDeviceBuffer&>(*device_buffer).GetFlushedLength(),
+      4u);
+}
+
+TEST(TransientBufferRingTest, SubAllocatesWithAlignment) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TransientBufferRing ring(allocator);
+
+  auto first = ring.Allocate(Usage::kUniform, 2u, 64u, nullptr);
+  auto second = ring.Allocate(Usage::kUniform, 2u, 64u, nullptr);
+  EXPECT_EQ(first.range, Range(0u, 2u));
+  EXPECT_EQ(second.range, Range(64u, 2u));
+  EXPECT_EQ(first.buffer, second.buffer);
+  EXPECT_EQ(allocator->GetCreatedBufferCount(), 1u);
+}
+
+TEST(TransientBufferRingTest, SeparatesUniformAndVertexData) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TransientBufferRing ring(allocator);
+
+  auto uniform = ring.Allocate(Usage::kUniform, 16u, 64u, nullptr);
+  auto vertex = ring.Allocate(Usage::kVertex, 16u, 4u, nullptr);
+  EXPECT_NE(uniform.buffer, vertex.buffer);
+  EXPECT_EQ(vertex.range.offset, 0u);
+  EXPECT_EQ(ring.GetBlockCount(Usage::kUniform), 1u);
+  EXPECT_EQ(ring.GetBlockCount(Usage::kVertex), 1u);
+}
+
+TEST(TransientBufferRingTest, RecyclesBlocksThatAreNoLongerReferenced) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TransientBufferRing ring(allocator);
+  constexpr size_t kHalfBlock = TransientBufferRing::kBlockSize / 2u;
+
+  // Fill two blocks while holding on to the views, as in-flight command
+  // buffers would.
+  std::vector<BufferView> in_flight;
+  for (size_t i = 0; i < 4u; i++) {
+    in_flight.push_back(
+        ring.Allocate(Usage::kVertex, kHalfBlock, 0u, nullptr));
+  }
+  EXPECT_EQ(ring.GetBlockCount(Usage::kVertex), 2u);
+  const Buffer* first_block = in_flight.front().buffer.get();
+
+  // A third block is needed while the first two are still referenced.
+  auto view = ring.Allocate(Usage::kVertex, kHalfBlock, 0u, nullptr);
+  EXPECT_EQ(ring.GetBlockCount(Usage::kVertex), 3u);
+
+  // Once the device is done with them, blocks are reused in order.
+  in_flight.clear();
+  view = ring.Allocate(Usage::kVertex, kHalfBlock, 0u, nullptr);
+  EXPECT_EQ(ring.GetBlockCount(Usage::kVertex), 3u);
+  view = ring.Allocate(Usage::kVertex, kHalfBlock, 0u, nullptr);
+  EXPECT_EQ(ring.GetBlockCount(Usage::kVertex), 3u);
+  EXPECT_EQ(view.buffer.get(), first_block);
+  EXPECT_EQ(view.range.offset, 0u);
+  EXPECT_EQ(allocator->GetCreatedBufferCount(), 3u);
+}
+
+TEST(TransientBufferRingTest, LargeAllocationsGetTheirOwnBuffer) {
+  auto allocator = std::make_shared<TestAllocator>();
+  TransientBufferRing ring(allocator);
+
+  auto view = ring.Allocate(
+      Usage::kVertex, TransientBufferRing::kBlockSize + 1u, 0u, nullptr);
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view.range.length, TransientBufferRing::kBlockSize + 1u);
+  EXPECT_EQ(ring.GetBlockCount(Usage::kVertex), 0u);
+}
+
+TEST(TransientBufferRingTest, HostBufferEmplacesIntoRing) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto ring = std::make_shared<TransientBufferRing>(allocator);
+  auto host_buffer = HostBuffer::Create(ring);
+
+  struct alignas(16) Uniform {
+    float value;
+  };
+  auto uniform = host_buffer->EmplaceUniform(Uniform{4.0f});
+  auto vertex = host_buffer->Emplace(uint32_t{7u});
+  ASSERT_TRUE(uniform);
+  ASSERT_TRUE(vertex);
+  EXPECT_NE(uniform.buffer, vertex.buffer);
+  EXPECT_EQ(*reinterpret_cast<const float*>(uniform.contents +
+                                            uniform.range.offset),
+            4.0f);
+  EXPECT_EQ(*reinterpret_cast<const uint32_t*>(vertex.contents +
+                                               vertex.range.offset),
+            7u);
+  // Nothing is accumulated in host memory.
+  EXPECT_EQ(host_buffer->GetLength(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
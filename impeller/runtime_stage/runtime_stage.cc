@@ -67,29 +67,17 @@ RuntimeStage::RuntimeStage(std::shared_ptr<fml::Mapping> payload)
   if (!fb::RuntimeStageBufferHasIdentifier(payload_->GetMapping())) {
     return;
   }
-  auto runtime_stage = fb::GetRuntimeStage(payload_->GetMapping());
-  if (!runtime_stage) {
+  runtime_stage_ = fb::GetRuntimeStage(payload_->GetMapping());
+  if (!runtime_stage_) {
     return;
   }
+  const auto* runtime_stage = runtime_stage_;
 
   stage_ = ToShaderStage(runtime_stage->stage());
   entrypoint_ = runtime_stage->entrypoint()->str();
 
-  auto* uniforms = runtime_stage->uniforms();
-  if (uniforms) {
-    for (auto i = uniforms->begin(), end = uniforms->end(); i != end; i++) {
-      RuntimeUniformDescription desc;
-      desc.name = i->name()->str();
-      desc.location = i->location();
-      desc.type = ToType(i->type());
-      desc.dimensions = RuntimeUniformDimensions{
-          static_cast<size_t>(i->rows()), static_cast<size_t>(i->columns())};
-      desc.bit_width = i->bit_width();
-      desc.array_elements = i->array_elements();
-      uniforms_.emplace_back(std::move(desc));
-    }
-  }
-
+  // The uniforms are only decoded once they are asked for. The code and SkSL
+  // are never copied out of the payload.
   code_mapping_ = std::make_shared<fml::NonOwnedMapping>(
       runtime_stage->shader()->data(),     //
       runtime_stage->shader()->size(),     //
@@ -121,13 +109,40 @@ const std::shared_ptr<fml::Mapping>& RuntimeStage::GetSkSLMapping() const {
   return sksl_mapping_;
 }
 
+void RuntimeStage::DecodeUniforms() const {
+  if (!uniforms_decoded_) {
+    // The stage was moved from.
+    return;
+  }
+  std::call_once(*uniforms_decoded_, [this]() {
+    if (!runtime_stage_ || !runtime_stage_->uniforms()) {
+      return;
+    }
+    const auto* uniforms = runtime_stage_->uniforms();
+    uniforms_.reserve(uniforms->size());
+    for (auto i = uniforms->begin(), end = uniforms->end(); i != end; i++) {
+      RuntimeUniformDescription desc;
+      desc.name = i->name()->str();
+      desc.location = i->location();
+      desc.type = ToType(i->type());
+      desc.dimensions = RuntimeUniformDimensions{
+          static_cast<size_t>(i->rows()), static_cast<size_t>(i->columns())};
+      desc.bit_width = i->bit_width();
+      desc.array_elements = i->array_elements();
+      uniforms_.emplace_back(std::move(desc));
+    }
+  });
+}
+
 const std::vector<RuntimeUniformDescription>& RuntimeStage::GetUniforms()
     const {
+  DecodeUniforms();
   return uniforms_;
 }
 
 const RuntimeUniformDescription* RuntimeStage::GetUniform(
     const std::string& name) const {
+  DecodeUniforms();
   for (const auto& uniform : uniforms_) {
     if (uniform.name == name) {
       return &uniform;
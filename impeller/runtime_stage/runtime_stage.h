@@ -5,7 +5,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
@@ -14,6 +16,10 @@
 
 namespace impeller {
 
+namespace fb {
+struct RuntimeStage;
+}  // namespace fb
+
 class RuntimeStage {
  public:
   explicit RuntimeStage(std::shared_ptr<fml::Mapping> payload);
@@ -26,6 +32,12 @@ class RuntimeStage {
 
   RuntimeShaderStage GetShaderStage() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The uniforms of the stage, in the order of their locations.
+  ///
+  ///             They are decoded from the payload on the first call to this
+  ///             method or to `GetUniform`.
+  ///
   const std::vector<RuntimeUniformDescription>& GetUniforms() const;
 
   const std::string& GetEntrypoint() const;
@@ -43,13 +55,19 @@ class RuntimeStage {
  private:
   RuntimeShaderStage stage_ = RuntimeShaderStage::kVertex;
   std::shared_ptr<fml::Mapping> payload_;
+  const fb::RuntimeStage* runtime_stage_ = nullptr;
   std::string entrypoint_;
   std::shared_ptr<fml::Mapping> code_mapping_;
   std::shared_ptr<fml::Mapping> sksl_mapping_;
-  std::vector<RuntimeUniformDescription> uniforms_;
+  // Held by pointer so that the stage stays movable.
+  std::unique_ptr<std::once_flag> uniforms_decoded_ =
+      std::make_unique<std::once_flag>();
+  mutable std::vector<RuntimeUniformDescription> uniforms_;
   bool is_valid_ = false;
   bool is_dirty_ = true;
 
+  void DecodeUniforms() const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(RuntimeStage);
 };
 
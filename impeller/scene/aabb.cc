@@ -0,0 +1,33 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/aabb.h"
+
+#include <cmath>
+
+namespace impeller {
+namespace scene {
+
+AABB AABB::TransformBounds(const Matrix& transform) const {
+  // Transform the center, and project the half extents of the box onto each
+  // axis of the transformed space.
+  const auto center = GetCenter();
+  const auto extent = GetSize() * 0.5f;
+  const auto& m = transform.m;
+  Vector3 new_center(
+      center.x * m[0] + center.y * m[4] + center.z * m[8] + m[12],
+      center.x * m[1] + center.y * m[5] + center.z * m[9] + m[13],
+      center.x * m[2] + center.y * m[6] + center.z * m[10] + m[14]);
+  Vector3 new_extent(
+      extent.x * std::abs(m[0]) + extent.y * std::abs(m[4]) +
+          extent.z * std::abs(m[8]),
+      extent.x * std::abs(m[1]) + extent.y * std::abs(m[5]) +
+          extent.z * std::abs(m[9]),
+      extent.x * std::abs(m[2]) + extent.y * std::abs(m[6]) +
+          extent.z * std::abs(m[10]));
+  return {new_center - new_extent, new_center + new_extent};
+}
+
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,49 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/vector.h"
+
+namespace impeller {
+namespace scene {
+
+//------------------------------------------------------------------------------
+/// @brief      An axis-aligned bounding box.
+///
+struct AABB {
+  Vector3 min;
+  Vector3 max;
+
+  constexpr bool operator==(const AABB& other) const {
+    return min == other.min && max == other.max;
+  }
+
+  constexpr bool operator!=(const AABB& other) const {
+    return !(*this == other);
+  }
+
+  constexpr Vector3 GetCenter() const { return (min + max) * 0.5f; }
+
+  constexpr Vector3 GetSize() const { return max - min; }
+
+  constexpr Scalar GetSurfaceArea() const {
+    auto size = GetSize();
+    return 2 * (size.x * size.y + size.y * size.z + size.z * size.x);
+  }
+
+  constexpr AABB Union(const AABB& other) const {
+    return {min.Min(other.min), max.Max(other.max)};
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the bounds of this box after it has been transformed
+  ///             by an affine transform.
+  ///
+  AABB TransformBounds(const Matrix& transform) const;
+};
+
+}  // namespace scene
+}  // namespace impeller
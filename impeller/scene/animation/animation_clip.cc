@@ -9,6 +9,7 @@
 #include <memory>
 #include <valarray>
 
+#include "flutter/fml/logging.h"
 #include "impeller/scene/node.h"
 
 namespace impeller {
@@ -111,15 +112,16 @@ void AnimationClip::Advance(SecondsF delta_time) {
 }
 
 void AnimationClip::ApplyToBindings(
-    std::unordered_map<Node*, AnimationTransforms>& transform_decomps,
+    std::vector<AnimationTransforms>& transform_decomps,
     Scalar weight_multiplier) const {
   for (auto& binding : bindings_) {
-    auto transforms = transform_decomps.find(binding.node);
-    if (transforms == transform_decomps.end()) {
+    if (!binding.target_index.has_value()) {
       continue;
     }
-    binding.channel.resolver->Apply(transforms->second, playback_time_,
-                                    weight_ * weight_multiplier);
+    FML_DCHECK(binding.target_index.value() < transform_decomps.size());
+    binding.channel.resolver->Apply(
+        transform_decomps[binding.target_index.value()], playback_time_,
+        weight_ * weight_multiplier);
   }
 }
 
@@ -5,7 +5,7 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -62,9 +62,10 @@ class AnimationClip final {
   void Advance(SecondsF delta_time);
 
   /// @brief  Applies the animation to all binded properties in the scene.
-  void ApplyToBindings(
-      std::unordered_map<Node*, AnimationTransforms>& transform_decomps,
-      Scalar weight_multiplier) const;
+  ///         The transforms are indexed by the target indices the player
+  ///         assigned to the bindings of this clip.
+  void ApplyToBindings(std::vector<AnimationTransforms>& transform_decomps,
+                       Scalar weight_multiplier) const;
 
  private:
   void BindToTarget(Node* node);
@@ -72,6 +73,9 @@ class AnimationClip final {
   struct ChannelBinding {
     const Animation::Channel& channel;
     Node* node;
+    /// The index of the transforms of `node` in the player that owns this
+    /// clip. Unset if the node transform can't be animated.
+    std::optional<size_t> target_index;
   };
 
   std::shared_ptr<Animation> animation_;
@@ -4,8 +4,9 @@
 
 #include "impeller/scene/animation/animation_player.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
-#include <unordered_map>
 
 #include "flutter/fml/time/time_point.h"
 #include "impeller/base/timing.h"
@@ -32,13 +33,21 @@ AnimationClip* AnimationPlayer::AddAnimation(
 
   // Record all of the unique default transforms that this AnimationClip
   // will mutate.
-  for (const auto& binding : clip.bindings_) {
+  for (auto& binding : clip.bindings_) {
+    auto found =
+        std::find(target_nodes_.begin(), target_nodes_.end(), binding.node);
+    if (found != target_nodes_.end()) {
+      binding.target_index = std::distance(target_nodes_.begin(), found);
+      continue;
+    }
     auto decomp = binding.node->GetLocalTransform().Decompose();
     if (!decomp.has_value()) {
       continue;
     }
-    target_transforms_.insert(
-        {binding.node, AnimationTransforms{.bind_pose = decomp.value()}});
+    binding.target_index = target_nodes_.size();
+    target_nodes_.push_back(binding.node);
+    target_transforms_.push_back(
+        AnimationTransforms{.bind_pose = decomp.value()});
   }
 
   auto result = clips_.insert({animation->GetName(), std::move(clip)});
@@ -62,7 +71,7 @@ void AnimationPlayer::Update() {
   previous_time_ = new_time;
 
   // Reset the animated pose state.
-  for (auto& [node, transforms] : target_transforms_) {
+  for (auto& transforms : target_transforms_) {
     transforms.animated_pose = transforms.bind_pose;
   }
 
@@ -80,8 +89,9 @@ void AnimationPlayer::Update() {
   }
 
   // Apply the animated pose to the bound joints.
-  for (auto& [node, transforms] : target_transforms_) {
-    node->SetLocalTransform(Matrix(transforms.animated_pose));
+  for (size_t i = 0; i < target_nodes_.size(); i++) {
+    target_nodes_[i]->SetLocalTransform(
+        Matrix(target_transforms_[i].animated_pose));
   }
 }
 
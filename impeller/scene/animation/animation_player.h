@@ -39,7 +39,11 @@ class AnimationPlayer final {
   void Update();
 
  private:
-  std::unordered_map<Node*, AnimationTransforms> target_transforms_;
+  /// The nodes animated by the clips, and their transforms at the same
+  /// indices. Clips refer to their targets by index, so that applying them
+  /// walks flat arrays instead of looking nodes up every frame.
+  std::vector<Node*> target_nodes_;
+  std::vector<AnimationTransforms> target_transforms_;
 
   std::map<std::string, AnimationClip> clips_;
 
@@ -66,11 +66,28 @@ TimelineResolver::TimelineKey TimelineResolver::GetTimelineKey(SecondsF time) {
   if (time.count() >= times_.back()) {
     return {.index = times_.size() - 1, .lerp = 1};
   }
-  auto it = std::lower_bound(times_.begin(), times_.end(), time.count());
-  size_t index = std::distance(times_.begin(), it);
 
-  Scalar previous_time = *(it - 1);
-  Scalar next_time = *it;
+  // The key is the first time that isn't less than `time`. Check the
+  // keyframes around the one found last before searching the whole timeline.
+  auto is_key = [&](size_t index) {
+    return index > 0 && index < times_.size() &&
+           times_[index - 1] < time.count() && times_[index] >= time.count();
+  };
+  size_t index;
+  if (is_key(cursor_)) {
+    index = cursor_;
+  } else if (is_key(cursor_ + 1)) {
+    index = cursor_ + 1;
+  } else if (cursor_ > 0 && is_key(cursor_ - 1)) {
+    index = cursor_ - 1;
+  } else {
+    auto it = std::lower_bound(times_.begin(), times_.end(), time.count());
+    index = std::distance(times_.begin(), it);
+  }
+  cursor_ = index;
+
+  Scalar previous_time = times_[index - 1];
+  Scalar next_time = times_[index];
   return {.index = index,
           .lerp = (time.count() - previous_time) / (next_time - previous_time)};
 }
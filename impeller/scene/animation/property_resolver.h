@@ -71,6 +71,12 @@ class TimelineResolver : public PropertyResolver {
   TimelineKey GetTimelineKey(SecondsF time);
 
   std::vector<Scalar> times_;
+
+ private:
+  /// The keyframe index found by the last call to `GetTimelineKey`. Clips
+  /// usually play forward (or backward) in small steps, so the next key is
+  /// almost always at or next to it.
+  size_t cursor_ = 0;
 };
 
 class TranslationTimelineResolver final : public TimelineResolver {
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/scene/animation/property_resolver.h"
+
+namespace impeller {
+namespace scene {
+namespace testing {
+
+namespace {
+
+/// Evaluates a translation timeline whose X coordinate is equal to the time
+/// of each keyframe, so that the resolved X coordinate is the time itself.
+class IdentityTimeline {
+ public:
+  IdentityTimeline() {
+    std::vector<Scalar> times = {0, 0.5, 1, 2, 2.5, 4};
+    std::vector<Vector3> values;
+    for (auto time : times) {
+      values.push_back({time, 0, 0});
+    }
+    resolver_ = PropertyResolver::MakeTranslationTimeline(std::move(times),
+                                                          std::move(values));
+  }
+
+  Scalar Resolve(Scalar time) {
+    AnimationTransforms transforms;
+    resolver_->Apply(transforms, SecondsF(time), 1);
+    return transforms.animated_pose.translation.x;
+  }
+
+ private:
+  std::unique_ptr<TranslationTimelineResolver> resolver_;
+};
+
+}  // namespace
+
+TEST(PropertyResolverTest, ResolvesTimelinePlayedForward) {
+  IdentityTimeline timeline;
+  for (Scalar time = 0; time <= 4; time += 0.05) {
+    EXPECT_NEAR(timeline.Resolve(time), time, 1e-5);
+  }
+}
+
+TEST(PropertyResolverTest, ResolvesTimelinePlayedBackward) {
+  IdentityTimeline timeline;
+  for (Scalar time = 4; time >= 0; time -= 0.05) {
+    EXPECT_NEAR(timeline.Resolve(time), time, 1e-5);
+  }
+}
+
+TEST(PropertyResolverTest, ResolvesTimelineAfterSeeking) {
+  IdentityTimeline timeline;
+  for (Scalar time : {3.5f, 0.25f, 0.75f, 3.9f, 1.5f, 2.25f, 0.1f, 2.5f}) {
+    EXPECT_NEAR(timeline.Resolve(time), time, 1e-5);
+  }
+}
+
+TEST(PropertyResolverTest, ClampsTimeToTimeline) {
+  IdentityTimeline timeline;
+  EXPECT_EQ(timeline.Resolve(-1), 0);
+  EXPECT_EQ(timeline.Resolve(5), 4);
+  EXPECT_EQ(timeline.Resolve(-1), 0);
+}
+
+}  // namespace testing
+}  // namespace scene
+}  // namespace impeller
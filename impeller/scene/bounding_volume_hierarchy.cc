@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/bounding_volume_hierarchy.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+namespace scene {
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() = default;
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy() = default;
+
+void BoundingVolumeHierarchy::BeginUpdate() {
+  for (auto& item : items_) {
+    item.updated = false;
+  }
+  moved_items_.clear();
+}
+
+void BoundingVolumeHierarchy::Update(Node* node, const AABB& bounds) {
+  auto found = item_indices_.find(node);
+  if (found == item_indices_.end()) {
+    item_indices_[node] = items_.size();
+    items_.push_back({.node = node, .bounds = bounds, .updated = true});
+    needs_build_ = true;
+    return;
+  }
+  auto& item = items_[found->second];
+  item.updated = true;
+  if (item.bounds != bounds) {
+    item.bounds = bounds;
+    moved_items_.push_back(found->second);
+  }
+}
+
+void BoundingVolumeHierarchy::EndUpdate() {
+  auto removed = std::remove_if(items_.begin(), items_.end(),
+                                [](const Item& item) { return !item.updated; });
+  if (removed != items_.end()) {
+    items_.erase(removed, items_.end());
+    item_indices_.clear();
+    for (size_t i = 0; i < items_.size(); i++) {
+      item_indices_[items_[i].node] = i;
+    }
+    needs_build_ = true;
+  }
+
+  if (!needs_build_) {
+    for (auto index : moved_items_) {
+      Refit(items_[index]);
+    }
+    needs_build_ = !tree_.empty() && tree_[0].bounds.GetSurfaceArea() >
+                                         built_surface_area_ *
+                                             kRebuildSurfaceAreaRatio;
+  }
+  moved_items_.clear();
+
+  if (needs_build_) {
+    Build();
+  }
+}
+
+void BoundingVolumeHierarchy::Query(const Frustum& frustum,
+                                    std::vector<Node*>& result) const {
+  if (tree_.empty()) {
+    return;
+  }
+  std::vector<int32_t> stack = {0};
+  while (!stack.empty()) {
+    const auto index = stack.back();
+    stack.pop_back();
+    const auto& tree_node = tree_[index];
+    switch (frustum.Classify(tree_node.bounds)) {
+      case Frustum::Containment::kOutside:
+        break;
+      case Frustum::Containment::kInside:
+        CollectLeaves(index, result);
+        break;
+      case Frustum::Containment::kIntersecting:
+        if (tree_node.item >= 0) {
+          result.push_back(items_[tree_node.item].node);
+        } else {
+          stack.push_back(tree_node.right);
+          stack.push_back(tree_node.left);
+        }
+        break;
+    }
+  }
+}
+
+size_t BoundingVolumeHierarchy::GetNodeCount() const {
+  return items_.size();
+}
+
+size_t BoundingVolumeHierarchy::GetBuildCount() const {
+  return build_count_;
+}
+
+void BoundingVolumeHierarchy::Build() {
+  TRACE_EVENT0("impeller", "BoundingVolumeHierarchy::Build");
+  needs_build_ = false;
+  build_count_++;
+  tree_.clear();
+  if (items_.empty()) {
+    built_surface_area_ = 0;
+    return;
+  }
+  tree_.reserve(items_.size() * 2 - 1);
+  std::vector<size_t> indices(items_.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    indices[i] = i;
+  }
+  BuildRange(indices, 0, indices.size(), -1);
+  built_surface_area_ = tree_[0].bounds.GetSurfaceArea();
+}
+
+int32_t BoundingVolumeHierarchy::BuildRange(std::vector<size_t>& items,
+                                            size_t begin,
+                                            size_t end,
+                                            int32_t parent) {
+  const auto index = static_cast<int32_t>(tree_.size());
+  tree_.push_back({.parent = parent});
+
+  if (end - begin == 1) {
+    auto& item = items_[items[begin]];
+    item.leaf = index;
+    tree_[index].bounds = item.bounds;
+    tree_[index].item = static_cast<int32_t>(items[begin]);
+    return index;
+  }
+
+  // Split the items at the median of their centers, along the axis in which
+  // the centers are spread the most.
+  AABB centers{items_[items[begin]].bounds.GetCenter(),
+               items_[items[begin]].bounds.GetCenter()};
+  for (size_t i = begin + 1; i < end; i++) {
+    auto center = items_[items[i]].bounds.GetCenter();
+    centers = centers.Union({center, center});
+  }
+  auto spread = centers.GetSize();
+  int axis = spread.x >= spread.y && spread.x >= spread.z ? 0
+             : spread.y >= spread.z                        ? 1
+                                                           : 2;
+  auto axis_center = [&](size_t item) {
+    auto center = items_[item].bounds.GetCenter();
+    return axis == 0 ? center.x : axis == 1 ? center.y : center.z;
+  };
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(items.begin() + begin, items.begin() + middle,
+                   items.begin() + end, [&](size_t a, size_t b) {
+                     return axis_center(a) < axis_center(b);
+                   });
+
+  const auto left = BuildRange(items, begin, middle, index);
+  const auto right = BuildRange(items, middle, end, index);
+  auto& tree_node = tree_[index];
+  tree_node.left = left;
+  tree_node.right = right;
+  tree_node.bounds = tree_[left].bounds.Union(tree_[right].bounds);
+  return index;
+}
+
+void BoundingVolumeHierarchy::Refit(const Item& item) {
+  tree_[item.leaf].bounds = item.bounds;
+  // Walk up the hierarchy until the bounds of an ancestor are unaffected.
+  for (auto index = tree_[item.leaf].parent; index >= 0;
+       index = tree_[index].parent) {
+    auto& tree_node = tree_[index];
+    auto bounds =
+        tree_[tree_node.left].bounds.Union(tree_[tree_node.right].bounds);
+    if (bounds == tree_node.bounds) {
+      break;
+    }
+    tree_node.bounds = bounds;
+  }
+}
+
+void BoundingVolumeHierarchy::CollectLeaves(int32_t tree_node,
+                                            std::vector<Node*>& result) const {
+  const auto& node = tree_[tree_node];
+  if (node.item >= 0) {
+    result.push_back(items_[node.item].node);
+    return;
+  }
+  CollectLeaves(node.left, result);
+  CollectLeaves(node.right, result);
+}
+
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/scene/aabb.h"
+#include "impeller/scene/frustum.h"
+
+namespace impeller {
+namespace scene {
+
+class Node;
+
+//------------------------------------------------------------------------------
+/// @brief      A binary bounding volume hierarchy over the world space bounds
+///             of the nodes of a scene.
+///
+///             The hierarchy is kept up to date across frames. Every frame,
+///             the bounds of all nodes are submitted between `BeginUpdate` and
+///             `EndUpdate`. Nodes whose bounds moved are refit in place, by
+///             updating the bounds of their ancestors in the hierarchy. The
+///             hierarchy is only rebuilt when nodes are added or removed, or
+///             when refitting has degraded it too much.
+///
+class BoundingVolumeHierarchy {
+ public:
+  /// The hierarchy is rebuilt once refitting has grown the surface area of
+  /// its root by this factor since it was last built.
+  static constexpr Scalar kRebuildSurfaceAreaRatio = 2;
+
+  BoundingVolumeHierarchy();
+
+  ~BoundingVolumeHierarchy();
+
+  void BeginUpdate();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Inserts a node, or updates its bounds if it is already part
+  ///             of the hierarchy.
+  ///
+  void Update(Node* node, const AABB& bounds);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the nodes that were not updated since `BeginUpdate`,
+  ///             and refits or rebuilds the hierarchy.
+  ///
+  void EndUpdate();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the nodes whose bounds intersect the frustum to
+  ///             `result`.
+  ///
+  void Query(const Frustum& frustum, std::vector<Node*>& result) const;
+
+  size_t GetNodeCount() const;
+
+  /// The number of times the hierarchy has been built. Exposed for testing.
+  size_t GetBuildCount() const;
+
+ private:
+  struct Item {
+    Node* node = nullptr;
+    AABB bounds;
+    int32_t leaf = -1;
+    bool updated = false;
+  };
+
+  struct TreeNode {
+    AABB bounds;
+    int32_t parent = -1;
+    int32_t left = -1;
+    int32_t right = -1;
+    /// The index of the item of leaves, or -1 for inner nodes.
+    int32_t item = -1;
+  };
+
+  std::vector<Item> items_;
+  std::unordered_map<Node*, size_t> item_indices_;
+  std::vector<size_t> moved_items_;
+  std::vector<TreeNode> tree_;
+  bool needs_build_ = false;
+  Scalar built_surface_area_ = 0;
+  size_t build_count_ = 0;
+
+  void Build();
+
+  int32_t BuildRange(std::vector<size_t>& items,
+                     size_t begin,
+                     size_t end,
+                     int32_t parent);
+
+  void Refit(const Item& item);
+
+  void CollectLeaves(int32_t tree_node, std::vector<Node*>& result) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BoundingVolumeHierarchy);
+};
+
+}  // namespace scene
+}  // namespace impeller
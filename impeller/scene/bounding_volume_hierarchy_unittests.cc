@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/scene/bounding_volume_hierarchy.h"
+#include "impeller/scene/camera.h"
+#include "impeller/scene/frustum.h"
+#include "impeller/scene/node.h"
+
+namespace impeller {
+namespace scene {
+namespace testing {
+
+namespace {
+
+AABB MakeUnitBox(Vector3 origin) {
+  return {origin, origin + Vector3(1, 1, 1)};
+}
+
+Frustum MakeFrustumLookingAtOrigin() {
+  auto camera = Camera::MakePerspective(Degrees(60), {0, 0, -10})
+                    .LookAt({0, 0, 0}, {0, 1, 0});
+  return Frustum::MakeFromTransform(camera.GetTransform({100, 100}));
+}
+
+std::vector<std::unique_ptr<Node>> MakeNodes(size_t count) {
+  std::vector<std::unique_ptr<Node>> nodes;
+  for (size_t i = 0; i < count; i++) {
+    nodes.push_back(std::make_unique<Node>());
+  }
+  return nodes;
+}
+
+}  // namespace
+
+TEST(BoundingVolumeHierarchyTest, QueriesNodesInsideFrustum) {
+  auto nodes = MakeNodes(100);
+  BoundingVolumeHierarchy bvh;
+  bvh.BeginUpdate();
+  for (size_t i = 0; i < nodes.size(); i++) {
+    // Only the first node is in front of the camera.
+    bvh.Update(nodes[i].get(), MakeUnitBox({i * 100.0f, 0, 0}));
+  }
+  bvh.EndUpdate();
+  EXPECT_EQ(bvh.GetNodeCount(), 100u);
+
+  std::vector<Node*> visible;
+  bvh.Query(MakeFrustumLookingAtOrigin(), visible);
+  ASSERT_EQ(visible.size(), 1u);
+  EXPECT_EQ(visible[0], nodes[0].get());
+}
+
+TEST(BoundingVolumeHierarchyTest, MatchesBruteForceCulling) {
+  auto nodes = MakeNodes(500);
+  std::vector<AABB> bounds;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    // Scatter the boxes deterministically around the camera.
+    auto x = static_cast<Scalar>((i * 37) % 101) - 50;
+    auto y = static_cast<Scalar>((i * 53) % 97) - 48;
+    auto z = static_cast<Scalar>((i * 71) % 89) - 44;
+    bounds.push_back(MakeUnitBox({x, y, z}));
+  }
+
+  BoundingVolumeHierarchy bvh;
+  bvh.BeginUpdate();
+  for (size_t i = 0; i < nodes.size(); i++) {
+    bvh.Update(nodes[i].get(), bounds[i]);
+  }
+  bvh.EndUpdate();
+
+  auto frustum = MakeFrustumLookingAtOrigin();
+  std::vector<Node*> visible;
+  bvh.Query(frustum, visible);
+  std::vector<Node*> expected;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (frustum.Intersects(bounds[i])) {
+      expected.push_back(nodes[i].get());
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+  std::sort(visible.begin(), visible.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(visible, expected);
+}
+
+TEST(BoundingVolumeHierarchyTest, RefitsMovedNodesWithoutRebuilding) {
+  auto nodes = MakeNodes(2);
+  BoundingVolumeHierarchy bvh;
+  bvh.BeginUpdate();
+  bvh.Update(nodes[0].get(), MakeUnitBox({0, 0, 0}));
+  bvh.Update(nodes[1].get(), MakeUnitBox({2, 0, 0}));
+  bvh.EndUpdate();
+  EXPECT_EQ(bvh.GetBuildCount(), 1u);
+
+  // Moving a node out of view.
+  bvh.BeginUpdate();
+  bvh.Update(nodes[0].get(), MakeUnitBox({0, 0, 0}));
+  bvh.Update(nodes[1].get(), MakeUnitBox({3, 0, 0}));
+  bvh.EndUpdate();
+  EXPECT_EQ(bvh.GetBuildCount(), 1u);
+
+  bvh.BeginUpdate();
+  bvh.Update(nodes[0].get(), MakeUnitBox({0, 0, 0}));
+  bvh.Update(nodes[1].get(), MakeUnitBox({0, 0, -50}));
+  bvh.EndUpdate();
+  // The root bounds grew considerably, so the hierarchy was rebuilt.
+  EXPECT_EQ(bvh.GetBuildCount(), 2u);
+
+  std::vector<Node*> visible;
+  bvh.Query(MakeFrustumLookingAtOrigin(), visible);
+  ASSERT_EQ(visible.size(), 1u);
+  EXPECT_EQ(visible[0], nodes[0].get());
+}
+
+TEST(BoundingVolumeHierarchyTest, RemovesNodesThatWereNotUpdated) {
+  auto nodes = MakeNodes(3);
+  BoundingVolumeHierarchy bvh;
+  bvh.BeginUpdate();
+  for (auto& node : nodes) {
+    bvh.Update(node.get(), MakeUnitBox({0, 0, 0}));
+  }
+  bvh.EndUpdate();
+
+  bvh.BeginUpdate();
+  bvh.Update(nodes[2].get(), MakeUnitBox({0, 0, 0}));
+  bvh.EndUpdate();
+  EXPECT_EQ(bvh.GetNodeCount(), 1u);
+  EXPECT_EQ(bvh.GetBuildCount(), 2u);
+
+  std::vector<Node*> visible;
+  bvh.Query(MakeFrustumLookingAtOrigin(), visible);
+  ASSERT_EQ(visible.size(), 1u);
+  EXPECT_EQ(visible[0], nodes[2].get());
+}
+
+}  // namespace testing
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/frustum.h"
+
+namespace impeller {
+namespace scene {
+
+Frustum Frustum::MakeFromTransform(const Matrix& view_projection) {
+  const auto& m = view_projection.m;
+  // The rows of the column-major transform.
+  const Vector4 x(m[0], m[4], m[8], m[12]);
+  const Vector4 y(m[1], m[5], m[9], m[13]);
+  const Vector4 z(m[2], m[6], m[10], m[14]);
+  const Vector4 w(m[3], m[7], m[11], m[15]);
+
+  Frustum frustum;
+  frustum.planes_ = {
+      w + x,  // Left.
+      w - x,  // Right.
+      w + y,  // Bottom.
+      w - y,  // Top.
+      z,      // Near.
+      w - z,  // Far.
+  };
+  return frustum;
+}
+
+Frustum::Containment Frustum::Classify(const AABB& box) const {
+  auto result = Containment::kInside;
+  for (const auto& plane : planes_) {
+    // The corners of the box that are the furthest along and the furthest
+    // against the plane normal.
+    Vector3 positive(plane.x >= 0 ? box.max.x : box.min.x,
+                     plane.y >= 0 ? box.max.y : box.min.y,
+                     plane.z >= 0 ? box.max.z : box.min.z);
+    Vector3 negative(plane.x >= 0 ? box.min.x : box.max.x,
+                     plane.y >= 0 ? box.min.y : box.max.y,
+                     plane.z >= 0 ? box.min.z : box.max.z);
+    if (Vector3(plane.x, plane.y, plane.z).Dot(positive) + plane.w < 0) {
+      return Containment::kOutside;
+    }
+    if (Vector3(plane.x, plane.y, plane.z).Dot(negative) + plane.w < 0) {
+      result = Containment::kIntersecting;
+    }
+  }
+  return result;
+}
+
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/scene/aabb.h"
+
+namespace impeller {
+namespace scene {
+
+//------------------------------------------------------------------------------
+/// @brief      The volume of space that is visible through a camera, bounded
+///             by six planes.
+///
+class Frustum {
+ public:
+  enum class Containment {
+    kOutside,
+    kIntersecting,
+    kInside,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Extracts the frustum planes from a view projection transform.
+  ///             Clip space depth is expected to range from 0 to 1, as it does
+  ///             for the transforms created by `Camera`.
+  ///
+  static Frustum MakeFromTransform(const Matrix& view_projection);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Classifies a box as being entirely outside, partially inside,
+  ///             or entirely inside the frustum.
+  ///
+  ///             The test is conservative: boxes that are close to a corner of
+  ///             the frustum may be classified as intersecting even though
+  ///             they are outside.
+  ///
+  Containment Classify(const AABB& box) const;
+
+  bool Intersects(const AABB& box) const {
+    return Classify(box) != Containment::kOutside;
+  }
+
+ private:
+  /// Planes in the form `ax + by + cz + d`, with normals pointing inward.
+  std::array<Vector4, 6> planes_;
+};
+
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,53 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/geometry/geometry_asserts.h"
+#include "impeller/scene/aabb.h"
+#include "impeller/scene/camera.h"
+#include "impeller/scene/frustum.h"
+
+namespace impeller {
+namespace scene {
+namespace testing {
+
+static AABB MakeCube(Vector3 center, Scalar half_size) {
+  return {center - Vector3(half_size, half_size, half_size),
+          center + Vector3(half_size, half_size, half_size)};
+}
+
+TEST(AABBTest, TransformBoundsOfRotatedBox) {
+  AABB box = {Vector3(-1, -2, -3), Vector3(1, 2, 3)};
+  auto bounds = box.TransformBounds(Matrix::MakeTranslation({10, 0, 0}) *
+                                    Matrix::MakeRotationZ(Degrees(90)));
+  ASSERT_VECTOR3_NEAR(bounds.min, Vector3(8, -1, -3));
+  ASSERT_VECTOR3_NEAR(bounds.max, Vector3(12, 1, 3));
+}
+
+TEST(FrustumTest, ClassifiesBoxesAgainstCameraFrustum) {
+  auto camera = Camera::MakePerspective(Degrees(60), {0, 0, -10})
+                    .LookAt({0, 0, 0}, {0, 1, 0});
+  auto frustum = Frustum::MakeFromTransform(camera.GetTransform({100, 100}));
+
+  EXPECT_EQ(frustum.Classify(MakeCube({0, 0, 0}, 1)),
+            Frustum::Containment::kInside);
+  EXPECT_EQ(frustum.Classify(MakeCube({0, 0, 0}, 100)),
+            Frustum::Containment::kIntersecting);
+  // Behind the camera.
+  EXPECT_EQ(frustum.Classify(MakeCube({0, 0, -20}, 1)),
+            Frustum::Containment::kOutside);
+  // Off to the side.
+  EXPECT_EQ(frustum.Classify(MakeCube({50, 0, 0}, 1)),
+            Frustum::Containment::kOutside);
+  EXPECT_EQ(frustum.Classify(MakeCube({0, -50, 0}, 1)),
+            Frustum::Containment::kOutside);
+  // Beyond the far plane.
+  EXPECT_EQ(frustum.Classify(MakeCube({0, 0, 2000}, 1)),
+            Frustum::Containment::kOutside);
+  EXPECT_TRUE(frustum.Intersects(MakeCube({5, 0, 0}, 1)));
+}
+
+}  // namespace testing
+}  // namespace scene
+}  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/scene/geometry.h"
 
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -16,9 +17,13 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
+#include "impeller/scene/importer/vertex_quantization.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
+#include "impeller/scene/shaders/unskinned_quantized.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -64,6 +69,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<AABB> position_bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -81,6 +87,23 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       is_skinned = true;
       break;
     }
+    case fb::VertexBuffer::QuantizedVertexBuffer: {
+      static_assert(sizeof(fb::QuantizedVertex) ==
+                    sizeof(importer::QuantizedVertex));
+      const auto* quantized = mesh.vertices_as_QuantizedVertexBuffer();
+      if (!quantized->position_bounds()) {
+        VALIDATION_LOG << "Quantized vertices are missing position bounds.";
+        return nullptr;
+      }
+      const auto* vertices = quantized->vertices();
+      vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
+      vertices_bytes = vertices->size() * sizeof(fb::QuantizedVertex);
+      is_skinned = false;
+      position_bounds =
+          AABB{importer::ToVector3(quantized->position_bounds()->min()),
+               importer::ToVector3(quantized->position_bounds()->max())};
+      break;
+    }
     case fb::VertexBuffer::NONE:
       VALIDATION_LOG << "Invalid vertex buffer type.";
       return nullptr;
@@ -116,11 +139,59 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .vertex_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  std::shared_ptr<Geometry> geometry;
+  if (position_bounds.has_value()) {
+    auto quantized = std::make_shared<QuantizedVertexBufferGeometry>();
+    quantized->SetVertexBuffer(std::move(vertex_buffer),
+                               position_bounds.value());
+    geometry = std::move(quantized);
+  } else {
+    geometry = MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  }
+  // Skinned vertices are moved by their joints, so the bounds of the bind
+  // pose don't bound them.
+  if (mesh.bounds() && !is_skinned) {
+    geometry->SetBounds(AABB{importer::ToVector3(mesh.bounds()->min()),
+                             importer::ToVector3(mesh.bounds()->max())});
+  }
+  return geometry;
+}
+
+bool Geometry::BindInstancesToCommand(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const std::vector<Matrix>& transforms,
+                                      Command& command) const {
+  return false;
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
 
+static bool BindUnskinnedInstances(HostBuffer& buffer,
+                                   const std::vector<Matrix>& transforms,
+                                   Command& command) {
+  if (transforms.empty()) {
+    return false;
+  }
+  auto instance_info =
+      buffer.Emplace(transforms.data(), transforms.size() * sizeof(Matrix),
+                     DefaultUniformAlignment(),
+                     TransientBufferRing::Usage::kUniform);
+  if (!instance_info) {
+    return false;
+  }
+  UnskinnedInstancedVertexShader::BindInstanceInfo(command, instance_info);
+  command.instance_count = transforms.size();
+  return true;
+}
+
+void Geometry::SetBounds(std::optional<AABB> bounds) {
+  bounds_ = bounds;
+}
+
+const std::optional<AABB>& Geometry::GetBounds() const {
+  return bounds_;
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
@@ -173,6 +244,17 @@ void CuboidGeometry::BindToCommand(const SceneContext& scene_context,
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+bool CuboidGeometry::BindInstancesToCommand(
+    const SceneContext& scene_context,
+    HostBuffer& buffer,
+    const std::vector<Matrix>& transforms,
+    Command& command) const {
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+  return BindUnskinnedInstances(buffer, transforms, command);
+}
+
 //------------------------------------------------------------------------------
 /// UnskinnedVertexBufferGeometry
 ///
@@ -211,6 +293,124 @@ void UnskinnedVertexBufferGeometry::BindToCommand(
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+bool UnskinnedVertexBufferGeometry::BindInstancesToCommand(
+    const SceneContext& scene_context,
+    HostBuffer& buffer,
+    const std::vector<Matrix>& transforms,
+    Command& command) const {
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+  return BindUnskinnedInstances(buffer, transforms, command);
+}
+
+//------------------------------------------------------------------------------
+/// QuantizedVertexBufferGeometry
+///
+
+QuantizedVertexBufferGeometry::QuantizedVertexBufferGeometry() = default;
+
+QuantizedVertexBufferGeometry::~QuantizedVertexBufferGeometry() = default;
+
+void QuantizedVertexBufferGeometry::SetVertexBuffer(VertexBuffer vertex_buffer,
+                                                    AABB position_bounds) {
+  vertex_buffer_ = std::move(vertex_buffer);
+  position_bounds_ = position_bounds;
+  decoded_vertex_buffer_.reset();
+}
+
+// |Geometry|
+GeometryType QuantizedVertexBufferGeometry::GetGeometryType() const {
+  return GeometryType::kUnskinnedQuantized;
+}
+
+// |Geometry|
+VertexBuffer QuantizedVertexBufferGeometry::GetVertexBuffer(
+    Allocator& allocator) const {
+  return vertex_buffer_;
+}
+
+// |Geometry|
+void QuantizedVertexBufferGeometry::BindToCommand(
+    const SceneContext& scene_context,
+    HostBuffer& buffer,
+    const Matrix& transform,
+    Command& command) const {
+  auto& allocator = *scene_context.GetContext()->GetResourceAllocator();
+  if (!scene_context.GetContext()->GetCapabilities()->SupportsSSBO()) {
+    // The pipeline of this geometry type is the unskinned pipeline.
+    command.BindVertices(GetDecodedVertexBuffer(allocator));
+
+    UnskinnedVertexShader::FrameInfo info;
+    info.mvp = transform;
+    UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
+    return;
+  }
+
+  // The vertex shader pulls the vertices from the storage buffer, so only the
+  // indices are read through the vertex buffer.
+  command.BindVertices(GetVertexBuffer(allocator));
+  UnskinnedQuantizedVertexShader::BindVertexData(command,
+                                                 vertex_buffer_.vertex_buffer);
+
+  UnskinnedQuantizedVertexShader::FrameInfo info;
+  info.mvp = transform;
+  info.position_offset = Vector4(position_bounds_.min);
+  info.position_scale = Vector4(position_bounds_.GetSize());
+  UnskinnedQuantizedVertexShader::BindFrameInfo(command,
+                                                buffer.EmplaceUniform(info));
+}
+
+const VertexBuffer& QuantizedVertexBufferGeometry::GetDecodedVertexBuffer(
+    Allocator& allocator) const {
+  if (decoded_vertex_buffer_.has_value()) {
+    return decoded_vertex_buffer_.value();
+  }
+
+  const auto& view = vertex_buffer_.vertex_buffer;
+  auto device_buffer = view.buffer->GetDeviceBuffer(allocator);
+  const uint8_t* contents =
+      device_buffer ? device_buffer->OnGetContents() : nullptr;
+  if (!contents) {
+    VALIDATION_LOG << "Could not read quantized vertices.";
+    decoded_vertex_buffer_ = VertexBuffer{};
+    return decoded_vertex_buffer_.value();
+  }
+
+  const size_t vertex_count =
+      view.range.length / sizeof(importer::QuantizedVertex);
+  std::vector<UnskinnedVertexShader::PerVertexData> vertices;
+  vertices.reserve(vertex_count);
+  for (size_t i = 0; i < vertex_count; i++) {
+    importer::QuantizedVertex quantized;
+    std::memcpy(&quantized,
+                contents + view.range.offset +
+                    i * sizeof(importer::QuantizedVertex),
+                sizeof(quantized));
+    const auto vertex = importer::DequantizeVertex(
+        quantized, position_bounds_.min, position_bounds_.max);
+    vertices.push_back({vertex.position, vertex.normal, vertex.tangent,
+                        vertex.texture_coords, vertex.color});
+  }
+
+  auto decoded = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(vertices.data()),
+      vertices.size() * sizeof(UnskinnedVertexShader::PerVertexData));
+  if (!decoded) {
+    VALIDATION_LOG << "Could not allocate decoded vertices.";
+    decoded_vertex_buffer_ = VertexBuffer{};
+    return decoded_vertex_buffer_.value();
+  }
+  decoded->SetLabel("Decoded mesh vertices");
+
+  decoded_vertex_buffer_ = vertex_buffer_;
+  decoded_vertex_buffer_->vertex_buffer = {
+      .buffer = decoded,
+      .range = Range(0, vertices.size() *
+                            sizeof(UnskinnedVertexShader::PerVertexData))};
+  return decoded_vertex_buffer_.value();
+}
+
 //------------------------------------------------------------------------------
 /// SkinnedVertexBufferGeometry
 ///
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
@@ -14,6 +16,7 @@
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/command.h"
+#include "impeller/scene/aabb.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/pipeline_key.h"
 #include "impeller/scene/scene_context.h"
@@ -46,7 +49,32 @@ class Geometry {
                              const Matrix& transform,
                              Command& command) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Binds the geometry to a command that draws one instance of it
+  ///             per transform. The transforms are packed into a storage
+  ///             buffer that the instanced pipeline of the geometry type reads.
+  ///
+  /// @return     Whether the geometry was bound. Geometry that can't be drawn
+  ///             instanced must be bound to one command per transform instead.
+  ///
+  virtual bool BindInstancesToCommand(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const std::vector<Matrix>& transforms,
+                                      Command& command) const;
+
   virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the bounds of the vertex positions, which are used to
+  ///             cull the geometry when it is out of view. Geometry without
+  ///             bounds is never culled.
+  ///
+  void SetBounds(std::optional<AABB> bounds);
+
+  const std::optional<AABB>& GetBounds() const;
+
+ private:
+  std::optional<AABB> bounds_;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -69,6 +97,12 @@ class CuboidGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  bool BindInstancesToCommand(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const std::vector<Matrix>& transforms,
+                              Command& command) const override;
+
  private:
   Vector3 size_;
 
@@ -95,12 +129,55 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  bool BindInstancesToCommand(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const std::vector<Matrix>& transforms,
+                              Command& command) const override;
+
  private:
   VertexBuffer vertex_buffer_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(UnskinnedVertexBufferGeometry);
 };
 
+class QuantizedVertexBufferGeometry final : public Geometry {
+ public:
+  QuantizedVertexBufferGeometry();
+
+  ~QuantizedVertexBufferGeometry() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the vertices and indices of the geometry. The vertices
+  ///             are `importer::QuantizedVertex`es, with positions relative
+  ///             to `position_bounds`. The buffer must be host visible.
+  ///
+  void SetVertexBuffer(VertexBuffer vertex_buffer, AABB position_bounds);
+
+  // |Geometry|
+  GeometryType GetGeometryType() const override;
+
+  // |Geometry|
+  VertexBuffer GetVertexBuffer(Allocator& allocator) const override;
+
+  // |Geometry|
+  void BindToCommand(const SceneContext& scene_context,
+                     HostBuffer& buffer,
+                     const Matrix& transform,
+                     Command& command) const override;
+
+ private:
+  VertexBuffer vertex_buffer_;
+  AABB position_bounds_;
+  /// The full precision vertices for backends without storage buffers, which
+  /// can't decode the vertices in the vertex shader.
+  mutable std::optional<VertexBuffer> decoded_vertex_buffer_;
+
+  const VertexBuffer& GetDecodedVertexBuffer(Allocator& allocator) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(QuantizedVertexBufferGeometry);
+};
+
 class SkinnedVertexBufferGeometry final : public Geometry {
  public:
   SkinnedVertexBufferGeometry();
@@ -9,12 +9,15 @@
 
 #include "flutter/fml/mapping.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
+#include "impeller/scene/importer/types.h"
 
 namespace impeller {
 namespace scene {
 namespace importer {
 
-bool ParseGLTF(const fml::Mapping& source_mapping, fb::SceneT& out_scene);
+bool ParseGLTF(const fml::Mapping& source_mapping,
+               fb::SceneT& out_scene,
+               const ImportOptions& options = {});
 
 }
 }  // namespace scene
@@ -16,6 +16,7 @@
 #include "impeller/geometry/matrix.h"
 #include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
+#include "impeller/scene/importer/vertex_cache_optimizer.h"
 #include "impeller/scene/importer/vertices_builder.h"
 #include "third_party/tinygltf/tiny_gltf.h"
 
@@ -60,8 +61,27 @@ static void ProcessMaterial(const tinygltf::Model& gltf,
           : -1;
 }
 
+/// @brief  Reorders the triangles of `indices` for vertex cache locality.
+template <typename IndexType>
+static void OptimizeIndices(fb::IndicesT& indices) {
+  std::vector<uint32_t> values(indices.count);
+  for (size_t i = 0; i < values.size(); i++) {
+    IndexType value;
+    std::memcpy(&value, indices.data.data() + i * sizeof(IndexType),
+                sizeof(IndexType));
+    values[i] = value;
+  }
+  OptimizeVertexCacheOrder(values);
+  for (size_t i = 0; i < values.size(); i++) {
+    const auto value = static_cast<IndexType>(values[i]);
+    std::memcpy(indices.data.data() + i * sizeof(IndexType), &value,
+                sizeof(IndexType));
+  }
+}
+
 static bool ProcessMeshPrimitive(const tinygltf::Model& gltf,
                                  const tinygltf::Primitive& primitive,
+                                 const ImportOptions& options,
                                  fb::MeshPrimitiveT& mesh_primitive) {
   //---------------------------------------------------------------------------
   /// Vertices.
@@ -69,9 +89,16 @@ static bool ProcessMeshPrimitive(const tinygltf::Model& gltf,
 
   {
     bool is_skinned = MeshPrimitiveIsSkinned(primitive);
-    std::unique_ptr<VerticesBuilder> builder =
-        is_skinned ? VerticesBuilder::MakeSkinned()
-                   : VerticesBuilder::MakeUnskinned();
+    std::unique_ptr<VerticesBuilder> builder;
+    if (is_skinned) {
+      // Skinned vertices are not quantized, since their joints and weights
+      // make up most of their size.
+      builder = VerticesBuilder::MakeSkinned();
+    } else if (options.quantize_vertices) {
+      builder = VerticesBuilder::MakeQuantized();
+    } else {
+      builder = VerticesBuilder::MakeUnskinned();
+    }
 
     for (const auto& attribute : primitive.attributes) {
       auto attribute_type = kAttributes.find(attribute.first);
@@ -150,12 +177,15 @@ static bool ProcessMeshPrimitive(const tinygltf::Model& gltf,
 
     auto indices = std::make_unique<fb::IndicesT>();
 
+    size_t index_size;
     switch (index_accessor.componentType) {
       case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
         indices->type = fb::IndexType::k16Bit;
+        index_size = sizeof(uint16_t);
         break;
       case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
         indices->type = fb::IndexType::k32Bit;
+        index_size = sizeof(uint32_t);
         break;
       default:
         std::cerr << "Mesh primitive has unsupported index type "
@@ -163,11 +193,22 @@ static bool ProcessMeshPrimitive(const tinygltf::Model& gltf,
         return false;
     }
     indices->count = index_accessor.count;
-    indices->data.resize(index_view.byteLength);
+    // Only the indices of the accessor are copied, since the view may be
+    // shared with other accessors.
+    indices->data.resize(index_accessor.count * index_size);
     const auto* index_buffer =
-        &gltf.buffers[index_view.buffer].data[index_view.byteOffset];
+        &gltf.buffers[index_view.buffer]
+             .data[index_view.byteOffset + index_accessor.byteOffset];
     std::memcpy(indices->data.data(), index_buffer, indices->data.size());
 
+    if (options.optimize_vertex_cache) {
+      if (indices->type == fb::IndexType::k16Bit) {
+        OptimizeIndices<uint16_t>(*indices);
+      } else {
+        OptimizeIndices<uint32_t>(*indices);
+      }
+    }
+
     mesh_primitive.indices = std::move(indices);
   }
 
@@ -191,6 +232,7 @@ static bool ProcessMeshPrimitive(const tinygltf::Model& gltf,
 
 static void ProcessNode(const tinygltf::Model& gltf,
                         const tinygltf::Node& in_node,
+                        const ImportOptions& options,
                         fb::NodeT& out_node) {
   out_node.name = in_node.name;
   out_node.children = in_node.children;
@@ -237,7 +279,7 @@ static void ProcessNode(const tinygltf::Model& gltf,
     auto& mesh = gltf.meshes[in_node.mesh];
     for (const auto& primitive : mesh.primitives) {
       auto mesh_primitive = std::make_unique<fb::MeshPrimitiveT>();
-      if (!ProcessMeshPrimitive(gltf, primitive, *mesh_primitive)) {
+      if (!ProcessMeshPrimitive(gltf, primitive, options, *mesh_primitive)) {
         continue;
       }
       out_node.mesh_primitives.push_back(std::move(mesh_primitive));
@@ -447,7 +489,9 @@ static void ProcessAnimation(const tinygltf::Model& gltf,
   out_animation.channels = std::move(channels);
 }
 
-bool ParseGLTF(const fml::Mapping& source_mapping, fb::SceneT& out_scene) {
+bool ParseGLTF(const fml::Mapping& source_mapping,
+               fb::SceneT& out_scene,
+               const ImportOptions& options) {
   tinygltf::Model gltf;
 
   {
@@ -482,7 +526,7 @@ bool ParseGLTF(const fml::Mapping& source_mapping, fb::SceneT& out_scene) {
 
   for (size_t node_i = 0; node_i < gltf.nodes.size(); node_i++) {
     auto node = std::make_unique<fb::NodeT>();
-    ProcessNode(gltf, gltf.nodes[node_i], *node);
+    ProcessNode(gltf, gltf.nodes[node_i], options, *node);
     out_scene.nodes.push_back(std::move(node));
   }
 
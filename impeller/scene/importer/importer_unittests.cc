@@ -8,6 +8,8 @@
 #include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/importer.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
+#include "impeller/scene/importer/vertex_cache_optimizer.h"
+#include "impeller/scene/importer/vertex_quantization.h"
 
 namespace impeller {
 namespace scene {
@@ -54,6 +56,86 @@ TEST(ImporterTest, CanParseUnskinnedGLTF) {
 
   Color color = ToColor(vertex.color());
   ASSERT_COLOR_NEAR(color, Color(0.0221714, 0.467781, 0.921584, 1));
+
+  ASSERT_NE(mesh.bounds, nullptr);
+  Vector3 bounds_min = ToVector3(mesh.bounds->min());
+  Vector3 bounds_max = ToVector3(mesh.bounds->max());
+  Vector3 vertices_min = ToVector3(vertices[0].position());
+  Vector3 vertices_max = vertices_min;
+  for (const auto& v : vertices) {
+    vertices_min = vertices_min.Min(ToVector3(v.position()));
+    vertices_max = vertices_max.Max(ToVector3(v.position()));
+  }
+  ASSERT_VECTOR3_NEAR(bounds_min, vertices_min);
+  ASSERT_VECTOR3_NEAR(bounds_max, vertices_max);
+}
+
+TEST(ImporterTest, CanQuantizeUnskinnedGLTF) {
+  auto mapping =
+      flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb");
+
+  fb::SceneT reference_scene;
+  ASSERT_TRUE(ParseGLTF(*mapping, reference_scene));
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(*mapping, scene,
+                        {.quantize_vertices = true,
+                         .optimize_vertex_cache = true}));
+
+  auto& reference_mesh =
+      *reference_scene.nodes[reference_scene.children[0]]->mesh_primitives[0];
+  auto& mesh = *scene.nodes[scene.children[0]]->mesh_primitives[0];
+
+  ASSERT_EQ(mesh.vertices.type, fb::VertexBuffer::QuantizedVertexBuffer);
+  auto* quantized = mesh.vertices.AsQuantizedVertexBuffer();
+  auto& reference_vertices =
+      reference_mesh.vertices.AsUnskinnedVertexBuffer()->vertices;
+  ASSERT_EQ(quantized->vertices.size(), reference_vertices.size());
+  EXPECT_LT(quantized->vertices.size() * sizeof(fb::QuantizedVertex) * 2u,
+            reference_vertices.size() * sizeof(fb::Vertex));
+
+  // The quantization range is the bounds of the mesh.
+  ASSERT_NE(quantized->position_bounds, nullptr);
+  ASSERT_NE(mesh.bounds, nullptr);
+  const Vector3 bounds_min = ToVector3(quantized->position_bounds->min());
+  const Vector3 bounds_max = ToVector3(quantized->position_bounds->max());
+  ASSERT_VECTOR3_NEAR(bounds_min, ToVector3(mesh.bounds->min()));
+  ASSERT_VECTOR3_NEAR(bounds_max, ToVector3(mesh.bounds->max()));
+
+  const Vector3 position_tolerance = (bounds_max - bounds_min) / 65535.0f;
+  for (size_t i = 0; i < reference_vertices.size(); i++) {
+    const auto& packed = quantized->vertices[i];
+    const QuantizedVertex vertex = {
+        packed.position_xy(), packed.position_z_tangent_w(), packed.normal(),
+        packed.tangent(),     packed.texture_coords(),       packed.color()};
+    const VertexAttributes result =
+        DequantizeVertex(vertex, bounds_min, bounds_max);
+    const auto& reference = reference_vertices[i];
+
+    const Vector3 position = ToVector3(reference.position());
+    EXPECT_NEAR(result.position.x, position.x, position_tolerance.x + 1e-6);
+    EXPECT_NEAR(result.position.y, position.y, position_tolerance.y + 1e-6);
+    EXPECT_NEAR(result.position.z, position.z, position_tolerance.z + 1e-6);
+    const Vector3 normal = ToVector3(reference.normal());
+    EXPECT_NEAR(result.normal.Dot(normal), 1.0f, 1e-4);
+    EXPECT_EQ(result.tangent.w, reference.tangent().w());
+    const Vector2 texture_coords = ToVector2(reference.texture_coords());
+    EXPECT_NEAR(result.texture_coords.x, texture_coords.x, 1e-3);
+    EXPECT_NEAR(result.texture_coords.y, texture_coords.y, 1e-3);
+  }
+
+  // The same triangles are drawn, with fewer vertex cache misses.
+  ASSERT_EQ(mesh.indices->count, reference_mesh.indices->count);
+  ASSERT_EQ(mesh.indices->type, fb::IndexType::k16Bit);
+  auto read_indices = [](const fb::IndicesT& indices) {
+    std::vector<uint32_t> result;
+    const auto* data = reinterpret_cast<const uint16_t*>(indices.data.data());
+    result.assign(data, data + indices.count);
+    return result;
+  };
+  const auto indices = read_indices(*mesh.indices);
+  const auto reference_indices = read_indices(*reference_mesh.indices);
+  EXPECT_LE(ComputeAverageCacheMissRatio(indices),
+            ComputeAverageCacheMissRatio(reference_indices));
 }
 
 TEST(ImporterTest, CanParseSkinnedGLTF) {
@@ -63,7 +63,8 @@ bool Main(const fml::CommandLine& command_line) {
   bool success = false;
   switch (switches.input_type) {
     case SourceType::kGLTF:
-      success = ParseGLTF(*source_file_mapping, scene);
+      success =
+          ParseGLTF(*source_file_mapping, scene, switches.import_options);
       break;
     case SourceType::kUnknown:
       std::cerr << "Unknown input type." << std::endl;
@@ -34,6 +34,8 @@ void Switches::PrintHelp(std::ostream& stream) {
   }
   stream << "} (default: gltf)" << std::endl;
   stream << "--output=<output_file>" << std::endl;
+  stream << "[optional] --quantize-vertices" << std::endl;
+  stream << "[optional] --optimize-vertex-cache" << std::endl;
 }
 
 Switches::Switches() = default;
@@ -58,7 +60,12 @@ Switches::Switches(const fml::CommandLine& command_line)
           fml::FilePermission::kRead))),
       source_file_name(command_line.GetOptionValueWithDefault("input", "")),
       input_type(SourceTypeFromCommandLine(command_line)),
-      output_file_name(command_line.GetOptionValueWithDefault("output", "")) {
+      output_file_name(command_line.GetOptionValueWithDefault("output", "")),
+      import_options({
+          .quantize_vertices = command_line.HasOption("quantize-vertices"),
+          .optimize_vertex_cache =
+              command_line.HasOption("optimize-vertex-cache"),
+      }) {
   if (!working_directory || !working_directory->is_valid()) {
     return;
   }
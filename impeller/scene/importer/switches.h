@@ -21,6 +21,7 @@ struct Switches {
   std::string source_file_name;
   SourceType input_type;
   std::string output_file_name;
+  ImportOptions import_options;
 
   Switches();
 
@@ -13,6 +13,15 @@ enum class SourceType {
   kGLTF,
 };
 
+struct ImportOptions {
+  /// Whether the vertices of unskinned meshes are packed into 24 bytes
+  /// instead of 64, at the cost of precision. See `QuantizedVertex`.
+  bool quantize_vertices = false;
+  /// Whether the triangles of meshes are reordered so that vertices are
+  /// reused while they are still in the post-transform vertex cache.
+  bool optimize_vertex_cache = false;
+};
+
 }  // namespace importer
 }  // namespace scene
 }  // namespace impeller
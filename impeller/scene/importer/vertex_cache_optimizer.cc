@@ -0,0 +1,206 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/importer/vertex_cache_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+namespace {
+
+constexpr Scalar kCacheDecayPower = 1.5f;
+constexpr Scalar kLastTriangleScore = 0.75f;
+constexpr Scalar kValenceBoostScale = 2.0f;
+constexpr Scalar kValenceBoostPower = 0.5f;
+
+struct VertexState {
+  /// The offset of the first triangle of the vertex in the adjacency list.
+  size_t first_triangle = 0u;
+  /// The number of triangles using the vertex that have not been emitted.
+  size_t remaining_triangles = 0u;
+  /// The position of the vertex in the modeled LRU cache, or -1.
+  int cache_position = -1;
+  Scalar score = 0;
+};
+
+}  // namespace
+
+static Scalar ComputeVertexScore(const VertexState& vertex,
+                                 size_t cache_size) {
+  if (vertex.remaining_triangles == 0u) {
+    // The vertex has no triangles left to make use of it.
+    return -1;
+  }
+
+  Scalar score = 0;
+  if (vertex.cache_position >= 0) {
+    if (vertex.cache_position < 3) {
+      // The vertex was used by the last triangle. It is deliberately scored
+      // lower than the rest of the cache, so that strips that turn back on
+      // themselves are avoided.
+      score = kLastTriangleScore;
+    } else {
+      const Scalar scale = 1.0f / static_cast<Scalar>(cache_size - 3u);
+      score = std::pow(1.0f - (vertex.cache_position - 3) * scale,
+                       kCacheDecayPower);
+    }
+  }
+
+  // Boost vertices with few remaining triangles, so that they are finished
+  // off instead of lingering as lone triangles until the end.
+  score += kValenceBoostScale *
+           std::pow(static_cast<Scalar>(vertex.remaining_triangles),
+                    -kValenceBoostPower);
+  return score;
+}
+
+void OptimizeVertexCacheOrder(std::vector<uint32_t>& indices,
+                              size_t cache_size) {
+  const size_t triangle_count = indices.size() / 3u;
+  if (triangle_count < 2u || cache_size < 4u) {
+    return;
+  }
+
+  const auto indices_end = indices.begin() + triangle_count * 3u;
+  const size_t vertex_count =
+      *std::max_element(indices.begin(), indices_end) + 1u;
+
+  // Build the triangle adjacency of every vertex.
+  std::vector<VertexState> vertices(vertex_count);
+  for (size_t i = 0; i < triangle_count * 3u; i++) {
+    vertices[indices[i]].remaining_triangles++;
+  }
+  size_t offset = 0u;
+  for (auto& vertex : vertices) {
+    vertex.first_triangle = offset;
+    offset += vertex.remaining_triangles;
+  }
+  std::vector<uint32_t> adjacency(offset);
+  {
+    std::vector<size_t> written(vertex_count, 0u);
+    for (size_t i = 0; i < triangle_count * 3u; i++) {
+      const uint32_t index = indices[i];
+      adjacency[vertices[index].first_triangle + written[index]++] =
+          static_cast<uint32_t>(i / 3u);
+    }
+  }
+
+  for (auto& vertex : vertices) {
+    vertex.score = ComputeVertexScore(vertex, cache_size);
+  }
+  auto triangle_score = [&](size_t t) {
+    return vertices[indices[t * 3]].score + vertices[indices[t * 3 + 1]].score +
+           vertices[indices[t * 3 + 2]].score;
+  };
+
+  size_t best_triangle = 0u;
+  for (size_t t = 1; t < triangle_count; t++) {
+    if (triangle_score(t) > triangle_score(best_triangle)) {
+      best_triangle = t;
+    }
+  }
+
+  std::vector<bool> emitted(triangle_count, false);
+  std::vector<uint32_t> result;
+  result.reserve(triangle_count * 3u);
+  // The cache holds three extra entries for the vertices of the triangle
+  // being emitted.
+  std::vector<uint32_t> cache;
+  std::vector<uint32_t> next_cache;
+  cache.reserve(cache_size + 3u);
+  next_cache.reserve(cache_size + 3u);
+
+  size_t scan_position = 0u;
+  while (true) {
+    emitted[best_triangle] = true;
+    const uint32_t* triangle = &indices[best_triangle * 3u];
+    result.insert(result.end(), triangle, triangle + 3);
+
+    // Remove the triangle from the adjacency of its vertices.
+    for (size_t i = 0; i < 3u; i++) {
+      auto& vertex = vertices[triangle[i]];
+      auto begin = adjacency.begin() + vertex.first_triangle;
+      auto end = begin + vertex.remaining_triangles;
+      std::iter_swap(std::find(begin, end, best_triangle), end - 1);
+      vertex.remaining_triangles--;
+    }
+
+    // Move the vertices of the triangle to the front of the cache.
+    next_cache.assign(triangle, triangle + 3);
+    for (uint32_t index : cache) {
+      if (index != triangle[0] && index != triangle[1] &&
+          index != triangle[2]) {
+        next_cache.push_back(index);
+      }
+    }
+    for (size_t i = 0; i < next_cache.size(); i++) {
+      auto& vertex = vertices[next_cache[i]];
+      vertex.cache_position = i < cache_size ? static_cast<int>(i) : -1;
+      vertex.score = ComputeVertexScore(vertex, cache_size);
+    }
+    if (next_cache.size() > cache_size) {
+      next_cache.resize(cache_size);
+    }
+    std::swap(cache, next_cache);
+
+    // Only the triangles of cached vertices changed score, so the next
+    // triangle is picked among them.
+    Scalar best_score = -1;
+    for (uint32_t index : cache) {
+      const auto& vertex = vertices[index];
+      for (size_t i = 0; i < vertex.remaining_triangles; i++) {
+        const uint32_t t = adjacency[vertex.first_triangle + i];
+        const Scalar score = triangle_score(t);
+        if (score > best_score) {
+          best_score = score;
+          best_triangle = t;
+        }
+      }
+    }
+
+    if (best_score < 0) {
+      // None of the cached vertices have triangles left, so start over with
+      // the next triangle that hasn't been emitted.
+      while (scan_position < triangle_count && emitted[scan_position]) {
+        scan_position++;
+      }
+      if (scan_position == triangle_count) {
+        break;
+      }
+      best_triangle = scan_position;
+    }
+  }
+
+  std::copy(result.begin(), result.end(), indices.begin());
+}
+
+Scalar ComputeAverageCacheMissRatio(const std::vector<uint32_t>& indices,
+                                    size_t cache_size) {
+  const size_t triangle_count = indices.size() / 3u;
+  if (triangle_count == 0u) {
+    return 0;
+  }
+  std::deque<uint32_t> cache;
+  size_t misses = 0u;
+  for (size_t i = 0; i < triangle_count * 3u; i++) {
+    if (std::find(cache.begin(), cache.end(), indices[i]) != cache.end()) {
+      continue;
+    }
+    misses++;
+    cache.push_back(indices[i]);
+    if (cache.size() > cache_size) {
+      cache.pop_front();
+    }
+  }
+  return static_cast<Scalar>(misses) / static_cast<Scalar>(triangle_count);
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
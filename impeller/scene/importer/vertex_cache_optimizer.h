@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// @brief      Reorders the triangles of a triangle list so that vertices are
+///             reused while they are still in the post-transform vertex
+///             cache of the GPU.
+///
+///             This is Tom Forsyth's "Linear-Speed Vertex Cache
+///             Optimisation". Triangles are greedily emitted in the order of
+///             a score that favors vertices which were recently used and
+///             vertices that have few remaining triangles. The winding of
+///             each triangle is preserved.
+///
+/// @param      indices     The triangle list to reorder in place. Trailing
+///                         indices that don't make up a whole triangle are
+///                         left untouched.
+/// @param[in]  cache_size  The number of vertices in the modeled cache.
+///
+void OptimizeVertexCacheOrder(std::vector<uint32_t>& indices,
+                              size_t cache_size = 32u);
+
+//------------------------------------------------------------------------------
+/// @brief      Computes the average number of vertices that miss a FIFO
+///             vertex cache of the given size per triangle. Lower is better;
+///             the ideal for regular meshes approaches 0.5.
+///
+Scalar ComputeAverageCacheMissRatio(const std::vector<uint32_t>& indices,
+                                    size_t cache_size = 32u);
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "flutter/testing/testing.h"
+#include "impeller/scene/importer/vertex_cache_optimizer.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+namespace testing {
+
+/// @brief  Returns a triangulated grid of `size` by `size` quads, with the
+///         triangles in random order.
+static std::vector<uint32_t> MakeShuffledGrid(uint32_t size) {
+  std::vector<std::array<uint32_t, 3>> triangles;
+  const uint32_t stride = size + 1;
+  for (uint32_t y = 0; y < size; y++) {
+    for (uint32_t x = 0; x < size; x++) {
+      const uint32_t corner = y * stride + x;
+      triangles.push_back({corner, corner + 1, corner + stride});
+      triangles.push_back({corner + 1, corner + stride + 1, corner + stride});
+    }
+  }
+  std::mt19937 random(42);
+  std::shuffle(triangles.begin(), triangles.end(), random);
+
+  std::vector<uint32_t> indices;
+  for (const auto& triangle : triangles) {
+    indices.insert(indices.end(), triangle.begin(), triangle.end());
+  }
+  return indices;
+}
+
+/// @brief  Returns the triangles of `indices` with their vertices rotated so
+///         that the smallest index comes first, sorted.
+static std::vector<std::array<uint32_t, 3>> CanonicalTriangles(
+    const std::vector<uint32_t>& indices) {
+  std::vector<std::array<uint32_t, 3>> triangles;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    std::array<uint32_t, 3> triangle = {indices[i], indices[i + 1],
+                                        indices[i + 2]};
+    std::rotate(triangle.begin(),
+                std::min_element(triangle.begin(), triangle.end()),
+                triangle.end());
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+TEST(VertexCacheOptimizerTest, ReducesCacheMisses) {
+  auto indices = MakeShuffledGrid(64);
+  const Scalar before = ComputeAverageCacheMissRatio(indices);
+
+  OptimizeVertexCacheOrder(indices);
+  const Scalar after = ComputeAverageCacheMissRatio(indices);
+
+  EXPECT_GT(before, 1.5f);
+  EXPECT_LT(after, 0.8f);
+}
+
+TEST(VertexCacheOptimizerTest, PreservesTrianglesAndWinding) {
+  const auto original = MakeShuffledGrid(16);
+  auto indices = original;
+  OptimizeVertexCacheOrder(indices);
+
+  ASSERT_EQ(indices.size(), original.size());
+  EXPECT_NE(indices, original);
+  EXPECT_EQ(CanonicalTriangles(indices), CanonicalTriangles(original));
+}
+
+TEST(VertexCacheOptimizerTest, LeavesIncompleteTrianglesAlone) {
+  std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3, 7};
+  OptimizeVertexCacheOrder(indices);
+  ASSERT_EQ(indices.size(), 7u);
+  EXPECT_EQ(indices.back(), 7u);
+  EXPECT_EQ(CanonicalTriangles({indices.begin(), indices.begin() + 6}),
+            CanonicalTriangles({0, 1, 2, 2, 1, 3}));
+}
+
+}  // namespace testing
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,213 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/importer/vertex_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+static constexpr Scalar kUnorm16Max = 65535.0f;
+static constexpr Scalar kSnorm16Max = 32767.0f;
+static constexpr Scalar kUnorm8Max = 255.0f;
+
+static uint32_t PackUnorm16(Scalar value) {
+  return static_cast<uint32_t>(
+      std::round(std::clamp(value, 0.0f, 1.0f) * kUnorm16Max));
+}
+
+static Scalar UnpackUnorm16(uint32_t bits) {
+  return static_cast<Scalar>(bits & 0xFFFF) / kUnorm16Max;
+}
+
+static uint32_t PackSnorm2x16(const Vector2& value) {
+  auto pack = [](Scalar component) {
+    auto snorm = static_cast<int16_t>(
+        std::round(std::clamp(component, -1.0f, 1.0f) * kSnorm16Max));
+    return static_cast<uint32_t>(static_cast<uint16_t>(snorm));
+  };
+  return pack(value.x) | (pack(value.y) << 16);
+}
+
+static Vector2 UnpackSnorm2x16(uint32_t bits) {
+  auto unpack = [](uint32_t component) {
+    auto snorm = static_cast<int16_t>(static_cast<uint16_t>(component));
+    return std::clamp(snorm / kSnorm16Max, -1.0f, 1.0f);
+  };
+  return Vector2(unpack(bits & 0xFFFF), unpack(bits >> 16));
+}
+
+static uint32_t PackUnorm4x8(const Color& color) {
+  auto pack = [](Scalar component) {
+    return static_cast<uint32_t>(
+        std::round(std::clamp(component, 0.0f, 1.0f) * kUnorm8Max));
+  };
+  return pack(color.red) | (pack(color.green) << 8) |
+         (pack(color.blue) << 16) | (pack(color.alpha) << 24);
+}
+
+static Color UnpackUnorm4x8(uint32_t bits) {
+  auto unpack = [bits](int shift) {
+    return static_cast<Scalar>((bits >> shift) & 0xFF) / kUnorm8Max;
+  };
+  return Color(unpack(0), unpack(8), unpack(16), unpack(24));
+}
+
+/// @brief  Returns the position of `value` within [min, max] in the range of
+///         0 to 1, or 0 if the range is empty.
+static Scalar Normalize(Scalar value, Scalar min, Scalar max) {
+  const Scalar extent = max - min;
+  return extent > 0 ? (value - min) / extent : 0;
+}
+
+uint16_t FloatToHalfBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const uint32_t sign = (bits >> 16) & 0x8000;
+  const uint32_t float_exponent = (bits >> 23) & 0xFF;
+  uint32_t mantissa = bits & 0x7FFFFF;
+
+  // Infinity and NaN.
+  if (float_exponent == 0xFF) {
+    return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+  }
+
+  const int32_t exponent = static_cast<int32_t>(float_exponent) - 127 + 15;
+  if (exponent >= 0x1F) {
+    return sign | 0x7C00;
+  }
+
+  // Values below the smallest normal half become subnormals, or zero.
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    const uint32_t shift = 14 - exponent;
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) {
+      half++;
+    }
+    return sign | half;
+  }
+
+  // Round to nearest even. A carry out of the mantissa correctly bumps the
+  // exponent, up to infinity.
+  uint32_t half = (exponent << 10) | (mantissa >> 13);
+  const uint32_t remainder = mantissa & 0x1FFF;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+    half++;
+  }
+  return sign | half;
+}
+
+float HalfBitsToFloat(uint16_t half) {
+  const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  int32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+
+  uint32_t bits;
+  if (exponent == 0x1F) {
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Subnormal halves are normal floats.
+    exponent = 1;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    mantissa &= 0x3FF;
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+Vector2 EncodeOctahedral(const Vector3& direction) {
+  const Scalar l1_norm =
+      std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+  if (l1_norm == 0) {
+    return Vector2(0, 0);
+  }
+  Vector2 result(direction.x / l1_norm, direction.y / l1_norm);
+  if (direction.z < 0) {
+    // Fold the lower hemisphere over the diagonals.
+    result = Vector2((1 - std::abs(result.y)) * (result.x >= 0 ? 1 : -1),
+                     (1 - std::abs(result.x)) * (result.y >= 0 ? 1 : -1));
+  }
+  return result;
+}
+
+Vector3 DecodeOctahedral(const Vector2& encoded) {
+  Vector3 result(encoded.x, encoded.y,
+                 1 - std::abs(encoded.x) - std::abs(encoded.y));
+  const Scalar fold = std::max(-result.z, 0.0f);
+  result.x += result.x >= 0 ? -fold : fold;
+  result.y += result.y >= 0 ? -fold : fold;
+  return result.Normalize();
+}
+
+QuantizedVertex QuantizeVertex(const VertexAttributes& vertex,
+                               const Vector3& bounds_min,
+                               const Vector3& bounds_max) {
+  const uint32_t x =
+      PackUnorm16(Normalize(vertex.position.x, bounds_min.x, bounds_max.x));
+  const uint32_t y =
+      PackUnorm16(Normalize(vertex.position.y, bounds_min.y, bounds_max.y));
+  const uint32_t z =
+      PackUnorm16(Normalize(vertex.position.z, bounds_min.z, bounds_max.z));
+  const uint32_t handedness = vertex.tangent.w < 0 ? 0 : 0xFFFF;
+
+  const Vector3 tangent(vertex.tangent.x, vertex.tangent.y, vertex.tangent.z);
+
+  QuantizedVertex result;
+  result.position_xy = x | (y << 16);
+  result.position_z_tangent_w = z | (handedness << 16);
+  result.normal = PackSnorm2x16(EncodeOctahedral(vertex.normal));
+  result.tangent = PackSnorm2x16(EncodeOctahedral(tangent));
+  result.texture_coords =
+      FloatToHalfBits(vertex.texture_coords.x) |
+      (static_cast<uint32_t>(FloatToHalfBits(vertex.texture_coords.y)) << 16);
+  result.color = PackUnorm4x8(vertex.color);
+  return result;
+}
+
+VertexAttributes DequantizeVertex(const QuantizedVertex& vertex,
+                                  const Vector3& bounds_min,
+                                  const Vector3& bounds_max) {
+  const Vector3 normalized_position(UnpackUnorm16(vertex.position_xy),
+                                    UnpackUnorm16(vertex.position_xy >> 16),
+                                    UnpackUnorm16(vertex.position_z_tangent_w));
+  const Scalar handedness =
+      UnpackUnorm16(vertex.position_z_tangent_w >> 16) * 2 - 1;
+  const Vector3 tangent = DecodeOctahedral(UnpackSnorm2x16(vertex.tangent));
+
+  VertexAttributes result;
+  result.position =
+      bounds_min + normalized_position * (bounds_max - bounds_min);
+  result.normal = DecodeOctahedral(UnpackSnorm2x16(vertex.normal));
+  result.tangent = Vector4(tangent.x, tangent.y, tangent.z, handedness);
+  result.texture_coords =
+      Vector2(HalfBitsToFloat(vertex.texture_coords & 0xFFFF),
+              HalfBitsToFloat(vertex.texture_coords >> 16));
+  result.color = UnpackUnorm4x8(vertex.color);
+  return result;
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
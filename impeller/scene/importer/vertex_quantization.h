@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/vector.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// @brief      The full precision attributes of an unskinned vertex.
+///
+struct VertexAttributes {
+  Vector3 position;
+  Vector3 normal;
+  Vector4 tangent;  // The 4th component determines the handedness.
+  Vector2 texture_coords;
+  Color color = Color::White();
+};
+
+//------------------------------------------------------------------------------
+/// @brief      An unskinned vertex packed into six 32 bit words.
+///
+///             Each word is laid out so that it can be unpacked by the GLSL
+///             `unpack*` built-ins, with the first component in the low bits:
+///
+///             * Positions are 16 bit unsigned normalized values relative to
+///               the bounds of the mesh (`unpackUnorm2x16`).
+///             * Normals and tangents are octahedral encoded 16 bit signed
+///               normalized values (`unpackSnorm2x16`).
+///             * The handedness of the tangent is stored in the high bits of
+///               the `position_z_tangent_w` word, as either 0 or 1.
+///             * Texture coordinates are half floats (`unpackHalf2x16`).
+///             * Colors are 8 bit unsigned normalized values
+///               (`unpackUnorm4x8`).
+///
+///             This layout is expected to be identical to that within
+///             `impeller/scene/importer/scene.fbs` and
+///             `impeller/scene/shaders/unskinned_quantized.vert`.
+///
+struct QuantizedVertex {
+  uint32_t position_xy = 0;
+  uint32_t position_z_tangent_w = 0;
+  uint32_t normal = 0;
+  uint32_t tangent = 0;
+  uint32_t texture_coords = 0;
+  uint32_t color = 0;
+};
+
+static_assert(sizeof(QuantizedVertex) == 6 * sizeof(uint32_t));
+
+//------------------------------------------------------------------------------
+/// @brief      Packs the attributes of a vertex whose position lies within the
+///             given bounds.
+///
+QuantizedVertex QuantizeVertex(const VertexAttributes& vertex,
+                               const Vector3& bounds_min,
+                               const Vector3& bounds_max);
+
+//------------------------------------------------------------------------------
+/// @brief      Unpacks a vertex that was quantized with the same bounds.
+///
+VertexAttributes DequantizeVertex(const QuantizedVertex& vertex,
+                                  const Vector3& bounds_min,
+                                  const Vector3& bounds_max);
+
+//------------------------------------------------------------------------------
+/// @brief      Maps a unit direction onto the [-1, 1] square by projecting it
+///             onto an octahedron and unfolding the lower half.
+///
+Vector2 EncodeOctahedral(const Vector3& direction);
+
+//------------------------------------------------------------------------------
+/// @brief      The inverse of `EncodeOctahedral`. The result is normalized.
+///
+Vector3 DecodeOctahedral(const Vector2& encoded);
+
+//------------------------------------------------------------------------------
+/// @brief      Converts a float to the bits of the nearest half float. Unlike
+///             `ScalarToHalf`, this works on hosts without a native half
+///             type, which is where the importer runs.
+///
+uint16_t FloatToHalfBits(float value);
+
+float HalfBitsToFloat(uint16_t bits);
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <limits>
+
+#include "flutter/testing/testing.h"
+#include "impeller/geometry/geometry_asserts.h"
+#include "impeller/scene/importer/vertex_quantization.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+namespace testing {
+
+TEST(VertexQuantizationTest, HalfConversionRoundTrips) {
+  EXPECT_EQ(FloatToHalfBits(0.0f), 0x0000u);
+  EXPECT_EQ(FloatToHalfBits(-0.0f), 0x8000u);
+  EXPECT_EQ(FloatToHalfBits(1.0f), 0x3C00u);
+  EXPECT_EQ(FloatToHalfBits(-2.0f), 0xC000u);
+  EXPECT_EQ(FloatToHalfBits(65504.0f), 0x7BFFu);
+  EXPECT_EQ(FloatToHalfBits(1.0e6f), 0x7C00u);
+  EXPECT_EQ(FloatToHalfBits(std::numeric_limits<float>::infinity()), 0x7C00u);
+  // The smallest subnormal half.
+  EXPECT_EQ(FloatToHalfBits(5.9604645e-8f), 0x0001u);
+  // Ties round to even.
+  EXPECT_EQ(FloatToHalfBits(1.0f + 1.0f / 2048.0f), 0x3C00u);
+  EXPECT_EQ(FloatToHalfBits(1.0f + 3.0f / 2048.0f), 0x3C02u);
+
+  for (uint32_t bits = 0; bits < 0x7C00u; bits++) {
+    const auto half = static_cast<uint16_t>(bits);
+    ASSERT_EQ(FloatToHalfBits(HalfBitsToFloat(half)), half);
+    const auto negative_half = static_cast<uint16_t>(bits | 0x8000u);
+    ASSERT_EQ(FloatToHalfBits(HalfBitsToFloat(negative_half)), negative_half);
+  }
+}
+
+TEST(VertexQuantizationTest, OctahedralEncodingRoundTrips) {
+  const Vector3 directions[] = {
+      {1, 0, 0},  {-1, 0, 0}, {0, 1, 0},       {0, -1, 0},
+      {0, 0, 1},  {0, 0, -1}, {1, 1, 1},       {-1, -1, -1},
+      {1, -2, 3}, {-3, 2, -1}, {0.2, 0.1, -5},
+  };
+  for (const auto& direction : directions) {
+    const Vector2 encoded = EncodeOctahedral(direction.Normalize());
+    EXPECT_LE(std::abs(encoded.x), 1.0f);
+    EXPECT_LE(std::abs(encoded.y), 1.0f);
+    ASSERT_VECTOR3_NEAR(DecodeOctahedral(encoded), direction.Normalize());
+  }
+}
+
+TEST(VertexQuantizationTest, QuantizedVertexRoundTrips) {
+  const Vector3 bounds_min(-2, 0, 5);
+  const Vector3 bounds_max(2, 1, 5);
+
+  VertexAttributes vertex;
+  vertex.position = Vector3(0.5, 0.25, 5);
+  vertex.normal = Vector3(0.6, -0.8, 0);
+  vertex.tangent = Vector4(0, 0, -1, -1);
+  vertex.texture_coords = Vector2(0.75, 0.125);
+  vertex.color = Color(1, 0.5, 0, 1);
+
+  const QuantizedVertex quantized =
+      QuantizeVertex(vertex, bounds_min, bounds_max);
+  const VertexAttributes result =
+      DequantizeVertex(quantized, bounds_min, bounds_max);
+
+  // 16 bits over a 4 unit range.
+  EXPECT_NEAR(result.position.x, vertex.position.x, 4.0f / 65535.0f);
+  EXPECT_NEAR(result.position.y, vertex.position.y, 1.0f / 65535.0f);
+  // The empty Z range is reproduced exactly.
+  EXPECT_EQ(result.position.z, vertex.position.z);
+  ASSERT_VECTOR3_NEAR(result.normal, vertex.normal);
+  ASSERT_VECTOR4_NEAR(result.tangent, vertex.tangent);
+  // These texture coordinates are exactly representable as half floats.
+  EXPECT_EQ(result.texture_coords, vertex.texture_coords);
+  ASSERT_COLOR_NEAR(result.color, Color(1, 128.0f / 255.0f, 0, 1));
+}
+
+TEST(VertexQuantizationTest, PacksComponentsLikeGLSL) {
+  VertexAttributes vertex;
+  vertex.position = Vector3(1, 0, 1);
+  vertex.normal = Vector3(0, 0, 1);
+  vertex.tangent = Vector4(1, 0, 0, 1);
+  vertex.texture_coords = Vector2(1, 0);
+  vertex.color = Color(1, 0, 0, 0);
+
+  const QuantizedVertex quantized =
+      QuantizeVertex(vertex, Vector3(0, 0, 0), Vector3(1, 1, 1));
+  // The first component is in the low bits, as with `unpackUnorm2x16`.
+  EXPECT_EQ(quantized.position_xy, 0x0000FFFFu);
+  EXPECT_EQ(quantized.position_z_tangent_w, 0xFFFFFFFFu);
+  EXPECT_EQ(quantized.normal, 0x00000000u);
+  EXPECT_EQ(quantized.tangent, 0x00007FFFu);
+  EXPECT_EQ(quantized.texture_coords, 0x00003C00u);
+  EXPECT_EQ(quantized.color, 0x000000FFu);
+}
+
+}  // namespace testing
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
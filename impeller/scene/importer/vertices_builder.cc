@@ -8,15 +8,36 @@
 #include <limits>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 #include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
+#include "impeller/scene/importer/vertex_quantization.h"
 
 namespace impeller {
 namespace scene {
 namespace importer {
 
+/// @brief  Computes the bounding box of the positions of `vertices`, or
+///         returns null if there are no vertices.
+template <typename VertexType, typename PositionProc>
+static std::unique_ptr<fb::AABB> ComputeBounds(
+    const std::vector<VertexType>& vertices,
+    const PositionProc& position_proc) {
+  if (vertices.empty()) {
+    return nullptr;
+  }
+  Vector3 min = position_proc(vertices.front());
+  Vector3 max = min;
+  for (const auto& vertex : vertices) {
+    const Vector3 position = position_proc(vertex);
+    min = min.Min(position);
+    max = max.Max(position);
+  }
+  return std::make_unique<fb::AABB>(ToFBVec3(min), ToFBVec3(max));
+}
+
 //------------------------------------------------------------------------------
 /// VerticesBuilder
 ///
@@ -29,6 +50,10 @@ std::unique_ptr<VerticesBuilder> VerticesBuilder::MakeSkinned() {
   return std::make_unique<SkinnedVerticesBuilder>();
 }
 
+std::unique_ptr<VerticesBuilder> VerticesBuilder::MakeQuantized() {
+  return std::make_unique<UnskinnedVerticesBuilder>(/*quantize=*/true);
+}
+
 VerticesBuilder::VerticesBuilder() = default;
 
 VerticesBuilder::~VerticesBuilder() = default;
@@ -160,12 +185,17 @@ void VerticesBuilder::WriteAttribute(void* destination,
 /// UnskinnedVerticesBuilder
 ///
 
-UnskinnedVerticesBuilder::UnskinnedVerticesBuilder() = default;
+UnskinnedVerticesBuilder::UnskinnedVerticesBuilder(bool quantize)
+    : quantize_(quantize) {}
 
 UnskinnedVerticesBuilder::~UnskinnedVerticesBuilder() = default;
 
 void UnskinnedVerticesBuilder::WriteFBVertices(
     fb::MeshPrimitiveT& primitive) const {
+  if (quantize_) {
+    WriteFBQuantizedVertices(primitive);
+    return;
+  }
   auto vertex_buffer = fb::UnskinnedVertexBufferT();
   vertex_buffer.vertices.resize(0);
   for (auto& v : vertices_) {
@@ -174,6 +204,32 @@ void UnskinnedVerticesBuilder::WriteFBVertices(
         ToFBVec2(v.texture_coords), ToFBColor(v.color)));
   }
   primitive.vertices.Set(std::move(vertex_buffer));
+  primitive.bounds = ComputeBounds(
+      vertices_, [](const Vertex& vertex) { return vertex.position; });
+}
+
+void UnskinnedVerticesBuilder::WriteFBQuantizedVertices(
+    fb::MeshPrimitiveT& primitive) const {
+  primitive.bounds = ComputeBounds(
+      vertices_, [](const Vertex& vertex) { return vertex.position; });
+  auto vertex_buffer = fb::QuantizedVertexBufferT();
+  if (primitive.bounds) {
+    const Vector3 bounds_min = ToVector3(primitive.bounds->min());
+    const Vector3 bounds_max = ToVector3(primitive.bounds->max());
+    vertex_buffer.vertices.reserve(vertices_.size());
+    for (auto& v : vertices_) {
+      const QuantizedVertex quantized = QuantizeVertex(
+          {v.position, v.normal, v.tangent, v.texture_coords, v.color},
+          bounds_min, bounds_max);
+      vertex_buffer.vertices.push_back(fb::QuantizedVertex(
+          quantized.position_xy, quantized.position_z_tangent_w,
+          quantized.normal, quantized.tangent, quantized.texture_coords,
+          quantized.color));
+    }
+    vertex_buffer.position_bounds =
+        std::make_unique<fb::AABB>(*primitive.bounds);
+  }
+  primitive.vertices.Set(std::move(vertex_buffer));
 }
 
 void UnskinnedVerticesBuilder::SetAttributeFromBuffer(
@@ -215,6 +271,8 @@ void SkinnedVerticesBuilder::WriteFBVertices(
         unskinned_attributes, ToFBVec4(v.joints), ToFBVec4(v.weights)));
   }
   primitive.vertices.Set(std::move(vertex_buffer));
+  primitive.bounds = ComputeBounds(
+      vertices_, [](const Vertex& vertex) { return vertex.vertex.position; });
 }
 
 void SkinnedVerticesBuilder::SetAttributeFromBuffer(
@@ -25,6 +25,8 @@ class VerticesBuilder {
 
   static std::unique_ptr<VerticesBuilder> MakeSkinned();
 
+  static std::unique_ptr<VerticesBuilder> MakeQuantized();
+
   enum class ComponentType {
     kSignedByte = 5120,
     kUnsignedByte,
@@ -108,7 +110,9 @@ class UnskinnedVerticesBuilder final : public VerticesBuilder {
     Color color = Color::White();
   };
 
-  UnskinnedVerticesBuilder();
+  /// If `quantize` is true, the vertices are written as a
+  /// `QuantizedVertexBuffer`.
+  explicit UnskinnedVerticesBuilder(bool quantize = false);
 
   virtual ~UnskinnedVerticesBuilder() override;
 
@@ -123,8 +127,11 @@ class UnskinnedVerticesBuilder final : public VerticesBuilder {
                               size_t attribute_count) override;
 
  private:
+  const bool quantize_;
   std::vector<Vertex> vertices_;
 
+  void WriteFBQuantizedVertices(fb::MeshPrimitiveT& primitive) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(UnskinnedVerticesBuilder);
 };
 
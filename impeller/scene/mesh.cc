@@ -33,6 +33,19 @@ std::vector<Mesh::Primitive>& Mesh::GetPrimitives() {
   return primitives_;
 }
 
+std::optional<AABB> Mesh::GetBounds() const {
+  std::optional<AABB> bounds;
+  for (const auto& mesh : primitives_) {
+    const auto& primitive_bounds = mesh.geometry->GetBounds();
+    if (!primitive_bounds.has_value()) {
+      return std::nullopt;
+    }
+    bounds = bounds.has_value() ? bounds->Union(primitive_bounds.value())
+                                : primitive_bounds.value();
+  }
+  return bounds;
+}
+
 bool Mesh::Render(SceneEncoder& encoder,
                   const Matrix& transform,
                   const std::shared_ptr<Texture>& joints) const {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "flutter/fml/macros.h"
@@ -33,6 +34,12 @@ class Mesh final {
   void AddPrimitive(Primitive mesh_);
   std::vector<Primitive>& GetPrimitives();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The union of the bounds of all primitives, or null if any
+  ///             primitive is unbounded.
+  ///
+  std::optional<AABB> GetBounds() const;
+
   bool Render(SceneEncoder& encoder,
               const Matrix& transform,
               const std::shared_ptr<Texture>& joints) const;
@@ -354,6 +354,54 @@ bool Node::IsJoint() const {
 bool Node::Render(SceneEncoder& encoder,
                   Allocator& allocator,
                   const Matrix& parent_transform) {
+  Update();
+
+  world_transform_ = parent_transform * local_transform_;
+  if (skin_) {
+    skin_->UpdateJointMatrices();
+  }
+  RenderMesh(encoder, allocator);
+
+  for (auto& child : children_) {
+    if (!child->Render(encoder, allocator, world_transform_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Node::Collect(const Matrix& parent_transform,
+                   BoundingVolumeHierarchy& bvh,
+                   std::vector<Node*>& unculled_nodes,
+                   size_t& next_render_order) {
+  Update();
+
+  world_transform_ = parent_transform * local_transform_;
+  render_order_ = next_render_order++;
+  if (!mesh_.GetPrimitives().empty()) {
+    auto bounds = mesh_.GetBounds();
+    if (bounds.has_value()) {
+      bvh.Update(this, bounds->TransformBounds(world_transform_));
+    } else {
+      unculled_nodes.push_back(this);
+    }
+  }
+
+  for (auto& child : children_) {
+    if (!child->Collect(world_transform_, bvh, unculled_nodes,
+                        next_render_order)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Node::RenderMesh(SceneEncoder& encoder, Allocator& allocator) {
+  mesh_.Render(encoder, world_transform_,
+               skin_ ? skin_->GetJointsTexture(allocator) : nullptr);
+}
+
+void Node::Update() {
   std::optional<std::vector<MutationLog::Entry>> log = mutation_log_.Flush();
   if (log.has_value()) {
     for (const auto& entry : log.value()) {
@@ -405,17 +453,6 @@ bool Node::Render(SceneEncoder& encoder,
   if (animation_player_.has_value()) {
     animation_player_->Update();
   }
-
-  Matrix transform = parent_transform * local_transform_;
-  mesh_.Render(encoder, transform,
-               skin_ ? skin_->GetJointsTexture(allocator) : nullptr);
-
-  for (auto& child : children_) {
-    if (!child->Render(encoder, allocator, transform)) {
-      return false;
-    }
-  }
-  return true;
 }
 
 void Node::AddMutation(const MutationLog::Entry& entry) {
@@ -18,6 +18,7 @@
 #include "impeller/scene/animation/animation.h"
 #include "impeller/scene/animation/animation_clip.h"
 #include "impeller/scene/animation/animation_player.h"
+#include "impeller/scene/bounding_volume_hierarchy.h"
 #include "impeller/scene/camera.h"
 #include "impeller/scene/mesh.h"
 #include "impeller/scene/scene_encoder.h"
@@ -105,6 +106,27 @@ class Node final {
   void AddMutation(const MutationLog::Entry& entry);
 
  private:
+  /// Applies pending mutations and advances the animation player.
+  void Update();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Updates this node and its children like `Render`, without
+  ///             encoding their meshes. Meshes with bounds are submitted to
+  ///             the hierarchy along with their world space bounds, and the
+  ///             nodes of meshes that can't be culled are appended to
+  ///             `unculled_nodes`. The scene renders the meshes it finds
+  ///             visible once all nodes are updated, in the order of
+  ///             `render_order_`.
+  ///
+  bool Collect(const Matrix& parent_transform,
+               BoundingVolumeHierarchy& bvh,
+               std::vector<Node*>& unculled_nodes,
+               size_t& next_render_order);
+
+  /// Encodes the mesh of this node using the last computed world transform,
+  /// and the last computed joint matrices of its skin.
+  void RenderMesh(SceneEncoder& encoder, Allocator& allocator);
+
   void UnpackFromFlatbuffer(
       const fb::Node& node,
       const std::vector<std::shared_ptr<Node>>& scene_nodes,
@@ -114,6 +136,14 @@ class Node final {
   mutable MutationLog mutation_log_;
 
   Matrix local_transform_;
+  /// The transform of this node in world space, as of the last time the node
+  /// was rendered.
+  Matrix world_transform_;
+  /// The position of this node in the last traversal of the scene graph.
+  /// Meshes are encoded in this order, regardless of the order in which
+  /// culling finds them, so that translucent meshes blend in scene graph
+  /// order.
+  size_t render_order_ = 0;
 
   std::string name_;
   bool is_root_ = false;
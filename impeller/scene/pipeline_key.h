@@ -12,7 +12,8 @@ namespace scene {
 enum class GeometryType {
   kUnskinned = 0,
   kSkinned = 1,
-  kLastType = kSkinned,
+  kUnskinnedQuantized = 2,
+  kLastType = kUnskinnedQuantized,
 };
 enum class MaterialType {
   kUnlit = 0,
@@ -22,10 +23,13 @@ enum class MaterialType {
 struct PipelineKey {
   GeometryType geometry_type = GeometryType::kUnskinned;
   MaterialType material_type = MaterialType::kUnlit;
+  /// Whether the vertex stage reads per-instance transforms from a storage
+  /// buffer instead of a single transform from a uniform.
+  bool instanced = false;
 
   struct Hash {
     constexpr std::size_t operator()(const PipelineKey& o) const {
-      return fml::HashCombine(o.geometry_type, o.material_type);
+      return fml::HashCombine(o.geometry_type, o.material_type, o.instanced);
     }
   };
 
@@ -33,7 +37,8 @@ struct PipelineKey {
     constexpr bool operator()(const PipelineKey& lhs,
                               const PipelineKey& rhs) const {
       return lhs.geometry_type == rhs.geometry_type &&
-             lhs.material_type == rhs.material_type;
+             lhs.material_type == rhs.material_type &&
+             lhs.instanced == rhs.instanced;
     }
   };
 };
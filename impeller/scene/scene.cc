@@ -4,13 +4,18 @@
 
 #include "impeller/scene/scene.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
 #include "impeller/scene/scene_encoder.h"
+#include "impeller/scene/skin.h"
 
 namespace impeller {
 namespace scene {
@@ -32,14 +37,33 @@ Node& Scene::GetRoot() {
 
 bool Scene::Render(const RenderTarget& render_target,
                    const Matrix& camera_transform) {
-  // Collect the render commands from the scene.
-  SceneEncoder encoder;
-  if (!root_.Render(encoder,
-                    *scene_context_->GetContext()->GetResourceAllocator(),
-                    Matrix())) {
+  auto& allocator = *scene_context_->GetContext()->GetResourceAllocator();
+
+  // Update the scene and find the visible nodes. Meshes with bounds are only
+  // visible if their world space bounds intersect the view frustum.
+  visible_nodes_.clear();
+  bvh_.BeginUpdate();
+  size_t render_order = 0;
+  if (!root_.Collect(Matrix(), bvh_, visible_nodes_, render_order)) {
     FML_LOG(ERROR) << "Failed to render frame.";
     return false;
   }
+  bvh_.EndUpdate();
+  bvh_.Query(Frustum::MakeFromTransform(camera_transform), visible_nodes_);
+  // The hierarchy returns nodes in spatial order. Restore the scene graph
+  // order, which translucent meshes are blended in.
+  std::sort(visible_nodes_.begin(), visible_nodes_.end(),
+            [](const Node* a, const Node* b) {
+              return a->render_order_ < b->render_order_;
+            });
+
+  UpdateJointMatrices();
+
+  // Collect the render commands from the visible nodes.
+  SceneEncoder encoder;
+  for (auto* node : visible_nodes_) {
+    node->RenderMesh(encoder, allocator);
+  }
 
   // Encode the commands.
 
@@ -57,6 +81,34 @@ bool Scene::Render(const RenderTarget& render_target,
   return true;
 }
 
+void Scene::UpdateJointMatrices() {
+  TRACE_EVENT0("impeller", "Scene::UpdateJointMatrices");
+  visible_skins_.clear();
+  for (auto* node : visible_nodes_) {
+    if (node->skin_) {
+      visible_skins_.push_back(node->skin_.get());
+    }
+  }
+
+  auto worker_task_runner =
+      scene_context_->GetContext()->GetWorkerTaskRunner();
+  if (!worker_task_runner || visible_skins_.size() < 2u) {
+    for (auto* skin : visible_skins_) {
+      skin->UpdateJointMatrices();
+    }
+    return;
+  }
+
+  fml::CountDownLatch latch(visible_skins_.size());
+  for (auto* skin : visible_skins_) {
+    worker_task_runner->PostTask([skin, &latch]() {
+      skin->UpdateJointMatrices();
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+}
+
 bool Scene::Render(const RenderTarget& render_target, const Camera& camera) {
   return Render(render_target,
                 camera.GetTransform(render_target.GetRenderTargetSize()));
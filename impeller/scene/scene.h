@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 
 #include "impeller/renderer/render_target.h"
+#include "impeller/scene/bounding_volume_hierarchy.h"
 #include "impeller/scene/camera.h"
 #include "impeller/scene/node.h"
 #include "impeller/scene/scene_context.h"
@@ -35,6 +36,17 @@ class Scene {
  private:
   std::shared_ptr<SceneContext> scene_context_;
   Node root_;
+  BoundingVolumeHierarchy bvh_;
+  std::vector<Node*> visible_nodes_;
+  std::vector<Skin*> visible_skins_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the joint matrices of the skins of the visible nodes.
+  ///             Skins are independent of each other, so their palettes are
+  ///             computed in parallel on the worker pool of the context, if
+  ///             it has one.
+  ///
+  void UpdateJointMatrices();
 
   FML_DISALLOW_COPY_AND_ASSIGN(Scene);
 };
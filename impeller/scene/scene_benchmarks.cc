@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <memory>
+#include <vector>
+
+#include "impeller/scene/geometry.h"
+#include "impeller/scene/material.h"
+#include "impeller/scene/scene_encoder.h"
+
+namespace impeller {
+namespace scene {
+
+/// Batches a scene of repeated props: `state.range(0)` instances spread over
+/// `state.range(1)` distinct meshes, added in an interleaved order.
+static void BM_BatchSceneCommands(benchmark::State& state) {
+  const auto instance_count = static_cast<size_t>(state.range(0));
+  const auto mesh_count = static_cast<size_t>(state.range(1));
+
+  std::vector<std::shared_ptr<Geometry>> geometries;
+  std::vector<std::unique_ptr<Material>> materials;
+  for (size_t i = 0; i < mesh_count; i++) {
+    geometries.push_back(Geometry::MakeCuboid({1, 1, 1}));
+    materials.push_back(Material::MakeUnlit());
+  }
+
+  std::vector<SceneCommand> commands;
+  commands.reserve(instance_count);
+  for (size_t i = 0; i < instance_count; i++) {
+    commands.push_back(SceneCommand{
+        .label = "Prop",
+        .transform = Matrix::MakeTranslation({static_cast<Scalar>(i), 0, 0}),
+        .geometry = geometries[i % mesh_count].get(),
+        .material = materials[i % mesh_count].get(),
+    });
+  }
+
+  size_t draw_count = 0u;
+  while (state.KeepRunning()) {
+    auto batches =
+        BatchSceneCommands(commands, SceneEncoder::kMaxInstancesPerDraw);
+    draw_count = batches.size();
+    benchmark::DoNotOptimize(batches);
+  }
+  state.counters["DrawCount"] = draw_count;
+}
+
+BENCHMARK(BM_BatchSceneCommands)
+    ->Args({1000, 1})
+    ->Args({1000, 10})
+    ->Args({10000, 10})
+    ->Args({10000, 100});
+
+}  // namespace scene
+}  // namespace impeller
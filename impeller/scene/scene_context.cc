@@ -8,6 +8,8 @@
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unlit.frag.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
+#include "impeller/scene/shaders/unskinned_quantized.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -44,6 +46,24 @@ SceneContext::SceneContext(std::shared_ptr<Context> context)
           *context_);
   pipelines_[{PipelineKey{GeometryType::kSkinned, MaterialType::kUnlit}}] =
       MakePipelineVariants<SkinnedVertexShader, UnlitFragmentShader>(*context_);
+  // Instanced draws read their transforms from a storage buffer.
+  if (context_->GetCapabilities()->SupportsSSBO()) {
+    pipelines_[{PipelineKey{GeometryType::kUnskinned, MaterialType::kUnlit,
+                            /*instanced=*/true}}] =
+        MakePipelineVariants<UnskinnedInstancedVertexShader,
+                             UnlitFragmentShader>(*context_);
+    pipelines_[{PipelineKey{GeometryType::kUnskinnedQuantized,
+                            MaterialType::kUnlit}}] =
+        MakePipelineVariants<UnskinnedQuantizedVertexShader,
+                             UnlitFragmentShader>(*context_);
+  } else {
+    // Quantized vertices are pulled from a storage buffer. Without storage
+    // buffers, the geometry decodes them on the CPU instead.
+    pipelines_[{PipelineKey{GeometryType::kUnskinnedQuantized,
+                            MaterialType::kUnlit}}] =
+        MakePipelineVariants<UnskinnedVertexShader, UnlitFragmentShader>(
+            *context_);
+  }
 
   {
     impeller::TextureDescriptor texture_descriptor;
@@ -4,6 +4,11 @@
 
 #include "flutter/fml/macros.h"
 
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/fml/logging.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
@@ -20,28 +25,142 @@ void SceneEncoder::Add(const SceneCommand& command) {
   commands_.push_back(command);
 }
 
-static void EncodeCommand(const SceneContext& scene_context,
-                          const Matrix& view_transform,
-                          RenderPass& render_pass,
-                          const SceneCommand& scene_command) {
+/// Encodes a draw of the material of `scene_command`. `bind_geometry` binds
+/// the vertices, and the transforms, to the command. Returns false if the
+/// pipeline or the geometry doesn't support the draw, in which case nothing is
+/// encoded.
+template <typename GeometryBinder>
+static bool EncodeDraw(const SceneContext& scene_context,
+                       RenderPass& render_pass,
+                       const SceneCommand& scene_command,
+                       bool instanced,
+                       const GeometryBinder& bind_geometry) {
+  auto pipeline = scene_context.GetPipeline(
+      PipelineKey{scene_command.geometry->GetGeometryType(),
+                  scene_command.material->GetMaterialType(), instanced},
+      scene_command.material->GetContextOptions(render_pass));
+  if (!pipeline) {
+    return false;
+  }
+
   auto& host_buffer = render_pass.GetTransientsBuffer();
 
   Command cmd;
   cmd.label = scene_command.label;
   cmd.stencil_reference =
       0;  // TODO(bdero): Configurable stencil ref per-command.
+  cmd.pipeline = std::move(pipeline);
+  if (!bind_geometry(host_buffer, cmd)) {
+    return false;
+  }
+  scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
 
-  cmd.pipeline = scene_context.GetPipeline(
-      PipelineKey{scene_command.geometry->GetGeometryType(),
-                  scene_command.material->GetMaterialType()},
-      scene_command.material->GetContextOptions(render_pass));
+  return render_pass.AddCommand(std::move(cmd));
+}
 
-  scene_command.geometry->BindToCommand(
-      scene_context, host_buffer, view_transform * scene_command.transform,
-      cmd);
-  scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
+static void EncodeCommand(const SceneContext& scene_context,
+                          const Matrix& view_transform,
+                          RenderPass& render_pass,
+                          const SceneCommand& scene_command) {
+  EncodeDraw(scene_context, render_pass, scene_command, /*instanced=*/false,
+             [&](HostBuffer& host_buffer, Command& cmd) {
+               scene_command.geometry->BindToCommand(
+                   scene_context, host_buffer,
+                   view_transform * scene_command.transform, cmd);
+               return true;
+             });
+}
+
+/// Encodes a batch of commands sharing a geometry and a material as a single
+/// instanced draw. Returns false if the pipeline or the geometry doesn't
+/// support instancing, in which case nothing is encoded.
+static bool EncodeInstancedCommand(const SceneContext& scene_context,
+                                   const Matrix& view_transform,
+                                   RenderPass& render_pass,
+                                   const SceneCommandBatch& batch) {
+  std::vector<Matrix> transforms;
+  transforms.reserve(batch.size());
+  for (const auto* command : batch) {
+    transforms.push_back(view_transform * command->transform);
+  }
 
-  render_pass.AddCommand(std::move(cmd));
+  const auto& first = *batch.front();
+  return EncodeDraw(scene_context, render_pass, first, /*instanced=*/true,
+                    [&](HostBuffer& host_buffer, Command& cmd) {
+                      return first.geometry->BindInstancesToCommand(
+                          scene_context, host_buffer, transforms, cmd);
+                    });
+}
+
+namespace {
+
+/// A scene command along with the keys it is ordered by. Materials and
+/// geometries are identified by the index of the first command that uses
+/// them, so that the order doesn't depend on where they are allocated.
+struct SortedSceneCommand {
+  const SceneCommand* command;
+  size_t material_id;
+  size_t geometry_id;
+};
+
+}  // namespace
+
+/// Orders opaque commands so that commands sharing a pipeline, and then a
+/// material, are encoded next to each other. Translucent commands are encoded
+/// last, in the order in which they were added.
+static bool CommandEncodesBefore(const SortedSceneCommand& a,
+                                 const SortedSceneCommand& b) {
+  const bool a_translucent = a.command->material->IsTranslucent();
+  const bool b_translucent = b.command->material->IsTranslucent();
+  if (a_translucent || b_translucent) {
+    return !a_translucent && b_translucent;
+  }
+  return std::make_tuple(a.command->geometry->GetGeometryType(),
+                         a.command->material->GetMaterialType(), a.material_id,
+                         a.geometry_id) <
+         std::make_tuple(b.command->geometry->GetGeometryType(),
+                         b.command->material->GetMaterialType(), b.material_id,
+                         b.geometry_id);
+}
+
+std::vector<SceneCommandBatch> BatchSceneCommands(
+    const std::vector<SceneCommand>& commands,
+    size_t max_instance_count) {
+  std::unordered_map<const Material*, size_t> material_ids;
+  std::unordered_map<const Geometry*, size_t> geometry_ids;
+  std::vector<SortedSceneCommand> sorted_commands;
+  sorted_commands.reserve(commands.size());
+  for (size_t i = 0; i < commands.size(); i++) {
+    const auto& command = commands[i];
+    sorted_commands.push_back(
+        {.command = &command,
+         .material_id = material_ids.try_emplace(command.material, i)
+                            .first->second,
+         .geometry_id = geometry_ids.try_emplace(command.geometry, i)
+                            .first->second});
+  }
+  // The sort is stable, so translucent commands, and opaque commands that
+  // can't be told apart, keep the order in which they were added.
+  std::stable_sort(sorted_commands.begin(), sorted_commands.end(),
+                   CommandEncodesBefore);
+
+  std::vector<SceneCommandBatch> batches;
+  for (const auto& sorted_command : sorted_commands) {
+    const auto* command = sorted_command.command;
+    if (!batches.empty()) {
+      auto& batch = batches.back();
+      const auto* last = batch.back();
+      if (batch.size() < max_instance_count &&
+          !command->material->IsTranslucent() &&
+          command->geometry == last->geometry &&
+          command->material == last->material) {
+        batch.push_back(command);
+        continue;
+      }
+    }
+    batches.push_back({command});
+  }
+  return batches;
 }
 
 std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
@@ -90,8 +209,16 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  for (const auto& batch :
+       BatchSceneCommands(commands_, kMaxInstancesPerDraw)) {
+    if (batch.size() > 1u &&
+        EncodeInstancedCommand(scene_context, camera_transform, *render_pass,
+                               batch)) {
+      continue;
+    }
+    for (const auto* command : batch) {
+      EncodeCommand(scene_context, camera_transform, *render_pass, *command);
+    }
   }
 
   if (!render_pass->EncodeCommands()) {
@@ -26,8 +26,32 @@ struct SceneCommand {
   Material* material;
 };
 
+/// A run of scene commands that are encoded together, as a single draw when
+/// there is more than one.
+using SceneCommandBatch = std::vector<const SceneCommand*>;
+
+//------------------------------------------------------------------------------
+/// @brief      Orders scene commands for encoding, and batches opaque commands
+///             that share both their geometry and their material so that they
+///             may be drawn instanced.
+///
+///             Translucent commands are encoded last, one per batch, in the
+///             order in which they were added. The order of the batches only
+///             depends on the order of the commands, and not on the addresses
+///             of their geometries or materials.
+///
+/// @param[in]  commands            The commands to order.
+/// @param[in]  max_instance_count  The largest number of commands in a batch.
+///
+std::vector<SceneCommandBatch> BatchSceneCommands(
+    const std::vector<SceneCommand>& commands,
+    size_t max_instance_count);
+
 class SceneEncoder {
  public:
+  /// The largest number of instances that are encoded into a single draw.
+  static constexpr size_t kMaxInstancesPerDraw = 1024u;
+
   void Add(const SceneCommand& command);
 
  private:
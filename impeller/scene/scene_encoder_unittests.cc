@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/scene/geometry.h"
+#include "impeller/scene/material.h"
+#include "impeller/scene/scene_encoder.h"
+
+namespace impeller {
+namespace scene {
+namespace testing {
+
+namespace {
+
+SceneCommand MakeCommand(Geometry* geometry, Material* material) {
+  return SceneCommand{.label = "Test",
+                      .transform = Matrix(),
+                      .geometry = geometry,
+                      .material = material};
+}
+
+}  // namespace
+
+TEST(SceneEncoderTest, BatchesCommandsSharingGeometryAndMaterial) {
+  auto geometry = Geometry::MakeCuboid({1, 1, 1});
+  auto material = Material::MakeUnlit();
+
+  std::vector<SceneCommand> commands;
+  for (int i = 0; i < 5; i++) {
+    commands.push_back(MakeCommand(geometry.get(), material.get()));
+  }
+
+  auto batches = BatchSceneCommands(commands, 1024u);
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[0].size(), 5u);
+}
+
+TEST(SceneEncoderTest, BatchesInterleavedCommands) {
+  auto geometry_a = Geometry::MakeCuboid({1, 1, 1});
+  auto geometry_b = Geometry::MakeCuboid({2, 2, 2});
+  auto material = Material::MakeUnlit();
+
+  std::vector<SceneCommand> commands;
+  for (int i = 0; i < 4; i++) {
+    commands.push_back(MakeCommand(geometry_a.get(), material.get()));
+    commands.push_back(MakeCommand(geometry_b.get(), material.get()));
+  }
+
+  auto batches = BatchSceneCommands(commands, 1024u);
+  ASSERT_EQ(batches.size(), 2u);
+  for (const auto& batch : batches) {
+    ASSERT_EQ(batch.size(), 4u);
+    for (const auto* command : batch) {
+      EXPECT_EQ(command->geometry, batch.front()->geometry);
+    }
+  }
+}
+
+TEST(SceneEncoderTest, DoesNotBatchAcrossMaterials) {
+  auto geometry = Geometry::MakeCuboid({1, 1, 1});
+  auto material_a = Material::MakeUnlit();
+  auto material_b = Material::MakeUnlit();
+
+  std::vector<SceneCommand> commands = {
+      MakeCommand(geometry.get(), material_a.get()),
+      MakeCommand(geometry.get(), material_b.get()),
+  };
+
+  EXPECT_EQ(BatchSceneCommands(commands, 1024u).size(), 2u);
+}
+
+TEST(SceneEncoderTest, SplitsBatchesAtMaxInstanceCount) {
+  auto geometry = Geometry::MakeCuboid({1, 1, 1});
+  auto material = Material::MakeUnlit();
+
+  std::vector<SceneCommand> commands;
+  for (int i = 0; i < 10; i++) {
+    commands.push_back(MakeCommand(geometry.get(), material.get()));
+  }
+
+  auto batches = BatchSceneCommands(commands, 4u);
+  ASSERT_EQ(batches.size(), 3u);
+  EXPECT_EQ(batches[0].size(), 4u);
+  EXPECT_EQ(batches[1].size(), 4u);
+  EXPECT_EQ(batches[2].size(), 2u);
+}
+
+TEST(SceneEncoderTest, DoesNotBatchTranslucentCommands) {
+  auto geometry = Geometry::MakeCuboid({1, 1, 1});
+  auto opaque = Material::MakeUnlit();
+  auto translucent = Material::MakeUnlit();
+  translucent->SetTranslucent(true);
+
+  std::vector<SceneCommand> commands = {
+      MakeCommand(geometry.get(), translucent.get()),
+      MakeCommand(geometry.get(), opaque.get()),
+      MakeCommand(geometry.get(), translucent.get()),
+      MakeCommand(geometry.get(), opaque.get()),
+  };
+
+  auto batches = BatchSceneCommands(commands, 1024u);
+  ASSERT_EQ(batches.size(), 3u);
+  EXPECT_EQ(batches[0].size(), 2u);
+  EXPECT_EQ(batches[0].front()->material, opaque.get());
+  EXPECT_EQ(batches[1].size(), 1u);
+  EXPECT_EQ(batches[2].size(), 1u);
+  EXPECT_EQ(batches[2].front()->material, translucent.get());
+}
+
+TEST(SceneEncoderTest, OrdersMaterialsByFirstUse) {
+  auto geometry = Geometry::MakeCuboid({1, 1, 1});
+  std::vector<std::unique_ptr<Material>> materials;
+  for (int i = 0; i < 8; i++) {
+    materials.push_back(Material::MakeUnlit());
+  }
+
+  // Add the materials in reverse order of their addresses.
+  std::sort(materials.begin(), materials.end(),
+            [](const auto& a, const auto& b) { return a.get() > b.get(); });
+  std::vector<SceneCommand> commands;
+  for (int pass = 0; pass < 2; pass++) {
+    for (const auto& material : materials) {
+      commands.push_back(MakeCommand(geometry.get(), material.get()));
+    }
+  }
+
+  auto batches = BatchSceneCommands(commands, 1024u);
+  ASSERT_EQ(batches.size(), materials.size());
+  for (size_t i = 0; i < batches.size(); i++) {
+    EXPECT_EQ(batches[i].size(), 2u);
+    EXPECT_EQ(batches[i].front()->material, materials[i].get());
+  }
+}
+
+TEST(SceneEncoderTest, KeepsTheOrderOfTranslucentCommands) {
+  auto geometry_a = Geometry::MakeCuboid({1, 1, 1});
+  auto geometry_b = Geometry::MakeCuboid({2, 2, 2});
+  auto material_a = Material::MakeUnlit();
+  material_a->SetTranslucent(true);
+  auto material_b = Material::MakeUnlit();
+  material_b->SetTranslucent(true);
+
+  std::vector<SceneCommand> commands = {
+      MakeCommand(geometry_b.get(), material_b.get()),
+      MakeCommand(geometry_a.get(), material_a.get()),
+      MakeCommand(geometry_b.get(), material_a.get()),
+      MakeCommand(geometry_a.get(), material_b.get()),
+  };
+
+  auto batches = BatchSceneCommands(commands, 1024u);
+  ASSERT_EQ(batches.size(), commands.size());
+  for (size_t i = 0; i < batches.size(); i++) {
+    ASSERT_EQ(batches[i].size(), 1u);
+    EXPECT_EQ(batches[i].front(), &commands[i]);
+  }
+}
+
+}  // namespace testing
+}  // namespace scene
+}  // namespace impeller
@@ -300,6 +300,45 @@ TEST_P(SceneTest, Dash) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(SceneTest, ThousandsOfRepeatedCuboids) {
+  auto scene_context = std::make_shared<SceneContext>(GetContext());
+  auto scene = Scene(scene_context);
+
+  // Every node shares its geometry and material, so all of them are encoded
+  // as a handful of instanced draws.
+  Vector3 size(0.5, 0.5, 0.5);
+  std::shared_ptr<Geometry> geometry = Geometry::MakeCuboid(size);
+  std::shared_ptr<Material> material = Material::MakeUnlit();
+  static constexpr int kGridSize = 64;
+  for (int x = 0; x < kGridSize; x++) {
+    for (int z = 0; z < kGridSize; z++) {
+      auto node = std::make_shared<Node>();
+      Mesh mesh;
+      mesh.AddPrimitive({geometry, material});
+      node->SetMesh(std::move(mesh));
+      node->SetLocalTransform(
+          Matrix::MakeTranslation({x - kGridSize / 2.0f, 0, z * 1.0f}));
+      scene.GetRoot().AddChild(std::move(node));
+    }
+  }
+
+  Renderer::RenderCallback callback = [&](RenderTarget& render_target) {
+    Quaternion rotation({0, 1, 0}, GetSecondsElapsed() * 0.1);
+    // Face towards the +Z direction (+X right, +Y up).
+    auto camera = Camera::MakePerspective(
+                      /* fov */ Degrees(60),
+                      /* position */ Vector3(0, 10, -10))
+                      .LookAt(
+                          /* target */ rotation * Vector3(0, 0, 1),
+                          /* up */ {0, 1, 0});
+
+    scene.Render(render_target, camera);
+    return true;
+  };
+
+  OpenPlaygroundHere(callback);
+}
+
 }  // namespace testing
 }  // namespace scene
 }  // namespace impeller
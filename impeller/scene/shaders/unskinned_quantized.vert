@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifdef IMPELLER_TARGET_OPENGLES
+
+void main() {
+  // Storage buffers are not supported on legacy targets. Quantized geometry is
+  // decoded on the CPU and drawn with the unskinned pipeline instead.
+}
+
+#else  // IMPELLER_TARGET_OPENGLES
+
+uniform FrameInfo {
+  mat4 mvp;
+  // Dequantized positions are `position_offset + unorm * position_scale`.
+  vec4 position_offset;
+  vec4 position_scale;
+}
+frame_info;
+
+// The vertices are pulled from a storage buffer rather than declared as
+// inputs, since not every backend can describe packed 16 bit vertex
+// attributes. This layout is expected to be identical to that of
+// `QuantizedVertex` within `impeller/scene/importer/scene.fbs`.
+readonly buffer VertexData {
+  uint words[];
+}
+vertex_data;
+
+const int kWordsPerVertex = 6;
+
+out vec3 v_position;
+out mat3 v_tangent_space;
+out vec2 v_texture_coords;
+out vec4 v_color;
+
+vec3 DecodeOctahedral(vec2 encoded) {
+  vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float fold = max(-direction.z, 0.0);
+  direction.x += direction.x >= 0.0 ? -fold : fold;
+  direction.y += direction.y >= 0.0 ? -fold : fold;
+  return normalize(direction);
+}
+
+void main() {
+  int base = gl_VertexIndex * kWordsPerVertex;
+  vec2 position_xy = unpackUnorm2x16(vertex_data.words[base]);
+  vec2 position_z_tangent_w = unpackUnorm2x16(vertex_data.words[base + 1]);
+  vec3 normal = DecodeOctahedral(unpackSnorm2x16(vertex_data.words[base + 2]));
+  vec3 tangent = DecodeOctahedral(unpackSnorm2x16(vertex_data.words[base + 3]));
+  vec2 texture_coords = unpackHalf2x16(vertex_data.words[base + 4]);
+  vec4 color = unpackUnorm4x8(vertex_data.words[base + 5]);
+
+  vec3 position =
+      frame_info.position_offset.xyz +
+      vec3(position_xy, position_z_tangent_w.x) * frame_info.position_scale.xyz;
+  float tangent_w = position_z_tangent_w.y * 2.0 - 1.0;
+
+  gl_Position = frame_info.mvp * vec4(position, 1.0);
+  v_position = gl_Position.xyz;
+
+  vec3 lh_tangent = tangent * tangent_w;
+  v_tangent_space = mat3(frame_info.mvp) *
+                    mat3(lh_tangent, cross(normal, lh_tangent), normal);
+  v_texture_coords = texture_coords;
+  v_color = color;
+}
+
+#endif  // IMPELLER_TARGET_OPENGLES
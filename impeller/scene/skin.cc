@@ -38,6 +38,10 @@ std::unique_ptr<Skin> Skin::MakeFromFlatbuffer(
       scene_nodes[joint]->SetIsJoint(true);
     }
     result.joints_.push_back(scene_nodes[joint]);
+    if (scene_nodes[joint]) {
+      result.joint_indices_.insert(
+          {scene_nodes[joint].get(), result.joints_.size() - 1});
+    }
   }
 
   result.inverse_bind_matrices_.reserve(skin.inverse_bind_matrices()->size());
@@ -62,44 +66,24 @@ Skin::Skin(Skin&&) = default;
 
 Skin& Skin::operator=(Skin&&) = default;
 
-std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
+void Skin::UpdateJointMatrices() {
   // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
   // Therefore, each joint needs 4 pixels.
   auto required_pixels = joints_.size() * 4;
   auto dimension_size = std::max(
       2u,
       Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
+  palette_size_ = ISize(dimension_size, dimension_size);
+  joint_matrices_.assign(palette_size_.Area() / 4, Matrix());
+  model_matrices_.resize(joints_.size());
+  model_matrices_computed_.assign(joints_.size(), false);
 
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
-  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
-  texture_descriptor.size = {dimension_size, dimension_size};
-  texture_descriptor.mip_count = 1u;
-
-  auto result = allocator.CreateTexture(texture_descriptor);
-  result->SetLabel("Joints Texture");
-  if (!result) {
-    FML_LOG(ERROR) << "Could not create joint texture.";
-    return nullptr;
-  }
-
-  std::vector<Matrix> joints;
-  joints.resize(result->GetSize().Area() / 4, Matrix());
-  FML_DCHECK(joints.size() >= joints_.size());
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
-    const Node* joint = joints_[joint_i].get();
-    if (!joint) {
+    if (!joints_[joint_i]) {
       // When a joint is missing, just let it remain as an identity matrix.
       continue;
     }
 
-    // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
-    while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
-      joint = joint->GetParent();
-    }
-
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
     // transforms from model space to the default pose space of the joint. The
@@ -107,11 +91,56 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     // the joint's default pose and the joint's current pose in the scene. This
     // is necessary because the skinned model's vertex positions (which _define_
     // the default pose) are all in model space.
-    joints[joint_i] = joints[joint_i] * inverse_bind_matrices_[joint_i];
+    joint_matrices_[joint_i] =
+        GetJointModelMatrix(joint_i) * inverse_bind_matrices_[joint_i];
+  }
+}
+
+const Matrix& Skin::GetJointModelMatrix(size_t joint_index) {
+  if (model_matrices_computed_[joint_index]) {
+    return model_matrices_[joint_index];
   }
 
-  if (!result->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
-                           joints.size() * sizeof(Matrix))) {
+  // Compute a model space matrix for the joint by walking up the bones to the
+  // skeleton root, or to the first parent joint of this skin, whose model
+  // space matrix is computed (once) in the same way.
+  Matrix matrix = joints_[joint_index]->GetLocalTransform();
+  const Node* joint = joints_[joint_index]->GetParent();
+  while (joint && joint->IsJoint()) {
+    if (auto found = joint_indices_.find(joint);
+        found != joint_indices_.end()) {
+      matrix = GetJointModelMatrix(found->second) * matrix;
+      break;
+    }
+    matrix = joint->GetLocalTransform() * matrix;
+    joint = joint->GetParent();
+  }
+
+  model_matrices_[joint_index] = matrix;
+  model_matrices_computed_[joint_index] = true;
+  return model_matrices_[joint_index];
+}
+
+std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
+  if (joint_matrices_.empty()) {
+    UpdateJointMatrices();
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
+  texture_descriptor.size = palette_size_;
+  texture_descriptor.mip_count = 1u;
+
+  auto result = allocator.CreateTexture(texture_descriptor);
+  if (!result) {
+    FML_LOG(ERROR) << "Could not create joint texture.";
+    return nullptr;
+  }
+  result->SetLabel("Joints Texture");
+
+  if (!result->SetContents(reinterpret_cast<uint8_t*>(joint_matrices_.data()),
+                           joint_matrices_.size() * sizeof(Matrix))) {
     FML_LOG(ERROR) << "Could not set contents of joint texture.";
     return nullptr;
   }
@@ -6,6 +6,8 @@
 
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 
@@ -27,6 +29,20 @@ class Skin final {
   Skin(Skin&&);
   Skin& operator=(Skin&&);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the joint matrices of the skin from the current
+  ///             local transforms of its joints.
+  ///
+  ///             Only the joints of this skin are read and only this skin is
+  ///             written, so the palettes of different skins may be computed
+  ///             concurrently, as long as the scene isn't mutated meanwhile.
+  ///
+  void UpdateJointMatrices();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Uploads the joint matrices computed by the last call to
+  ///             `UpdateJointMatrices` to a new texture.
+  ///
   std::shared_ptr<Texture> GetJointsTexture(Allocator& allocator);
 
  private:
@@ -34,6 +50,18 @@ class Skin final {
 
   std::vector<std::shared_ptr<Node>> joints_;
   std::vector<Matrix> inverse_bind_matrices_;
+  /// Maps joint nodes to their index in `joints_`, so that the model space
+  /// matrices of parent joints are reused instead of walking every joint up
+  /// to the skeleton root.
+  std::unordered_map<const Node*, size_t> joint_indices_;
+  std::vector<Matrix> joint_matrices_;
+  /// The size of the texture the joint matrices are uploaded to.
+  ISize palette_size_;
+  /// Scratch state of `UpdateJointMatrices`, kept to avoid reallocating it.
+  std::vector<Matrix> model_matrices_;
+  std::vector<bool> model_matrices_computed_;
+
+  const Matrix& GetJointModelMatrix(size_t joint_index);
 
   FML_DISALLOW_COPY_AND_ASSIGN(Skin);
 };
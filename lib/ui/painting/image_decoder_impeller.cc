@@ -14,7 +14,9 @@
 #include "flutter/impeller/display_list/dl_image_impeller.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/renderer/texture_ktx2.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
 #include "impeller/base/strings.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/geometry/size.h"
@@ -471,6 +473,29 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
+        // KTX2 images are uploaded with all of their levels as they are,
+        // unless the device can't sample their format.
+        if (auto ktx2_image =
+                KTX2ImageGenerator::GetKTX2Image(raw_descriptor->data())) {
+          const auto& size = ktx2_image->GetSize();
+          if (size.width > max_size_supported.width ||
+              size.height > max_size_supported.height) {
+            result(nullptr, "KTX2 image exceeds the maximum texture size.");
+            return;
+          }
+          io_runner->PostTask([result, context, ktx2_image]() {
+            auto texture =
+                impeller::CreateTextureForKTX2Image(*context, *ktx2_image);
+            if (!texture) {
+              result(nullptr, "Could not create texture for KTX2 image.");
+              return;
+            }
+            result(impeller::DlImageImpeller::Make(std::move(texture)),
+                   std::string());
+          });
+          return;
+        }
+
         // Always decompress on the concurrent runner.
         auto bitmap_result = DecompressTexture(
             raw_descriptor, target_size, max_size_supported,
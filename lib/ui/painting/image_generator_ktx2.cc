@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+static SkAlphaType AlphaTypeForKTX2Format(
+    impeller::CompressedImageKTX2::Format format) {
+  switch (format) {
+    case impeller::CompressedImageKTX2::Format::kETC2R8G8B8:
+      return kOpaque_SkAlphaType;
+    case impeller::CompressedImageKTX2::Format::kR8G8B8A8:
+    case impeller::CompressedImageKTX2::Format::kETC2R8G8B8A8:
+    case impeller::CompressedImageKTX2::Format::kASTC4x4:
+      return kPremul_SkAlphaType;
+  }
+  FML_UNREACHABLE();
+}
+
+KTX2ImageGenerator::KTX2ImageGenerator(
+    std::shared_ptr<impeller::CompressedImageKTX2> image)
+    : image_(std::move(image)),
+      image_info_(SkImageInfo::Make(image_->GetSize().width,
+                                    image_->GetSize().height,
+                                    kRGBA_8888_SkColorType,
+                                    AlphaTypeForKTX2Format(
+                                        image_->GetFormat()))) {}
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+std::shared_ptr<impeller::CompressedImageKTX2>
+KTX2ImageGenerator::GetKTX2Image(const sk_sp<SkData>& data) {
+  if (!data) {
+    return nullptr;
+  }
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      data->bytes(), data->size(),
+      // The image references the data instead of copying it.
+      [data](auto, auto) {});
+  if (!impeller::CompressedImageKTX2::IsKTX2(*mapping)) {
+    return nullptr;
+  }
+  return impeller::CompressedImageKTX2::Create(std::move(mapping));
+}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  TRACE_EVENT0("flutter", "KTX2ImageGenerator::GetPixels");
+  if (info.dimensions() != image_info_.dimensions()) {
+    FML_DLOG(ERROR) << "KTX2 images can only be decoded at their full size.";
+    return false;
+  }
+  const auto decompressed = image_->Decode();
+  if (!decompressed.IsValid() ||
+      decompressed.GetFormat() != impeller::DecompressedImage::Format::kRGBA) {
+    FML_DLOG(ERROR) << "Could not decode KTX2 image.";
+    return false;
+  }
+  const SkPixmap decoded(image_info_,
+                         decompressed.GetAllocation()->GetMapping(),
+                         image_info_.minRowBytes());
+  return decoded.readPixels(info, pixels, row_bytes);
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  auto image = GetKTX2Image(data);
+  if (!image) {
+    return nullptr;
+  }
+  return std::unique_ptr<ImageGenerator>(
+      new KTX2ImageGenerator(std::move(image)));
+}
+
+}  // namespace flutter
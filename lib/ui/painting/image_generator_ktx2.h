@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+#include "impeller/image/backends/ktx2/compressed_image_ktx2.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes images in KTX2 containers, whose levels are in a format
+///             that GPUs can sample from directly.
+///
+///             The Impeller image decoder uploads the levels of these images
+///             as is, see |GetKTX2Image|. This generator transcodes the base
+///             level to RGBA for everything else. The alpha of the levels is
+///             taken to be premultiplied, since compressed blocks cannot be
+///             premultiplied when they are uploaded.
+///
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  ~KTX2ImageGenerator();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the image in the data if it is a supported KTX2
+  ///             image, or `nullptr` otherwise. Only parses the container.
+  ///
+  static std::shared_ptr<impeller::CompressedImageKTX2> GetKTX2Image(
+      const sk_sp<SkData>& data);
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  std::shared_ptr<impeller::CompressedImageKTX2> image_;
+  SkImageInfo image_info_;
+
+  explicit KTX2ImageGenerator(
+      std::shared_ptr<impeller::CompressedImageKTX2> image);
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
@@ -4,6 +4,9 @@
 
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 
+#include <cstring>
+#include <vector>
+
 #include "flutter/fml/mapping.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
@@ -42,6 +45,43 @@ TEST_F(ShellTest, CreateCompatibleReturnsBuiltinImageGeneratorForValidImage) {
   ASSERT_EQ(info.height(), 4032);
 }
 
+TEST_F(ShellTest, CreateCompatibleReturnsKTX2ImageGeneratorForKTX2Image) {
+  // A 2x2 RGBA8 image in a KTX2 container.
+  const uint8_t identifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  std::vector<uint8_t> ktx2(104u);
+  std::memcpy(ktx2.data(), identifier, sizeof(identifier));
+  auto write_u32 = [&ktx2](size_t offset, uint32_t value) {
+    std::memcpy(ktx2.data() + offset, &value, sizeof(value));
+  };
+  write_u32(12u, 37u);  // VK_FORMAT_R8G8B8A8_UNORM
+  write_u32(20u, 2u);   // pixelWidth
+  write_u32(24u, 2u);   // pixelHeight
+  write_u32(36u, 1u);   // faceCount
+  write_u32(40u, 1u);   // levelCount
+  write_u32(80u, ktx2.size());
+  write_u32(88u, 16u);
+  const uint8_t pixel[] = {0x80, 0x40, 0x20, 0xFF};
+  for (size_t i = 0; i < 4u; i++) {
+    ktx2.insert(ktx2.end(), pixel, pixel + sizeof(pixel));
+  }
+
+  ImageGeneratorRegistry registry;
+  auto result = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(ktx2.data(), ktx2.size()));
+  ASSERT_NE(result, nullptr);
+  const auto info = result->GetInfo();
+  ASSERT_EQ(info.width(), 2);
+  ASSERT_EQ(info.height(), 2);
+
+  std::vector<uint8_t> pixels(info.computeMinByteSize());
+  ASSERT_TRUE(
+      result->GetPixels(info, pixels.data(), info.minRowBytes(), 0, {}));
+  for (size_t i = 0; i < pixels.size(); i += sizeof(pixel)) {
+    ASSERT_EQ(std::memcmp(pixels.data() + i, pixel, sizeof(pixel)), 0);
+  }
+}
+
 TEST_F(ShellTest, CreateCompatibleReturnsNullptrForInvalidImage) {
   ImageGeneratorRegistry registry;
   auto result = registry.CreateCompatibleGenerator(SkData::MakeEmpty());
@@ -0,0 +1,241 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+bool PackedSemanticsNode::HasAction(SemanticsAction action) const {
+  return (actions & static_cast<int32_t>(action)) != 0;
+}
+
+bool PackedSemanticsNode::HasFlag(SemanticsFlags flag) const {
+  return (flags & static_cast<int32_t>(flag)) != 0;
+}
+
+PackedSemanticsUpdate::PackedSemanticsUpdate() = default;
+
+PackedSemanticsUpdate::~PackedSemanticsUpdate() = default;
+
+PackedSemanticsUpdate::PackedSemanticsUpdate(
+    const PackedSemanticsUpdate& other) = default;
+
+PackedSemanticsUpdate::PackedSemanticsUpdate(PackedSemanticsUpdate&& other) =
+    default;
+
+PackedSemanticsUpdate& PackedSemanticsUpdate::operator=(
+    const PackedSemanticsUpdate& other) = default;
+
+PackedSemanticsUpdate& PackedSemanticsUpdate::operator=(
+    PackedSemanticsUpdate&& other) = default;
+
+const char* PackedSemanticsUpdate::GetString(
+    PackedSemanticsNode::StringIndex index) const {
+  if (index >= string_offsets_.size()) {
+    // Only a default constructed update has no strings at all.
+    FML_DCHECK(string_offsets_.empty());
+    return "";
+  }
+  return string_data_.data() + string_offsets_[index];
+}
+
+size_t PackedSemanticsUpdate::GetStringLength(
+    PackedSemanticsNode::StringIndex index) const {
+  if (index >= string_offsets_.size()) {
+    FML_DCHECK(string_offsets_.empty());
+    return 0;
+  }
+  const size_t end = index + 1 < string_offsets_.size()
+                         ? string_offsets_[index + 1]
+                         : string_data_.size();
+  // Excludes the null terminator.
+  return end - string_offsets_[index] - 1;
+}
+
+const int32_t* PackedSemanticsUpdate::GetInt32s(
+    PackedSemanticsRange range) const {
+  FML_DCHECK(range.offset + range.count <= int32s_.size());
+  return int32s_.data() + range.offset;
+}
+
+const StringAttributePtr* PackedSemanticsUpdate::GetStringAttributes(
+    PackedSemanticsRange range) const {
+  FML_DCHECK(range.offset + range.count <= string_attributes_.size());
+  return string_attributes_.data() + range.offset;
+}
+
+SemanticsNode PackedSemanticsUpdate::ToSemanticsNode(
+    const PackedSemanticsNode& node) const {
+  auto string = [this](PackedSemanticsNode::StringIndex index) {
+    return std::string(GetString(index), GetStringLength(index));
+  };
+  auto attributes = [this](PackedSemanticsRange range) {
+    const StringAttributePtr* data = GetStringAttributes(range);
+    return StringAttributes(data, data + range.count);
+  };
+  auto int32s = [this](PackedSemanticsRange range) {
+    const int32_t* data = GetInt32s(range);
+    return std::vector<int32_t>(data, data + range.count);
+  };
+
+  SemanticsNode result;
+  result.id = node.id;
+  result.flags = node.flags;
+  result.actions = node.actions;
+  result.maxValueLength = node.maxValueLength;
+  result.currentValueLength = node.currentValueLength;
+  result.textSelectionBase = node.textSelectionBase;
+  result.textSelectionExtent = node.textSelectionExtent;
+  result.platformViewId = node.platformViewId;
+  result.scrollChildren = node.scrollChildren;
+  result.scrollIndex = node.scrollIndex;
+  result.scrollPosition = node.scrollPosition;
+  result.scrollExtentMax = node.scrollExtentMax;
+  result.scrollExtentMin = node.scrollExtentMin;
+  result.elevation = node.elevation;
+  result.thickness = node.thickness;
+  result.label = string(node.label);
+  result.labelAttributes = attributes(node.labelAttributes);
+  result.hint = string(node.hint);
+  result.hintAttributes = attributes(node.hintAttributes);
+  result.value = string(node.value);
+  result.valueAttributes = attributes(node.valueAttributes);
+  result.increasedValue = string(node.increasedValue);
+  result.increasedValueAttributes = attributes(node.increasedValueAttributes);
+  result.decreasedValue = string(node.decreasedValue);
+  result.decreasedValueAttributes = attributes(node.decreasedValueAttributes);
+  result.tooltip = string(node.tooltip);
+  result.textDirection = node.textDirection;
+  result.rect = node.rect;
+  result.transform = node.transform;
+  result.childrenInTraversalOrder = int32s(node.childrenInTraversalOrder);
+  result.childrenInHitTestOrder = int32s(node.childrenInHitTestOrder);
+  result.customAccessibilityActions = int32s(node.customAccessibilityActions);
+  return result;
+}
+
+SemanticsNodeUpdates PackedSemanticsUpdate::ToSemanticsNodeUpdates() const {
+  SemanticsNodeUpdates updates;
+  updates.reserve(nodes_.size());
+  for (const PackedSemanticsNode& node : nodes_) {
+    updates.emplace(node.id, ToSemanticsNode(node));
+  }
+  return updates;
+}
+
+PackedSemanticsUpdateBuilder::PackedSemanticsUpdateBuilder() {
+  Reset();
+}
+
+PackedSemanticsUpdateBuilder::~PackedSemanticsUpdateBuilder() = default;
+
+PackedSemanticsNode& PackedSemanticsUpdateBuilder::AddNode(int32_t id) {
+  auto [it, inserted] = node_indices_.emplace(id, update_.nodes_.size());
+  if (inserted) {
+    update_.nodes_.emplace_back();
+  } else {
+    // The strings and lists of the previous version of the node stay in the
+    // shared arrays, unreferenced. Nodes are rarely updated twice in a batch.
+    update_.nodes_[it->second] = PackedSemanticsNode();
+  }
+  PackedSemanticsNode& node = update_.nodes_[it->second];
+  node.id = id;
+  return node;
+}
+
+void PackedSemanticsUpdateBuilder::AddNode(const SemanticsNode& node) {
+  PackedSemanticsNode& packed = AddNode(node.id);
+  packed.flags = node.flags;
+  packed.actions = node.actions;
+  packed.maxValueLength = node.maxValueLength;
+  packed.currentValueLength = node.currentValueLength;
+  packed.textSelectionBase = node.textSelectionBase;
+  packed.textSelectionExtent = node.textSelectionExtent;
+  packed.platformViewId = node.platformViewId;
+  packed.scrollChildren = node.scrollChildren;
+  packed.scrollIndex = node.scrollIndex;
+  packed.scrollPosition = node.scrollPosition;
+  packed.scrollExtentMax = node.scrollExtentMax;
+  packed.scrollExtentMin = node.scrollExtentMin;
+  packed.elevation = node.elevation;
+  packed.thickness = node.thickness;
+  packed.label = InternString(node.label);
+  packed.labelAttributes = AddStringAttributes(node.labelAttributes);
+  packed.hint = InternString(node.hint);
+  packed.hintAttributes = AddStringAttributes(node.hintAttributes);
+  packed.value = InternString(node.value);
+  packed.valueAttributes = AddStringAttributes(node.valueAttributes);
+  packed.increasedValue = InternString(node.increasedValue);
+  packed.increasedValueAttributes =
+      AddStringAttributes(node.increasedValueAttributes);
+  packed.decreasedValue = InternString(node.decreasedValue);
+  packed.decreasedValueAttributes =
+      AddStringAttributes(node.decreasedValueAttributes);
+  packed.tooltip = InternString(node.tooltip);
+  packed.textDirection = node.textDirection;
+  packed.rect = node.rect;
+  packed.transform = node.transform;
+  packed.childrenInTraversalOrder = AddInt32s(node.childrenInTraversalOrder);
+  packed.childrenInHitTestOrder = AddInt32s(node.childrenInHitTestOrder);
+  packed.customAccessibilityActions =
+      AddInt32s(node.customAccessibilityActions);
+}
+
+PackedSemanticsNode::StringIndex PackedSemanticsUpdateBuilder::InternString(
+    const std::string& string) {
+  auto [it, inserted] = string_indices_.emplace(
+      string, static_cast<PackedSemanticsNode::StringIndex>(
+                  update_.string_offsets_.size()));
+  if (inserted) {
+    std::vector<char>& data = update_.string_data_;
+    update_.string_offsets_.push_back(data.size());
+    data.insert(data.end(), string.begin(), string.end());
+    data.push_back('\0');
+  }
+  return it->second;
+}
+
+PackedSemanticsRange PackedSemanticsUpdateBuilder::AddInt32s(
+    const int32_t* data,
+    size_t count) {
+  if (count == 0) {
+    return {};
+  }
+  std::vector<int32_t>& int32s = update_.int32s_;
+  PackedSemanticsRange range{static_cast<uint32_t>(int32s.size()),
+                             static_cast<uint32_t>(count)};
+  int32s.insert(int32s.end(), data, data + count);
+  return range;
+}
+
+PackedSemanticsRange PackedSemanticsUpdateBuilder::AddStringAttributes(
+    const StringAttributes& attributes) {
+  if (attributes.empty()) {
+    return {};
+  }
+  StringAttributes& shared = update_.string_attributes_;
+  PackedSemanticsRange range{static_cast<uint32_t>(shared.size()),
+                             static_cast<uint32_t>(attributes.size())};
+  shared.insert(shared.end(), attributes.begin(), attributes.end());
+  return range;
+}
+
+PackedSemanticsUpdate PackedSemanticsUpdateBuilder::Build() {
+  PackedSemanticsUpdate update = std::move(update_);
+  Reset();
+  return update;
+}
+
+void PackedSemanticsUpdateBuilder::Reset() {
+  update_ = PackedSemanticsUpdate();
+  string_indices_.clear();
+  node_indices_.clear();
+  // The empty string is shared by most fields of most nodes, and is the
+  // string that default constructed nodes refer to.
+  InternString(std::string());
+}
+
+}  // namespace flutter
@@ -0,0 +1,218 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_PACKED_SEMANTICS_UPDATE_H_
+#define FLUTTER_LIB_UI_SEMANTICS_PACKED_SEMANTICS_UPDATE_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "flutter/lib/ui/semantics/string_attribute.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A span of one of the shared arrays of a |PackedSemanticsUpdate|.
+///
+struct PackedSemanticsRange {
+  uint32_t offset = 0;
+  uint32_t count = 0;
+};
+
+//------------------------------------------------------------------------------
+/// A node of a |PackedSemanticsUpdate|.
+///
+/// The fields mirror those of |SemanticsNode|, except that strings are indices
+/// into the string table of the update and that lists are ranges of its shared
+/// arrays. The node is trivially copyable.
+///
+struct PackedSemanticsNode {
+  using StringIndex = uint32_t;
+
+  bool HasAction(SemanticsAction action) const;
+  bool HasFlag(SemanticsFlags flag) const;
+
+  int32_t id = 0;
+  int32_t flags = 0;
+  int32_t actions = 0;
+  int32_t maxValueLength = -1;
+  int32_t currentValueLength = -1;
+  int32_t textSelectionBase = -1;
+  int32_t textSelectionExtent = -1;
+  int32_t platformViewId = -1;
+  int32_t scrollChildren = 0;
+  int32_t scrollIndex = 0;
+  double scrollPosition = std::nan("");
+  double scrollExtentMax = std::nan("");
+  double scrollExtentMin = std::nan("");
+  double elevation = 0.0;
+  double thickness = 0.0;
+  StringIndex label = 0;
+  PackedSemanticsRange labelAttributes;
+  StringIndex hint = 0;
+  PackedSemanticsRange hintAttributes;
+  StringIndex value = 0;
+  PackedSemanticsRange valueAttributes;
+  StringIndex increasedValue = 0;
+  PackedSemanticsRange increasedValueAttributes;
+  StringIndex decreasedValue = 0;
+  PackedSemanticsRange decreasedValueAttributes;
+  StringIndex tooltip = 0;
+  int32_t textDirection = 0;  // 0=unknown, 1=rtl, 2=ltr
+
+  SkRect rect = SkRect::MakeEmpty();  // Local space, relative to parent.
+  SkM44 transform = SkM44{};          // Identity
+  PackedSemanticsRange childrenInTraversalOrder;
+  PackedSemanticsRange childrenInHitTestOrder;
+  PackedSemanticsRange customAccessibilityActions;
+};
+
+//------------------------------------------------------------------------------
+/// A batch of semantics node updates stored in a handful of flat arrays.
+///
+/// Every distinct string of the batch is stored once in a single buffer of
+/// null terminated strings, no matter how many nodes use it. The child lists
+/// and custom action lists of all nodes are ranges of one shared array of
+/// integers, and the string attributes of all nodes are ranges of one shared
+/// array of attributes.
+///
+/// Once built, an update is immutable. Consumers read the nodes in place: the
+/// strings returned by |GetString| and the arrays returned by |GetInt32s|
+/// remain valid for the lifetime of the update, so they can be handed to the
+/// platform without copying them.
+///
+/// @see        `PackedSemanticsUpdateBuilder`
+///
+class PackedSemanticsUpdate {
+ public:
+  PackedSemanticsUpdate();
+
+  ~PackedSemanticsUpdate();
+
+  PackedSemanticsUpdate(const PackedSemanticsUpdate& other);
+
+  PackedSemanticsUpdate(PackedSemanticsUpdate&& other);
+
+  PackedSemanticsUpdate& operator=(const PackedSemanticsUpdate& other);
+
+  PackedSemanticsUpdate& operator=(PackedSemanticsUpdate&& other);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The updated nodes, in the order they were added. Each node
+  ///             identifier appears at most once.
+  ///
+  const std::vector<PackedSemanticsNode>& nodes() const { return nodes_; }
+
+  size_t size() const { return nodes_.size(); }
+
+  bool empty() const { return nodes_.empty(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of distinct strings of the update, including the
+  ///             empty string.
+  ///
+  size_t GetStringCount() const { return string_offsets_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The null terminated string with the given index.
+  ///
+  const char* GetString(PackedSemanticsNode::StringIndex index) const;
+
+  size_t GetStringLength(PackedSemanticsNode::StringIndex index) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The integers of a child list or custom action list.
+  ///
+  const int32_t* GetInt32s(PackedSemanticsRange range) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The string attributes of a string of a node.
+  ///
+  const StringAttributePtr* GetStringAttributes(
+      PackedSemanticsRange range) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unpacks a node of this update into a standalone node.
+  ///
+  SemanticsNode ToSemanticsNode(const PackedSemanticsNode& node) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unpacks every node of this update, for consumers that work
+  ///             with |SemanticsNodeUpdates|.
+  ///
+  SemanticsNodeUpdates ToSemanticsNodeUpdates() const;
+
+ private:
+  friend class PackedSemanticsUpdateBuilder;
+
+  std::vector<PackedSemanticsNode> nodes_;
+  // The null terminated strings, back to back.
+  std::vector<char> string_data_;
+  // The offset of each string into |string_data_|.
+  std::vector<uint32_t> string_offsets_;
+  std::vector<int32_t> int32s_;
+  StringAttributes string_attributes_;
+};
+
+//------------------------------------------------------------------------------
+/// Builds a |PackedSemanticsUpdate|, interning the strings of the nodes as they
+/// are added.
+///
+class PackedSemanticsUpdateBuilder {
+ public:
+  PackedSemanticsUpdateBuilder();
+
+  ~PackedSemanticsUpdateBuilder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the node with the identifier |id| to the update, or
+  ///             resets it if it had already been added. The caller fills in
+  ///             the returned node, which remains valid until the next node is
+  ///             added.
+  ///
+  PackedSemanticsNode& AddNode(int32_t id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a copy of |node| to the update, replacing any node with
+  ///             the same identifier.
+  ///
+  void AddNode(const SemanticsNode& node);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the index of |string| in the string table of the
+  ///             update, adding it if it is not already present.
+  ///
+  PackedSemanticsNode::StringIndex InternString(const std::string& string);
+
+  PackedSemanticsRange AddInt32s(const int32_t* data, size_t count);
+
+  PackedSemanticsRange AddInt32s(const std::vector<int32_t>& values) {
+    return AddInt32s(values.data(), values.size());
+  }
+
+  PackedSemanticsRange AddStringAttributes(const StringAttributes& attributes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the update and resets the builder.
+  ///
+  PackedSemanticsUpdate Build();
+
+ private:
+  PackedSemanticsUpdate update_;
+  std::unordered_map<std::string, PackedSemanticsNode::StringIndex>
+      string_indices_;
+  std::unordered_map<int32_t, size_t> node_indices_;
+
+  void Reset();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedSemanticsUpdateBuilder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_PACKED_SEMANTICS_UPDATE_H_
@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+SemanticsNode MakeNode(int32_t id, std::string label) {
+  SemanticsNode node;
+  node.id = id;
+  node.label = std::move(label);
+  node.rect = SkRect::MakeLTRB(0, 0, 10, 20);
+  return node;
+}
+
+}  // namespace
+
+TEST(PackedSemanticsUpdateTest, EmptyUpdate) {
+  PackedSemanticsUpdate update;
+  EXPECT_TRUE(update.empty());
+  EXPECT_STREQ(update.GetString(0), "");
+  EXPECT_EQ(update.GetStringLength(0), 0u);
+  EXPECT_TRUE(update.ToSemanticsNodeUpdates().empty());
+
+  PackedSemanticsUpdateBuilder builder;
+  update = builder.Build();
+  EXPECT_TRUE(update.empty());
+  EXPECT_EQ(update.GetStringCount(), 1u);
+}
+
+TEST(PackedSemanticsUpdateTest, StringsAreInterned) {
+  PackedSemanticsUpdateBuilder builder;
+  for (int32_t id = 0; id < 100; id++) {
+    SemanticsNode node = MakeNode(id, id % 2 ? "Odd" : "Even");
+    node.hint = "Double tap to activate";
+    node.tooltip = "Odd";
+    builder.AddNode(node);
+  }
+  PackedSemanticsUpdate update = builder.Build();
+
+  ASSERT_EQ(update.size(), 100u);
+  // The empty string, "Odd", "Even" and the hint.
+  EXPECT_EQ(update.GetStringCount(), 4u);
+  const PackedSemanticsNode& odd = update.nodes()[1];
+  EXPECT_STREQ(update.GetString(odd.label), "Odd");
+  EXPECT_EQ(update.GetStringLength(odd.label), 3u);
+  EXPECT_EQ(odd.tooltip, odd.label);
+  EXPECT_EQ(update.GetString(odd.tooltip), update.GetString(odd.label));
+  EXPECT_STREQ(update.GetString(odd.value), "");
+  EXPECT_STREQ(update.GetString(update.nodes()[2].label), "Even");
+  EXPECT_EQ(update.nodes()[2].hint, odd.hint);
+}
+
+TEST(PackedSemanticsUpdateTest, ListsShareOneArray) {
+  PackedSemanticsUpdateBuilder builder;
+  SemanticsNode root = MakeNode(0, "root");
+  root.childrenInTraversalOrder = {1, 2, 3};
+  root.childrenInHitTestOrder = {3, 2, 1};
+  root.customAccessibilityActions = {7};
+  builder.AddNode(root);
+  builder.AddNode(MakeNode(1, "leaf"));
+  SemanticsNode parent = MakeNode(2, "parent");
+  parent.childrenInTraversalOrder = {4};
+  parent.childrenInHitTestOrder = {4};
+  builder.AddNode(parent);
+  PackedSemanticsUpdate update = builder.Build();
+
+  const PackedSemanticsNode& packed_root = update.nodes()[0];
+  ASSERT_EQ(packed_root.childrenInTraversalOrder.count, 3u);
+  const int32_t* traversal =
+      update.GetInt32s(packed_root.childrenInTraversalOrder);
+  EXPECT_EQ(traversal[0], 1);
+  EXPECT_EQ(traversal[2], 3);
+  EXPECT_EQ(update.GetInt32s(packed_root.childrenInHitTestOrder)[0], 3);
+  ASSERT_EQ(packed_root.customAccessibilityActions.count, 1u);
+  EXPECT_EQ(update.GetInt32s(packed_root.customAccessibilityActions)[0], 7);
+
+  EXPECT_EQ(update.nodes()[1].childrenInTraversalOrder.count, 0u);
+
+  const PackedSemanticsNode& packed_parent = update.nodes()[2];
+  ASSERT_EQ(packed_parent.childrenInTraversalOrder.count, 1u);
+  EXPECT_EQ(update.GetInt32s(packed_parent.childrenInTraversalOrder),
+            update.GetInt32s(packed_root.childrenInTraversalOrder) + 7);
+}
+
+TEST(PackedSemanticsUpdateTest, UnpacksToEqualNodes) {
+  SemanticsNode node = MakeNode(42, "label");
+  node.flags = static_cast<int32_t>(SemanticsFlags::kIsButton);
+  node.actions = static_cast<int32_t>(SemanticsAction::kTap);
+  node.textSelectionBase = 1;
+  node.textSelectionExtent = 3;
+  node.scrollPosition = 12.5;
+  node.elevation = 2;
+  node.hint = "hint";
+  node.value = "value";
+  node.increasedValue = "increased";
+  node.decreasedValue = "decreased";
+  node.tooltip = "tooltip";
+  node.textDirection = 2;
+  node.transform = SkM44::Translate(5, 6);
+  node.childrenInTraversalOrder = {1, 2};
+  node.childrenInHitTestOrder = {2, 1};
+  auto attribute = std::make_shared<LocaleStringAttribute>();
+  attribute->start = 0;
+  attribute->end = 2;
+  attribute->type = StringAttributeType::kLocale;
+  attribute->locale = "en-MX";
+  node.hintAttributes.push_back(attribute);
+
+  PackedSemanticsUpdateBuilder builder;
+  builder.AddNode(node);
+  PackedSemanticsUpdate update = builder.Build();
+  ASSERT_EQ(update.size(), 1u);
+  EXPECT_TRUE(update.nodes()[0].HasFlag(SemanticsFlags::kIsButton));
+  EXPECT_TRUE(update.nodes()[0].HasAction(SemanticsAction::kTap));
+
+  SemanticsNodeUpdates unpacked = update.ToSemanticsNodeUpdates();
+  ASSERT_EQ(unpacked.size(), 1u);
+  const SemanticsNode& result = unpacked[42];
+  EXPECT_EQ(result.id, 42);
+  EXPECT_EQ(result.flags, node.flags);
+  EXPECT_EQ(result.actions, node.actions);
+  EXPECT_EQ(result.textSelectionBase, 1);
+  EXPECT_EQ(result.textSelectionExtent, 3);
+  EXPECT_EQ(result.scrollPosition, 12.5);
+  EXPECT_TRUE(std::isnan(result.scrollExtentMax));
+  EXPECT_EQ(result.elevation, 2);
+  EXPECT_EQ(result.label, "label");
+  EXPECT_EQ(result.hint, "hint");
+  EXPECT_EQ(result.value, "value");
+  EXPECT_EQ(result.increasedValue, "increased");
+  EXPECT_EQ(result.decreasedValue, "decreased");
+  EXPECT_EQ(result.tooltip, "tooltip");
+  EXPECT_EQ(result.textDirection, 2);
+  EXPECT_EQ(result.rect, node.rect);
+  EXPECT_EQ(result.transform, node.transform);
+  EXPECT_EQ(result.childrenInTraversalOrder, node.childrenInTraversalOrder);
+  EXPECT_EQ(result.childrenInHitTestOrder, node.childrenInHitTestOrder);
+  EXPECT_TRUE(result.customAccessibilityActions.empty());
+  EXPECT_TRUE(result.labelAttributes.empty());
+  ASSERT_EQ(result.hintAttributes.size(), 1u);
+  EXPECT_EQ(result.hintAttributes[0], attribute);
+}
+
+TEST(PackedSemanticsUpdateTest, LaterUpdateOfNodeWins) {
+  PackedSemanticsUpdateBuilder builder;
+  builder.AddNode(MakeNode(1, "first"));
+  builder.AddNode(MakeNode(2, "other"));
+  SemanticsNode second = MakeNode(1, "second");
+  second.childrenInTraversalOrder = {2};
+  builder.AddNode(second);
+  PackedSemanticsUpdate update = builder.Build();
+
+  ASSERT_EQ(update.size(), 2u);
+  EXPECT_EQ(update.nodes()[0].id, 1);
+  EXPECT_STREQ(update.GetString(update.nodes()[0].label), "second");
+  EXPECT_EQ(update.nodes()[0].childrenInTraversalOrder.count, 1u);
+  EXPECT_EQ(update.ToSemanticsNodeUpdates()[1].label, "second");
+}
+
+TEST(PackedSemanticsUpdateTest, BuilderIsResetByBuild) {
+  PackedSemanticsUpdateBuilder builder;
+  builder.AddNode(MakeNode(1, "first"));
+  PackedSemanticsUpdate first = builder.Build();
+
+  builder.AddNode(MakeNode(2, "second"));
+  PackedSemanticsUpdate second = builder.Build();
+
+  ASSERT_EQ(first.size(), 1u);
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_EQ(second.nodes()[0].id, 2);
+  EXPECT_EQ(second.GetStringCount(), 2u);
+  EXPECT_STREQ(second.GetString(second.nodes()[0].label), "second");
+  EXPECT_STREQ(first.GetString(first.nodes()[0].label), "first");
+}
+
+TEST(PackedSemanticsUpdateTest, StringsOutliveMovesOfTheUpdate) {
+  PackedSemanticsUpdateBuilder builder;
+  builder.AddNode(MakeNode(1, "a fairly long label that is not inlined"));
+  PackedSemanticsUpdate update = builder.Build();
+  const char* label = update.GetString(update.nodes()[0].label);
+
+  PackedSemanticsUpdate moved = std::move(update);
+  EXPECT_EQ(moved.GetString(moved.nodes()[0].label), label);
+  EXPECT_EQ(std::strcmp(label, "a fairly long label that is not inlined"), 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
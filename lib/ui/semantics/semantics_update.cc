@@ -19,20 +19,20 @@ namespace flutter {
 IMPLEMENT_WRAPPERTYPEINFO(ui, SemanticsUpdate);
 
 void SemanticsUpdate::create(Dart_Handle semantics_update_handle,
-                             SemanticsNodeUpdates nodes,
+                             PackedSemanticsUpdate nodes,
                              CustomAccessibilityActionUpdates actions) {
   auto semantics_update = fml::MakeRefCounted<SemanticsUpdate>(
       std::move(nodes), std::move(actions));
   semantics_update->AssociateWithDartWrapper(semantics_update_handle);
 }
 
-SemanticsUpdate::SemanticsUpdate(SemanticsNodeUpdates nodes,
+SemanticsUpdate::SemanticsUpdate(PackedSemanticsUpdate nodes,
                                  CustomAccessibilityActionUpdates actions)
     : nodes_(std::move(nodes)), actions_(std::move(actions)) {}
 
 SemanticsUpdate::~SemanticsUpdate() = default;
 
-SemanticsNodeUpdates SemanticsUpdate::takeNodes() {
+PackedSemanticsUpdate SemanticsUpdate::takeNodes() {
   return std::move(nodes_);
 }
 
@@ -7,6 +7,7 @@
 
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 
 namespace flutter {
@@ -18,20 +19,20 @@ class SemanticsUpdate : public RefCountedDartWrappable<SemanticsUpdate> {
  public:
   ~SemanticsUpdate() override;
   static void create(Dart_Handle semantics_update_handle,
-                     SemanticsNodeUpdates nodes,
+                     PackedSemanticsUpdate nodes,
                      CustomAccessibilityActionUpdates actions);
 
-  SemanticsNodeUpdates takeNodes();
+  PackedSemanticsUpdate takeNodes();
 
   CustomAccessibilityActionUpdates takeActions();
 
   void dispose();
 
  private:
-  explicit SemanticsUpdate(SemanticsNodeUpdates nodes,
+  explicit SemanticsUpdate(PackedSemanticsUpdate nodes,
                            CustomAccessibilityActionUpdates updates);
 
-  SemanticsNodeUpdates nodes_;
+  PackedSemanticsUpdate nodes_;
   CustomAccessibilityActionUpdates actions_;
 };
 
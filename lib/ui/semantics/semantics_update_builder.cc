@@ -16,12 +16,15 @@
 
 namespace flutter {
 
-void pushStringAttributes(
-    StringAttributes& destination,
+PackedSemanticsRange pushStringAttributes(
+    PackedSemanticsUpdateBuilder& destination,
     const std::vector<NativeStringAttribute*>& native_attributes) {
+  StringAttributes attributes;
+  attributes.reserve(native_attributes.size());
   for (const auto& native_attribute : native_attributes) {
-    destination.push_back(native_attribute->GetAttribute());
+    attributes.push_back(native_attribute->GetAttribute());
   }
+  return destination.AddStringAttributes(attributes);
 }
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, SemanticsUpdateBuilder);
@@ -70,8 +73,7 @@ void SemanticsUpdateBuilder::updateNode(
             (scrollChildren > 0 && childrenInHitTestOrder.data()))
       << "Semantics update contained scrollChildren but did not have "
          "childrenInHitTestOrder";
-  SemanticsNode node;
-  node.id = id;
+  PackedSemanticsNode& node = nodes_.AddNode(id);
   node.flags = flags;
   node.actions = actions;
   node.maxValueLength = maxValueLength;
@@ -88,17 +90,19 @@ void SemanticsUpdateBuilder::updateNode(
                                SafeNarrow(right), SafeNarrow(bottom));
   node.elevation = elevation;
   node.thickness = thickness;
-  node.label = std::move(label);
-  pushStringAttributes(node.labelAttributes, labelAttributes);
-  node.value = std::move(value);
-  pushStringAttributes(node.valueAttributes, valueAttributes);
-  node.increasedValue = std::move(increasedValue);
-  pushStringAttributes(node.increasedValueAttributes, increasedValueAttributes);
-  node.decreasedValue = std::move(decreasedValue);
-  pushStringAttributes(node.decreasedValueAttributes, decreasedValueAttributes);
-  node.hint = std::move(hint);
-  pushStringAttributes(node.hintAttributes, hintAttributes);
-  node.tooltip = std::move(tooltip);
+  node.label = nodes_.InternString(label);
+  node.labelAttributes = pushStringAttributes(nodes_, labelAttributes);
+  node.value = nodes_.InternString(value);
+  node.valueAttributes = pushStringAttributes(nodes_, valueAttributes);
+  node.increasedValue = nodes_.InternString(increasedValue);
+  node.increasedValueAttributes =
+      pushStringAttributes(nodes_, increasedValueAttributes);
+  node.decreasedValue = nodes_.InternString(decreasedValue);
+  node.decreasedValueAttributes =
+      pushStringAttributes(nodes_, decreasedValueAttributes);
+  node.hint = nodes_.InternString(hint);
+  node.hintAttributes = pushStringAttributes(nodes_, hintAttributes);
+  node.tooltip = nodes_.InternString(tooltip);
   node.textDirection = textDirection;
   SkScalar scalarTransform[16];
   for (int i = 0; i < 16; ++i) {
@@ -106,16 +110,12 @@ void SemanticsUpdateBuilder::updateNode(
   }
   node.transform = SkM44::ColMajor(scalarTransform);
   node.childrenInTraversalOrder =
-      std::vector<int32_t>(childrenInTraversalOrder.data(),
-                           childrenInTraversalOrder.data() +
-                               childrenInTraversalOrder.num_elements());
-  node.childrenInHitTestOrder = std::vector<int32_t>(
-      childrenInHitTestOrder.data(),
-      childrenInHitTestOrder.data() + childrenInHitTestOrder.num_elements());
-  node.customAccessibilityActions = std::vector<int32_t>(
-      localContextActions.data(),
-      localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+      nodes_.AddInt32s(childrenInTraversalOrder.data(),
+                       childrenInTraversalOrder.num_elements());
+  node.childrenInHitTestOrder = nodes_.AddInt32s(
+      childrenInHitTestOrder.data(), childrenInHitTestOrder.num_elements());
+  node.customAccessibilityActions = nodes_.AddInt32s(
+      localContextActions.data(), localContextActions.num_elements());
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -131,7 +131,7 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
-  SemanticsUpdate::create(semantics_update_handle, std::move(nodes_),
+  SemanticsUpdate::create(semantics_update_handle, nodes_.Build(),
                           std::move(actions_));
   ClearDartWrapper();
 }
@@ -75,7 +75,7 @@ class SemanticsUpdateBuilder
 
  private:
   explicit SemanticsUpdateBuilder();
-  SemanticsNodeUpdates nodes_;
+  PackedSemanticsUpdateBuilder nodes_;
   CustomAccessibilityActionUpdates actions_;
 };
 
@@ -22,7 +22,7 @@ TEST_F(SemanticsUpdateBuilderTest, CanHandleAttributedStrings) {
         handle, tonic::DartWrappable::kPeerIndex, &peer);
     ASSERT_FALSE(Dart_IsError(result));
     SemanticsUpdate* update = reinterpret_cast<SemanticsUpdate*>(peer);
-    SemanticsNodeUpdates nodes = update->takeNodes();
+    SemanticsNodeUpdates nodes = update->takeNodes().ToSemanticsNodeUpdates();
     ASSERT_EQ(nodes.size(), (size_t)1);
     auto node = nodes.find(0)->second;
     // Should match the updateNode in ui_test.dart.
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_buffer_pool.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+PointerDataBufferPool::PointerDataBufferPool() = default;
+
+PointerDataBufferPool::~PointerDataBufferPool() = default;
+
+PointerDataBufferPool& PointerDataBufferPool::GetShared() {
+  // Never destroyed, as packets may still be released during shutdown.
+  static PointerDataBufferPool* pool = new PointerDataBufferPool();
+  return *pool;
+}
+
+bool PointerDataBufferPool::Acquire(std::vector<uint8_t>& buffer) {
+  FML_DCHECK(buffer.empty());
+  for (Slot& slot : slots_) {
+    SlotState expected = SlotState::kFull;
+    if (slot.state.compare_exchange_strong(expected, SlotState::kBusy,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+      buffer.swap(slot.buffer);
+      slot.state.store(SlotState::kEmpty, std::memory_order_release);
+      buffer.clear();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PointerDataBufferPool::Release(std::vector<uint8_t>& buffer) {
+  if (buffer.capacity() == 0 || buffer.capacity() > kMaxPooledCapacity) {
+    return false;
+  }
+  for (Slot& slot : slots_) {
+    SlotState expected = SlotState::kEmpty;
+    if (slot.state.compare_exchange_strong(expected, SlotState::kBusy,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+      // The slot holds an empty vector without storage, which is swapped
+      // into |buffer|.
+      buffer.swap(slot.buffer);
+      slot.state.store(SlotState::kFull, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t PointerDataBufferPool::GetPooledCount() const {
+  size_t count = 0;
+  for (const Slot& slot : slots_) {
+    if (slot.state.load(std::memory_order_relaxed) == SlotState::kFull) {
+      count++;
+    }
+  }
+  return count;
+}
+
+}  // namespace flutter
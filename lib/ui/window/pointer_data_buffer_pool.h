@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_POINTER_DATA_BUFFER_POOL_H_
+#define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_BUFFER_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A lock-free pool of the byte buffers that back `PointerDataPacket`s.
+///
+/// Pointer data packets are created on the platform thread and destroyed on
+/// the UI thread once they have been dispatched, at the rate of the input
+/// devices. Instead of freeing its buffer, a packet returns it to the pool,
+/// and the next packet takes it back with its capacity intact, so that the
+/// steady state of the input path does not allocate.
+///
+/// The pool holds a fixed number of buffers. Each slot is claimed with a
+/// single compare-and-swap, so neither thread ever blocks: when no buffer is
+/// available a packet allocates one as usual, and when the pool is full a
+/// returned buffer is freed.
+///
+class PointerDataBufferPool {
+ public:
+  /// The number of buffers the pool holds. A few packets are in flight
+  /// between the platform thread and the UI thread at any time.
+  static constexpr size_t kSlotCount = 8;
+
+  /// Buffers larger than this are freed rather than pooled, so that a burst
+  /// of events does not pin a large allocation.
+  static constexpr size_t kMaxPooledCapacity = 64 * 1024;
+
+  PointerDataBufferPool();
+
+  ~PointerDataBufferPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pool shared by all pointer data packets.
+  ///
+  static PointerDataBufferPool& GetShared();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Moves a pooled buffer into |buffer|, which must be empty. The
+  ///             returned buffer is empty, but retains its capacity.
+  ///
+  /// @return     Whether a pooled buffer was available.
+  ///
+  bool Acquire(std::vector<uint8_t>& buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Moves |buffer| into the pool, leaving |buffer| empty. The
+  ///             buffer is left untouched if the pool is full or if the
+  ///             buffer is too large to be pooled.
+  ///
+  /// @return     Whether the buffer was pooled.
+  ///
+  bool Release(std::vector<uint8_t>& buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of buffers currently in the pool.
+  ///
+  size_t GetPooledCount() const;
+
+ private:
+  enum class SlotState : uint8_t {
+    kEmpty,
+    // A thread is moving a buffer into or out of the slot.
+    kBusy,
+    kFull,
+  };
+
+  struct Slot {
+    std::atomic<SlotState> state{SlotState::kEmpty};
+    std::vector<uint8_t> buffer;
+  };
+
+  std::array<Slot, kSlotCount> slots_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataBufferPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_POINTER_DATA_BUFFER_POOL_H_
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_buffer_pool.h"
+
+#include <cstring>
+#include <thread>
+
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Empties the shared pool, so that a test knows which buffers it holds.
+void DrainSharedPool() {
+  std::vector<uint8_t> buffer;
+  while (PointerDataBufferPool::GetShared().Acquire(buffer)) {
+    buffer = std::vector<uint8_t>();
+  }
+}
+
+}  // namespace
+
+TEST(PointerDataBufferPoolTest, AcquireFromEmptyPool) {
+  PointerDataBufferPool pool;
+  std::vector<uint8_t> buffer;
+  EXPECT_FALSE(pool.Acquire(buffer));
+  EXPECT_EQ(buffer.capacity(), 0u);
+}
+
+TEST(PointerDataBufferPoolTest, ReusesReleasedBuffers) {
+  PointerDataBufferPool pool;
+  std::vector<uint8_t> buffer(100, 1);
+  const uint8_t* storage = buffer.data();
+  EXPECT_TRUE(pool.Release(buffer));
+  EXPECT_EQ(buffer.capacity(), 0u);
+  EXPECT_EQ(pool.GetPooledCount(), 1u);
+
+  std::vector<uint8_t> reused;
+  ASSERT_TRUE(pool.Acquire(reused));
+  EXPECT_TRUE(reused.empty());
+  EXPECT_GE(reused.capacity(), 100u);
+  EXPECT_EQ(reused.data(), storage);
+  EXPECT_EQ(pool.GetPooledCount(), 0u);
+}
+
+TEST(PointerDataBufferPoolTest, DoesNotPoolEmptyOrLargeBuffers) {
+  PointerDataBufferPool pool;
+  std::vector<uint8_t> empty;
+  EXPECT_FALSE(pool.Release(empty));
+
+  std::vector<uint8_t> large(PointerDataBufferPool::kMaxPooledCapacity + 1);
+  EXPECT_FALSE(pool.Release(large));
+  EXPECT_EQ(large.size(), PointerDataBufferPool::kMaxPooledCapacity + 1);
+  EXPECT_EQ(pool.GetPooledCount(), 0u);
+}
+
+TEST(PointerDataBufferPoolTest, RejectsBuffersWhenFull) {
+  PointerDataBufferPool pool;
+  for (size_t i = 0; i < PointerDataBufferPool::kSlotCount; i++) {
+    std::vector<uint8_t> buffer(16);
+    EXPECT_TRUE(pool.Release(buffer));
+  }
+  std::vector<uint8_t> buffer(16);
+  EXPECT_FALSE(pool.Release(buffer));
+  EXPECT_EQ(buffer.size(), 16u);
+  EXPECT_EQ(pool.GetPooledCount(), PointerDataBufferPool::kSlotCount);
+}
+
+TEST(PointerDataBufferPoolTest, PacketsRecycleTheirBuffers) {
+  DrainSharedPool();
+  const uint8_t* storage;
+  {
+    PointerDataPacket packet(4);
+    storage = packet.data().data();
+  }
+  EXPECT_EQ(PointerDataBufferPool::GetShared().GetPooledCount(), 1u);
+
+  PointerDataPacket packet(2);
+  EXPECT_EQ(packet.data().data(), storage);
+  EXPECT_EQ(packet.GetLength(), 2u);
+  EXPECT_EQ(PointerDataBufferPool::GetShared().GetPooledCount(), 0u);
+  // Recycled buffers are cleared.
+  PointerData zero;
+  zero.Clear();
+  PointerData data = packet.GetPointerData(1);
+  EXPECT_EQ(std::memcmp(&data, &zero, sizeof(PointerData)), 0);
+}
+
+TEST(PointerDataBufferPoolTest, PacketCanBeResized) {
+  PointerDataPacket packet(1);
+  PointerData data;
+  data.Clear();
+  data.physical_x = 3;
+  packet.SetPointerData(0, data);
+  packet.Resize(3);
+  EXPECT_EQ(packet.GetLength(), 3u);
+  EXPECT_EQ(packet.GetPointerData(0).physical_x, 3);
+  packet.Resize(1);
+  EXPECT_EQ(packet.GetLength(), 1u);
+  EXPECT_EQ(packet.GetPointerData(0).physical_x, 3);
+}
+
+TEST(PointerDataBufferPoolTest, BuffersMoveBetweenThreads) {
+  PointerDataBufferPool pool;
+  constexpr int kIterations = 10000;
+  // One thread takes buffers out of the pool and fills them, as the platform
+  // thread does, while the other returns buffers, as the UI thread does.
+  std::thread producer([&pool]() {
+    for (int i = 0; i < kIterations; i++) {
+      std::vector<uint8_t> buffer;
+      pool.Acquire(buffer);
+      buffer.assign(64, static_cast<uint8_t>(i));
+      for (uint8_t value : buffer) {
+        ASSERT_EQ(value, static_cast<uint8_t>(i));
+      }
+    }
+  });
+  std::thread consumer([&pool]() {
+    for (int i = 0; i < kIterations; i++) {
+      std::vector<uint8_t> buffer(64);
+      pool.Release(buffer);
+    }
+  });
+  producer.join();
+  consumer.join();
+  EXPECT_LE(pool.GetPooledCount(), PointerDataBufferPool::kSlotCount);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,18 +4,29 @@
 
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/fml/logging.h"
+#include "flutter/lib/ui/window/pointer_data_buffer_pool.h"
 
 #include <cstring>
 
 namespace flutter {
 
-PointerDataPacket::PointerDataPacket(size_t count)
-    : data_(count * sizeof(PointerData)) {}
+PointerDataPacket::PointerDataPacket(size_t count) {
+  PointerDataBufferPool::GetShared().Acquire(data_);
+  data_.resize(count * sizeof(PointerData));
+}
 
-PointerDataPacket::PointerDataPacket(uint8_t* data, size_t num_bytes)
-    : data_(data, data + num_bytes) {}
+PointerDataPacket::PointerDataPacket(uint8_t* data, size_t num_bytes) {
+  PointerDataBufferPool::GetShared().Acquire(data_);
+  data_.assign(data, data + num_bytes);
+}
 
-PointerDataPacket::~PointerDataPacket() = default;
+PointerDataPacket::~PointerDataPacket() {
+  PointerDataBufferPool::GetShared().Release(data_);
+}
+
+void PointerDataPacket::Resize(size_t count) {
+  data_.resize(count * sizeof(PointerData));
+}
 
 void PointerDataPacket::SetPointerData(size_t i, const PointerData& data) {
   FML_DCHECK(i < GetLength());
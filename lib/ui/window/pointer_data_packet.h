@@ -13,12 +13,17 @@
 
 namespace flutter {
 
+// The buffers of packets are recycled through |PointerDataBufferPool|.
 class PointerDataPacket {
  public:
   explicit PointerDataPacket(size_t count);
   PointerDataPacket(uint8_t* data, size_t num_bytes);
   ~PointerDataPacket();
 
+  // Changes the number of pointer data in the packet. The pointer data below
+  // |count| are preserved.
+  void Resize(size_t count);
+
   void SetPointerData(size_t i, const PointerData& data);
   PointerData GetPointerData(size_t i) const;
   size_t GetLength() const;
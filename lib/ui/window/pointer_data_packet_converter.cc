@@ -17,23 +17,23 @@ PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     std::unique_ptr<PointerDataPacket> packet) {
-  std::vector<PointerData> converted_pointers;
   // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
+  // converted_pointers_, whose storage is reused for every packet.
+  converted_pointers_.clear();
   for (size_t i = 0; i < packet->GetLength(); i++) {
     PointerData pointer_data = packet->GetPointerData(i);
-    ConvertPointerData(pointer_data, converted_pointers);
+    ConvertPointerData(pointer_data, converted_pointers_);
   }
 
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
+  // Writes converted_pointers_ back into the packet, which only grows if
+  // pointer data were synthesized.
+  packet->Resize(converted_pointers_.size());
   size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
+  for (auto& converted_pointer : converted_pointers_) {
+    packet->SetPointerData(count++, converted_pointer);
   }
 
-  return converted_packet;
+  return packet;
 }
 
 void PointerDataPacketConverter::ConvertPointerData(
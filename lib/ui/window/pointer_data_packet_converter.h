@@ -84,6 +84,8 @@ class PointerDataPacketConverter {
   ///             not have sufficient information and may contain illegal
   ///             pointer transitions. This method will fill out that
   ///             information and attempt to correct pointer transitions.
+  ///             The packet is converted in place, so that its buffer is
+  ///             reused rather than a new packet being allocated.
   ///
   /// @param[in]  packet                   The raw pointer packet sent from
   ///                                      embedding.
@@ -101,6 +103,10 @@ class PointerDataPacketConverter {
 
   int64_t pointer_;
 
+  // The pointer data of the packet being converted. A member so that its
+  // storage is reused.
+  std::vector<PointerData> converted_pointers_;
+
   void ConvertPointerData(PointerData pointer_data,
                           std::vector<PointerData>& converted_pointers);
 
@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_resampler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace flutter {
+
+PointerDataResampler::PointerDataResampler() = default;
+
+PointerDataResampler::~PointerDataResampler() = default;
+
+void PointerDataResampler::Observe(PointerDataPacket& packet,
+                                   int64_t observed_time) {
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    PointerData pointer_data = packet.GetPointerData(i);
+    if (pointer_data.signal_kind != PointerData::SignalKind::kNone) {
+      continue;
+    }
+
+    switch (pointer_data.change) {
+      case PointerData::Change::kDown: {
+        PointerHistory& history = pointers_[pointer_data.device];
+        history.samples.clear();
+        history.samples.push_back({pointer_data.time_stamp,
+                                   pointer_data.physical_x,
+                                   pointer_data.physical_y});
+        history.last_event = pointer_data;
+        history.dispatched_x = pointer_data.physical_x;
+        history.dispatched_y = pointer_data.physical_y;
+        history.observed_time = observed_time;
+        history.has_new_samples = false;
+        break;
+      }
+      case PointerData::Change::kMove:
+      case PointerData::Change::kUp:
+      case PointerData::Change::kCancel: {
+        auto iter = pointers_.find(pointer_data.device);
+        if (iter == pointers_.end()) {
+          break;
+        }
+        PointerHistory& history = iter->second;
+        if (history.dispatched_x != history.last_event.physical_x ||
+            history.dispatched_y != history.last_event.physical_y) {
+          // A predicted event moved the pointer since its last real event.
+          pointer_data.physical_delta_x =
+              pointer_data.physical_x - history.dispatched_x;
+          pointer_data.physical_delta_y =
+              pointer_data.physical_y - history.dispatched_y;
+          packet.SetPointerData(i, pointer_data);
+        }
+        if (pointer_data.change != PointerData::Change::kMove) {
+          pointers_.erase(iter);
+          break;
+        }
+
+        std::deque<Sample>& samples = history.samples;
+        samples.push_back({pointer_data.time_stamp, pointer_data.physical_x,
+                           pointer_data.physical_y});
+        while (samples.size() > 2 &&
+               samples.front().time <
+                   pointer_data.time_stamp - kVelocityWindowMicros) {
+          samples.pop_front();
+        }
+        history.last_event = pointer_data;
+        history.dispatched_x = pointer_data.physical_x;
+        history.dispatched_y = pointer_data.physical_y;
+        history.observed_time = observed_time;
+        history.has_new_samples = true;
+        break;
+      }
+      case PointerData::Change::kRemove:
+        pointers_.erase(pointer_data.device);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataResampler::Resample(
+    int64_t target_time) {
+  std::vector<PointerData> predicted_events;
+  for (auto& [device, history] : pointers_) {
+    if (!history.has_new_samples) {
+      continue;
+    }
+    history.has_new_samples = false;
+
+    double x;
+    double y;
+    if (!PredictPosition(history, target_time, x, y)) {
+      continue;
+    }
+    // The predicted event keeps the time stamp of the last real event. The
+    // predicted time may be after the next real event, and the target time is
+    // in a different time base.
+    PointerData predicted = history.last_event;
+    predicted.change = PointerData::Change::kMove;
+    predicted.physical_x = x;
+    predicted.physical_y = y;
+    predicted.physical_delta_x = x - history.dispatched_x;
+    predicted.physical_delta_y = y - history.dispatched_y;
+    predicted.synthesized = kPointerDataPredicted;
+    predicted_events.push_back(predicted);
+    history.dispatched_x = x;
+    history.dispatched_y = y;
+  }
+
+  if (predicted_events.empty()) {
+    return nullptr;
+  }
+  auto packet = std::make_unique<PointerDataPacket>(predicted_events.size());
+  for (size_t i = 0; i < predicted_events.size(); i++) {
+    packet->SetPointerData(i, predicted_events[i]);
+  }
+  return packet;
+}
+
+bool PointerDataResampler::HasPendingSamples() const {
+  return std::any_of(pointers_.begin(), pointers_.end(), [](const auto& entry) {
+    return entry.second.has_new_samples;
+  });
+}
+
+bool PointerDataResampler::PredictPosition(const PointerHistory& history,
+                                           int64_t target_time,
+                                           double& x,
+                                           double& y) const {
+  const Sample& newest = history.samples.back();
+  if (target_time <= history.observed_time) {
+    return false;
+  }
+  // The velocity is estimated from the oldest sample in the window rather
+  // than from the previous sample, which smooths out jittery sample times.
+  const Sample& oldest = history.samples.front();
+  const int64_t elapsed = newest.time - oldest.time;
+  if (elapsed <= 0) {
+    return false;
+  }
+  const double horizon = static_cast<double>(
+      std::min(target_time - history.observed_time, kMaxPredictionMicros));
+  x = newest.x + (newest.x - oldest.x) * horizon / elapsed;
+  y = newest.y + (newest.y - oldest.y) * horizon / elapsed;
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_POINTER_DATA_RESAMPLER_H_
+#define FLUTTER_LIB_UI_WINDOW_POINTER_DATA_RESAMPLER_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+/// The value of |PointerData::synthesized| for the events emitted by
+/// |PointerDataResampler|. The events synthesized by
+/// |PointerDataPacketConverter| use 1. The framework reads any non-zero value
+/// as a synthesized event.
+static constexpr int64_t kPointerDataPredicted = 2;
+
+//------------------------------------------------------------------------------
+/// Predicts where the dragged pointers will be at the target time of a frame.
+///
+/// The resampler observes the converted pointer data packets as they are
+/// dispatched to the framework and keeps a short history of the positions of
+/// every pointer that is down. When a frame begins, |Resample| extrapolates
+/// the recent velocity of each pointer that moved since the previous frame to
+/// the target time of the frame, and returns a move event at the predicted
+/// position. The framework then lays out the frame for where the pointer will
+/// be when the frame is presented, rather than where it was when the last
+/// event was sampled, which hides up to a frame of input latency.
+///
+/// Predicted events have |PointerData::synthesized| set to
+/// |kPointerDataPredicted|, so the framework leaves them out of velocity
+/// estimates. They carry the time stamp of the newest real event of the
+/// pointer, so time stamps never decrease, even if the next real event arrives
+/// before the predicted time. To keep the stream consistent for consumers that
+/// accumulate deltas, the delta of every event is relative to the previous
+/// event dispatched for the pointer, predicted or not. |Observe| rewrites the
+/// delta of the first real event after a prediction accordingly.
+///
+/// Positions are only ever predicted, never interpolated between samples:
+/// interpolating requires holding back real events until a later sample
+/// arrives, which adds the latency this class is meant to remove.
+///
+/// Times are in microseconds. The time stamps of the events are only compared
+/// with each other, since embedders stamp events in time bases of their own.
+/// How far ahead to predict is measured from the time at which the newest
+/// event was observed to the target time of the frame, which are both in the
+/// time base of |fml::TimePoint|.
+///
+class PointerDataResampler {
+ public:
+  /// The longest time ahead of the observation of the newest sample that a
+  /// position is predicted for. Longer predictions overshoot too much when the
+  /// pointer changes direction.
+  static constexpr int64_t kMaxPredictionMicros = 8000;
+
+  /// The samples that are used to estimate the velocity of a pointer are the
+  /// ones taken within this time of the newest sample.
+  static constexpr int64_t kVelocityWindowMicros = 20000;
+
+  PointerDataResampler();
+
+  ~PointerDataResampler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the events of a converted packet that is about to be
+  ///             dispatched, and adjusts the deltas of events that follow a
+  ///             predicted event.
+  ///
+  /// @param[in]  observed_time  The current time, in the time base of the
+  ///                            target times passed to |Resample|.
+  ///
+  void Observe(PointerDataPacket& packet, int64_t observed_time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Predicts the position at |target_time| of every pointer that
+  ///             is down and that moved since the previous call.
+  ///
+  /// @param[in]  target_time  The time to predict for, in the time base of
+  ///                          the observed times passed to |Observe|.
+  ///
+  /// @return     A packet with one predicted move event per such pointer, or
+  ///             null if there is none.
+  ///
+  std::unique_ptr<PointerDataPacket> Resample(int64_t target_time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether there is a pointer that |Resample| would emit an
+  ///             event for.
+  ///
+  bool HasPendingSamples() const;
+
+ private:
+  struct Sample {
+    int64_t time;
+    double x;
+    double y;
+  };
+
+  struct PointerHistory {
+    // The newest samples, oldest first.
+    std::deque<Sample> samples;
+    // The last real event of the pointer.
+    PointerData last_event;
+    // The position of the last event dispatched for the pointer, which is
+    // where |last_event| was unless a predicted event followed it.
+    double dispatched_x;
+    double dispatched_y;
+    // When the newest sample was observed.
+    int64_t observed_time;
+    // Whether a sample was added since the previous call to |Resample|.
+    bool has_new_samples;
+  };
+
+  // The history of every pointer that is down, keyed by |PointerData::device|.
+  std::map<int64_t, PointerHistory> pointers_;
+
+  bool PredictPosition(const PointerHistory& history,
+                       int64_t target_time,
+                       double& x,
+                       double& y) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataResampler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_POINTER_DATA_RESAMPLER_H_
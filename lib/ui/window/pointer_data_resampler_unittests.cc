@@ -0,0 +1,340 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/pointer_data_resampler.h"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// An event of a recorded event stream.
+struct RecordedEvent {
+  int64_t time;
+  PointerData::Change change;
+  int64_t device;
+  double x;
+  double y;
+};
+
+constexpr int64_t kFrameInterval = 16667;
+
+// A drag recorded at 240Hz that speeds up, slows down, and changes direction.
+const std::vector<RecordedEvent> kRecordedDrag = {
+    {1000, PointerData::Change::kDown, 0, 100, 500},
+    {5167, PointerData::Change::kMove, 0, 101, 497},
+    {9333, PointerData::Change::kMove, 0, 103, 491},
+    {13500, PointerData::Change::kMove, 0, 107, 480},
+    {17667, PointerData::Change::kMove, 0, 113, 462},
+    {21833, PointerData::Change::kMove, 0, 121, 440},
+    {26000, PointerData::Change::kMove, 0, 130, 415},
+    {30167, PointerData::Change::kMove, 0, 138, 392},
+    {34333, PointerData::Change::kMove, 0, 144, 374},
+    {38500, PointerData::Change::kMove, 0, 147, 362},
+    {42667, PointerData::Change::kMove, 0, 146, 356},
+    {46833, PointerData::Change::kMove, 0, 141, 355},
+    {51000, PointerData::Change::kMove, 0, 133, 358},
+    {55167, PointerData::Change::kMove, 0, 124, 363},
+    {59333, PointerData::Change::kMove, 0, 117, 367},
+    {63500, PointerData::Change::kUp, 0, 117, 367},
+};
+
+PointerData MakePointerData(const RecordedEvent& event) {
+  PointerData data;
+  data.Clear();
+  data.time_stamp = event.time;
+  data.change = event.change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = event.device;
+  data.physical_x = event.x;
+  data.physical_y = event.y;
+  return data;
+}
+
+// Replays a recorded event stream, frame by frame, through a resampler.
+//
+// Before each frame, the events sampled before the start of the frame are
+// delivered in one packet, with their deltas filled in as
+// |PointerDataPacketConverter| does. The frame then begins and the resampler
+// predicts the pointers for the target time of the frame. Returns every event
+// in the order it would be dispatched to the framework.
+//
+// The events are stamped with their recorded time plus |time_stamp_offset|,
+// while frames are timed by the recorded times.
+std::vector<PointerData> Replay(const std::vector<RecordedEvent>& events,
+                                int frame_count,
+                                int64_t time_stamp_offset = 0) {
+  PointerDataResampler resampler;
+  std::vector<PointerData> dispatched;
+  std::map<int64_t, PointerData> last_events;
+  size_t next_event = 0;
+  for (int frame = 1; frame <= frame_count; frame++) {
+    const int64_t frame_start = frame * kFrameInterval;
+    std::vector<PointerData> packet_events;
+    while (next_event < events.size() &&
+           events[next_event].time <= frame_start) {
+      PointerData data = MakePointerData(events[next_event++]);
+      data.time_stamp += time_stamp_offset;
+      auto last = last_events.find(data.device);
+      if (last != last_events.end() &&
+          data.change != PointerData::Change::kDown) {
+        data.physical_delta_x = data.physical_x - last->second.physical_x;
+        data.physical_delta_y = data.physical_y - last->second.physical_y;
+      }
+      last_events[data.device] = data;
+      packet_events.push_back(data);
+    }
+    if (!packet_events.empty()) {
+      PointerDataPacket packet(packet_events.size());
+      for (size_t i = 0; i < packet_events.size(); i++) {
+        packet.SetPointerData(i, packet_events[i]);
+      }
+      resampler.Observe(packet, frame_start);
+      for (size_t i = 0; i < packet.GetLength(); i++) {
+        dispatched.push_back(packet.GetPointerData(i));
+      }
+    }
+
+    auto predicted = resampler.Resample(frame_start + kFrameInterval);
+    if (predicted) {
+      for (size_t i = 0; i < predicted->GetLength(); i++) {
+        dispatched.push_back(predicted->GetPointerData(i));
+      }
+    }
+  }
+  return dispatched;
+}
+
+std::vector<PointerData> PredictedEvents(
+    const std::vector<PointerData>& events) {
+  std::vector<PointerData> predicted;
+  for (const PointerData& event : events) {
+    if (event.synthesized == kPointerDataPredicted) {
+      predicted.push_back(event);
+    }
+  }
+  return predicted;
+}
+
+}  // namespace
+
+TEST(PointerDataResamplerTest, PredictsConstantVelocityDrag) {
+  // 0.001px per microsecond, sampled every 4ms.
+  std::vector<RecordedEvent> events = {
+      {2000, PointerData::Change::kDown, 0, 0, 0}};
+  for (int64_t time = 6000; time <= 30000; time += 4000) {
+    events.push_back(
+        {time, PointerData::Change::kMove, 0, (time - 2000) / 1000.0, 0});
+  }
+
+  auto predicted = PredictedEvents(Replay(events, 2));
+  ASSERT_EQ(predicted.size(), 2u);
+  // The newest sample before the first frame is at 14ms, and the frame
+  // targets 33.3ms. The prediction is capped at 8ms ahead of the sample.
+  EXPECT_EQ(predicted[0].time_stamp, 14000);
+  EXPECT_EQ(predicted[0].change, PointerData::Change::kMove);
+  EXPECT_DOUBLE_EQ(predicted[0].physical_x, 12.0 + 8.0);
+  EXPECT_DOUBLE_EQ(predicted[0].physical_y, 0.0);
+  // The newest sample before the second frame is at 30ms.
+  EXPECT_EQ(predicted[1].time_stamp, 30000);
+  EXPECT_DOUBLE_EQ(predicted[1].physical_x, 28.0 + 8.0);
+}
+
+TEST(PointerDataResamplerTest, PredictsShortlyAheadOfLateSamples) {
+  PointerDataResampler resampler;
+  PointerDataPacket packet(3);
+  packet.SetPointerData(
+      0, MakePointerData({0, PointerData::Change::kDown, 0, 0, 0}));
+  packet.SetPointerData(
+      1, MakePointerData({4000, PointerData::Change::kMove, 0, 4, 8}));
+  packet.SetPointerData(
+      2, MakePointerData({8000, PointerData::Change::kMove, 0, 8, 16}));
+  resampler.Observe(packet, 8000);
+  ASSERT_TRUE(resampler.HasPendingSamples());
+
+  auto predicted = resampler.Resample(10000);
+  ASSERT_NE(predicted, nullptr);
+  ASSERT_EQ(predicted->GetLength(), 1u);
+  PointerData data = predicted->GetPointerData(0);
+  EXPECT_DOUBLE_EQ(data.physical_x, 10);
+  EXPECT_DOUBLE_EQ(data.physical_y, 20);
+  EXPECT_DOUBLE_EQ(data.physical_delta_x, 2);
+  EXPECT_DOUBLE_EQ(data.physical_delta_y, 4);
+  EXPECT_FALSE(resampler.HasPendingSamples());
+}
+
+TEST(PointerDataResamplerTest, DoesNotPredictTargetsBeforeTheNewestSample) {
+  PointerDataResampler resampler;
+  PointerDataPacket packet(2);
+  packet.SetPointerData(
+      0, MakePointerData({0, PointerData::Change::kDown, 0, 0, 0}));
+  packet.SetPointerData(
+      1, MakePointerData({8000, PointerData::Change::kMove, 0, 8, 0}));
+  resampler.Observe(packet, 8000);
+  EXPECT_EQ(resampler.Resample(8000), nullptr);
+}
+
+TEST(PointerDataResamplerTest, TimeStampsNeverDecrease) {
+  PointerDataResampler resampler;
+  PointerDataPacket packet(2);
+  packet.SetPointerData(
+      0, MakePointerData({0, PointerData::Change::kDown, 0, 0, 0}));
+  packet.SetPointerData(
+      1, MakePointerData({4000, PointerData::Change::kMove, 0, 4, 0}));
+  resampler.Observe(packet, 4000);
+  auto predicted = resampler.Resample(12000);
+  ASSERT_NE(predicted, nullptr);
+  PointerData predicted_data = predicted->GetPointerData(0);
+  EXPECT_DOUBLE_EQ(predicted_data.physical_x, 12);
+
+  // The next real event is sampled before the time the prediction was for.
+  PointerDataPacket next_packet(1);
+  next_packet.SetPointerData(
+      0, MakePointerData({6000, PointerData::Change::kMove, 0, 6, 0}));
+  resampler.Observe(next_packet, 6000);
+  EXPECT_EQ(predicted_data.time_stamp, 4000);
+  EXPECT_LE(predicted_data.time_stamp,
+            next_packet.GetPointerData(0).time_stamp);
+
+  std::vector<PointerData> dispatched = Replay(kRecordedDrag, 5);
+  for (size_t i = 1; i < dispatched.size(); i++) {
+    EXPECT_GE(dispatched[i].time_stamp, dispatched[i - 1].time_stamp);
+  }
+}
+
+TEST(PointerDataResamplerTest, PredictsInTheTimeBaseOfTheEvents) {
+  // Like the milliseconds since boot that some window systems stamp events
+  // with, which are unrelated to the time of the frames.
+  constexpr int64_t kTimeStampOffset = 123456789000;
+  std::vector<PointerData> expected = Replay(kRecordedDrag, 5);
+  std::vector<PointerData> dispatched =
+      Replay(kRecordedDrag, 5, kTimeStampOffset);
+  ASSERT_EQ(dispatched.size(), expected.size());
+  for (size_t i = 0; i < dispatched.size(); i++) {
+    EXPECT_EQ(dispatched[i].time_stamp,
+              expected[i].time_stamp + kTimeStampOffset);
+    EXPECT_EQ(dispatched[i].synthesized, expected[i].synthesized);
+    EXPECT_DOUBLE_EQ(dispatched[i].physical_x, expected[i].physical_x);
+    EXPECT_DOUBLE_EQ(dispatched[i].physical_y, expected[i].physical_y);
+  }
+}
+
+TEST(PointerDataResamplerTest, OnlyPredictsPointersThatMoved) {
+  std::vector<RecordedEvent> events = {
+      {1000, PointerData::Change::kDown, 0, 0, 0},
+      {5000, PointerData::Change::kMove, 0, 4, 0},
+      {9000, PointerData::Change::kMove, 0, 8, 0},
+      // The pointer rests from here on.
+  };
+  auto predicted = PredictedEvents(Replay(events, 4));
+  ASSERT_EQ(predicted.size(), 1u);
+
+  // A pointer that is only pressed is not predicted either.
+  events = {{1000, PointerData::Change::kDown, 0, 0, 0}};
+  EXPECT_TRUE(PredictedEvents(Replay(events, 2)).empty());
+}
+
+TEST(PointerDataResamplerTest, StopsPredictingWhenPointerIsLifted) {
+  std::vector<RecordedEvent> events = {
+      {1000, PointerData::Change::kDown, 0, 0, 0},
+      {5000, PointerData::Change::kMove, 0, 4, 0},
+      {9000, PointerData::Change::kMove, 0, 8, 0},
+      {13000, PointerData::Change::kUp, 0, 8, 0},
+  };
+  EXPECT_TRUE(PredictedEvents(Replay(events, 3)).empty());
+}
+
+TEST(PointerDataResamplerTest, PredictsPointersIndependently) {
+  std::vector<RecordedEvent> events = {
+      {1000, PointerData::Change::kDown, 0, 0, 0},
+      {1000, PointerData::Change::kDown, 1, 100, 100},
+      {5000, PointerData::Change::kMove, 0, 4, 0},
+      {5000, PointerData::Change::kMove, 1, 100, 96},
+      {9000, PointerData::Change::kMove, 0, 8, 0},
+      {9000, PointerData::Change::kMove, 1, 100, 92},
+  };
+  auto predicted = PredictedEvents(Replay(events, 1));
+  ASSERT_EQ(predicted.size(), 2u);
+  EXPECT_EQ(predicted[0].device, 0);
+  EXPECT_DOUBLE_EQ(predicted[0].physical_x, 16);
+  EXPECT_DOUBLE_EQ(predicted[0].physical_y, 0);
+  EXPECT_EQ(predicted[1].device, 1);
+  EXPECT_DOUBLE_EQ(predicted[1].physical_x, 100);
+  EXPECT_DOUBLE_EQ(predicted[1].physical_y, 84);
+}
+
+TEST(PointerDataResamplerTest, IgnoresHoveringPointers) {
+  std::vector<RecordedEvent> events = {
+      {1000, PointerData::Change::kHover, 0, 0, 0},
+      {5000, PointerData::Change::kHover, 0, 4, 0},
+      {9000, PointerData::Change::kHover, 0, 8, 0},
+  };
+  EXPECT_TRUE(PredictedEvents(Replay(events, 1)).empty());
+}
+
+TEST(PointerDataResamplerTest, RecordedDragKeepsDeltasConsistent) {
+  std::vector<PointerData> dispatched = Replay(kRecordedDrag, 5);
+  ASSERT_EQ(dispatched.size(), kRecordedDrag.size() + 3);
+
+  // Every event moves the pointer from where the previous event left it, so
+  // the deltas add up to the positions whether or not a consumer uses the
+  // predicted events.
+  double x = dispatched[0].physical_x;
+  double y = dispatched[0].physical_y;
+  size_t real_events = 0;
+  for (const PointerData& event : dispatched) {
+    EXPECT_DOUBLE_EQ(event.physical_delta_x, event.physical_x - x);
+    EXPECT_DOUBLE_EQ(event.physical_delta_y, event.physical_y - y);
+    x = event.physical_x;
+    y = event.physical_y;
+    if (event.synthesized != kPointerDataPredicted) {
+      EXPECT_EQ(event.time_stamp, kRecordedDrag[real_events].time);
+      EXPECT_EQ(event.physical_x, kRecordedDrag[real_events].x);
+      EXPECT_EQ(event.physical_y, kRecordedDrag[real_events].y);
+      real_events++;
+    }
+  }
+  EXPECT_EQ(real_events, kRecordedDrag.size());
+}
+
+TEST(PointerDataResamplerTest, RecordedDragPredictions) {
+  auto predicted = PredictedEvents(Replay(kRecordedDrag, 5));
+  ASSERT_EQ(predicted.size(), 3u);
+
+  // Frame 1: samples up to 13.5ms, velocity over the 20ms window from the
+  // down event at 1ms.
+  EXPECT_EQ(predicted[0].time_stamp, 13500);
+  EXPECT_DOUBLE_EQ(predicted[0].physical_x, 107 + 7.0 * 8000 / 12500);
+  EXPECT_DOUBLE_EQ(predicted[0].physical_y, 480 - 20.0 * 8000 / 12500);
+
+  // Frame 2: samples up to 30.167ms, window from 13.5ms.
+  EXPECT_EQ(predicted[1].time_stamp, 30167);
+  EXPECT_DOUBLE_EQ(predicted[1].physical_x, 138 + 31.0 * 8000 / 16667);
+  EXPECT_DOUBLE_EQ(predicted[1].physical_y, 392 - 88.0 * 8000 / 16667);
+
+  // Frame 3: samples up to 46.833ms, window from 30.167ms, as the pointer
+  // turns around.
+  EXPECT_EQ(predicted[2].time_stamp, 46833);
+  EXPECT_DOUBLE_EQ(predicted[2].physical_x, 141 + 3.0 * 8000 / 16666);
+  EXPECT_DOUBLE_EQ(predicted[2].physical_y, 355 - 37.0 * 8000 / 16666);
+}
+
+TEST(PointerDataResamplerTest, ReplayIsDeterministic) {
+  std::vector<PointerData> first = Replay(kRecordedDrag, 5);
+  std::vector<PointerData> second = Replay(kRecordedDrag, 5);
+  ASSERT_EQ(first.size(), second.size());
+  for (size_t i = 0; i < first.size(); i++) {
+    EXPECT_EQ(std::memcmp(&first[i], &second[i], sizeof(PointerData)), 0);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
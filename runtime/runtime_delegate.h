@@ -11,6 +11,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -30,7 +31,7 @@ class RuntimeDelegate {
   virtual void Render(std::unique_ptr<flutter::LayerTree> layer_tree,
                       float device_pixel_ratio) = 0;
 
-  virtual void UpdateSemantics(SemanticsNodeUpdates update,
+  virtual void UpdateSemantics(PackedSemanticsUpdate update,
                                CustomAccessibilityActionUpdates actions) = 0;
 
   virtual void HandlePlatformMessage(
@@ -42,6 +42,11 @@ const std::string_view
         "_flutter.renderFrameWithRasterStats";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kDumpTraceRingBufferExtensionName =
+    "_flutter.dumpTraceRingBuffer";
+const std::string_view
+    ServiceProtocol::kGetFrameLatencyStatisticsExtensionName =
+        "_flutter.getFrameLatencyStatistics";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -63,6 +68,8 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
+          kDumpTraceRingBufferExtensionName,
+          kGetFrameLatencyStatisticsExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -31,6 +31,8 @@ class ServiceProtocol {
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kDumpTraceRingBufferExtensionName;
+  static const std::string_view kGetFrameLatencyStatisticsExtensionName;
 
   class Handler {
    public:
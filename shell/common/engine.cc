@@ -256,6 +256,9 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 }
 
 void Engine::BeginFrame(fml::TimePoint frame_time, uint64_t frame_number) {
+  if (pointer_data_dispatcher_) {
+    pointer_data_dispatcher_->OnBeginFrame(frame_time);
+  }
   runtime_controller_->BeginFrame(frame_time, frame_number);
 }
 
@@ -470,7 +473,7 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
   animator_->Render(std::move(layer_tree), device_pixel_ratio);
 }
 
-void Engine::UpdateSemantics(SemanticsNodeUpdates update,
+void Engine::UpdateSemantics(PackedSemanticsUpdate update,
                              CustomAccessibilityActionUpdates actions) {
   delegate_.OnEngineUpdateSemantics(std::move(update), std::move(actions));
 }
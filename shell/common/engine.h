@@ -16,6 +16,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -150,17 +151,17 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
     ///             platform task runner while the engine is running on the UI
     ///             task runner.
     ///
-    /// @see        `SemanticsNode`, `SemanticsNodeUpdates`,
+    /// @see        `SemanticsNode`, `PackedSemanticsUpdate`,
     ///             `CustomAccessibilityActionUpdates`,
     ///             `PlatformView::UpdateSemantics`
     ///
-    /// @param[in]  updates  A map with the stable semantics node identifier as
-    ///                      key and the node properties as the value.
+    /// @param[in]  updates  The updated semantics nodes, packed with their
+    ///                      strings and child lists.
     /// @param[in]  actions  A map with the stable semantics node identifier as
     ///                      key and the custom node action as the value.
     ///
     virtual void OnEngineUpdateSemantics(
-        SemanticsNodeUpdates updates,
+        PackedSemanticsUpdate updates,
         CustomAccessibilityActionUpdates actions) = 0;
 
     //--------------------------------------------------------------------------
@@ -910,7 +911,7 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
               float device_pixel_ratio) override;
 
   // |RuntimeDelegate|
-  void UpdateSemantics(SemanticsNodeUpdates update,
+  void UpdateSemantics(PackedSemanticsUpdate update,
                        CustomAccessibilityActionUpdates actions) override;
 
   // |RuntimeDelegate|
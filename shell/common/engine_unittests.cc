@@ -24,7 +24,7 @@ namespace {
 class MockDelegate : public Engine::Delegate {
  public:
   MOCK_METHOD2(OnEngineUpdateSemantics,
-               void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
+               void(PackedSemanticsUpdate, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(OnEngineHandlePlatformMessage,
                void(std::unique_ptr<PlatformMessage>));
   MOCK_METHOD0(OnPreEngineRestart, void());
@@ -53,7 +53,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
   MOCK_METHOD1(ScheduleFrame, void(bool));
   MOCK_METHOD2(Render, void(std::unique_ptr<flutter::LayerTree>, float));
   MOCK_METHOD2(UpdateSemantics,
-               void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
+               void(PackedSemanticsUpdate, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(HandlePlatformMessage, void(std::unique_ptr<PlatformMessage>));
   MOCK_METHOD0(GetFontCollection, FontCollection&());
   MOCK_METHOD0(GetAssetManager, std::shared_ptr<AssetManager>());
@@ -113,6 +113,12 @@ void PlatformView::UpdateSemantics(
     // NOLINTNEXTLINE(performance-unnecessary-value-param)
     CustomAccessibilityActionUpdates actions) {}
 
+void PlatformView::UpdatePackedSemantics(
+    const PackedSemanticsUpdate& update,
+    const CustomAccessibilityActionUpdates& actions) {
+  UpdateSemantics(update.ToSemanticsNodeUpdates(), actions);
+}
+
 void PlatformView::HandlePlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   if (auto response = message->response()) {
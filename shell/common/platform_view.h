@@ -16,6 +16,7 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/window/key_data_packet.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -464,6 +465,25 @@ class PlatformView {
   virtual void UpdateSemantics(SemanticsNodeUpdates updates,
                                CustomAccessibilityActionUpdates actions);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the framework to tell the embedder to apply the
+  ///             specified semantics node updates, in the packed form they
+  ///             are produced in. Platform views that can read the packed
+  ///             nodes in place override this method to avoid unpacking every
+  ///             node. The default implementation unpacks the nodes and calls
+  ///             `UpdateSemantics`.
+  ///
+  /// @see        PackedSemanticsUpdate, CustomAccessibilityActionUpdates
+  ///
+  /// @param[in]  update   The updated semantics nodes. The update is only
+  ///                      valid for the duration of the call.
+  /// @param[in]  actions  A map with the stable semantics node identifier as
+  ///                      key and the custom node action as the value.
+  ///
+  virtual void UpdatePackedSemantics(
+      const PackedSemanticsUpdate& update,
+      const CustomAccessibilityActionUpdates& actions);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to specify the updated viewport metrics. In
   ///             response to this call, on the raster thread, the rasterizer
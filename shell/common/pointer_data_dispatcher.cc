@@ -11,10 +11,17 @@ namespace flutter {
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
+void PointerDataDispatcher::OnBeginFrame(fml::TimePoint frame_target_time) {}
+
 SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -58,6 +65,31 @@ void SmoothPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
       });
 }
 
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+  resampler_.Observe(*packet,
+                     fml::TimePoint::Now().ToEpochDelta().ToMicroseconds());
+  delegate_.DoDispatchPacket(std::move(packet), trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::OnBeginFrame(
+    fml::TimePoint frame_target_time) {
+  if (!resampler_.HasPendingSamples()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::OnBeginFrame");
+  auto packet = resampler_.Resample(
+      frame_target_time.ToEpochDelta().ToMicroseconds());
+  if (packet) {
+    uint64_t trace_flow_id = fml::tracing::TraceNonce();
+    TRACE_FLOW_BEGIN("flutter", "PointerEvent", trace_flow_id);
+    delegate_.DoDispatchPacket(std::move(packet), trace_flow_id);
+  }
+}
+
 void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   FML_DCHECK(pending_packet_ != nullptr);
   FML_DCHECK(is_pointer_data_in_progress_);
@@ -5,6 +5,7 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include "flutter/lib/ui/window/pointer_data_resampler.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -74,6 +75,15 @@ class PointerDataDispatcher {
   virtual void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Signal that the engine is about to begin a frame, before the
+  ///             framework is asked to build it. The default implementation
+  ///             does nothing.
+  ///
+  /// @param[in]  frame_target_time  The time by which the frame is expected
+  ///                                to be presented.
+  virtual void OnBeginFrame(fml::TimePoint frame_target_time);
+
   //----------------------------------------------------------------------------
   /// @brief      Default destructor.
   virtual ~PointerDataDispatcher();
@@ -163,6 +173,35 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that forwards packets without delay, and that dispatches a
+/// predicted move event for every dragged pointer when a frame begins. See
+/// `PointerDataResampler`.
+///
+/// The prediction extrapolates the pointer to the target time of the frame, so
+/// that the framework builds the frame for where the pointer will be when the
+/// frame is presented. How far ahead to predict is measured from when the
+/// newest event was dispatched, since the time stamps of the events are in the
+/// time base of the embedder rather than that of `fml::TimePoint`.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit ResamplingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  // |PointerDataDispatcer|
+  void OnBeginFrame(fml::TimePoint frame_target_time) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  PointerDataResampler resampler_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -592,6 +592,9 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       }
     }
 
+    layer_tree.enable_compiled_paint(
+        delegate_.GetSettings().enable_compiled_layer_tree_paint);
+
     bool ignore_raster_cache = true;
     if (surface_->EnableRasterCache() &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
@@ -25,10 +26,16 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
+  auto assets_directory = fml::OpenDirectory(settings.assets_path.c_str(),
+                                             false, fml::FilePermission::kRead);
+  // A packed bundle answers lookups from its in-memory index. Assets missing
+  // from it are still looked up in the directory.
+  if (auto packed_bundle = PackedAssetBundle::Open(
+          assets_directory, PackedAssetBundle::kDefaultFileName)) {
+    asset_manager->PushBack(std::move(packed_bundle));
+  }
   asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+      std::move(assets_directory), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
@@ -7,12 +7,14 @@
 
 #include <memory>
 #include <sstream>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
@@ -40,6 +42,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -120,6 +123,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_ring_buffer) {
+      fml::tracing::TraceRingSetEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -141,6 +148,53 @@ void PerformInitializationTasks(Settings& settings) {
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+// The first request for the default font manager enumerates the system fonts,
+// which can take tens of milliseconds. The UI task runner is idle until the
+// engine is created, so warm the process wide font manager up there while the
+// VM starts. The engine's own font setup then finds it ready.
+//
+// On Windows, every request creates a new DirectWrite font manager instead of
+// returning a process wide one, so a prefetched manager would be discarded.
+void PrefetchDefaultFontManager(const Settings& settings,
+                                const TaskRunners& task_runners) {
+#if !FML_OS_WIN
+  // The embedding has already done this. Font initialization data makes the
+  // platform create a new font manager for every request, so there is nothing
+  // to warm up either.
+  if (settings.prefetched_default_font_manager ||
+      settings.font_initialization_data != 0) {
+    return;
+  }
+  task_runners.GetUITaskRunner()->PostTask([]() {
+    TRACE_EVENT0("flutter", "Shell::PrefetchDefaultFontManager");
+    txt::GetDefaultFontManager(0);
+  });
+#endif  // !FML_OS_WIN
+}
+
+// Maps the snapshots named by the settings. For concurrent startup, the
+// isolate snapshot is mapped on the IO task runner while the VM snapshot is
+// mapped on this thread.
+std::pair<fml::RefPtr<const DartSnapshot>, fml::RefPtr<const DartSnapshot>>
+MapSnapshots(const Settings& settings, const TaskRunners& task_runners) {
+  TRACE_EVENT0("flutter", "Shell::MapSnapshots");
+  if (!settings.concurrent_shell_startup) {
+    return {DartSnapshot::VMSnapshotFromSettings(settings),
+            DartSnapshot::IsolateSnapshotFromSettings(settings)};
+  }
+
+  std::promise<fml::RefPtr<const DartSnapshot>> isolate_snapshot_promise;
+  auto isolate_snapshot_future = isolate_snapshot_promise.get_future();
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetIOTaskRunner(), [&settings, &isolate_snapshot_promise]() {
+        TRACE_EVENT0("flutter", "Shell::MapIsolateSnapshot");
+        isolate_snapshot_promise.set_value(
+            DartSnapshot::IsolateSnapshotFromSettings(settings));
+      });
+  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+  return {std::move(vm_snapshot), isolate_snapshot_future.get()};
+}
+
 }  // namespace
 
 std::unique_ptr<Shell> Shell::Create(
@@ -154,14 +208,26 @@ std::unique_ptr<Shell> Shell::Create(
   PerformInitializationTasks(settings);
 
   TRACE_EVENT0("flutter", "Shell::Create");
+  const auto create_start = fml::TimePoint::Now();
+
+  if (settings.concurrent_shell_startup) {
+    PrefetchDefaultFontManager(settings, task_runners);
+  }
 
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
-  auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  fml::RefPtr<const DartSnapshot> vm_snapshot;
+  fml::RefPtr<const DartSnapshot> isolate_snapshot;
+  std::tie(vm_snapshot, isolate_snapshot) =
+      MapSnapshots(settings, task_runners);
+  const auto create_dart_vm_start = fml::TimePoint::Now();
+  auto vm = [&]() {
+    TRACE_EVENT0("flutter", "Shell::CreateDartVM");
+    return DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  }();
   FML_CHECK(vm) << "Must be able to initialize the VM.";
+  const auto create_dart_vm_end = fml::TimePoint::Now();
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
@@ -171,17 +237,25 @@ std::unique_ptr<Shell> Shell::Create(
   auto resource_cache_limit_calculator =
       std::make_shared<ResourceCacheLimitCalculator>(
           settings.resource_cache_max_bytes_threshold);
-  return CreateWithSnapshot(platform_data,                    //
-                            task_runners,                     //
-                            /*parent_merger=*/nullptr,        //
-                            /*parent_io_manager=*/nullptr,    //
-                            resource_cache_limit_calculator,  //
-                            settings,                         //
-                            std::move(vm),                    //
-                            std::move(isolate_snapshot),      //
-                            on_create_platform_view,          //
-                            on_create_rasterizer,             //
-                            CreateEngine, is_gpu_disabled);
+  auto shell =
+      CreateWithSnapshot(platform_data,                    //
+                         task_runners,                     //
+                         /*parent_merger=*/nullptr,        //
+                         /*parent_io_manager=*/nullptr,    //
+                         resource_cache_limit_calculator,  //
+                         settings,                         //
+                         std::move(vm),                    //
+                         std::move(isolate_snapshot),      //
+                         on_create_platform_view,          //
+                         on_create_rasterizer,             //
+                         CreateEngine, is_gpu_disabled);
+  if (shell) {
+    auto& timings = shell->startup_timings_;
+    timings.map_snapshots = create_dart_vm_start - create_start;
+    timings.create_dart_vm = create_dart_vm_end - create_dart_vm_start;
+    timings.total = fml::TimePoint::Now() - create_start;
+  }
+  return shell;
 }
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
@@ -212,10 +286,13 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                 is_gpu_disabled));
 
   // Create the platform view on the platform thread (this thread).
+  const auto platform_view_start = fml::TimePoint::Now();
   auto platform_view = on_create_platform_view(*shell.get());
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
+  shell->startup_timings_.setup_platform_view =
+      fml::TimePoint::Now() - platform_view_start;
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -232,8 +309,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        impeller_context = platform_view->GetImpellerContext()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        const auto start = fml::TimePoint::Now();
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        shell->startup_timings_.setup_gpu_subsystem =
+            fml::TimePoint::Now() - start;
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -268,9 +348,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &unref_queue_promise,                                              //
        platform_view_ptr,                                                 //
        io_task_runner,                                                    //
+       &timings = shell->startup_timings_,                                //
        is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        const auto start = fml::TimePoint::Now();
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -282,6 +364,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
               platform_view_ptr->GetImpellerContext()  // impeller context
           );
         }
+        timings.setup_io_subsystem = fml::TimePoint::Now() - start;
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
         io_manager_promise.set_value(io_manager);
@@ -290,6 +373,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (settings.enable_pointer_prediction) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -307,6 +395,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &unref_queue_future,                             //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        const auto start = fml::TimePoint::Now();
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
@@ -314,7 +403,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
 
-        engine_promise.set_value(
+        auto engine =
             on_create_engine(*shell,                          //
                              dispatcher_maker,                //
                              *shell->GetDartVM(),             //
@@ -327,7 +416,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                              unref_queue_future.get(),        //
                              snapshot_delegate_future.get(),  //
                              shell->volatile_path_tracker_,
-                             shell->is_gpu_disabled_sync_switch_));
+                             shell->is_gpu_disabled_sync_switch_);
+        // Includes the time spent waiting for the IO and GPU subsystems.
+        shell->startup_timings_.setup_ui_subsystem =
+            fml::TimePoint::Now() - start;
+        engine_promise.set_value(std::move(engine));
       }));
 
   if (!shell->Setup(std::move(platform_view),  //
@@ -359,6 +452,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
   PerformInitializationTasks(settings);
 
   TRACE_EVENT0("flutter", "Shell::CreateWithSnapshot");
+  const auto create_start = fml::TimePoint::Now();
 
   const bool callbacks_valid =
       on_create_platform_view && on_create_rasterizer && on_create_engine;
@@ -399,6 +493,9 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
         latch.Signal();
       }));
   latch.Wait();
+  if (shell) {
+    shell->startup_timings_.total = fml::TimePoint::Now() - create_start;
+  }
   return shell;
 }
 
@@ -483,6 +580,16 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kDumpTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolDumpTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameLatencyStatisticsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameLatencyStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -1253,7 +1360,7 @@ void Shell::OnAnimatorDrawLastLayerTree(
 }
 
 // |Engine::Delegate|
-void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
+void Shell::OnEngineUpdateSemantics(PackedSemanticsUpdate update,
                                     CustomAccessibilityActionUpdates actions) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
@@ -1262,7 +1369,7 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
       [view = platform_view_->GetWeakPtr(), update = std::move(update),
        actions = std::move(actions)] {
         if (view) {
-          view->UpdateSemantics(update, actions);
+          view->UpdatePackedSemantics(update, actions);
         }
       });
 }
@@ -1499,6 +1606,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  frame_latency_aggregator_.AddFrame(timing);
+
+  MaybeDumpTraceRingBufferForJank(timing);
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1827,6 +1938,93 @@ bool Shell::OnServiceProtocolGetSkSLs(
   return true;
 }
 
+void Shell::MaybeDumpTraceRingBufferForJank(const FrameTiming& timing) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  if (!settings_.trace_ring_buffer_jank_callback ||
+      !fml::tracing::TraceRingIsEnabled()) {
+    return;
+  }
+
+  const fml::TimeDelta frame_time =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kVsyncStart);
+  const fml::TimeDelta jank_threshold =
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count()) * 2;
+  if (frame_time < jank_threshold) {
+    return;
+  }
+
+  // Consecutive janky frames usually share a cause, and the ring buffer
+  // already holds the events of the frames before them.
+  const auto now = fml::TimePoint::Now();
+  if (now - last_trace_ring_buffer_dump_ < fml::TimeDelta::FromSeconds(1)) {
+    return;
+  }
+  last_trace_ring_buffer_dump_ = now;
+
+  // Serializing the buffers is too slow to do on the raster thread that just
+  // missed its deadline.
+  task_runners_.GetIOTaskRunner()->PostTask(
+      [callback = settings_.trace_ring_buffer_jank_callback]() {
+        TRACE_EVENT0("flutter", "Shell::DumpTraceRingBufferForJank");
+        callback(fml::tracing::TraceRingDumpJSON());
+      });
+}
+
+bool Shell::OnServiceProtocolDumpTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", allocator);
+  response->AddMember("enabled", fml::tracing::TraceRingIsEnabled(),
+                      allocator);
+  response->AddMember("trace", fml::tracing::TraceRingDumpJSON(), allocator);
+  return true;
+}
+
+const Shell::StartupTimings& Shell::GetStartupTimings() const {
+  return startup_timings_;
+}
+
+FrameLatencyAggregator::Statistics Shell::GetFrameLatencyStatistics(
+    bool reset) {
+  if (reset) {
+    return frame_latency_aggregator_.GetStatisticsAndReset();
+  }
+  return frame_latency_aggregator_.GetStatistics();
+}
+
+bool Shell::OnServiceProtocolGetFrameLatencyStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const bool reset = params.count("reset") > 0 && params.at("reset") == "true";
+  const auto statistics = GetFrameLatencyStatistics(reset);
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameLatencyStatistics", allocator);
+  response->AddMember<uint64_t>("frameCount", statistics.frame_count,
+                                allocator);
+  for (size_t i = 0;
+       i < static_cast<size_t>(FrameLatencyAggregator::Phase::kCount); i++) {
+    const auto phase = static_cast<FrameLatencyAggregator::Phase>(i);
+    const auto& percentiles = statistics.Get(phase);
+    rapidjson::Value value(rapidjson::kObjectType);
+    value.AddMember<uint64_t>("p50", percentiles.p50, allocator);
+    value.AddMember<uint64_t>("p90", percentiles.p90, allocator);
+    value.AddMember<uint64_t>("p99", percentiles.p99, allocator);
+    value.AddMember<uint64_t>("p999", percentiles.p999, allocator);
+    value.AddMember<uint64_t>("max", percentiles.max, allocator);
+    response->AddMember(
+        rapidjson::StringRef(FrameLatencyAggregator::GetPhaseName(phase)),
+        value, allocator);
+  }
+  return true;
+}
+
 bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
     rapidjson::Document* response) {
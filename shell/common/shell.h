@@ -14,6 +14,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_latency_aggregator.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -27,6 +28,7 @@
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
+#include "flutter/lib/ui/semantics/packed_semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -383,6 +385,39 @@ class Shell final : public PlatformView::Delegate,
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Latency percentiles of the frames rasterized since the shell
+  ///             was created or since the last reset. This may be called on
+  ///             any thread.
+  ///
+  /// @param[in]  reset  Whether to clear the histograms after reading them.
+  ///
+  FrameLatencyAggregator::Statistics GetFrameLatencyStatistics(bool reset);
+
+  //----------------------------------------------------------------------------
+  /// @brief      How long each phase of shell creation took. Phases run on
+  ///             different task runners, and with
+  ///             `Settings::concurrent_shell_startup` even more of them
+  ///             overlap, so they do not add up to `total`. Phases that did
+  ///             not run for this shell, such as creating the Dart VM for a
+  ///             spawned shell, are zero.
+  ///
+  struct StartupTimings {
+    fml::TimeDelta map_snapshots;
+    fml::TimeDelta create_dart_vm;
+    fml::TimeDelta setup_platform_view;
+    fml::TimeDelta setup_gpu_subsystem;
+    fml::TimeDelta setup_io_subsystem;
+    fml::TimeDelta setup_ui_subsystem;
+    fml::TimeDelta total;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The startup breakdown of this shell. Complete once the shell
+  ///             has been returned by `Create` or `Spawn`.
+  ///
+  const StartupTimings& GetStartupTimings() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Install a new factory that can match against and decode image
   ///             data.
@@ -465,6 +500,18 @@ class Shell final : public PlatformView::Delegate,
   // ui.PlatformDispatcher.onReportTimings.
   bool frame_timings_report_scheduled_ = false;
 
+  // Latency histograms of every rasterized frame. Written on the raster
+  // thread, safe to read from any thread.
+  FrameLatencyAggregator frame_latency_aggregator_;
+
+  // Written by the tasks that set up the subsystems of the shell, all of which
+  // complete before the shell is returned to its creator.
+  StartupTimings startup_timings_;
+
+  // When the trace ring buffer was last handed to the embedder because of a
+  // janky frame. Only accessed on the raster thread.
+  fml::TimePoint last_trace_ring_buffer_dump_;
+
   // Vector of FrameTiming::kCount * n timestamps for n frames whose timings
   // have not been reported yet. Vector of ints instead of FrameTiming is stored
   // here for easier conversions to Dart objects.
@@ -616,7 +663,7 @@ class Shell final : public PlatformView::Delegate,
 
   // |Engine::Delegate|
   void OnEngineUpdateSemantics(
-      SemanticsNodeUpdates update,
+      PackedSemanticsUpdate update,
       CustomAccessibilityActionUpdates actions) override;
 
   // |Engine::Delegate|
@@ -730,6 +777,27 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the contents of the trace ring buffer in the Chrome JSON
+  // trace event format.
+  bool OnServiceProtocolDumpTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with latency percentiles, in microseconds, of the frames
+  // rasterized so far. If the "reset" parameter is "true", the histograms are
+  // cleared after they are read.
+  bool OnServiceProtocolGetFrameLatencyStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Hands the trace ring buffer to the embedder if |timing| missed the frame
+  // budget badly enough to be considered jank.
+  void MaybeDumpTraceRingBufferForJank(const FrameTiming& timing);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
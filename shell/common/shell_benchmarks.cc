@@ -7,6 +7,8 @@
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/shell_test_platform_view.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
@@ -120,4 +122,118 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures the time from the call to |Shell::Create| until the first frame
+// produced by the root isolate has been rasterized, which is what users see
+// as cold start. Like the other benchmarks here, only the first iteration
+// pays for bootstrapping the Dart VM.
+static void TimeToFirstFrame(benchmark::State& state,
+                             bool concurrent_shell_startup) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  std::unique_ptr<Shell> shell;
+  std::unique_ptr<ThreadHost> thread_host;
+  testing::ELFAOTSymbols aot_symbols;
+  Settings settings = {};
+
+  {
+    benchmarking::ScopedPauseTiming pause(state, true);
+    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+    settings.task_observer_remove = [](intptr_t) {};
+    settings.concurrent_shell_startup = concurrent_shell_startup;
+
+    if (DartVM::IsRunningPrecompiledCode()) {
+      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+          testing::kDefaultAOTAppELFFileName);
+      FML_CHECK(
+          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+          << "Could not set up settings with AOT symbols.";
+    } else {
+      settings.application_kernels = [&]() {
+        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+        kernel_mappings.emplace_back(
+            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+        return kernel_mappings;
+      };
+    }
+
+    thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+        "io.flutter.bench.", ThreadHost::Type::Platform |
+                                 ThreadHost::Type::RASTER |
+                                 ThreadHost::Type::IO | ThreadHost::Type::UI));
+  }
+
+  TaskRunners task_runners("test",
+                           thread_host->platform_thread->GetTaskRunner(),
+                           thread_host->raster_thread->GetTaskRunner(),
+                           thread_host->ui_thread->GetTaskRunner(),
+                           thread_host->io_thread->GetTaskRunner());
+
+  shell = Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      testing::ShellTestPlatformViewBuilder({}),
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  FML_CHECK(shell);
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetPlatformTaskRunner(), [&shell, &settings, &latch]() {
+        shell->GetPlatformView()->NotifyCreated();
+        shell->GetPlatformView()->SetViewportMetrics(
+            {1.0, 800.0, 600.0, 22, 0});
+        auto configuration = RunConfiguration::InferFromSettings(settings);
+        configuration.SetEntrypoint("scene_with_red_box");
+        shell->RunEngine(std::move(configuration),
+                         [&latch](Engine::RunStatus run_status) {
+                           FML_CHECK(run_status == Engine::RunStatus::Success);
+                           latch.Signal();
+                         });
+      });
+  latch.Wait();
+  FML_CHECK(shell->WaitForFirstFrame(fml::TimeDelta::Max()).ok());
+
+  {
+    benchmarking::ScopedPauseTiming pause(state, true);
+    const auto& timings = shell->GetStartupTimings();
+    state.counters["MapSnapshotsMs"] = timings.map_snapshots.ToMillisecondsF();
+    state.counters["CreateDartVMMs"] =
+        timings.create_dart_vm.ToMillisecondsF();
+    state.counters["SetupGPUSubsystemMs"] =
+        timings.setup_gpu_subsystem.ToMillisecondsF();
+    state.counters["SetupIOSubsystemMs"] =
+        timings.setup_io_subsystem.ToMillisecondsF();
+    state.counters["SetupUISubsystemMs"] =
+        timings.setup_ui_subsystem.ToMillisecondsF();
+    state.counters["CreateShellMs"] = timings.total.ToMillisecondsF();
+
+    latch.Reset();
+    fml::TaskRunner::RunNowOrPostTask(task_runners.GetPlatformTaskRunner(),
+                                      [&shell, &latch]() mutable {
+                                        shell.reset();
+                                        latch.Signal();
+                                      });
+    latch.Wait();
+    thread_host.reset();
+  }
+
+  FML_CHECK(!shell);
+}
+
+static void BM_ShellTimeToFirstFrame(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    TimeToFirstFrame(state, false);
+  }
+}
+
+BENCHMARK(BM_ShellTimeToFirstFrame)->Unit(benchmark::kMillisecond);
+
+static void BM_ShellTimeToFirstFrameConcurrentStartup(
+    benchmark::State& state) {
+  while (state.KeepRunning()) {
+    TimeToFirstFrame(state, true);
+  }
+}
+
+BENCHMARK(BM_ShellTimeToFirstFrameConcurrentStartup)
+    ->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
@@ -3741,6 +3741,28 @@ TEST_F(ShellTest, PrefetchDefaultFontManager) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ConcurrentShellStartup) {
+  auto settings = CreateSettingsForFixture();
+  settings.concurrent_shell_startup = true;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  ASSERT_TRUE(shell);
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+
+  const auto& timings = shell->GetStartupTimings();
+  ASSERT_GT(timings.total, fml::TimeDelta::Zero());
+  ASSERT_GE(timings.total, timings.map_snapshots + timings.create_dart_vm);
+  ASSERT_GE(timings.total, timings.setup_ui_subsystem);
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  ASSERT_TRUE(shell->WaitForFirstFrame(fml::TimeDelta::Max()).ok());
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, OnPlatformViewCreatedWhenUIThreadIsBusy) {
   // This test will deadlock if the threading logic in
   // Shell::OnCreatePlatformView is wrong.
@@ -325,6 +325,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_startup =
       command_line.HasOption(FlagForSwitch(Switch::TraceStartup));
 
+  settings.trace_ring_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::TraceRingBuffer));
+
   settings.enable_serial_gc =
       command_line.HasOption(FlagForSwitch(Switch::EnableSerialGC));
 
@@ -471,6 +474,15 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
+  settings.concurrent_shell_startup =
+      command_line.HasOption(FlagForSwitch(Switch::ConcurrentShellStartup));
+
+  settings.enable_compiled_layer_tree_paint = command_line.HasOption(
+      FlagForSwitch(Switch::EnableCompiledLayerTreePaint));
+
+  settings.enable_pointer_prediction =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerPrediction));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
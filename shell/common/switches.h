@@ -162,6 +162,12 @@ DEF_SWITCH(TraceStartup,
            "trace-startup",
            "Trace early application lifecycle. Automatically switches to an "
            "endless trace buffer.")
+DEF_SWITCH(TraceRingBuffer,
+           "trace-ring-buffer",
+           "Record trace events into an in-process ring buffer that can be "
+           "dumped through the service protocol or when a frame misses its "
+           "budget. Unlike the timeline, this is also available in release "
+           "mode.")
 DEF_SWITCH(TraceSkia,
            "trace-skia",
            "Trace Skia calls. This is useful when debugging the GPU threed."
@@ -213,6 +219,20 @@ DEF_SWITCH(PrefetchedDefaultFontManager,
            "prefetched-default-font-manager",
            "Indicates whether the embedding started a prefetch of the "
            "default font manager before creating the engine.")
+DEF_SWITCH(ConcurrentShellStartup,
+           "concurrent-shell-startup",
+           "Overlap the independent parts of shell creation, such as snapshot "
+           "mapping, font manager setup, and Dart VM initialization, across "
+           "the shell's task runners.")
+DEF_SWITCH(EnableCompiledLayerTreePaint,
+           "enable-compiled-layer-tree-paint",
+           "Paint layer trees by executing a linearized copy of the tree "
+           "instead of recursing through the layers.")
+DEF_SWITCH(EnablePointerPrediction,
+           "enable-pointer-prediction",
+           "When a frame begins, dispatch a move event for every dragged "
+           "pointer at the position it is predicted to have when the frame is "
+           "presented.")
 DEF_SWITCH(VerboseLogging,
            "verbose-logging",
            "By default, only errors are logged. This flag enabled logging at "
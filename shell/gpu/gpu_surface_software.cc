@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
@@ -64,9 +65,18 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
   SkCanvas* canvas = backing_store->getCanvas();
   canvas->resetMatrix();
 
+  // The submit callback lives as long as the frame, so the delegate gets the
+  // backing store back when the frame is dropped without being presented.
+  auto discard = std::make_shared<fml::ScopedCleanupClosure>(
+      [self = weak_factory_.GetWeakPtr(), backing_store]() {
+        if (self && self->IsValid()) {
+          self->delegate_->DiscardBackingStore(backing_store);
+        }
+      });
+
   SurfaceFrame::SubmitCallback on_submit =
-      [self = weak_factory_.GetWeakPtr()](const SurfaceFrame& surface_frame,
-                                          DlCanvas* canvas) -> bool {
+      [self = weak_factory_.GetWeakPtr(), discard](
+          const SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
     // If the surface itself went away, there is nothing more to do.
     if (!self || !self->IsValid() || canvas == nullptr) {
       return false;
@@ -74,9 +84,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->Flush();
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    if (!self->delegate_->PresentBackingStoreWithInfo(
+            surface_frame.SkiaSurface(), surface_frame.submit_info())) {
+      return false;
+    }
+    discard->Release();
+    return true;
   };
 
+  framebuffer_info = delegate_->GetBackingStoreFramebufferInfo();
   return std::make_unique<SurfaceFrame>(backing_store, framebuffer_info,
                                         on_submit, logical_size);
 }
@@ -8,4 +8,20 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+SurfaceFrame::FramebufferInfo
+GPUSurfaceSoftwareDelegate::GetBackingStoreFramebufferInfo() const {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  return framebuffer_info;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithInfo(
+    sk_sp<SkSurface> backing_store,
+    const SurfaceFrame::SubmitInfo& submit_info) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
+void GPUSurfaceSoftwareDelegate::DiscardBackingStore(
+    sk_sp<SkSurface> backing_store) {}
+
 }  // namespace flutter
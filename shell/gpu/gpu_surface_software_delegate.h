@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/surface_frame.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -48,6 +49,42 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Describes the backing store last returned by
+  ///             |AcquireBackingStore|. Delegates that retain the contents of
+  ///             their backing stores across frames enable partial repaint by
+  ///             reporting the existing damage of the backing store.
+  ///
+  /// @return     The framebuffer info. By default, the backing store supports
+  ///             readback but not partial repaint.
+  ///
+  virtual SurfaceFrame::FramebufferInfo GetBackingStoreFramebufferInfo() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the backing store along with the damage computed by
+  ///             the rasterizer for this frame.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  submit_info    The damage and timing of the frame.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen. By default, this calls |PresentBackingStore|.
+  ///
+  virtual bool PresentBackingStoreWithInfo(
+      sk_sp<SkSurface> backing_store,
+      const SurfaceFrame::SubmitInfo& submit_info);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called when the frame rendered into the backing store is
+  ///             destroyed without having been presented, for instance
+  ///             because the rasterizer dropped it. Delegates that hand out
+  ///             backing stores from a pool reclaim them here. By default,
+  ///             this does nothing.
+  ///
+  /// @param[in]  backing_store  The backing store of the dropped frame.
+  ///
+  virtual void DiscardBackingStore(sk_sp<SkSurface> backing_store);
 };
 
 }  // namespace flutter
@@ -19,6 +19,35 @@ constexpr int kHasScrollingAction =
     FlutterSemanticsAction::kFlutterSemanticsActionScrollUp |
     FlutterSemanticsAction::kFlutterSemanticsActionScrollDown;
 
+namespace {
+
+bool RectsEqual(const FlutterRect& a, const FlutterRect& b) {
+  return a.left == b.left && a.top == b.top && a.right == b.right &&
+         a.bottom == b.bottom;
+}
+
+bool TransformsEqual(const FlutterTransformation& a,
+                     const FlutterTransformation& b) {
+  return a.scaleX == b.scaleX && a.skewX == b.skewX && a.transX == b.transX &&
+         a.skewY == b.skewY && a.scaleY == b.scaleY && a.transY == b.transY &&
+         a.pers0 == b.pers0 && a.pers1 == b.pers1 && a.pers2 == b.pers2;
+}
+
+gfx::RectF ToRelativeBounds(const FlutterRect& rect) {
+  return gfx::RectF(rect.left, rect.top, rect.right - rect.left,
+                    rect.bottom - rect.top);
+}
+
+std::unique_ptr<gfx::Transform> ToRelativeTransform(
+    const FlutterTransformation& transform) {
+  return std::make_unique<gfx::Transform>(
+      transform.scaleX, transform.skewX, transform.transX, 0, transform.skewY,
+      transform.scaleY, transform.transY, 0, transform.pers0, transform.pers1,
+      transform.pers2, 0, 0, 0, 0, 0);
+}
+
+}  // namespace
+
 // AccessibilityBridge
 AccessibilityBridge::AccessibilityBridge()
     : tree_(std::make_unique<ui::AXTree>()) {
@@ -38,7 +67,9 @@ AccessibilityBridge::~AccessibilityBridge() {
 
 void AccessibilityBridge::AddFlutterSemanticsNodeUpdate(
     const FlutterSemanticsNode2& node) {
-  pending_semantics_node_updates_[node.id] = FromFlutterSemanticsNode(node);
+  SemanticsNode semantics_node = FromFlutterSemanticsNode(node);
+  semantics_node.dirty_fields = GetDirtyFields(semantics_node);
+  pending_semantics_node_updates_[node.id] = std::move(semantics_node);
 }
 
 void AccessibilityBridge::AddFlutterSemanticsCustomActionUpdate(
@@ -57,15 +88,35 @@ void AccessibilityBridge::CommitUpdates() {
   // First, start by removing nodes if necessary.
   std::optional<ui::AXTreeUpdate> remove_reparented =
       CreateRemoveReparentedNodesUpdate();
+  std::vector<SemanticsNode> moved_nodes;
   if (remove_reparented.has_value()) {
     tree_->Unserialize(remove_reparented.value());
 
     std::string error = tree_->error();
     if (!error.empty()) {
       FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+      committed_semantics_nodes_.clear();
       assert(false);
       return;
     }
+  } else {
+    // Nodes that did not change since they were last committed need no update
+    // at all, and nodes whose location is their only change are patched in
+    // place once the tree is updated. Neither is converted to ui::AXNodeData.
+    // This is not safe when nodes are reparented, since removing the moved
+    // nodes from their old parents removes whole subtrees from the tree.
+    for (auto iter = pending_semantics_node_updates_.begin();
+         iter != pending_semantics_node_updates_.end();) {
+      const uint32_t dirty_fields = iter->second.dirty_fields;
+      if ((dirty_fields & ~kSemanticsNodeLocation) != 0) {
+        ++iter;
+        continue;
+      }
+      if (dirty_fields != 0) {
+        moved_nodes.push_back(std::move(iter->second));
+      }
+      iter = pending_semantics_node_updates_.erase(iter);
+    }
   }
 
   // Second, apply the pending node updates. This also moves reparented nodes to
@@ -112,8 +163,20 @@ void AccessibilityBridge::CommitUpdates() {
   std::string error = tree_->error();
   if (!error.empty()) {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
+    committed_semantics_nodes_.clear();
     return;
   }
+
+  for (const SemanticsNode& node : moved_nodes) {
+    UpdateLocation(node);
+  }
+  for (auto& list : results) {
+    for (SemanticsNode& node : list) {
+      const int32_t id = node.id;
+      committed_semantics_nodes_[id] = std::move(node);
+    }
+  }
+
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -190,6 +253,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -216,6 +280,11 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
 
   for (auto node_update : pending_semantics_node_updates_) {
+    // The children of nodes whose children did not change are already the
+    // children of these nodes in the tree.
+    if ((node_update.second.dirty_fields & kSemanticsNodeChildren) == 0) {
+      continue;
+    }
     for (int32_t child_id : node_update.second.children_in_traversal_order) {
       // Skip nodes that don't exist or have a parent in the current tree.
       ui::AXNode* child = tree_->GetFromId(child_id);
@@ -295,14 +364,8 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
   SetNameFromFlutterUpdate(node_data, node);
   SetValueFromFlutterUpdate(node_data, node);
   SetTooltipFromFlutterUpdate(node_data, node);
-  node_data.relative_bounds.bounds.SetRect(node.rect.left, node.rect.top,
-                                           node.rect.right - node.rect.left,
-                                           node.rect.bottom - node.rect.top);
-  node_data.relative_bounds.transform = std::make_unique<gfx::Transform>(
-      node.transform.scaleX, node.transform.skewX, node.transform.transX, 0,
-      node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
-      node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
-      0, 0);
+  node_data.relative_bounds.bounds = ToRelativeBounds(node.rect);
+  node_data.relative_bounds.transform = ToRelativeTransform(node.transform);
   for (auto child : node.children_in_traversal_order) {
     node_data.child_ids.push_back(child);
   }
@@ -576,6 +639,69 @@ void AccessibilityBridge::SetTreeData(const SemanticsNode& node,
   }
 }
 
+uint32_t AccessibilityBridge::GetDirtyFields(const SemanticsNode& node) const {
+  auto iter = committed_semantics_nodes_.find(node.id);
+  if (iter == committed_semantics_nodes_.end()) {
+    return kSemanticsNodeAllFields;
+  }
+  const SemanticsNode& old = iter->second;
+  uint32_t dirty_fields = 0;
+  if (node.flags != old.flags) {
+    dirty_fields |= kSemanticsNodeFlags;
+  }
+  if (node.actions != old.actions ||
+      node.custom_accessibility_actions != old.custom_accessibility_actions) {
+    dirty_fields |= kSemanticsNodeActions;
+  }
+  if (node.text_selection_base != old.text_selection_base ||
+      node.text_selection_extent != old.text_selection_extent) {
+    dirty_fields |= kSemanticsNodeTextSelection;
+  }
+  if (node.scroll_child_count != old.scroll_child_count ||
+      node.scroll_index != old.scroll_index ||
+      node.scroll_position != old.scroll_position ||
+      node.scroll_extent_max != old.scroll_extent_max ||
+      node.scroll_extent_min != old.scroll_extent_min) {
+    dirty_fields |= kSemanticsNodeScroll;
+  }
+  if (node.elevation != old.elevation || node.thickness != old.thickness) {
+    dirty_fields |= kSemanticsNodeElevation;
+  }
+  if (node.label != old.label || node.hint != old.hint ||
+      node.value != old.value || node.increased_value != old.increased_value ||
+      node.decreased_value != old.decreased_value ||
+      node.tooltip != old.tooltip) {
+    dirty_fields |= kSemanticsNodeStrings;
+  }
+  if (node.text_direction != old.text_direction) {
+    dirty_fields |= kSemanticsNodeTextDirection;
+  }
+  if (!RectsEqual(node.rect, old.rect) ||
+      !TransformsEqual(node.transform, old.transform)) {
+    dirty_fields |= kSemanticsNodeLocation;
+  }
+  if (node.children_in_traversal_order != old.children_in_traversal_order) {
+    dirty_fields |= kSemanticsNodeChildren;
+  }
+  return dirty_fields;
+}
+
+void AccessibilityBridge::UpdateLocation(const SemanticsNode& node) {
+  ui::AXNode* ax_node = tree_->GetFromId(node.id);
+  if (!ax_node) {
+    // The node was removed along with an ancestor.
+    return;
+  }
+  // See OnAtomicUpdateFinished.
+  AccessibilityNodeId offset_container_id = -1;
+  if (ax_node->parent()) {
+    offset_container_id = ax_node->parent()->id();
+  }
+  ax_node->SetLocation(offset_container_id, ToRelativeBounds(node.rect),
+                       ToRelativeTransform(node.transform).get());
+  committed_semantics_nodes_[node.id] = node;
+}
+
 AccessibilityBridge::SemanticsNode
 AccessibilityBridge::FromFlutterSemanticsNode(
     const FlutterSemanticsNode2& flutter_node) {
@@ -168,6 +168,22 @@ class AccessibilityBridge
   void RecreateNodeDelegates();
 
  private:
+  // The groups of fields of a SemanticsNode that are tracked for changes, see
+  // SemanticsNode::dirty_fields.
+  enum SemanticsNodeField : uint32_t {
+    kSemanticsNodeFlags = 1 << 0,
+    kSemanticsNodeActions = 1 << 1,
+    kSemanticsNodeTextSelection = 1 << 2,
+    kSemanticsNodeScroll = 1 << 3,
+    kSemanticsNodeElevation = 1 << 4,
+    kSemanticsNodeStrings = 1 << 5,
+    kSemanticsNodeTextDirection = 1 << 6,
+    // The rect and the transform.
+    kSemanticsNodeLocation = 1 << 7,
+    kSemanticsNodeChildren = 1 << 8,
+    kSemanticsNodeAllFields = (1 << 9) - 1,
+  };
+
   // See FlutterSemanticsNode in embedder.h
   typedef struct {
     int32_t id;
@@ -193,6 +209,9 @@ class AccessibilityBridge
     FlutterTransformation transform;
     std::vector<int32_t> children_in_traversal_order;
     std::vector<int32_t> custom_accessibility_actions;
+    // The SemanticsNodeFields that differ from the version of this node that
+    // was last committed to the tree. All fields are dirty for new nodes.
+    uint32_t dirty_fields;
   } SemanticsNode;
 
   // See FlutterSemanticsCustomAction in embedder.h
@@ -211,6 +230,9 @@ class AccessibilityBridge
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
+  // The last committed version of every node in the tree, used to find the
+  // fields that pending updates change.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
 
   void InitAXTree(const ui::AXTreeUpdate& initial_state);
@@ -219,6 +241,14 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
+  // Returns the SemanticsNodeFields of |node| that differ from its last
+  // committed version.
+  uint32_t GetDirtyFields(const SemanticsNode& node) const;
+
+  // Updates the location of the AXNode of |node| in place, for nodes whose
+  // location is the only change.
+  void UpdateLocation(const SemanticsNode& node);
+
   void GetSubTreeList(const SemanticsNode& target,
                       std::vector<SemanticsNode>& result);
   void ConvertFlutterUpdate(const SemanticsNode& node,
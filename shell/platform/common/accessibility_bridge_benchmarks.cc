@@ -0,0 +1,157 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int32_t kItemsPerGroup = 100;
+
+// The semantics of a scrolling list with groups of items. The root is the
+// scrollable, its children are the groups and their children are the items.
+class SemanticsTree {
+ public:
+  explicit SemanticsTree(int32_t group_count) {
+    root_children_.resize(group_count);
+    group_children_.resize(group_count);
+    int32_t next_id = 1;
+    for (int32_t group = 0; group < group_count; group++) {
+      root_children_[group] = next_id++;
+      for (int32_t item = 0; item < kItemsPerGroup; item++) {
+        group_children_[group].push_back(next_id++);
+      }
+    }
+    labels_.resize(next_id);
+    for (int32_t id = 0; id < next_id; id++) {
+      labels_[id] = "Node " + std::to_string(id);
+    }
+  }
+
+  size_t node_count() const { return labels_.size(); }
+
+  // Sends every node to |bridge|, with the items moved by |scroll_offset| and
+  // with |label_suffix| appended to all labels.
+  void AddUpdates(AccessibilityBridge& bridge,
+                  double scroll_offset,
+                  const std::string& label_suffix) {
+    std::vector<std::string> labels(labels_.size());
+    for (size_t id = 0; id < labels_.size(); id++) {
+      labels[id] = labels_[id] + label_suffix;
+    }
+
+    FlutterSemanticsNode2 root = MakeNode(0, labels[0]);
+    root.actions = kFlutterSemanticsActionScrollUp;
+    root.scroll_position = scroll_offset;
+    root.rect = {0, 0, 400, 800};
+    root.child_count = root_children_.size();
+    root.children_in_traversal_order = root_children_.data();
+    bridge.AddFlutterSemanticsNodeUpdate(root);
+
+    for (size_t group = 0; group < root_children_.size(); group++) {
+      const int32_t group_id = root_children_[group];
+      FlutterSemanticsNode2 group_node = MakeNode(group_id, labels[group_id]);
+      group_node.rect = {0, 0, 400, 50.0 * kItemsPerGroup};
+      group_node.transform.transY =
+          50.0 * kItemsPerGroup * group - scroll_offset;
+      group_node.child_count = group_children_[group].size();
+      group_node.children_in_traversal_order = group_children_[group].data();
+      bridge.AddFlutterSemanticsNodeUpdate(group_node);
+
+      for (int32_t item = 0; item < kItemsPerGroup; item++) {
+        const int32_t item_id = group_children_[group][item];
+        FlutterSemanticsNode2 item_node = MakeNode(item_id, labels[item_id]);
+        item_node.rect = {0, 0, 400, 50};
+        item_node.transform.transY = 50.0 * item;
+        bridge.AddFlutterSemanticsNodeUpdate(item_node);
+      }
+    }
+  }
+
+ private:
+  static FlutterSemanticsNode2 MakeNode(int32_t id, const std::string& label) {
+    return {
+        .id = id,
+        .flags = static_cast<FlutterSemanticsFlag>(0),
+        .actions = static_cast<FlutterSemanticsAction>(0),
+        .text_selection_base = -1,
+        .text_selection_extent = -1,
+        .label = label.c_str(),
+        .hint = "",
+        .value = "",
+        .increased_value = "",
+        .decreased_value = "",
+        .transform = {1, 0, 0, 0, 1, 0, 0, 0, 1},
+        .tooltip = "",
+    };
+  }
+
+  std::vector<int32_t> root_children_;
+  std::vector<std::vector<int32_t>> group_children_;
+  std::vector<std::string> labels_;
+};
+
+enum class SemanticsChange {
+  // All nodes are sent again without changes.
+  kNone,
+  // The list scrolls, which moves the groups.
+  kScroll,
+  // The labels of all nodes change.
+  kLabels,
+};
+
+void BM_AccessibilityBridgeCommitUpdates(benchmark::State& state,
+                                         SemanticsChange change) {
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  SemanticsTree tree(state.range(0) / kItemsPerGroup);
+  tree.AddUpdates(*bridge, 0, "");
+  bridge->CommitUpdates();
+
+  int frame = 0;
+  for (auto _ : state) {
+    frame++;
+    state.PauseTiming();
+    bridge->accessibility_events.clear();
+    switch (change) {
+      case SemanticsChange::kNone:
+        tree.AddUpdates(*bridge, 0, "");
+        break;
+      case SemanticsChange::kScroll:
+        tree.AddUpdates(*bridge, frame % 100, "");
+        break;
+      case SemanticsChange::kLabels:
+        tree.AddUpdates(*bridge, 0, frame % 2 ? "!" : "");
+        break;
+    }
+    state.ResumeTiming();
+
+    bridge->CommitUpdates();
+  }
+  state.counters["Nodes"] = tree.node_count();
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_AccessibilityBridgeCommitUpdates,
+                  Unchanged,
+                  SemanticsChange::kNone)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AccessibilityBridgeCommitUpdates,
+                  Scroll,
+                  SemanticsChange::kScroll)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AccessibilityBridgeCommitUpdates,
+                  Labels,
+                  SemanticsChange::kLabels)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter
@@ -577,6 +577,80 @@ TEST(AccessibilityBridgeTest, CanReparentNodeWithChild) {
               Contains(ui::AXEventGenerator::Event::ROLE_CHANGED).Times(1));
 }
 
+TEST(AccessibilityBridgeTest, IgnoresUnchangedNodes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  child2.label = "new child 2";
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(root_node->GetChildCount(), 2);
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+  EXPECT_EQ(child2_node->GetName(), "new child 2");
+  ASSERT_EQ(bridge->accessibility_events.size(), size_t{1});
+  EXPECT_EQ(bridge->accessibility_events[0],
+            ui::AXEventGenerator::Event::NAME_CHANGED);
+}
+
+TEST(AccessibilityBridgeTest, UpdatesLocationOfMovedNodes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  root.rect = {0, 0, 100, 100};
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  child1.rect = {0, 0, 10, 10};
+  child1.transform = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  // Scroll the child.
+  child1.transform.transY = -20;
+  child1.rect = {0, 0, 10, 15};
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  const ui::AXRelativeBounds& bounds = child1_node->GetData().relative_bounds;
+  EXPECT_EQ(bounds.offset_container_id, 0);
+  EXPECT_EQ(bounds.bounds, gfx::RectF(0, 0, 10, 15));
+  ASSERT_TRUE(bounds.transform);
+  EXPECT_EQ(*bounds.transform,
+            gfx::Transform(1, 0, 0, 0, 0, 1, -20, 0, 0, 0, 1, 0, 0, 0, 0, 0));
+  EXPECT_TRUE(bridge->accessibility_events.empty());
+
+  // Moving a node that is removed in the same update is harmless.
+  root.child_count = 0;
+  root.children_in_traversal_order = nullptr;
+  child1.transform.transY = -40;
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->CommitUpdates();
+
+  EXPECT_TRUE(bridge->GetFlutterPlatformNodeDelegateFromID(1).expired());
+}
+
 TEST(AccessibilityBridgeTest, AXTreeManagerTest) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "flutter/shell/platform/common/text_piece_table.h"
 #include "flutter/shell/platform/common/text_range.h"
 
 namespace flutter {
@@ -183,10 +184,16 @@ class TextInputModel {
   bool SelectToEnd();
 
   // Gets the current text as UTF-8.
+  //
+  // The text is converted to UTF-8 once, and later edits are spliced into the
+  // converted text.
   std::string GetText() const;
 
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
+  //
+  // Takes logarithmic time in the number of edits since the text was last set,
+  // rather than linear time in the length of the text.
   int GetCursorOffset() const;
 
   // Returns a range covering the entire text.
@@ -218,7 +225,7 @@ class TextInputModel {
     return composing_ ? composing_range_ : text_range();
   }
 
-  std::u16string text_;
+  TextPieceTable text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
@@ -0,0 +1,385 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_piece_table.h"
+
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/string_conversion.h"
+
+namespace flutter {
+
+namespace {
+
+// Returns the number of bytes that encode |code_unit| in UTF-8.
+//
+// Each half of a surrogate pair counts for two bytes, so that a pair adds up
+// to the four bytes of its code point even if the pair spans two pieces.
+size_t Utf8Length(char16_t code_unit) {
+  if (code_unit < 0x80) {
+    return 1;
+  }
+  if (code_unit < 0x800) {
+    return 2;
+  }
+  if (code_unit >= 0xD800 && code_unit <= 0xDFFF) {
+    return 2;
+  }
+  return 3;
+}
+
+bool IsLeadingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xD800;
+}
+
+bool IsTrailingSurrogate(char16_t code_unit) {
+  return (code_unit & 0xFC00) == 0xDC00;
+}
+
+// Appends the UTF-8 encoding of |length| code units at |data| to |out|.
+//
+// Returns false, leaving |out| partially appended to, if the text contains a
+// surrogate that is not part of a pair.
+bool AppendUtf8(const char16_t* data, size_t length, std::string* out) {
+  for (size_t i = 0; i < length; i++) {
+    uint32_t code_point = data[i];
+    if (IsLeadingSurrogate(data[i]) && i + 1 < length &&
+        IsTrailingSurrogate(data[i + 1])) {
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + data[++i] - 0xDC00;
+    } else if (IsLeadingSurrogate(data[i]) || IsTrailingSurrogate(data[i])) {
+      return false;
+    }
+    if (code_point < 0x80) {
+      out->push_back(code_point);
+    } else if (code_point < 0x800) {
+      out->push_back(0xC0 | (code_point >> 6));
+      out->push_back(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      out->push_back(0xE0 | (code_point >> 12));
+      out->push_back(0x80 | ((code_point >> 6) & 0x3F));
+      out->push_back(0x80 | (code_point & 0x3F));
+    } else {
+      out->push_back(0xF0 | (code_point >> 18));
+      out->push_back(0x80 | ((code_point >> 12) & 0x3F));
+      out->push_back(0x80 | ((code_point >> 6) & 0x3F));
+      out->push_back(0x80 | (code_point & 0x3F));
+    }
+  }
+  return true;
+}
+
+// Appends to |offsets| the UTF-8 offset after each of |length| code units at
+// |data|, continuing from the last offset in |offsets|.
+void AppendUtf8Offsets(const char16_t* data,
+                       size_t length,
+                       std::vector<uint32_t>* offsets) {
+  uint32_t offset = offsets->back();
+  for (size_t i = 0; i < length; i++) {
+    offset += Utf8Length(data[i]);
+    offsets->push_back(offset);
+  }
+}
+
+// Once the inserted text is at least this long, it is compacted as soon as
+// most of it is no longer part of the document.
+constexpr size_t kMinimumAddedLengthToCompact = 1024;
+
+}  // namespace
+
+struct TextPieceTable::Node {
+  // Whether the piece refers to |added_| rather than to |original_|.
+  bool added;
+  size_t start;
+  size_t length;
+  size_t utf8_length;
+
+  uint32_t priority;
+  NodePtr left;
+  NodePtr right;
+
+  // The totals of the pieces in the subtree rooted at this node.
+  size_t subtree_length;
+  size_t subtree_utf8_length;
+  size_t subtree_count;
+
+  void Update() {
+    subtree_length = length;
+    subtree_utf8_length = utf8_length;
+    subtree_count = 1;
+    for (const Node* child : {left.get(), right.get()}) {
+      if (child) {
+        subtree_length += child->subtree_length;
+        subtree_utf8_length += child->subtree_utf8_length;
+        subtree_count += child->subtree_count;
+      }
+    }
+  }
+};
+
+TextPieceTable::TextPieceTable() = default;
+
+TextPieceTable::~TextPieceTable() = default;
+
+void TextPieceTable::SetText(std::u16string text) {
+  utf8_text_.reset();
+  ResetPieces(std::move(text));
+}
+
+void TextPieceTable::ResetPieces(std::u16string text) {
+  root_.reset();
+  // Assigning fresh buffers releases the memory of the old ones.
+  added_ = std::u16string();
+  added_utf8_offsets_ = {0};
+  original_ = std::move(text);
+  original_utf8_offsets_ = {0};
+  original_utf8_offsets_.reserve(original_.length() + 1);
+  AppendUtf8Offsets(original_.data(), original_.length(),
+                    &original_utf8_offsets_);
+  if (!original_.empty()) {
+    root_ = MakeNode(false, 0, original_.length());
+  }
+}
+
+void TextPieceTable::Insert(size_t position, const std::u16string& text) {
+  FML_DCHECK(position <= length());
+  if (text.empty()) {
+    return;
+  }
+  if (utf8_text_) {
+    // Splice the text into the UTF-8 copy, unless that would split a
+    // surrogate pair, which has no UTF-8 encoding.
+    std::string utf8_text;
+    if (!IsInsideSurrogatePair(position) &&
+        AppendUtf8(text.data(), text.length(), &utf8_text)) {
+      utf8_text_->insert(Utf8Offset(position), utf8_text);
+    } else {
+      utf8_text_.reset();
+    }
+  }
+  auto [left, right] = Split(std::move(root_), position);
+
+  const size_t start = added_.length();
+  added_.append(text);
+  AppendUtf8Offsets(text.data(), text.length(), &added_utf8_offsets_);
+
+  // Typing inserts text right after the text inserted last. In that case the
+  // piece of the previous insertion is extended instead of adding a piece for
+  // every keystroke.
+  Node* last = left.get();
+  while (last && last->right) {
+    last = last->right.get();
+  }
+  if (last && last->added && last->start + last->length == start) {
+    const size_t utf8_length = PieceUtf8Length(true, start, text.length());
+    for (Node* node = left.get(); node; node = node->right.get()) {
+      node->subtree_length += text.length();
+      node->subtree_utf8_length += utf8_length;
+    }
+    last->length += text.length();
+    last->utf8_length += utf8_length;
+  } else {
+    left = Merge(std::move(left), MakeNode(true, start, text.length()));
+  }
+  root_ = Merge(std::move(left), std::move(right));
+
+  // Each compaction copies the document once, and is preceded by at least as
+  // many inserted code units as the document is long.
+  if (added_.length() >= kMinimumAddedLengthToCompact &&
+      added_.length() > 2 * this->length()) {
+    ResetPieces(ToString());
+  }
+}
+
+void TextPieceTable::Erase(size_t position, size_t length) {
+  FML_DCHECK(position + length <= this->length());
+  if (length == 0) {
+    return;
+  }
+  if (utf8_text_) {
+    if (!IsInsideSurrogatePair(position) &&
+        !IsInsideSurrogatePair(position + length)) {
+      const size_t start = Utf8Offset(position);
+      utf8_text_->erase(start, Utf8Offset(position + length) - start);
+    } else {
+      utf8_text_.reset();
+    }
+  }
+  auto [left, rest] = Split(std::move(root_), position);
+  auto [erased, right] = Split(std::move(rest), length);
+  root_ = Merge(std::move(left), std::move(right));
+  if (!root_) {
+    ResetPieces(std::u16string());
+  }
+}
+
+void TextPieceTable::Replace(size_t position,
+                             size_t length,
+                             const std::u16string& text) {
+  Erase(position, length);
+  Insert(position, text);
+}
+
+char16_t TextPieceTable::at(size_t position) const {
+  FML_DCHECK(position < length());
+  const Node* node = root_.get();
+  while (node) {
+    const size_t left_length = node->left ? node->left->subtree_length : 0;
+    if (position < left_length) {
+      node = node->left.get();
+    } else if (position < left_length + node->length) {
+      return PieceData(*node)[position - left_length];
+    } else {
+      position -= left_length + node->length;
+      node = node->right.get();
+    }
+  }
+  return 0;
+}
+
+size_t TextPieceTable::length() const {
+  return root_ ? root_->subtree_length : 0;
+}
+
+size_t TextPieceTable::utf8_length() const {
+  return root_ ? root_->subtree_utf8_length : 0;
+}
+
+size_t TextPieceTable::Utf8Offset(size_t position) const {
+  FML_DCHECK(position <= length());
+  size_t offset = 0;
+  const Node* node = root_.get();
+  while (node) {
+    const size_t left_length = node->left ? node->left->subtree_length : 0;
+    const size_t left_utf8_length =
+        node->left ? node->left->subtree_utf8_length : 0;
+    if (position <= left_length) {
+      node = node->left.get();
+    } else if (position < left_length + node->length) {
+      return offset + left_utf8_length +
+             PieceUtf8Length(node->added, node->start, position - left_length);
+    } else {
+      position -= left_length + node->length;
+      offset += left_utf8_length + node->utf8_length;
+      node = node->right.get();
+    }
+  }
+  return offset;
+}
+
+std::u16string TextPieceTable::ToString() const {
+  std::u16string text;
+  text.reserve(length());
+  // An in-order traversal of the pieces.
+  std::vector<const Node*> stack;
+  const Node* node = root_.get();
+  while (node || !stack.empty()) {
+    while (node) {
+      stack.push_back(node);
+      node = node->left.get();
+    }
+    node = stack.back();
+    stack.pop_back();
+    text.append(PieceData(*node), node->length);
+    node = node->right.get();
+  }
+  return text;
+}
+
+const std::string& TextPieceTable::ToUtf8String() const {
+  if (!utf8_text_) {
+    utf8_text_ = fml::Utf16ToUtf8(ToString());
+  }
+  return *utf8_text_;
+}
+
+size_t TextPieceTable::piece_count() const {
+  return root_ ? root_->subtree_count : 0;
+}
+
+std::pair<TextPieceTable::NodePtr, TextPieceTable::NodePtr>
+TextPieceTable::Split(NodePtr node, size_t position) {
+  if (!node) {
+    return {nullptr, nullptr};
+  }
+  const size_t left_length = node->left ? node->left->subtree_length : 0;
+  if (position <= left_length) {
+    auto [left, right] = Split(std::move(node->left), position);
+    node->left = std::move(right);
+    node->Update();
+    return {std::move(left), std::move(node)};
+  }
+  if (position >= left_length + node->length) {
+    auto [left, right] = Split(std::move(node->right),
+                               position - left_length - node->length);
+    node->right = std::move(left);
+    node->Update();
+    return {std::move(node), std::move(right)};
+  }
+
+  // The position is inside the piece of |node|, which is cut in two.
+  const size_t offset = position - left_length;
+  NodePtr tail =
+      MakeNode(node->added, node->start + offset, node->length - offset);
+  node->length = offset;
+  node->utf8_length -= tail->utf8_length;
+  NodePtr right = Merge(std::move(tail), std::move(node->right));
+  node->Update();
+  return {std::move(node), std::move(right)};
+}
+
+TextPieceTable::NodePtr TextPieceTable::Merge(NodePtr left, NodePtr right) {
+  if (!left) {
+    return right;
+  }
+  if (!right) {
+    return left;
+  }
+  if (left->priority > right->priority) {
+    left->right = Merge(std::move(left->right), std::move(right));
+    left->Update();
+    return left;
+  }
+  right->left = Merge(std::move(left), std::move(right->left));
+  right->Update();
+  return right;
+}
+
+TextPieceTable::NodePtr TextPieceTable::MakeNode(bool added,
+                                                 size_t start,
+                                                 size_t length) {
+  // Xorshift, which is plenty random for balancing the tree.
+  random_state_ ^= random_state_ << 13;
+  random_state_ ^= random_state_ >> 17;
+  random_state_ ^= random_state_ << 5;
+
+  auto node = std::make_unique<Node>();
+  node->added = added;
+  node->start = start;
+  node->length = length;
+  node->utf8_length = PieceUtf8Length(added, start, length);
+  node->priority = random_state_;
+  node->Update();
+  return node;
+}
+
+const char16_t* TextPieceTable::PieceData(const Node& node) const {
+  return (node.added ? added_ : original_).data() + node.start;
+}
+
+size_t TextPieceTable::PieceUtf8Length(bool added,
+                                       size_t start,
+                                       size_t length) const {
+  const std::vector<uint32_t>& offsets =
+      added ? added_utf8_offsets_ : original_utf8_offsets_;
+  return offsets[start + length] - offsets[start];
+}
+
+bool TextPieceTable::IsInsideSurrogatePair(size_t position) const {
+  return position > 0 && position < length() &&
+         IsLeadingSurrogate(at(position - 1)) &&
+         IsTrailingSurrogate(at(position));
+}
+
+}  // namespace flutter
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_TEXT_PIECE_TABLE_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_PIECE_TABLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace flutter {
+
+// A UTF-16 text buffer that supports efficient edits of large documents.
+//
+// The text is stored as a piece table: the text the buffer was last reset to
+// and an append-only buffer of all text inserted since are never modified, and
+// the document is a sequence of pieces that each refer to a span of one of
+// them. The pieces are kept in a balanced search tree (a treap) ordered by
+// position, and every subtree caches its length in UTF-16 code units and in
+// UTF-8 bytes. The UTF-8 length of any span of the two buffers is looked up in
+// a table of prefix lengths. Inserting, erasing, reading a code unit and
+// mapping a UTF-16 offset to a UTF-8 offset therefore take O(log n) time in
+// the number of pieces, plus the length of the inserted text.
+//
+// The inserted text is compacted into the original text once most of it has
+// been erased again, which costs amortized constant time per inserted code
+// unit.
+//
+// Positions and lengths are in UTF-16 code units, as in |TextRange|.
+class TextPieceTable {
+ public:
+  TextPieceTable();
+  ~TextPieceTable();
+
+  TextPieceTable(const TextPieceTable&) = delete;
+  TextPieceTable& operator=(const TextPieceTable&) = delete;
+
+  // Replaces the contents of the buffer with |text|.
+  void SetText(std::u16string text);
+
+  // Inserts |text| before the code unit at |position|.
+  void Insert(size_t position, const std::u16string& text);
+
+  // Erases |length| code units starting at |position|.
+  void Erase(size_t position, size_t length);
+
+  // Replaces |length| code units starting at |position| with |text|.
+  void Replace(size_t position, size_t length, const std::u16string& text);
+
+  // Returns the code unit at |position|, which must be less than |length|.
+  char16_t at(size_t position) const;
+
+  // Returns the length of the text in UTF-16 code units.
+  size_t length() const;
+
+  // Returns the length of the text when encoded as UTF-8.
+  size_t utf8_length() const;
+
+  // Returns the number of UTF-8 bytes that encode the text before the code
+  // unit at |position|.
+  size_t Utf8Offset(size_t position) const;
+
+  // Returns the entire text.
+  std::u16string ToString() const;
+
+  // Returns the entire text as UTF-8.
+  //
+  // The text is converted once. Later edits are spliced into the result
+  // rather than converting the text again, which costs a move of the UTF-8
+  // text after the edit. Edits that split a surrogate pair drop the result
+  // instead, since a lone surrogate has no UTF-8 encoding.
+  const std::string& ToUtf8String() const;
+
+  // Returns the number of pieces the text is currently split into.
+  size_t piece_count() const;
+
+ private:
+  struct Node;
+  using NodePtr = std::unique_ptr<Node>;
+
+  // Splits |node| into a tree holding the first |position| code units and a
+  // tree holding the rest, splitting a piece if necessary.
+  std::pair<NodePtr, NodePtr> Split(NodePtr node, size_t position);
+
+  // Concatenates the trees |left| and |right|.
+  static NodePtr Merge(NodePtr left, NodePtr right);
+
+  NodePtr MakeNode(bool added, size_t start, size_t length);
+
+  // Makes |text| the original text of a single piece, discarding the
+  // inserted text.
+  void ResetPieces(std::u16string text);
+
+  const char16_t* PieceData(const Node& node) const;
+
+  size_t PieceUtf8Length(bool added, size_t start, size_t length) const;
+
+  // Whether |position| is between the two halves of a surrogate pair.
+  bool IsInsideSurrogatePair(size_t position) const;
+
+  // The text that the buffer was last reset to.
+  std::u16string original_;
+  // All text inserted since the buffer was last reset.
+  std::u16string added_;
+  // The UTF-8 length of the first i code units of |original_| and |added_|.
+  std::vector<uint32_t> original_utf8_offsets_ = {0};
+  std::vector<uint32_t> added_utf8_offsets_ = {0};
+  NodePtr root_;
+  mutable std::optional<std::string> utf8_text_;
+  uint32_t random_state_ = 0x9E3779B9;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_TEXT_PIECE_TABLE_H_
@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/text_piece_table.h"
+
+#include <algorithm>
+#include <random>
+
+#include "flutter/fml/string_conversion.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+TEST(TextPieceTable, Empty) {
+  TextPieceTable table;
+  EXPECT_EQ(table.length(), 0u);
+  EXPECT_EQ(table.utf8_length(), 0u);
+  EXPECT_EQ(table.Utf8Offset(0), 0u);
+  EXPECT_EQ(table.ToString(), u"");
+  EXPECT_EQ(table.ToUtf8String(), "");
+  EXPECT_EQ(table.piece_count(), 0u);
+}
+
+TEST(TextPieceTable, SetText) {
+  TextPieceTable table;
+  table.SetText(u"ABCDE");
+  EXPECT_EQ(table.length(), 5u);
+  EXPECT_EQ(table.ToString(), u"ABCDE");
+  EXPECT_EQ(table.at(0), u'A');
+  EXPECT_EQ(table.at(4), u'E');
+  EXPECT_EQ(table.piece_count(), 1u);
+
+  table.Insert(2, u"xy");
+  table.SetText(u"Z");
+  EXPECT_EQ(table.ToString(), u"Z");
+  EXPECT_EQ(table.piece_count(), 1u);
+}
+
+TEST(TextPieceTable, Insert) {
+  TextPieceTable table;
+  table.SetText(u"ABCDE");
+  table.Insert(0, u"<");
+  table.Insert(6, u">");
+  table.Insert(3, u"--");
+  EXPECT_EQ(table.ToString(), u"<AB--CDE>");
+  EXPECT_EQ(table.length(), 9u);
+  EXPECT_EQ(table.at(3), u'-');
+  EXPECT_EQ(table.at(8), u'>');
+}
+
+TEST(TextPieceTable, ConsecutiveInsertsShareAPiece) {
+  TextPieceTable table;
+  table.SetText(u"ABCDE");
+  for (char16_t c : std::u16string(u"hello")) {
+    table.Insert(2 + table.length() - 5, std::u16string(1, c));
+  }
+  EXPECT_EQ(table.ToString(), u"ABhelloCDE");
+  EXPECT_EQ(table.piece_count(), 3u);
+}
+
+TEST(TextPieceTable, Erase) {
+  TextPieceTable table;
+  table.SetText(u"ABCDE");
+  table.Insert(5, u"FGH");
+  table.Erase(1, 2);
+  EXPECT_EQ(table.ToString(), u"ADEFGH");
+  table.Erase(2, 3);
+  EXPECT_EQ(table.ToString(), u"ADH");
+  table.Erase(0, 3);
+  EXPECT_EQ(table.ToString(), u"");
+  EXPECT_EQ(table.piece_count(), 0u);
+}
+
+TEST(TextPieceTable, Replace) {
+  TextPieceTable table;
+  table.SetText(u"ABCDE");
+  table.Replace(1, 3, u"xyz!");
+  EXPECT_EQ(table.ToString(), u"Axyz!E");
+}
+
+TEST(TextPieceTable, Utf8Offset) {
+  TextPieceTable table;
+  // 1, 2, 3 and 4 byte characters.
+  table.SetText(u"aé中\U0001F604b");
+  EXPECT_EQ(table.utf8_length(), 11u);
+  EXPECT_EQ(table.Utf8Offset(0), 0u);
+  EXPECT_EQ(table.Utf8Offset(1), 1u);
+  EXPECT_EQ(table.Utf8Offset(2), 3u);
+  EXPECT_EQ(table.Utf8Offset(3), 6u);
+  EXPECT_EQ(table.Utf8Offset(5), 10u);
+  EXPECT_EQ(table.Utf8Offset(6), 11u);
+
+  table.Insert(3, u"\U0001F643");
+  EXPECT_EQ(table.utf8_length(), 15u);
+  EXPECT_EQ(table.Utf8Offset(5), 10u);
+  EXPECT_EQ(table.Utf8Offset(8), 15u);
+}
+
+TEST(TextPieceTable, Utf8StringIsUpdatedByEdits) {
+  TextPieceTable table;
+  table.SetText(u"AB");
+  EXPECT_EQ(table.ToUtf8String(), "AB");
+  table.Insert(1, u"é");
+  EXPECT_EQ(table.ToUtf8String(), "AéB");
+  table.Erase(0, 1);
+  EXPECT_EQ(table.ToUtf8String(), "éB");
+  table.Erase(0, 2);
+  EXPECT_EQ(table.ToUtf8String(), "");
+  table.Insert(0, u"\U0001F604");
+  EXPECT_EQ(table.ToUtf8String(), "\U0001F604");
+}
+
+TEST(TextPieceTable, Utf8StringSurvivesSplitSurrogatePairs) {
+  TextPieceTable table;
+  table.SetText(u"a\U0001F604b");
+  EXPECT_EQ(table.ToUtf8String(), "a\U0001F604b");
+
+  // Typing a pair one half at a time.
+  const std::u16string pair = u"\U0001F643";
+  table.Insert(1, pair.substr(0, 1));
+  table.Insert(2, pair.substr(1, 1));
+  EXPECT_EQ(table.ToUtf8String(), "a\U0001F643\U0001F604b");
+
+  // Erasing a pair one half at a time.
+  table.Erase(4, 1);
+  table.Erase(3, 1);
+  EXPECT_EQ(table.ToUtf8String(), "a\U0001F643b");
+  EXPECT_EQ(table.utf8_length(), 6u);
+}
+
+TEST(TextPieceTable, ErasedInsertionsAreCompacted) {
+  TextPieceTable table;
+  table.SetText(u"ab");
+  EXPECT_EQ(table.ToUtf8String(), "ab");
+  int compactions = 0;
+  for (int i = 0; i < 3000; i++) {
+    table.Insert(1, u"xyz");
+    // Without compaction, the text would be split into three pieces.
+    if (table.piece_count() == 1) {
+      compactions++;
+    }
+    table.Erase(1, 3);
+  }
+  EXPECT_EQ(table.ToString(), u"ab");
+  EXPECT_EQ(table.ToUtf8String(), "ab");
+  // The inserted text is compacted once it reaches 1024 code units.
+  EXPECT_EQ(compactions, 3000 * 3 / 1024);
+}
+
+TEST(TextPieceTable, MatchesStringForRandomEdits) {
+  std::mt19937 random(42);
+  const std::u16string alphabet = u"abé中";
+  std::u16string expected = u"The quick brown fox";
+  TextPieceTable table;
+  table.SetText(expected);
+  // Edits are spliced into the UTF-8 text once it has been requested.
+  table.ToUtf8String();
+
+  for (int i = 0; i < 2000; i++) {
+    const size_t position = random() % (expected.length() + 1);
+    if (random() % 3 == 0 && position < expected.length()) {
+      const size_t length =
+          1 + random() % std::min<size_t>(8, expected.length() - position);
+      expected.erase(position, length);
+      table.Erase(position, length);
+    } else {
+      std::u16string text(1 + random() % 4, alphabet[random() % 4]);
+      expected.insert(position, text);
+      table.Insert(position, text);
+    }
+
+    ASSERT_EQ(table.length(), expected.length());
+    const size_t probe = random() % (expected.length() + 1);
+    ASSERT_EQ(table.Utf8Offset(probe),
+              fml::Utf16ToUtf8(expected.substr(0, probe)).length());
+    if (probe < expected.length()) {
+      ASSERT_EQ(table.at(probe), expected[probe]);
+    }
+    if (i % 100 == 0) {
+      ASSERT_EQ(table.ToUtf8String(), fml::Utf16ToUtf8(expected));
+    }
+  }
+  EXPECT_EQ(table.ToString(), expected);
+  EXPECT_EQ(table.ToUtf8String(), fml::Utf16ToUtf8(expected));
+}
+
+}  // namespace flutter
@@ -154,8 +154,15 @@ static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
 
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  const bool presents_surface =
+      SAFE_EXISTS(software_config, surface_present_callback);
+  const bool acquires_buffers =
+      SAFE_EXISTS(software_config, acquire_buffer_callback);
+  if (acquires_buffers !=
+          SAFE_EXISTS(software_config, present_buffer_callback) ||
+      acquires_buffers !=
+          SAFE_EXISTS(software_config, release_buffer_callback) ||
+      presents_surface == acquires_buffers) {
     return false;
   }
 
@@ -234,7 +241,6 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // FML_OS_LINUX || FML_OS_WIN
 
-#ifdef SHELL_ENABLE_GL
 // Auxiliary function used to translate rectangles of type SkIRect to
 // FlutterRect.
 static FlutterRect SkIRectToFlutterRect(const SkIRect sk_rect) {
@@ -245,6 +251,7 @@ static FlutterRect SkIRectToFlutterRect(const SkIRect sk_rect) {
   return flutter_rect;
 }
 
+#ifdef SHELL_ENABLE_GL
 // Auxiliary function used to translate rectangles of type FlutterRect to
 // SkIRect.
 static const SkIRect FlutterRectToSkIRect(FlutterRect flutter_rect) {
@@ -642,16 +649,80 @@ InferSoftwarePlatformViewCreationCallback(
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
-
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
-      software_dispatch_table = {
-          software_present_backing_store,  // required
+      software_dispatch_table;
+
+  if (auto surface_present_callback =
+          SAFE_ACCESS(software_config, surface_present_callback, nullptr)) {
+    software_dispatch_table.software_present_backing_store =
+        [surface_present_callback, user_data](
+            const void* allocation, size_t row_bytes, size_t height) -> bool {
+      return surface_present_callback(user_data, allocation, row_bytes, height);
+    };
+  } else {
+    using SoftwareBuffer = flutter::EmbedderSurfaceSoftware::SoftwareBuffer;
+    using SoftwareBufferPresentInfo =
+        flutter::EmbedderSurfaceSoftware::SoftwareBufferPresentInfo;
+
+    software_dispatch_table.software_acquire_buffer =
+        [acquire_buffer_callback = software_config->acquire_buffer_callback,
+         user_data](const SkISize& size) -> std::optional<SoftwareBuffer> {
+      FlutterFrameInfo frame_info = {};
+      frame_info.struct_size = sizeof(FlutterFrameInfo);
+      frame_info.size = {static_cast<uint32_t>(size.width()),
+                         static_cast<uint32_t>(size.height())};
+      FlutterSoftwareBuffer buffer = {};
+      buffer.struct_size = sizeof(FlutterSoftwareBuffer);
+      if (!acquire_buffer_callback(user_data, &frame_info, &buffer) ||
+          buffer.allocation == nullptr) {
+        return std::nullopt;
+      }
+      const auto color_info = getSkColorInfo(buffer.pixel_format);
+      if (!color_info) {
+        return std::nullopt;
+      }
+      return SoftwareBuffer{
+          .id = buffer.buffer_id,
+          .allocation = buffer.allocation,
+          .row_bytes = buffer.row_bytes,
+          .color_info = *color_info,
       };
+    };
+
+    software_dispatch_table.software_present_buffer =
+        [present_buffer_callback = software_config->present_buffer_callback,
+         user_data](const SoftwareBufferPresentInfo& software_present_info) {
+      // The damage is computed as a single rectangle. See the OpenGL present
+      // callback above.
+      FlutterRect frame_damage_rect =
+          SkIRectToFlutterRect(software_present_info.frame_damage);
+      FlutterRect buffer_damage_rect =
+          SkIRectToFlutterRect(software_present_info.buffer_damage);
+
+      FlutterSoftwarePresentInfo present_info = {
+          .struct_size = sizeof(FlutterSoftwarePresentInfo),
+          .buffer_id = software_present_info.id,
+          .frame_damage =
+              {
+                  .struct_size = sizeof(FlutterDamage),
+                  .num_rects = 1,
+                  .damage = &frame_damage_rect,
+              },
+          .buffer_damage =
+              {
+                  .struct_size = sizeof(FlutterDamage),
+                  .num_rects = 1,
+                  .damage = &buffer_damage_rect,
+              },
+      };
+      return present_buffer_callback(user_data, &present_info);
+    };
+
+    software_dispatch_table.software_release_buffer =
+        [release_buffer_callback = software_config->release_buffer_callback,
+         user_data](intptr_t id) { release_buffer_callback(user_data, id); };
+  }
 
   return fml::MakeCopyable(
       [software_dispatch_table, platform_dispatch_table,
@@ -1398,7 +1469,8 @@ void PopulateAOTSnapshotMappingCallbacks(
 
 // Translates engine semantic nodes to embedder semantic nodes.
 FlutterSemanticsNode CreateEmbedderSemanticsNode(
-    const flutter::SemanticsNode& node) {
+    const flutter::PackedSemanticsUpdate& update,
+    const flutter::PackedSemanticsNode& node) {
   SkMatrix transform = node.transform.asM33();
   FlutterTransformation flutter_transform{
       transform.get(SkMatrix::kMScaleX), transform.get(SkMatrix::kMSkewX),
@@ -1424,28 +1496,29 @@ FlutterSemanticsNode CreateEmbedderSemanticsNode(
       node.scrollExtentMin,
       node.elevation,
       node.thickness,
-      node.label.c_str(),
-      node.hint.c_str(),
-      node.value.c_str(),
-      node.increasedValue.c_str(),
-      node.decreasedValue.c_str(),
+      update.GetString(node.label),
+      update.GetString(node.hint),
+      update.GetString(node.value),
+      update.GetString(node.increasedValue),
+      update.GetString(node.decreasedValue),
       static_cast<FlutterTextDirection>(node.textDirection),
       FlutterRect{node.rect.fLeft, node.rect.fTop, node.rect.fRight,
                   node.rect.fBottom},
       flutter_transform,
-      node.childrenInTraversalOrder.size(),
-      node.childrenInTraversalOrder.data(),
-      node.childrenInHitTestOrder.data(),
-      node.customAccessibilityActions.size(),
-      node.customAccessibilityActions.data(),
+      node.childrenInTraversalOrder.count,
+      update.GetInt32s(node.childrenInTraversalOrder),
+      update.GetInt32s(node.childrenInHitTestOrder),
+      node.customAccessibilityActions.count,
+      update.GetInt32s(node.customAccessibilityActions),
       node.platformViewId,
-      node.tooltip.c_str(),
+      update.GetString(node.tooltip),
   };
 }
 
 // Translates engine semantic nodes to embedder semantic nodes.
 FlutterSemanticsNode2 CreateEmbedderSemanticsNode2(
-    const flutter::SemanticsNode& node) {
+    const flutter::PackedSemanticsUpdate& update,
+    const flutter::PackedSemanticsNode& node) {
   SkMatrix transform = node.transform.asM33();
   FlutterTransformation flutter_transform{
       transform.get(SkMatrix::kMScaleX), transform.get(SkMatrix::kMSkewX),
@@ -1467,22 +1540,22 @@ FlutterSemanticsNode2 CreateEmbedderSemanticsNode2(
       node.scrollExtentMin,
       node.elevation,
       node.thickness,
-      node.label.c_str(),
-      node.hint.c_str(),
-      node.value.c_str(),
-      node.increasedValue.c_str(),
-      node.decreasedValue.c_str(),
+      update.GetString(node.label),
+      update.GetString(node.hint),
+      update.GetString(node.value),
+      update.GetString(node.increasedValue),
+      update.GetString(node.decreasedValue),
       static_cast<FlutterTextDirection>(node.textDirection),
       FlutterRect{node.rect.fLeft, node.rect.fTop, node.rect.fRight,
                   node.rect.fBottom},
       flutter_transform,
-      node.childrenInTraversalOrder.size(),
-      node.childrenInTraversalOrder.data(),
-      node.childrenInHitTestOrder.data(),
-      node.customAccessibilityActions.size(),
-      node.customAccessibilityActions.data(),
+      node.childrenInTraversalOrder.count,
+      update.GetInt32s(node.childrenInTraversalOrder),
+      update.GetInt32s(node.childrenInHitTestOrder),
+      node.customAccessibilityActions.count,
+      update.GetInt32s(node.customAccessibilityActions),
       node.platformViewId,
-      node.tooltip.c_str(),
+      update.GetString(node.tooltip),
   };
 }
 
@@ -1522,11 +1595,11 @@ CreateNewEmbedderSemanticsUpdateCallback(
     FlutterUpdateSemanticsCallback update_semantics_callback,
     void* user_data) {
   return [update_semantics_callback, user_data](
-             const flutter::SemanticsNodeUpdates& nodes,
+             const flutter::PackedSemanticsUpdate& nodes,
              const flutter::CustomAccessibilityActionUpdates& actions) {
     std::vector<FlutterSemanticsNode> embedder_nodes;
-    for (const auto& value : nodes) {
-      embedder_nodes.push_back(CreateEmbedderSemanticsNode(value.second));
+    for (const auto& node : nodes.nodes()) {
+      embedder_nodes.push_back(CreateEmbedderSemanticsNode(nodes, node));
     }
 
     std::vector<FlutterSemanticsCustomAction> embedder_custom_actions;
@@ -1554,7 +1627,7 @@ CreateNewEmbedderSemanticsUpdateCallback2(
     FlutterUpdateSemanticsCallback2 update_semantics_callback,
     void* user_data) {
   return [update_semantics_callback, user_data](
-             const flutter::SemanticsNodeUpdates& nodes,
+             const flutter::PackedSemanticsUpdate& nodes,
              const flutter::CustomAccessibilityActionUpdates& actions) {
     std::vector<FlutterSemanticsNode2> embedder_nodes;
     std::vector<FlutterSemanticsCustomAction2> embedder_custom_actions;
@@ -1562,8 +1635,8 @@ CreateNewEmbedderSemanticsUpdateCallback2(
     embedder_nodes.reserve(nodes.size());
     embedder_custom_actions.reserve(actions.size());
 
-    for (const auto& value : nodes) {
-      embedder_nodes.push_back(CreateEmbedderSemanticsNode2(value.second));
+    for (const auto& node : nodes.nodes()) {
+      embedder_nodes.push_back(CreateEmbedderSemanticsNode2(nodes, node));
     }
 
     for (const auto& value : actions) {
@@ -1610,13 +1683,13 @@ CreateLegacyEmbedderSemanticsUpdateCallback(
     void* user_data) {
   return [update_semantics_node_callback,
           update_semantics_custom_action_callback,
-          user_data](const flutter::SemanticsNodeUpdates& nodes,
+          user_data](const flutter::PackedSemanticsUpdate& nodes,
                      const flutter::CustomAccessibilityActionUpdates& actions) {
     // First, queue all node and custom action updates.
     if (update_semantics_node_callback != nullptr) {
-      for (const auto& value : nodes) {
+      for (const auto& node : nodes.nodes()) {
         const FlutterSemanticsNode embedder_node =
-            CreateEmbedderSemanticsNode(value.second);
+            CreateEmbedderSemanticsNode(nodes, node);
         update_semantics_node_callback(&embedder_node, user_data);
       }
     }
@@ -3199,6 +3272,51 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineGetFrameLatencyStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameLatencyStatistics* statistics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (statistics == nullptr || !STRUCT_HAS_MEMBER(statistics, frame_count)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame latency statistics specified.");
+  }
+
+  const auto result = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                          ->GetShell()
+                          .GetFrameLatencyStatistics(reset);
+
+  using Phase = flutter::FrameLatencyAggregator::Phase;
+  auto convert = [&result](Phase phase) {
+    const auto& percentiles = result.Get(phase);
+    FlutterFrameLatencyPercentiles converted = {};
+    converted.p50 = percentiles.p50;
+    converted.p90 = percentiles.p90;
+    converted.p99 = percentiles.p99;
+    converted.p999 = percentiles.p999;
+    converted.max = percentiles.max;
+    return converted;
+  };
+
+  statistics->frame_count = result.frame_count;
+  if (STRUCT_HAS_MEMBER(statistics, vsync_overhead)) {
+    statistics->vsync_overhead = convert(Phase::kVsyncOverhead);
+  }
+  if (STRUCT_HAS_MEMBER(statistics, build)) {
+    statistics->build = convert(Phase::kBuild);
+  }
+  if (STRUCT_HAS_MEMBER(statistics, raster)) {
+    statistics->raster = convert(Phase::kRaster);
+  }
+  if (STRUCT_HAS_MEMBER(statistics, total)) {
+    statistics->total = convert(Phase::kTotal);
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3251,6 +3369,7 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(GetFrameLatencyStatistics, FlutterEngineGetFrameLatencyStatistics);
 #undef SET_PROC
 
   return kSuccess;
@@ -789,6 +789,62 @@ typedef struct {
 
 } FlutterVulkanRendererConfig;
 
+/// A buffer owned by the embedder that the engine renders a frame into.
+///
+/// See: \ref FlutterSoftwareRendererConfig.acquire_buffer_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwareBuffer).
+  size_t struct_size;
+  /// Identifies the buffer among the buffers the embedder hands out. The
+  /// engine keeps track of what changed in each buffer since it was last
+  /// presented so that it only repaints those parts. The contents of a buffer
+  /// must be retained between frames. If they are not, for example because
+  /// the buffer was reallocated, the buffer must be given a new identifier.
+  intptr_t buffer_id;
+  /// A pointer to the pixels of the buffer. It must remain valid until the
+  /// buffer is presented.
+  void* allocation;
+  /// The number of bytes in a single row of the buffer.
+  size_t row_bytes;
+  /// The pixel format of the buffer.
+  FlutterSoftwarePixelFormat pixel_format;
+} FlutterSoftwareBuffer;
+
+/// Callback for when the engine needs a buffer to render the next frame into.
+/// The embedder populates the buffer and returns true, or returns false if no
+/// buffer is available.
+typedef bool (*FlutterSoftwareBufferCallback)(
+    void* /* user data */,
+    const FlutterFrameInfo* /* frame info */,
+    FlutterSoftwareBuffer* /* buffer out */);
+
+/// This information is passed to the embedder when a software buffer is
+/// presented.
+///
+/// See: \ref FlutterSoftwareRendererConfig.present_buffer_callback.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSoftwarePresentInfo).
+  size_t struct_size;
+  /// The identifier of the buffer that was rendered into.
+  intptr_t buffer_id;
+  /// The area that changed since the previous frame. This is the only area
+  /// that the embedder needs to copy or scan out.
+  FlutterDamage frame_damage;
+  /// The area of the buffer that was rendered into for this frame.
+  FlutterDamage buffer_damage;
+} FlutterSoftwarePresentInfo;
+
+/// Callback for when a software buffer is presented.
+typedef bool (*FlutterSoftwareBufferPresentCallback)(
+    void* /* user data */,
+    const FlutterSoftwarePresentInfo* /* present info */);
+
+/// Callback for when the engine gives back a software buffer without
+/// presenting it.
+typedef void (*FlutterSoftwareBufferReleaseCallback)(
+    void* /* user data */,
+    intptr_t /* buffer id */);
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
   size_t struct_size;
@@ -796,7 +852,30 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Specifying one (and only one) of `surface_present_callback` or all of
+  /// `acquire_buffer_callback`, `present_buffer_callback` and
+  /// `release_buffer_callback` is required.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The callback invoked when the engine needs a buffer to render the next
+  /// frame into. The embedder typically hands out the buffers of a small pool
+  /// in turn. The engine renders directly into the buffer, and only repaints
+  /// the parts of it that changed since it was last presented.
+  /// Not used if a FlutterCompositor is supplied in FlutterProjectArgs.
+  FlutterSoftwareBufferCallback acquire_buffer_callback;
+  /// The callback invoked when a frame has been rendered into a buffer
+  /// obtained from `acquire_buffer_callback`. The present info describes the
+  /// area that changed since the previous frame. The buffer is not accessed
+  /// by the engine after this callback returns until it is acquired again.
+  /// Not used if a FlutterCompositor is supplied in FlutterProjectArgs.
+  FlutterSoftwareBufferPresentCallback present_buffer_callback;
+  /// The callback invoked when a buffer obtained from
+  /// `acquire_buffer_callback` will not be presented, for example because
+  /// the frame was dropped or the engine is shutting down. The buffer is not
+  /// accessed by the engine after this callback returns until it is acquired
+  /// again. Its contents may have been partially rendered into.
+  /// Not used if a FlutterCompositor is supplied in FlutterProjectArgs.
+  FlutterSoftwareBufferReleaseCallback release_buffer_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1703,6 +1782,32 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// Latency percentiles, in microseconds, of one phase of frame production.
+/// Values are accurate to within about 6%.
+typedef struct {
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t p999;
+  /// The largest latency recorded.
+  uint64_t max;
+} FlutterFrameLatencyPercentiles;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameLatencyStatistics).
+  size_t struct_size;
+  /// The number of frames the percentiles below were computed over.
+  uint64_t frame_count;
+  /// From the vsync signal to the start of the frame build on the UI thread.
+  FlutterFrameLatencyPercentiles vsync_overhead;
+  /// From the start to the end of the frame build on the UI thread.
+  FlutterFrameLatencyPercentiles build;
+  /// From the start to the end of rasterization on the raster thread.
+  FlutterFrameLatencyPercentiles raster;
+  /// From the vsync signal to the end of rasterization.
+  FlutterFrameLatencyPercentiles total;
+} FlutterFrameLatencyStatistics;
+
 typedef int64_t FlutterEngineDartPort;
 
 typedef enum {
@@ -2806,6 +2911,26 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the latency percentiles of the frames rendered since the
+///             engine was started or since the last call to this method with
+///             `reset` set. The engine keeps fixed size histograms, so this is
+///             suitable for monitoring tail latencies over long sessions. This
+///             may be called on any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[in]  reset       Whether to clear the histograms after reading them.
+/// @param[out] statistics  The statistics to fill in. The `struct_size` field
+///                         must be set by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameLatencyStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameLatencyStatistics* statistics);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2928,6 +3053,10 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetFrameLatencyStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameLatencyStatistics* statistics);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2974,6 +3103,7 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineGetFrameLatencyStatisticsFnPtr GetFrameLatencyStatistics;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
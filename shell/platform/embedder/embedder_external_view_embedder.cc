@@ -130,9 +130,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   auto [matched_render_targets, pending_keys] =
       render_target_cache_.GetExistingTargetsInCache(pending_views_);
 
-  // This is where unused render targets will be collected. Control may flow to
-  // the embedder. Here, the embedder has the opportunity to trample on the
-  // OpenGL context.
+  // This is where render targets that have been unused for a few frames will
+  // be collected. Control may flow to the embedder. Here, the embedder has the
+  // opportunity to trample on the OpenGL context.
   //
   // For optimum performance, we should tell the render target cache to clear
   // its unused entries before allocating new ones. This collection step before
@@ -143,7 +143,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.CollectIdleRenderTargets();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -254,8 +254,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // @warning: Embedder may trample on our OpenGL context here.
   deferred_cleanup_render_targets.clear();
 
-  // Hold all rendered layers in the render target cache for one frame to
-  // see if they may be reused next frame.
+  // Hold all rendered layers in the render target cache to see if they may be
+  // reused in the next frames.
   for (auto& render_target : matched_render_targets) {
     if (!avoid_backing_store_cache_) {
       render_target_cache_.CacheRenderTarget(render_target.first,
@@ -4,9 +4,15 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+#include <iterator>
+
+#include "flutter/fml/trace_event.h"
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t max_idle_frames)
+    : max_idle_frames_(max_idle_frames) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -17,33 +23,104 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
+  // Views first take back their own render targets, so that a view that
+  // falls back to the render target of another view doesn't steal it from
+  // that view.
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.empty()) {
+    auto target =
+        TakeRenderTarget(external_view->CreateRenderTargetDescriptor(),
+                         /*match_any_view=*/false);
+    if (target) {
+      resolved_render_targets[view.first] = std::move(target);
+    } else {
       unmatched_identifiers.insert(view.first);
+    }
+  }
+
+  for (auto it = unmatched_identifiers.begin();
+       it != unmatched_identifiers.end();) {
+    auto target = TakeRenderTarget(
+        pending_views.at(*it)->CreateRenderTargetDescriptor(),
+        /*match_any_view=*/true);
+    if (target) {
+      resolved_render_targets[*it] = std::move(target);
+      it = unmatched_identifiers.erase(it);
     } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+      ++it;
     }
   }
+
+  metrics_.reused_count += resolved_render_targets.size();
+  metrics_.missed_count += unmatched_identifiers.size();
   return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
 }
 
+std::unique_ptr<EmbedderRenderTarget>
+EmbedderRenderTargetCache::TakeRenderTarget(
+    const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+    bool match_any_view) {
+  auto found = cached_render_targets_.find(descriptor.surface_size);
+  if (found == cached_render_targets_.end()) {
+    return nullptr;
+  }
+  auto& targets = found->second;
+  // Prefer the most recently cached render targets.
+  auto match = std::find_if(
+      targets.rbegin(), targets.rend(), [&](const CachedRenderTarget& cached) {
+        return EmbedderExternalView::ViewIdentifier::Equal{}(
+            cached.view_identifier, descriptor.view_identifier);
+      });
+  if (match == targets.rend()) {
+    if (!match_any_view || targets.empty()) {
+      return nullptr;
+    }
+    match = targets.rbegin();
+  }
+  auto target = std::move(match->target);
+  targets.erase(std::next(match).base());
+  if (targets.empty()) {
+    cached_render_targets_.erase(found);
+  }
+  return target;
+}
+
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::CollectIdleRenderTargets() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> collected_targets;
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    auto& targets = it->second;
+    for (auto& cached : targets) {
+      if (++cached.idle_frames > max_idle_frames_) {
+        collected_targets.emplace(std::move(cached.target));
+      }
+    }
+    targets.erase(std::remove_if(targets.begin(), targets.end(),
+                                 [](const CachedRenderTarget& cached) {
+                                   return cached.target == nullptr;
+                                 }),
+                  targets.end());
+    if (targets.empty()) {
+      it = cached_render_targets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  metrics_.evicted_count += collected_targets.size();
+  TraceMetricsToTimeline();
+  return collected_targets;
+}
+
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
   for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
+    for (auto& cached : targets.second) {
+      cleared_targets.emplace(std::move(cached.target));
     }
   }
   cached_render_targets_.clear();
@@ -56,9 +133,9 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   if (target == nullptr) {
     return;
   }
-  auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, target->GetRenderTargetSize()};
-  cached_render_targets_[desc].push(std::move(target));
+  auto size = target->GetRenderTargetSize();
+  cached_render_targets_[size].push_back(
+      {view_identifier, std::move(target), 0});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
@@ -69,4 +146,21 @@ size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
   return count;
 }
 
+const EmbedderRenderTargetCache::Metrics&
+EmbedderRenderTargetCache::GetMetrics() const {
+  return metrics_;
+}
+
+void EmbedderRenderTargetCache::TraceMetricsToTimeline() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter",                                          //
+                    "EmbedderRenderTargetCache",                        //
+                    reinterpret_cast<int64_t>(this),                    //
+                    "CachedCount", GetCachedTargetsCount(),             //
+                    "ReusedCount", metrics_.reused_count,               //
+                    "MissedCount", metrics_.missed_count,               //
+                    "EvictedCount", metrics_.evicted_count);
+#endif  // !FLUTTER_RELEASE
+}
+
 }  // namespace flutter
@@ -6,10 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 
@@ -19,9 +20,30 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets are pooled by size. A view is preferably given
+///             back the render target it rendered into last, but may take
+///             the render target of any other view of the same size, so that
+///             overlays that come and go reuse backing stores. Render
+///             targets that are not used for a number of frames are
+///             collected.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  /// The number of frames a render target is kept around unused by default.
+  static constexpr size_t kDefaultMaxIdleFrames = 3;
+
+  struct Metrics {
+    /// The number of times a cached render target was reused.
+    size_t reused_count = 0;
+    /// The number of times a view needed a render target that the cache did
+    /// not have.
+    size_t missed_count = 0;
+    /// The number of render targets that were collected after being idle.
+    size_t evicted_count = 0;
+  };
+
+  explicit EmbedderRenderTargetCache(
+      size_t max_idle_frames = kDefaultMaxIdleFrames);
 
   ~EmbedderRenderTargetCache();
 
@@ -35,6 +57,32 @@ class EmbedderRenderTargetCache {
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes a cached render target matching the descriptor. A
+  ///             render target last used by the same view is preferred.
+  ///
+  /// @param[in]  descriptor          The view and size to match.
+  /// @param[in]  match_any_view      Whether a render target last used by
+  ///                                 another view of the same size may be
+  ///                                 returned.
+  ///
+  /// @return     The render target, or null if none matched.
+  ///
+  std::unique_ptr<EmbedderRenderTarget> TakeRenderTarget(
+      const EmbedderExternalView::RenderTargetDescriptor& descriptor,
+      bool match_any_view);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ages the render targets that were not used this frame and
+  ///             removes the ones that have been idle for longer than the
+  ///             maximum number of idle frames. Call once per frame, after
+  ///             the render targets for the frame have been taken.
+  ///
+  /// @return     The removed render targets. The embedder is notified of
+  ///             their collection when they are destroyed.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> CollectIdleRenderTargets();
+
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
@@ -43,14 +91,29 @@ class EmbedderRenderTargetCache {
 
   size_t GetCachedTargetsCount() const;
 
+  const Metrics& GetMetrics() const;
+
  private:
+  struct CachedRenderTarget {
+    EmbedderExternalView::ViewIdentifier view_identifier;
+    std::unique_ptr<EmbedderRenderTarget> target;
+    size_t idle_frames = 0;
+  };
+
+  struct SizeHash {
+    std::size_t operator()(const SkISize& size) const {
+      return fml::HashCombine(size.width(), size.height());
+    }
+  };
+
   using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+      std::unordered_map<SkISize, std::vector<CachedRenderTarget>, SizeHash>;
 
+  const size_t max_idle_frames_;
   CachedRenderTargets cached_render_targets_;
+  Metrics metrics_;
+
+  void TraceMetricsToTimeline() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
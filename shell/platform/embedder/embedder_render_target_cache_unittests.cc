@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+
+#include "flutter/testing/testing.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+class TestRenderTarget : public EmbedderRenderTarget {
+ public:
+  TestRenderTarget(SkISize size, size_t* collected_count)
+      : EmbedderRenderTarget({}, [collected_count]() { (*collected_count)++; }),
+        size_(size) {}
+
+  // |EmbedderRenderTarget|
+  sk_sp<SkSurface> GetSkiaSurface() const override { return nullptr; }
+
+  // |EmbedderRenderTarget|
+  impeller::RenderTarget* GetImpellerRenderTarget() const override {
+    return nullptr;
+  }
+
+  // |EmbedderRenderTarget|
+  std::shared_ptr<impeller::AiksContext> GetAiksContext() const override {
+    return nullptr;
+  }
+
+  // |EmbedderRenderTarget|
+  SkISize GetRenderTargetSize() const override { return size_; }
+
+ private:
+  const SkISize size_;
+};
+
+using ViewIdentifier = EmbedderExternalView::ViewIdentifier;
+using RenderTargetDescriptor = EmbedderExternalView::RenderTargetDescriptor;
+
+}  // namespace
+
+TEST(EmbedderRenderTargetCacheTest, PrefersRenderTargetOfSameView) {
+  EmbedderRenderTargetCache cache;
+  size_t collected_count = 0;
+  const auto size = SkISize::Make(100, 100);
+  auto first = std::make_unique<TestRenderTarget>(size, &collected_count);
+  auto second = std::make_unique<TestRenderTarget>(size, &collected_count);
+  auto* first_ptr = first.get();
+  cache.CacheRenderTarget(ViewIdentifier(1), std::move(first));
+  cache.CacheRenderTarget(ViewIdentifier(2), std::move(second));
+
+  auto target = cache.TakeRenderTarget(
+      RenderTargetDescriptor(ViewIdentifier(1), size),
+      /*match_any_view=*/true);
+  EXPECT_EQ(target.get(), first_ptr);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, FallsBackToRenderTargetOfOtherView) {
+  EmbedderRenderTargetCache cache;
+  size_t collected_count = 0;
+  const auto size = SkISize::Make(100, 100);
+  cache.CacheRenderTarget(
+      ViewIdentifier(1),
+      std::make_unique<TestRenderTarget>(size, &collected_count));
+
+  const auto descriptor = RenderTargetDescriptor(ViewIdentifier(2), size);
+  EXPECT_EQ(cache.TakeRenderTarget(descriptor, /*match_any_view=*/false),
+            nullptr);
+  EXPECT_NE(cache.TakeRenderTarget(descriptor, /*match_any_view=*/true),
+            nullptr);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, DoesNotMatchOtherSizes) {
+  EmbedderRenderTargetCache cache;
+  size_t collected_count = 0;
+  cache.CacheRenderTarget(ViewIdentifier(1),
+                          std::make_unique<TestRenderTarget>(
+                              SkISize::Make(100, 100), &collected_count));
+
+  const auto descriptor =
+      RenderTargetDescriptor(ViewIdentifier(1), SkISize::Make(100, 101));
+  EXPECT_EQ(cache.TakeRenderTarget(descriptor, /*match_any_view=*/true),
+            nullptr);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, CollectsRenderTargetsAfterIdleFrames) {
+  EmbedderRenderTargetCache cache(/*max_idle_frames=*/2);
+  size_t collected_count = 0;
+  cache.CacheRenderTarget(ViewIdentifier(1),
+                          std::make_unique<TestRenderTarget>(
+                              SkISize::Make(100, 100), &collected_count));
+
+  EXPECT_TRUE(cache.CollectIdleRenderTargets().empty());
+  EXPECT_TRUE(cache.CollectIdleRenderTargets().empty());
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 1u);
+
+  auto collected = cache.CollectIdleRenderTargets();
+  EXPECT_EQ(collected.size(), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(collected_count, 0u);
+  collected.clear();
+  EXPECT_EQ(collected_count, 1u);
+  EXPECT_EQ(cache.GetMetrics().evicted_count, 1u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, ReusedRenderTargetsAreNoLongerIdle) {
+  EmbedderRenderTargetCache cache(/*max_idle_frames=*/1);
+  size_t collected_count = 0;
+  const auto size = SkISize::Make(100, 100);
+  const auto descriptor = RenderTargetDescriptor(ViewIdentifier(1), size);
+  cache.CacheRenderTarget(
+      ViewIdentifier(1),
+      std::make_unique<TestRenderTarget>(size, &collected_count));
+
+  for (int frame = 0; frame < 5; frame++) {
+    auto target = cache.TakeRenderTarget(descriptor, /*match_any_view=*/true);
+    ASSERT_NE(target, nullptr);
+    EXPECT_TRUE(cache.CollectIdleRenderTargets().empty());
+    cache.CacheRenderTarget(ViewIdentifier(1), std::move(target));
+  }
+  EXPECT_EQ(collected_count, 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, ZeroIdleFramesCollectsUnusedTargets) {
+  EmbedderRenderTargetCache cache(/*max_idle_frames=*/0);
+  size_t collected_count = 0;
+  cache.CacheRenderTarget(ViewIdentifier(1),
+                          std::make_unique<TestRenderTarget>(
+                              SkISize::Make(100, 100), &collected_count));
+  EXPECT_EQ(cache.CollectIdleRenderTargets().size(), 1u);
+  EXPECT_EQ(collected_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
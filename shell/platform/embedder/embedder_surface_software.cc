@@ -20,13 +20,21 @@ EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : software_dispatch_table_(std::move(software_dispatch_table)),
       external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  const auto& table = software_dispatch_table_;
+  const bool presents_backing_store =
+      static_cast<bool>(table.software_present_backing_store);
+  const bool presents_buffers = table.software_acquire_buffer &&
+                                table.software_present_buffer &&
+                                table.software_release_buffer;
+  if (presents_backing_store == presents_buffers) {
     return;
   }
   valid_ = true;
 }
 
-EmbedderSurfaceSoftware::~EmbedderSurfaceSoftware() = default;
+EmbedderSurfaceSoftware::~EmbedderSurfaceSoftware() {
+  ReleaseEmbedderBuffer();
+}
 
 // |EmbedderSurface|
 bool EmbedderSurfaceSoftware::IsValid() const {
@@ -63,6 +71,10 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
     return nullptr;
   }
 
+  if (UsesEmbedderBuffers()) {
+    return AcquireEmbedderBuffer(size);
+  }
+
   if (sk_surface_ != nullptr &&
       SkISize::Make(sk_surface_->width(), sk_surface_->height()) == size) {
     // The old and new surface sizes are the same. Nothing to do here.
@@ -112,4 +124,137 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
   );
 }
 
+// |GPUSurfaceSoftwareDelegate|
+SurfaceFrame::FramebufferInfo
+EmbedderSurfaceSoftware::GetBackingStoreFramebufferInfo() const {
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  if (!buffer_id_.has_value()) {
+    return framebuffer_info;
+  }
+
+  // Embedder buffers keep their contents, so only the parts that changed
+  // since the buffer was last presented need to be painted again. Buffers
+  // that were not presented at this size yet are painted in full. Their
+  // existing damage is still specified so that the frame damage reported to
+  // the embedder is the difference to the previous frame.
+  framebuffer_info.supports_partial_repaint = true;
+  auto found = buffer_damage_.find(buffer_id_.value());
+  if (found != buffer_damage_.end()) {
+    framebuffer_info.existing_damage = found->second;
+  } else {
+    framebuffer_info.existing_damage = SkIRect::MakeSize(buffer_damage_size_);
+  }
+  return framebuffer_info;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithInfo(
+    sk_sp<SkSurface> backing_store,
+    const SurfaceFrame::SubmitInfo& submit_info) {
+  if (!UsesEmbedderBuffers()) {
+    return PresentBackingStore(std::move(backing_store));
+  }
+
+  if (!IsValid() || !buffer_id_.has_value() || backing_store != sk_surface_) {
+    FML_LOG(ERROR) << "Tried to present an invalid software buffer.";
+    return false;
+  }
+
+  return PresentEmbedderBuffer(
+      SkISize::Make(backing_store->width(), backing_store->height()),
+      submit_info);
+}
+
+bool EmbedderSurfaceSoftware::UsesEmbedderBuffers() const {
+  return static_cast<bool>(software_dispatch_table_.software_acquire_buffer);
+}
+
+sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireEmbedderBuffer(
+    const SkISize& size) {
+  // The previous buffer should have been presented or discarded already.
+  ReleaseEmbedderBuffer();
+
+  auto buffer = software_dispatch_table_.software_acquire_buffer(size);
+  if (!buffer.has_value()) {
+    FML_LOG(ERROR) << "The embedder did not provide a software buffer.";
+    return nullptr;
+  }
+
+  sk_surface_ = SkSurfaces::WrapPixels(
+      SkImageInfo::Make(size, buffer->color_info),  // image info
+      buffer->allocation,                           // pixels
+      buffer->row_bytes                             // row bytes
+  );
+  if (sk_surface_ == nullptr) {
+    FML_LOG(ERROR) << "Could not wrap embedder supplied software buffer.";
+    software_dispatch_table_.software_release_buffer(buffer->id);
+    return nullptr;
+  }
+
+  if (size != buffer_damage_size_) {
+    buffer_damage_.clear();
+    buffer_damage_size_ = size;
+  }
+  buffer_id_ = buffer->id;
+  return sk_surface_;
+}
+
+void EmbedderSurfaceSoftware::ReleaseEmbedderBuffer() {
+  sk_surface_ = nullptr;
+  if (!buffer_id_.has_value()) {
+    return;
+  }
+  const auto buffer_id = buffer_id_.value();
+  buffer_id_ = std::nullopt;
+  // Whatever was rendered into the buffer is unknown to the next frame.
+  buffer_damage_.erase(buffer_id);
+  software_dispatch_table_.software_release_buffer(buffer_id);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+void EmbedderSurfaceSoftware::DiscardBackingStore(
+    sk_sp<SkSurface> backing_store) {
+  // Only the buffer of the current frame is still held by the engine.
+  if (UsesEmbedderBuffers() && backing_store != nullptr &&
+      backing_store == sk_surface_) {
+    ReleaseEmbedderBuffer();
+  }
+}
+
+bool EmbedderSurfaceSoftware::PresentEmbedderBuffer(
+    const SkISize& size,
+    const SurfaceFrame::SubmitInfo& submit_info) {
+  TRACE_EVENT0("flutter", "EmbedderSurfaceSoftware::PresentEmbedderBuffer");
+  const auto buffer_id = buffer_id_.value();
+  sk_surface_ = nullptr;
+  buffer_id_ = std::nullopt;
+
+  // Without damage from the rasterizer, the whole frame was painted.
+  const auto bounds = SkIRect::MakeSize(size);
+  const SoftwareBufferPresentInfo present_info = {
+      .id = buffer_id,
+      .frame_damage = submit_info.frame_damage.value_or(bounds),
+      .buffer_damage = submit_info.buffer_damage.value_or(bounds),
+  };
+
+  if (!software_dispatch_table_.software_present_buffer(present_info)) {
+    // The contents of the buffers are unknown now.
+    buffer_damage_.clear();
+    return false;
+  }
+
+  // All the other buffers now lag behind the presented one by the damage of
+  // this frame.
+  for (auto& [id, damage] : buffer_damage_) {
+    damage.join(present_info.frame_damage);
+  }
+  if (buffer_damage_.size() >= kMaxTrackedBuffers &&
+      buffer_damage_.find(buffer_id) == buffer_damage_.end()) {
+    buffer_damage_.clear();
+  }
+  buffer_damage_[buffer_id] = SkIRect::MakeEmpty();
+  return true;
+}
+
 }  // namespace flutter
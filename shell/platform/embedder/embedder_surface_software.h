@@ -5,11 +5,15 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include <optional>
+#include <unordered_map>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 #include "flutter/shell/platform/embedder/embedder_surface.h"
 
+#include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
@@ -17,9 +21,33 @@ namespace flutter {
 class EmbedderSurfaceSoftware final : public EmbedderSurface,
                                       public GPUSurfaceSoftwareDelegate {
  public:
+  /// A buffer owned by the embedder that a frame is rendered into directly.
+  struct SoftwareBuffer {
+    intptr_t id = 0;
+    void* allocation = nullptr;
+    size_t row_bytes = 0;
+    SkColorInfo color_info;
+  };
+
+  struct SoftwareBufferPresentInfo {
+    intptr_t id = 0;
+    /// The area that changed since the previous frame.
+    SkIRect frame_damage;
+    /// The area of the buffer that was rendered into.
+    SkIRect buffer_damage;
+  };
+
+  /// Either `software_present_backing_store`, or all the buffer callbacks,
+  /// must be specified.
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;
+    std::function<std::optional<SoftwareBuffer>(const SkISize& size)>
+        software_acquire_buffer;
+    std::function<bool(const SoftwareBufferPresentInfo& present_info)>
+        software_present_buffer;
+    /// Gives back a buffer that was acquired but will not be presented.
+    std::function<void(intptr_t id)> software_release_buffer;
   };
 
   EmbedderSurfaceSoftware(
@@ -29,10 +57,30 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   ~EmbedderSurfaceSoftware() override;
 
  private:
+  // The number of buffers whose damage is tracked. Embedders cycle through a
+  // small pool of buffers, so this is only reached if buffer identifiers are
+  // not reused. Tracking then starts over with a full repaint of each buffer.
+  static constexpr size_t kMaxTrackedBuffers = 16;
+
   bool valid_ = false;
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  // The embedder buffer that |sk_surface_| wraps, if any.
+  std::optional<intptr_t> buffer_id_;
+  // For each buffer presented at the current size, the area that has changed
+  // since it was last presented. Other buffers are repainted in full.
+  std::unordered_map<intptr_t, SkIRect> buffer_damage_;
+  SkISize buffer_damage_size_ = SkISize::MakeEmpty();
+
+  bool UsesEmbedderBuffers() const;
+
+  sk_sp<SkSurface> AcquireEmbedderBuffer(const SkISize& size);
+
+  void ReleaseEmbedderBuffer();
+
+  bool PresentEmbedderBuffer(const SkISize& size,
+                             const SurfaceFrame::SubmitInfo& submit_info);
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -49,6 +97,17 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  SurfaceFrame::FramebufferInfo GetBackingStoreFramebufferInfo() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithInfo(
+      sk_sp<SkSurface> backing_store,
+      const SurfaceFrame::SubmitInfo& submit_info) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  void DiscardBackingStore(sk_sp<SkSurface> backing_store) override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_surface_software.h"
+
+#include <deque>
+#include <vector>
+
+#include "flutter/fml/message_loop.h"
+#include "flutter/testing/testing.h"
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+// An embedder pool of software buffers that are handed out in turn.
+class TestSoftwareBufferPool {
+ public:
+  TestSoftwareBufferPool(size_t count, SkISize size) : size_(size) {
+    for (size_t i = 0; i < count; i++) {
+      buffers_.emplace_back(size.width() * size.height());
+      free_ids_.push_back(i);
+    }
+  }
+
+  size_t GetFreeCount() const { return free_ids_.size(); }
+
+  EmbedderSurfaceSoftware::SoftwareDispatchTable CreateDispatchTable() {
+    EmbedderSurfaceSoftware::SoftwareDispatchTable table;
+    table.software_acquire_buffer = [this](const SkISize& size)
+        -> std::optional<EmbedderSurfaceSoftware::SoftwareBuffer> {
+      if (free_ids_.empty() || size != size_) {
+        return std::nullopt;
+      }
+      const intptr_t id = free_ids_.front();
+      free_ids_.pop_front();
+      return EmbedderSurfaceSoftware::SoftwareBuffer{
+          .id = id,
+          .allocation = buffers_[id].data(),
+          .row_bytes = size.width() * sizeof(uint32_t),
+          .color_info = SkColorInfo(kN32_SkColorType, kPremul_SkAlphaType,
+                                    SkColorSpace::MakeSRGB()),
+      };
+    };
+    table.software_present_buffer =
+        [this](const EmbedderSurfaceSoftware::SoftwareBufferPresentInfo&
+                   present_info) {
+          free_ids_.push_back(present_info.id);
+          return true;
+        };
+    table.software_release_buffer = [this](intptr_t id) {
+      free_ids_.push_back(id);
+    };
+    return table;
+  }
+
+ private:
+  const SkISize size_;
+  std::vector<std::vector<uint32_t>> buffers_;
+  std::deque<intptr_t> free_ids_;
+};
+
+}  // namespace
+
+TEST(EmbedderSurfaceSoftwareTest, DroppedFramesReturnTheirBuffers) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  const auto size = SkISize::Make(16, 16);
+  TestSoftwareBufferPool pool(2, size);
+  auto embedder_surface = std::make_unique<EmbedderSurfaceSoftware>(
+      pool.CreateDispatchTable(), nullptr);
+  auto surface =
+      static_cast<EmbedderSurface&>(*embedder_surface).CreateGPUSurface();
+  ASSERT_NE(surface, nullptr);
+
+  for (size_t i = 0; i < 10; i++) {
+    auto frame = surface->AcquireFrame(size);
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(pool.GetFreeCount(), 1u);
+    // The frame is dropped without being submitted.
+  }
+  ASSERT_EQ(pool.GetFreeCount(), 2u);
+
+  // Presented buffers are returned by the embedder's present callback alone.
+  auto frame = surface->AcquireFrame(size);
+  ASSERT_NE(frame, nullptr);
+  ASSERT_TRUE(frame->Submit());
+  frame.reset();
+  ASSERT_EQ(pool.GetFreeCount(), 2u);
+
+  // A buffer that is still held when the surfaces go away is given back too.
+  frame = surface->AcquireFrame(size);
+  ASSERT_NE(frame, nullptr);
+  ASSERT_EQ(pool.GetFreeCount(), 1u);
+  surface.reset();
+  frame.reset();
+  embedder_surface.reset();
+  ASSERT_EQ(pool.GetFreeCount(), 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
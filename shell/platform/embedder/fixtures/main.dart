@@ -726,6 +726,19 @@ void render_gradient() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+void render_gradient_over_and_over() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    SceneBuilder builder = SceneBuilder();
+    builder.pushOffset(0.0, 0.0);
+    builder.addPicture(Offset(0.0, 0.0), CreateGradientBox(Size(800.0, 600.0)));
+    builder.pop();
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 void render_texture() {
   PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
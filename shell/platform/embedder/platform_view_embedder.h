@@ -31,9 +31,9 @@ namespace flutter {
 
 class PlatformViewEmbedder final : public PlatformView {
  public:
-  using UpdateSemanticsCallback =
-      std::function<void(flutter::SemanticsNodeUpdates update,
-                         flutter::CustomAccessibilityActionUpdates actions)>;
+  using UpdateSemanticsCallback = std::function<void(
+      const flutter::PackedSemanticsUpdate& update,
+      const flutter::CustomAccessibilityActionUpdates& actions)>;
   using PlatformMessageResponseCallback =
       std::function<void(std::unique_ptr<PlatformMessage>)>;
   using ComputePlatformResolvedLocaleCallback =
@@ -94,9 +94,9 @@ class PlatformViewEmbedder final : public PlatformView {
   ~PlatformViewEmbedder() override;
 
   // |PlatformView|
-  void UpdateSemantics(
-      flutter::SemanticsNodeUpdates update,
-      flutter::CustomAccessibilityActionUpdates actions) override;
+  void UpdatePackedSemantics(
+      const flutter::PackedSemanticsUpdate& update,
+      const flutter::CustomAccessibilityActionUpdates& actions) override;
 
   // |PlatformView|
   void HandlePlatformMessage(std::unique_ptr<PlatformMessage> message) override;
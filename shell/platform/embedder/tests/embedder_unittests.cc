@@ -4,6 +4,7 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <array>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1335,6 +1336,136 @@ TEST_F(EmbedderTest, VerifyB143464703WithSoftwareBackend) {
       ImageMatchesFixture("verifyb143464703_soft_noxform.png", rendered_scene));
 }
 
+TEST_F(EmbedderTest, MustNotRunWithBothSoftwarePresentationModes) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetRendererConfig().software.acquire_buffer_callback =
+      [](void* user_data, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBuffer* buffer) -> bool { return false; };
+  builder.GetRendererConfig().software.present_buffer_callback =
+      [](void* user_data, const FlutterSoftwarePresentInfo* present_info)
+      -> bool { return false; };
+  builder.GetRendererConfig().software.release_buffer_callback =
+      [](void* user_data, intptr_t buffer_id) {};
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
+TEST_F(EmbedderTest, MustNotRunWithoutSoftwareBufferPresentCallback) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetRendererConfig().software.surface_present_callback = nullptr;
+  builder.GetRendererConfig().software.acquire_buffer_callback =
+      [](void* user_data, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBuffer* buffer) -> bool { return false; };
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
+TEST_F(EmbedderTest, MustNotRunWithoutSoftwareBufferReleaseCallback) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.GetRendererConfig().software.surface_present_callback = nullptr;
+  builder.GetRendererConfig().software.acquire_buffer_callback =
+      [](void* user_data, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBuffer* buffer) -> bool { return false; };
+  builder.GetRendererConfig().software.present_buffer_callback =
+      [](void* user_data, const FlutterSoftwarePresentInfo* present_info)
+      -> bool { return false; };
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
+TEST_F(EmbedderTest, CanRenderIntoEmbedderSoftwareBuffers) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetDartEntrypoint("render_gradient_over_and_over");
+
+  // The embedder cycles through two buffers. The callbacks are invoked on the
+  // raster thread.
+  static constexpr size_t kFrameCount = 4;
+  static std::array<std::vector<uint32_t>, 2> buffers;
+  static size_t acquired_count = 0;
+  static std::vector<std::pair<SkIRect, SkIRect>> damage;
+  static fml::CountDownLatch latch(kFrameCount);
+
+  auto& software_config = builder.GetRendererConfig().software;
+  software_config.surface_present_callback = nullptr;
+  software_config.acquire_buffer_callback =
+      [](void* user_data, const FlutterFrameInfo* frame_info,
+         FlutterSoftwareBuffer* buffer) -> bool {
+    const size_t index = acquired_count++ % buffers.size();
+    buffers[index].resize(frame_info->size.width * frame_info->size.height);
+    buffer->buffer_id = index;
+    buffer->allocation = buffers[index].data();
+    buffer->row_bytes = frame_info->size.width * sizeof(uint32_t);
+    buffer->pixel_format = kFlutterSoftwarePixelFormatNative32;
+    return true;
+  };
+  software_config.present_buffer_callback =
+      [](void* user_data, const FlutterSoftwarePresentInfo* present_info)
+      -> bool {
+    EXPECT_EQ(static_cast<size_t>(present_info->buffer_id),
+              (acquired_count - 1) % buffers.size());
+    EXPECT_EQ(present_info->frame_damage.num_rects, 1u);
+    EXPECT_EQ(present_info->buffer_damage.num_rects, 1u);
+    if (damage.size() < kFrameCount) {
+      const auto& frame = *present_info->frame_damage.damage;
+      const auto& buffer = *present_info->buffer_damage.damage;
+      damage.emplace_back(
+          SkIRect::MakeLTRB(frame.left, frame.top, frame.right, frame.bottom),
+          SkIRect::MakeLTRB(buffer.left, buffer.top, buffer.right,
+                            buffer.bottom));
+      latch.CountDown();
+    }
+    return true;
+  };
+  software_config.release_buffer_callback = [](void* user_data,
+                                               intptr_t buffer_id) {};
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+
+  const auto bounds = SkIRect::MakeWH(800, 600);
+  // The first frame is painted in full.
+  ASSERT_EQ(damage[0].first, bounds);
+  ASSERT_EQ(damage[0].second, bounds);
+  // The second buffer is painted in full, but nothing changed on screen.
+  ASSERT_TRUE(damage[1].first.isEmpty());
+  ASSERT_EQ(damage[1].second, bounds);
+  // Both buffers are up to date, so nothing is painted anymore.
+  for (size_t i = 2; i < kFrameCount; i++) {
+    ASSERT_TRUE(damage[i].first.isEmpty());
+    ASSERT_TRUE(damage[i].second.isEmpty());
+  }
+
+  // The pixels were rendered into the embedder owned buffer.
+  ASSERT_NE(buffers[0][0], 0u);
+
+  engine.reset();
+}
+
 TEST_F(EmbedderTest, CanSendLowMemoryNotification) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
 
@@ -2470,6 +2601,79 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetFrameLatencyStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameLatencyStatistics statistics = {};
+  ASSERT_EQ(FlutterEngineGetFrameLatencyStatistics(engine.get(), false,
+                                                   &statistics),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameLatencyStatistics(engine.get(), false,
+                                                   nullptr),
+            kInvalidArguments);
+
+  fml::AutoResetWaitableEvent frame_latch;
+  VoidCallback frame_callback = [](void* user_data) {
+    static_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+  };
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(engine.get(), frame_callback,
+                                              &frame_latch),
+            kSuccess);
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  frame_latch.Wait();
+
+  auto draw_frame = [&]() {
+    ASSERT_EQ(FlutterEngineSetNextFrameCallback(engine.get(), frame_callback,
+                                                &frame_latch),
+              kSuccess);
+    ASSERT_EQ(FlutterEngineScheduleFrame(engine.get()), kSuccess);
+    frame_latch.Wait();
+  };
+
+  // The next frame callback fires just before a frame is added to the
+  // statistics, so every frame but the last drawn one is guaranteed to be
+  // counted.
+  constexpr uint64_t kFrameCount = 4;
+  for (uint64_t i = 1; i < kFrameCount; i++) {
+    draw_frame();
+  }
+
+  statistics.struct_size = sizeof(statistics);
+  ASSERT_EQ(FlutterEngineGetFrameLatencyStatistics(engine.get(), true,
+                                                   &statistics),
+            kSuccess);
+  const uint64_t first_count = statistics.frame_count;
+  ASSERT_GE(first_count, kFrameCount - 1);
+  ASSERT_GT(statistics.total.max, 0u);
+  ASSERT_LE(statistics.total.p50, statistics.total.p90);
+  ASSERT_LE(statistics.total.p90, statistics.total.p99);
+  ASSERT_LE(statistics.total.p99, statistics.total.p999);
+  ASSERT_LE(statistics.total.p999, statistics.total.max);
+
+  // The frame that may have been rasterized during the reset must not be
+  // lost.
+  draw_frame();
+  draw_frame();
+  ASSERT_EQ(FlutterEngineGetFrameLatencyStatistics(engine.get(), false,
+                                                   &statistics),
+            kSuccess);
+  ASSERT_GE(first_count + statistics.frame_count, kFrameCount + 1);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {